@@ -2,21 +2,15 @@
 
 #include "windows.h"
 #include "CrossThreadsMessagingDevice.h"
-
-//#include "mmgr.h"
 
-std::queue<CCrossThreadsMessagingDevice::Msg> CCrossThreadsMessagingDevice::msg_queue;
-CRITICAL_SECTION CCrossThreadsMessagingDevice::queue_mutex;
+//#include "mmgr.h"
 
-class InitialiseMutex {
-public:
-  InitialiseMutex() 
-  {
-    InitializeCriticalSection(&CCrossThreadsMessagingDevice::queue_mutex);
-  }
-};
+CCrossThreadsMessagingDevice::Msg CCrossThreadsMessagingDevice::ring[CTMD_QUEUESIZE];
+std::atomic<unsigned> CCrossThreadsMessagingDevice::ring_head(0);
+std::atomic<unsigned> CCrossThreadsMessagingDevice::ring_tail(0);
 
-static InitialiseMutex init;
+std::atomic<std::thread::id> CCrossThreadsMessagingDevice::consumer;
+std::queue<CCrossThreadsMessagingDevice::Msg> CCrossThreadsMessagingDevice::local_queue;
 
 CCrossThreadsMessagingDevice::CCrossThreadsMessagingDevice()
   : m_pMonitor(NULL)
@@ -27,51 +21,90 @@ CCrossThreadsMessagingDevice::~CCrossThreadsMessagingDevice()
 {
 }
 
-void CCrossThreadsMessagingDevice::Post(WPARAM wParam, LPARAM lParam)
+bool CCrossThreadsMessagingDevice::Post(WPARAM wParam, LPARAM lParam, bool reserved)
 {
-  enqueue(Msg(this, wParam, lParam));
+  Msg m(this, wParam, lParam);
+
+  if (consumer.load(std::memory_order_relaxed) == std::this_thread::get_id()) {
+    local_queue.push(m);
+    return true;
+  }
+
+  return enqueue(m, reserved);
 }
 
-void CCrossThreadsMessagingDevice::ProcessMessages()
+int CCrossThreadsMessagingDevice::ProcessMessages(int maxMessages)
 {
+  consumer.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+  /* Inbound traffic first, then anything posted from this thread.
+     A handler may post more locally, so the local count is fixed up front */
+  int processed = 0;
   CCrossThreadsMessagingDevice::Msg m;
-  while (dequeue(m)) {
-    if( m.ctmd ) {
-      CCrossThreadsMessagingDevice *pThis = m.ctmd;
-      if (pThis->m_pMonitor ) 
-	pThis->m_pMonitor->OnCrossThreadsMessage(m.wParam, m.lParam);
-    }
+  while ((maxMessages < 0 || processed < maxMessages) && dequeue(m)) {
+    if (m.ctmd && m.ctmd->m_pMonitor)
+      m.ctmd->m_pMonitor->OnCrossThreadsMessage(m.wParam, m.lParam);
+    ++processed;
   }
+
+  size_t numLocal = local_queue.size();
+  while (numLocal-- > 0 && !local_queue.empty()) {
+    m = local_queue.front();
+    local_queue.pop();
+    if (m.ctmd && m.ctmd->m_pMonitor)
+      m.ctmd->m_pMonitor->OnCrossThreadsMessage(m.wParam, m.lParam);
+    ++processed;
+  }
+
+  return processed;
 }
 
 void CCrossThreadsMessagingDevice::ClearAllMessages()
 {
-  EnterCriticalSection(&queue_mutex);
-  while (!msg_queue.empty())
-    msg_queue.pop();
-  LeaveCriticalSection(&queue_mutex);  
+  /* Only the consumer moves the tail, so this is safe from the draining thread */
+  ring_tail.store(ring_head.load(std::memory_order_acquire), std::memory_order_release);
+  while (!local_queue.empty())
+    local_queue.pop();
 }
 
-void CCrossThreadsMessagingDevice::enqueue(Msg m)
+int CCrossThreadsMessagingDevice::NumQueued()
 {
- EnterCriticalSection(&queue_mutex);
- msg_queue.push(m);
- LeaveCriticalSection(&queue_mutex);
+  return (int) (ring_head.load(std::memory_order_acquire) - ring_tail.load(std::memory_order_acquire))
+       + (int) local_queue.size();
 }
 
-bool CCrossThreadsMessagingDevice::dequeue(Msg &m)
+bool CCrossThreadsMessagingDevice::HasRoom(int count, bool reserved)
 {
-  bool result;
-  EnterCriticalSection(&queue_mutex);
-  if (!msg_queue.empty()) {
-    m = msg_queue.front();
-    msg_queue.pop();
-    result = true;
-  }
-  else
-    result = false;
-  LeaveCriticalSection(&queue_mutex);
-  return result;
+  return room(reserved) >= (unsigned) count;
+}
+
+/* Free slots as seen by the producer - only grows until it posts again */
+unsigned CCrossThreadsMessagingDevice::room(bool reserved)
+{
+  unsigned used = ring_head.load(std::memory_order_relaxed) - ring_tail.load(std::memory_order_acquire);
+  unsigned size = reserved ? CTMD_QUEUESIZE : CTMD_QUEUESIZE - CTMD_RESERVEDSLOTS;
+  return used >= size ? 0 : size - used;
 }
 
- 
+bool CCrossThreadsMessagingDevice::enqueue(const Msg &m, bool reserved)
+{
+  if (room(reserved) == 0)
+    return false;
+
+  unsigned head = ring_head.load(std::memory_order_relaxed);
+
+  ring[head & (CTMD_QUEUESIZE - 1)] = m;
+  ring_head.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+bool CCrossThreadsMessagingDevice::dequeue(Msg &m)
+{
+  unsigned tail = ring_tail.load(std::memory_order_relaxed);
+  if (tail == ring_head.load(std::memory_order_acquire))
+    return false;
+
+  m = ring[tail & (CTMD_QUEUESIZE - 1)];
+  ring_tail.store(tail + 1, std::memory_order_release);
+  return true;
+}
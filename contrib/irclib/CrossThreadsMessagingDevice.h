@@ -5,6 +5,20 @@
 
 #include <windows.h>
 #include <queue>
+#include <atomic>
+#include <thread>
+
+/*
+  Messages posted from the network thread travel through a fixed size
+  single producer / single consumer ring, so neither side ever takes a lock.
+  Posts made from the thread that drains the queue (eg replies sent from a
+  message handler) go on a separate local queue instead.
+  The last few slots are kept back for reserved posts, so a session's
+  closing notice always gets through however far behind the consumer is.
+*/
+
+#define CTMD_QUEUESIZE     8192        // Must be a power of two
+#define CTMD_RESERVEDSLOTS 64          // Only reserved posts may use these
 
 class CCrossThreadsMessagingDevice
 {
@@ -18,11 +32,13 @@ public :
   virtual ~CCrossThreadsMessagingDevice();
 
   void SetMonitor(ICrossThreadsMessagingDeviceMonitor* pMonitor) { m_pMonitor = pMonitor; }
-  void Post(WPARAM wParam, LPARAM lParam);
+  bool Post(WPARAM wParam, LPARAM lParam, bool reserved = false);     // false if the queue is full
 
-  /* Call this in the target thread */
-  static void ProcessMessages();
+  /* Call this in the target thread - returns the number dispatched */
+  static int ProcessMessages(int maxMessages = -1);
   static void ClearAllMessages();
+  static int NumQueued();
+  static bool HasRoom(int count, bool reserved = false);            // For count posts from the producer
 
   operator bool() const { return true; }
 
@@ -45,11 +61,15 @@ private:
   };
 
 
-  friend class InitialiseMutex;
-  static CRITICAL_SECTION queue_mutex;
-  static std::queue<Msg> msg_queue;
-  
-  static void enqueue(Msg);
+  static Msg ring[CTMD_QUEUESIZE];
+  static std::atomic<unsigned> ring_head;     // Written by the producer only
+  static std::atomic<unsigned> ring_tail;     // Written by the consumer only
+
+  static std::atomic<std::thread::id> consumer;
+  static std::queue<Msg> local_queue;         // Touched by the consumer only
+
+  static unsigned room(bool reserved);
+  static bool enqueue(const Msg &m, bool reserved);
   static bool dequeue(Msg &m);
   
 };
@@ -184,50 +184,47 @@ bool CIrcSession::Connect(const CIrcSessionInfo& info)
 {
 //	ASSERT(m_hThread==NULL && !m_socket);
 
-	try
-	{
-		if( !m_socket.Create() )
-			throw "Failed to create socket!";
-
-		InetAddr addr(info.sServer.c_str(), info.iPort);
-		if( !m_socket.Connect(addr) )
-		{
-			m_socket.Close();
-			throw "Failed to connect to host!";
-		}
+	if( !m_socket.Create() )
+		return false;
 
-		m_info = info;
+	m_info = info;
 
-		// start receiving messages from host
+	// the host is looked up, connected to and registered with on the
+	// receiving thread, so a slow server never holds up the caller.
+	// a failure shows up as a disconnection.
+	// hold m_cs so a quick failure can't clear m_hThread before it's set
+	EnterCriticalSection(&m_cs);
 #ifndef WIN32
-		m_hThread = CreateThread(NULL, 0, (void *) ThreadProc, this, 0, NULL);
+	m_hThread = CreateThread(NULL, 0, (void *) ThreadProc, this, 0, NULL);
 #else
-		m_hThread = CreateThread(NULL, 0, ThreadProc, this, 0, NULL);
+	m_hThread = CreateThread(NULL, 0, ThreadProc, this, 0, NULL);
 #endif
-		Sleep(100);
+	LeaveCriticalSection(&m_cs);
+	if( !m_hThread )
+		m_socket.Close();
 
-		if( info.sPassword.length() )
-			m_socket.Send("PASS %s\r\n", info.sPassword.c_str());
+	return (bool)m_socket;
+}
 
-		m_socket.Send("NICK %s\r\n", info.sNick.c_str());
+bool CIrcSession::DoConnect()
+{
+	InetAddr addr(m_info.sServer.c_str(), m_info.iPort);
+	if( !m_socket.Connect(addr) )
+		return false;
 
-		TCHAR szHostName[MAX_PATH];
-		DWORD cbHostName = sizeof(szHostName);
-		GetComputerName(szHostName, &cbHostName);
+	if( m_info.sPassword.length() )
+		m_socket.Send("PASS %s\r\n", m_info.sPassword.c_str());
 
-		m_socket.Send("USER %s %s %s :%s\r\n", 
-			info.sUserID.c_str(), szHostName, "server", info.sFullName.c_str());
-	}
-	catch( const char* )
-	{
-		Disconnect();
-	}
-	catch( ... )
-	{
-		Disconnect();
-	}
+	m_socket.Send("NICK %s\r\n", m_info.sNick.c_str());
 
-	return (bool)m_socket;
+	TCHAR szHostName[MAX_PATH];
+	DWORD cbHostName = sizeof(szHostName);
+	GetComputerName(szHostName, &cbHostName);
+
+	m_socket.Send("USER %s %s %s :%s\r\n", 
+		m_info.sUserID.c_str(), szHostName, "server", m_info.sFullName.c_str());
+
+	return true;
 }
 
 void CIrcSession::Disconnect(const char* lpszMessage)
@@ -253,6 +250,19 @@ void CIrcSession::Disconnect(const char* lpszMessage)
 	}
 }
 
+void CIrcSession::WaitForRoom(bool reserved)
+{
+	// hold up the network thread (and so the server) until the monitors'
+	// thread has room for one copy per monitor. done outside m_cs, so the
+	// monitors' thread can still add and remove monitors meanwhile
+	EnterCriticalSection(&m_cs);
+	int nMonitors = (int)m_monitors.size();
+	LeaveCriticalSection(&m_cs);
+
+	while( !CCrossThreadsMessagingDevice::HasRoom(nMonitors, reserved) && (reserved || m_socket) )
+		Sleep(1);
+}
+
 void CIrcSession::Notify(const CIrcMessage* pmsg)
 {
 	// forward message to monitor objects
@@ -276,6 +286,9 @@ void CIrcSession::DoReceive()
 	if( m_info.bIdentServer )
 		m_identServer.Start(m_info.sUserID.c_str());
 
+	if( m_socket && !DoConnect() )
+		m_socket.Close();
+
 	while( m_socket )
 	{
 		int cbRead;
@@ -308,6 +321,13 @@ void CIrcSession::DoReceive()
 			{
 				// process single message by monitor objects
 				CIrcMessage msg(pStart, true);
+
+				// answer pings here, so the server doesn't drop us while
+				// the monitors' thread is busy
+				if( msg.sCommand == "PING" && msg.parameters.size() > 0 )
+					m_socket.Send("PONG :%s\r\n", msg.parameters[0].c_str());
+
+				WaitForRoom(false);
 				Notify(&msg);
 			}
 
@@ -329,6 +349,7 @@ void CIrcSession::DoReceive()
 		m_identServer.Stop();
 
 	// notify monitor objects that the connection has been closed
+	WaitForRoom(true);
 	Notify(NULL);
 }
 
@@ -337,8 +358,10 @@ DWORD WINAPI CIrcSession::ThreadProc(LPVOID pparam)
 	CIrcSession* pThis = (CIrcSession*)pparam;
 	try { pThis->DoReceive(); } catch( ... ) {}
 	pThis->m_info.Reset();
+	EnterCriticalSection(&pThis->m_cs);
 	CloseHandle(pThis->m_hThread);
 	pThis->m_hThread = NULL;
+	LeaveCriticalSection(&pThis->m_cs);
 	return 0;
 }
 
@@ -526,7 +549,12 @@ void CIrcMonitor::OnIrcMessage(const CIrcMessage* pmsg)
 	if( pmsg )
 		pMsgCopy = new CIrcMessage(*pmsg);
 
-	m_xPost.Post(0, (LPARAM)pMsgCopy);
+	// called with the session's m_cs held, so never wait here -
+	// DoReceive has already waited for room. the closing NULL may use the
+	// reserved slots, and so may a line if a monitor was added meanwhile
+	if( !m_xPost.Post(0, (LPARAM)pMsgCopy, pmsg == NULL) &&
+		!m_xPost.Post(0, (LPARAM)pMsgCopy, true) )
+		delete pMsgCopy;
 	//OnCrossThreadsMessage(0, (LPARAM)pMsgCopy);
 }
 
@@ -548,7 +576,7 @@ void CIrcMonitor::OnCrossThreadsMessage(WPARAM wParam, LPARAM lParam)
 		}
 		else // handler not found. call default handler
 			OnIrcDefault(pmsg);
-		// delete pmsg;
+		delete pmsg;
 	}
 	else
 		OnIrcDisconnected();
@@ -578,7 +606,6 @@ CIrcDefaultMonitor::CIrcDefaultMonitor(CIrcSession& session)
 	: CIrcMonitor(session)
 {
 	IRC_MAP_ENTRY(CIrcDefaultMonitor, "NICK", OnIrc_NICK)
-	IRC_MAP_ENTRY(CIrcDefaultMonitor, "PING", OnIrc_PING)
 	IRC_MAP_ENTRY(CIrcDefaultMonitor, "002", OnIrc_YOURHOST)
 	IRC_MAP_ENTRY(CIrcDefaultMonitor, "005", OnIrc_BOUNCE)
 }
@@ -590,14 +617,6 @@ bool CIrcDefaultMonitor::OnIrc_NICK(const CIrcMessage* pmsg)
 	return false;
 }
 
-bool CIrcDefaultMonitor::OnIrc_PING(const CIrcMessage* pmsg)
-{
-	char szResponse[100];
-	sprintf(szResponse, "PONG %s", pmsg->parameters[0].c_str());
-	m_session << CIrcMessage(szResponse);
-	return false;
-}
-
 bool CIrcDefaultMonitor::OnIrc_YOURHOST(const CIrcMessage* pmsg)
 {
 	static const char* lpszFmt = "Your host is %[^ \x5b,], running version %s";
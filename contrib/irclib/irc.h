@@ -110,6 +110,7 @@ protected :
 	Socket m_socket;
 	CIrcSessionInfo m_info;
 
+	bool DoConnect();
 	void DoReceive();
 
 private :
@@ -117,6 +118,7 @@ private :
 	HANDLE m_hThread;
 	CRITICAL_SECTION m_cs; // protect m_monitors
 
+	void WaitForRoom(bool reserved);
 	void Notify(const CIrcMessage* pmsg);
 	static DWORD WINAPI ThreadProc(LPVOID pparam);
 };
@@ -242,7 +244,6 @@ public :
 
 protected :
 	bool OnIrc_NICK(const CIrcMessage* pmsg);
-	bool OnIrc_PING(const CIrcMessage* pmsg);
 	bool OnIrc_YOURHOST(const CIrcMessage* pmsg);
 	bool OnIrc_BOUNCE(const CIrcMessage* pmsg);
 };
@@ -35,6 +35,8 @@ namespace Windows {
     // waitFor returns false if timed out (otherwise true)
     // timeout is given in milliseconds
     virtual bool waitFor( unsigned int timeout ) = 0;
+
+    virtual ~Handle() { }
   };
 
   class Thread : public Handle {
@@ -44,6 +46,7 @@ namespace Windows {
     virtual bool waitFor( unsigned timeout );
   
     void terminate();
+    void close();
 
   private:
     typedef void * (StartRoutine)(void *);
@@ -57,17 +60,19 @@ namespace Windows {
     StartRoutine *threadProc;
     void *arg;
 
-    bool started, running;
+    bool started, running, closed;
     int id;
   };
 
 
   Thread::Thread( void *threadProc, void *arg )
-    : threadProc((Thread::StartRoutine *) threadProc), arg(arg), started(false), running(false), id(0)
+    : threadProc((Thread::StartRoutine *) threadProc), arg(arg), started(false), running(false), closed(false), id(0)
   {
     pthread_mutex_init(&mutex, NULL);
     pthread_cond_init(&cond, NULL);
     id = pthread_create(&thr, NULL /* Attributes */, Thread::run, this);
+    if (id == 0)
+      pthread_detach(thr);   /* Nothing joins - waitFor uses the condition */
   }
 
   void *Thread::run( void *a )
@@ -84,8 +89,12 @@ namespace Windows {
     pthread_mutex_lock(&t->mutex);
     t->running = false;
     pthread_cond_signal(&t->cond);
+    bool closed = t->closed;
     pthread_mutex_unlock(&t->mutex);
 
+    if (closed)
+      delete t;
+
     return result;
   }
 
@@ -136,6 +145,20 @@ namespace Windows {
     pthread_mutex_unlock(&mutex);  
   }
 
+  // A thread closing its own handle (as irclib's do) is freed once it 
+  // has finished running, rather than from under itself
+  void Thread::close()
+  {
+    pthread_mutex_lock(&mutex);
+    bool stillRunning = running || !started;
+    if (stillRunning)
+      closed = true;
+    pthread_mutex_unlock(&mutex);
+
+    if (!stillRunning)
+      delete this;
+  }
+
 }
 
 using namespace Windows;
@@ -154,7 +177,7 @@ void TerminateThread(HANDLE thread, INT result)
 void CloseHandle(HANDLE thread)
 {
   /* Supposed to free up the thread */
-  delete (Thread *) thread;
+  ((Thread *) thread)->close();
 }
 
 int WaitForSingleObject( HANDLE object, DWORD timeout )
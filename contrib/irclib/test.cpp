@@ -1,10 +1,208 @@
+// test.cpp
+//
+// Loopback stress test for the session's receive path.
+// A stand-in IRC server on 127.0.0.1 registers the client, then floods the
+// channel with numbered PRIVMSGs as fast as it is asked to.  The main thread
+// plays the part of the game, draining a frame's worth of messages every 16ms,
+// and checks nothing was lost or reordered.
+//
+//    test [lines] [lines per second] [port]
+
 #include "irc.h"
 #include <stdio.h>
-
-//#include "mmgr.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+using namespace irc;
+
+//#include "mmgr.h"
+
+#define TEST_MESSAGESPERFRAME 256
+#define TEST_FRAMETIME        16
+
+static int numLines = 100000;
+static int linesPerSecond = 10000;
+static int port = 16667;
+
+static double TimeNow()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+////////////////////////////////////////////////////////////////////
+
+DWORD WINAPI ServerProc(LPVOID pparam)
+{
+	Socket* listener = (Socket*)pparam;
+
+	InetAddr addr;
+	Socket client = listener->Accept(addr);
+	if( !client )
+		return 1;
+
+	// wait for the client to register
+	char chBuf[1024];
+	int cbInBuf = 0;
+	while( !strstr(chBuf, "USER ") )
+	{
+		int cbRead = client.Receive((unsigned char*)chBuf + cbInBuf, sizeof(chBuf) - cbInBuf - 1);
+		if( cbRead <= 0 )
+			return 1;
+		cbInBuf += cbRead;
+		chBuf[cbInBuf] = '\0';
+	}
+
+	client.Send(":loopback 001 tester :Welcome to the loopback server\r\n");
+	client.Send("PING :loopback\r\n");
+
+	double start = TimeNow();
+	for( int i = 0; i < numLines; ++i )
+	{
+		// pace the flood, a few lines at a time
+		while( i > ( TimeNow() - start ) * linesPerSecond )
+			Sleep(1);
+
+		if( client.Send(":flooder!f@loopback PRIVMSG #uplink :line %d\r\n", i) <= 0 )
+			break;
+	}
+
+	// half close and wait for the client to hang up, so unread replies
+	// here don't reset the connection before it has had everything
+	client.Send("ERROR :Closing link\r\n");
+	shutdown(client, 1);
+	while( client.Receive((unsigned char*)chBuf, sizeof(chBuf)) > 0 )
+		;
+	client.Close();
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////
+
+class TestMonitor : public CIrcDefaultMonitor
+{
+public :
+	int received;
+	int outOfOrder;
+	bool welcomed;
+	bool disconnected;
+
+	TestMonitor(CIrcSession& session)
+		: CIrcDefaultMonitor(session), received(0), outOfOrder(0), welcomed(false), disconnected(false)
+	{
+		IRC_MAP_ENTRY(TestMonitor, "001", OnIrc_WELCOME)
+		IRC_MAP_ENTRY(TestMonitor, "PRIVMSG", OnIrc_PRIVMSG)
+	}
+
+	DEFINE_IRC_MAP()
+
+protected :
+	bool OnIrc_WELCOME(const CIrcMessage* pmsg)
+	{
+		welcomed = true;
+		return true;
+	}
+
+	bool OnIrc_PRIVMSG(const CIrcMessage* pmsg)
+	{
+		int n = -1;
+		if( pmsg->parameters.size() > 1 )
+			sscanf(pmsg->parameters[1].c_str(), "line %d", &n);
+		if( n != received )
+			++outOfOrder;
+		++received;
+		return true;
+	}
 
-int main()
+	void OnIrcDisconnected()
+	{
+		disconnected = true;
+	}
+};
+
+DECLARE_IRC_MAP(TestMonitor, CIrcDefaultMonitor)
+
+////////////////////////////////////////////////////////////////////
+
+int main(int argc, char** argv)
 {
-  printf("hello, world.\n");
-  return 0;
+	if( argc > 1 ) numLines = atoi(argv[1]);
+	if( argc > 2 ) linesPerSecond = atoi(argv[2]);
+	if( argc > 3 ) port = atoi(argv[3]);
+
+	WinsockInit winsock;
+
+	Socket listener;
+	int reuse = 1;
+	if( !listener.Create() ||
+		!listener.SetOpt(SO_REUSEADDR, (const char*)&reuse, sizeof(reuse)) ||
+		!listener.Bind(InetAddr("127.0.0.1", port)) ||
+		!listener.Listen() )
+	{
+		printf("Failed to listen on port %d\n", port);
+		return 1;
+	}
+
+#ifndef WIN32
+	HANDLE hServer = CreateThread(NULL, 0, (void *) ServerProc, &listener, 0, NULL);
+#else
+	HANDLE hServer = CreateThread(NULL, 0, ServerProc, &listener, 0, NULL);
+#endif
+
+	CIrcSession session;
+	TestMonitor monitor(session);
+	session.AddMonitor(&monitor);
+
+	CIrcSessionInfo info;
+	info.sServer = "127.0.0.1";
+	info.iPort = port;
+	info.sNick = "tester";
+	info.sUserID = "tester";
+	info.sFullName = "Loopback tester";
+
+	double start = TimeNow();
+	if( !session.Connect(info) )
+	{
+		printf("Failed to start the session\n");
+		return 1;
+	}
+	printf("Connect returned after %.1fms\n", ( TimeNow() - start ) * 1000.0);
+
+	// the game loop, as far as IRC is concerned
+	int frames = 0;
+	int maxQueued = 0;
+	double maxDrain = 0.0;
+	while( !monitor.disconnected && TimeNow() - start < 120.0 )
+	{
+		int queued = CCrossThreadsMessagingDevice::NumQueued();
+		if( queued > maxQueued )
+			maxQueued = queued;
+
+		double drainStart = TimeNow();
+		CCrossThreadsMessagingDevice::ProcessMessages(TEST_MESSAGESPERFRAME);
+		double drain = TimeNow() - drainStart;
+		if( drain > maxDrain )
+			maxDrain = drain;
+
+		++frames;
+		Sleep(TEST_FRAMETIME);
+	}
+
+	double elapsed = TimeNow() - start;
+	printf("%d of %d lines in %.2fs (%.0f lines/s) over %d frames\n",
+			monitor.received, numLines, elapsed, monitor.received / elapsed, frames);
+	printf("Most queued %d, longest drain %.2fms, %d out of order\n",
+			maxQueued, maxDrain * 1000.0, monitor.outOfOrder);
+
+	session.Disconnect();
+	session.RemoveMonitor(&monitor);
+	WaitForSingleObject(hServer, 5000);
+	listener.Close();
+
+	// the closing notice must arrive even when the flood filled the queue
+	bool passed = monitor.welcomed && monitor.disconnected && monitor.received == numLines && monitor.outOfOrder == 0;
+	printf(passed ? "PASSED\n" : "FAILED\n");
+	return passed ? 0 : 1;
 }
@@ -1,5 +1,18 @@
 
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <zlib.h>
 
 #include "tosser.h"
 
@@ -9,31 +22,75 @@
 
 //#include "debug.h"
 
-struct LocalFileHeader
+//
+// Archives are mapped into memory whole (or read into the heap if mapping
+// fails) and indexed from the ZIP central directory.  Nothing else is read
+// until an entry is used - at which point its local header is found and,
+// for encrypted archives, its payload is decrypted in place.
+// Encrypted archives are mapped copy-on-write, so only the pages of entries
+// actually used ever become private memory.
+//
+// Deflated entries are inflated on first use into a cache of bounded size,
+// least recently used entries being thrown away first.
+//
+
+#define BGL_HASHSIZE 4096
+#define BGL_CACHESIZE ( 32 * 1024 * 1024 )
+
+#define BGL_STORED		0
+#define BGL_DEFLATED	8
+
+struct BglArchive
+{
+
+	char	*id;
+	char	*base;						// Mapped / allocated file
+	size_t	basesize;
+	bool	mapped;
+
+	char	*data;						// Start of the zip data within base
+	size_t	size;
+	BglFilterFunc *decrypt;
+
+	struct BglEntry *entries;			// Indexed entries, until the archive is added
+
+};
+
+struct BglEntry
 {
 
-	char	signature [4];
-	short	version;
-	short	bitflag;
-	short	compressionmethod;
-	short	lastmodfiletime;
-	short	lastmodfiledate;
-	int		crc32;
+	char	*filename;					// Full slashified path - the lookup key
+	BglArchive *archive;
+
+	unsigned int headeroffset;			// Local file header, relative to archive->data
+	int		compressionmethod;
 	int		compressedsize;
 	int		uncompressedsize;
-	short	filenamelength;
-	short	extrafieldlength;
-	
-	char	*filename;
-	char	*extrafield;
-	char	*data;
 
-	char	*id;
+	char	*data;						// Payload within the archive, set on first use
+
+	char	*inflated;					// Deflated entries only, while cached
+	BglEntry *cacheprev;
+	BglEntry *cachenext;
+
+	BglEntry *next;						// Hash chain, in load order
 
 };
 
+//
+// Mapping and indexing an archive touches nothing shared, so can be done on
+// any thread.  Adding it to the file table happens in the caller's order.
+//
+
 
-static BTree <LocalFileHeader *> files;
+static BglEntry *files [BGL_HASHSIZE];
+static int numfiles = 0;
+static LList <BglArchive *> archives;
+
+static BglEntry *cachehead = NULL;				// Most recently used
+static BglEntry *cachetail = NULL;
+static size_t cachesize = 0;
+static size_t cachelimit = BGL_CACHESIZE;
 
 
 void BglSlashify ( char *string )
@@ -58,188 +115,618 @@ void BglSlashify ( char *string )
 
 }
 
-bool BglOpenZipFile ( char *zipfile, char *apppath, char *id )
+static unsigned int BglHash ( const char *filename )
 {
 
-	FILE *file = fopen ( zipfile, "rb" );
-	if ( !file ) return false;
+	unsigned int hash = 5381;
+	while ( *filename ) hash = hash * 33 + (unsigned char) *filename++;
+	return hash & ( BGL_HASHSIZE - 1 );
 
-	bool result = BglOpenZipFile ( file, apppath, id );
+}
 
-	fclose ( file );
+static unsigned int BglLittleEndian ( const unsigned char *bytes, int length )
+{
 
+	unsigned int result = 0;
+	for ( int i = length - 1; i >= 0; --i )
+		result = ( result << 8 ) | bytes [i];
 	return result;
 
 }
 
-bool BglOpenZipFile ( FILE *file, char *apppath, char *id )
+static bool BglRead ( BglArchive *archive, size_t offset, void *target, size_t length )
 {
-	
-	if ( !file ) return false;
 
-	while ( !feof ( file ) ) {
+	// Copies (and decrypts) part of the archive without touching the original
+
+	if ( offset > archive->size || length > archive->size - offset ) return false;
+
+	memcpy ( target, archive->data + offset, length );
+	if ( archive->decrypt ) archive->decrypt ( (unsigned char *) target, (unsigned int) length );
+
+	return true;
+
+}
+
+static BglEntry *BglLookup ( char *filename )
+{
+
+	char *filenamecopy = new char [strlen(filename)+1];
+	strcpy ( filenamecopy, filename );
+	BglSlashify ( filenamecopy );
+
+	// The first archive loaded with a given file wins
 
-		LocalFileHeader *fh = new LocalFileHeader ();
+	BglEntry *entry = files [BglHash ( filenamecopy )];
+	while ( entry && strcmp ( entry->filename, filenamecopy ) != 0 )
+		entry = entry->next;
 
-		fread ( fh->signature, 4, 1, file );
+	delete [] filenamecopy;
+
+	return entry;
+
+}
+
+static void BglAddEntry ( BglArchive *archive, char *apppath, char *filename, unsigned int headeroffset,
+						  int compressionmethod, int compressedsize, int uncompressedsize )
+{
+
+	if ( compressionmethod == BGL_STORED && compressedsize != uncompressedsize ) return;
+	if ( compressionmethod != BGL_STORED && compressionmethod != BGL_DEFLATED ) return;
+	if ( compressedsize < 0 || uncompressedsize < 0 ) return;
+	if ( strlen ( apppath ) + strlen ( filename ) >= 256 ) return;
+
+	char fullfilename [256];
+	sprintf ( fullfilename, "%s%s", apppath, filename );
+	BglSlashify ( fullfilename );
+
+	BglEntry *entry = new BglEntry ();
+	entry->filename = new char [strlen(fullfilename) + 1];
+	strcpy ( entry->filename, fullfilename );
+	entry->archive = archive;
+	entry->headeroffset = headeroffset;
+	entry->compressionmethod = compressionmethod;
+	entry->compressedsize = compressedsize;
+	entry->uncompressedsize = uncompressedsize;
+	entry->data = NULL;
+	entry->inflated = NULL;
+	entry->cacheprev = NULL;
+	entry->cachenext = NULL;
+
+	// Kept in reverse order here - BglAddZipFile puts them back
+
+	entry->next = archive->entries;
+	archive->entries = entry;
+
+}
 
-		if ( fh->signature [0] != 'P' || fh->signature [1] != 'K' )	{				// No longer reading valid data
-			delete fh;
+static bool BglIndexCentralDirectory ( BglArchive *archive, char *apppath )
+{
+
+	//
+	// Find the end of central directory record - 22 bytes plus
+	// a comment of up to 64k at the very end of the archive
+	//
+
+	if ( archive->size < 22 ) return false;
+
+	size_t tailsize = archive->size < 22 + 65535 ? archive->size : 22 + 65535;
+	size_t tailstart = archive->size - tailsize;
+	unsigned char *tail = new unsigned char [tailsize];
+	BglRead ( archive, tailstart, tail, tailsize );
+
+	unsigned char *eocd = NULL;
+	for ( size_t i = tailsize - 22 + 1; i-- > 0; ) {
+		if ( tail [i] == 'P' && tail [i+1] == 'K' && tail [i+2] == 5 && tail [i+3] == 6 ) {
+			eocd = tail + i;
 			break;
 		}
+	}
 
-		fread ( &fh->version, 2, 1, file );
-		fread ( &fh->bitflag, 2, 1, file );
-		fread ( &fh->compressionmethod, 2, 1, file );
-		fread ( &fh->lastmodfiletime, 2, 1, file );
-		fread ( &fh->lastmodfiledate, 2, 1, file );
-		fread ( &fh->crc32, 4, 1, file );
-		fread ( &fh->compressedsize, 4, 1, file );
-		fread ( &fh->uncompressedsize, 4, 1, file );
-		fread ( &fh->filenamelength, 2, 1, file );
-		fread ( &fh->extrafieldlength, 2, 1, file );
-
-		if ( fh->filenamelength > 0 ) {
-			fh->filename = new char [fh->filenamelength+1];
-			fread ( fh->filename, fh->filenamelength, 1, file );
-			*(fh->filename + fh->filenamelength) = 0;
-		}
-		else 
-			fh->filename = NULL;
+	if ( !eocd ) {
+		delete [] tail;
+		return false;
+	}
 
-		if ( fh->extrafieldlength > 0 ) {
-			fh->extrafield = new char [fh->extrafieldlength+1];
-			fread ( fh->extrafield, fh->extrafieldlength, 1, file );
-			*(fh->extrafield + fh->extrafieldlength) = 0;
-		}
-		else
-			fh->extrafield = NULL;
+	int numentries = (int) BglLittleEndian ( eocd + 10, 2 );
+	size_t cdsize = BglLittleEndian ( eocd + 12, 4 );
+	size_t cdoffset = BglLittleEndian ( eocd + 16, 4 );
+	delete [] tail;
 
-		if ( fh->uncompressedsize > 0 ) {
-			fh->data = new char [fh->uncompressedsize+1];
-			fread ( fh->data, fh->uncompressedsize, 1, file );
-			*(fh->data + fh->uncompressedsize) = 0;
-		}
-		else
-			fh->data = NULL;
+	unsigned char *cd = new unsigned char [cdsize + 1];
+	if ( !BglRead ( archive, cdoffset, cd, cdsize ) ) {
+		delete [] cd;
+		return false;
+	}
+
+	//
+	// Index every entry
+	//
 
-		if ( id ) {
-			fh->id = new char [strlen(id) + 1];
-			strcpy ( fh->id, id );
+	size_t position = 0;
+
+	for ( int i = 0; i < numentries; ++i ) {
+
+		if ( position + 46 > cdsize ) break;
+
+		unsigned char *header = cd + position;
+		if ( header [0] != 'P' || header [1] != 'K' || header [2] != 1 || header [3] != 2 ) break;
+
+		int compressionmethod = (int) BglLittleEndian ( header + 10, 2 );
+		int compressedsize = (int) BglLittleEndian ( header + 20, 4 );
+		int uncompressedsize = (int) BglLittleEndian ( header + 24, 4 );
+		size_t filenamelength = BglLittleEndian ( header + 28, 2 );
+		size_t extrafieldlength = BglLittleEndian ( header + 30, 2 );
+		size_t commentlength = BglLittleEndian ( header + 32, 2 );
+		unsigned int headeroffset = BglLittleEndian ( header + 42, 4 );
+
+		if ( position + 46 + filenamelength > cdsize ) break;
+
+		if ( filenamelength > 0 ) {
+			char *filename = new char [filenamelength + 1];
+			memcpy ( filename, header + 46, filenamelength );
+			filename [filenamelength] = 0;
+			BglAddEntry ( archive, apppath, filename, headeroffset, 
+						  compressionmethod, compressedsize, uncompressedsize );
+			delete [] filename;
 		}
-		else 
-			fh->id = NULL;
 
-		if ( fh->compressionmethod == 0 &&
-			 fh->compressedsize == fh->uncompressedsize &&
-			 fh->filename ) {
+		position += 46 + filenamelength + extrafieldlength + commentlength;
 
-			char fullfilename [256];
-			sprintf ( fullfilename, "%s%s", apppath, fh->filename );
+	}
 
-			BglSlashify ( fullfilename );
+	delete [] cd;
 
-			files.PutData ( fullfilename, fh );
+	return true;
 
+}
+
+static void BglIndexLocalHeaders ( BglArchive *archive, char *apppath )
+{
+
+	//
+	// No central directory - walk the local headers instead,
+	// skipping over the payloads
+	//
+
+	size_t position = 0;
+	unsigned char header [30];
+
+	while ( BglRead ( archive, position, header, 30 ) ) {
+
+		if ( header [0] != 'P' || header [1] != 'K' || header [2] != 3 || header [3] != 4 ) break;
+
+		int compressionmethod = (int) BglLittleEndian ( header + 8, 2 );
+		int compressedsize = (int) BglLittleEndian ( header + 18, 4 );
+		int uncompressedsize = (int) BglLittleEndian ( header + 22, 4 );
+		size_t filenamelength = BglLittleEndian ( header + 26, 2 );
+		size_t extrafieldlength = BglLittleEndian ( header + 28, 2 );
+
+		if ( filenamelength > 0 ) {
+			char *filename = new char [filenamelength + 1];
+			if ( !BglRead ( archive, position + 30, filename, filenamelength ) ) {
+				delete [] filename;
+				break;
+			}
+			filename [filenamelength] = 0;
+			BglAddEntry ( archive, apppath, filename, (unsigned int) position,
+						  compressionmethod, compressedsize, uncompressedsize );
+			delete [] filename;
 		}
-		else {
-			if ( fh->filename )
-				delete [] fh->filename;
-			if ( fh->extrafield )
-				delete [] fh->extrafield;
-			if ( fh->data )
-				delete [] fh->data;
-			if ( fh->id )
-				delete [] fh->id;
-
-			delete fh;
+
+		position += 30 + filenamelength + extrafieldlength + compressedsize;
+
+	}
+
+}
+
+static char *BglEntryData ( BglEntry *entry )
+{
+
+	if ( entry->data ) return entry->data;
+
+	//
+	// First use - the payload follows the local header, whose
+	// extra field can differ in size from the central directory's
+	//
+
+	BglArchive *archive = entry->archive;
+	unsigned char header [30];
+
+	if ( !BglRead ( archive, entry->headeroffset, header, 30 ) ) return NULL;
+	if ( header [0] != 'P' || header [1] != 'K' || header [2] != 3 || header [3] != 4 ) return NULL;
+
+	size_t dataoffset = entry->headeroffset + 30 + BglLittleEndian ( header + 26, 2 ) + BglLittleEndian ( header + 28, 2 );
+	if ( dataoffset > archive->size || (size_t) entry->compressedsize > archive->size - dataoffset ) return NULL;
+
+	entry->data = archive->data + dataoffset;
+	if ( archive->decrypt ) archive->decrypt ( (unsigned char *) entry->data, entry->compressedsize );
+
+	return entry->data;
+
+}
+
+static void BglCacheUnlink ( BglEntry *entry )
+{
+
+	if ( entry->cacheprev ) entry->cacheprev->cachenext = entry->cachenext;
+	else					cachehead = entry->cachenext;
+
+	if ( entry->cachenext ) entry->cachenext->cacheprev = entry->cacheprev;
+	else					cachetail = entry->cacheprev;
+
+	entry->cacheprev = NULL;
+	entry->cachenext = NULL;
+
+}
+
+static void BglCacheLink ( BglEntry *entry )
+{
+
+	// At the front - the most recently used
+
+	entry->cacheprev = NULL;
+	entry->cachenext = cachehead;
+
+	if ( cachehead )	cachehead->cacheprev = entry;
+	else				cachetail = entry;
+
+	cachehead = entry;
+
+}
+
+static void BglUncache ( BglEntry *entry )
+{
+
+	if ( !entry->inflated ) return;
+
+	BglCacheUnlink ( entry );
+
+	cachesize -= entry->uncompressedsize;
+	delete [] entry->inflated;
+	entry->inflated = NULL;
+
+}
+
+static void BglCache ( BglEntry *entry, char *inflated )
+{
+
+	entry->inflated = inflated;
+	BglCacheLink ( entry );
+	cachesize += entry->uncompressedsize;
+
+	// Make room - but never throw away the entry just asked for
+
+	while ( cachesize > cachelimit && cachetail != entry )
+		BglUncache ( cachetail );
+
+}
+
+static bool BglInflate ( char *source, int sourcesize, char *target, int targetsize )
+{
+
+	// Zip entries are raw deflate streams, with no zlib header
+
+	z_stream stream;
+	memset ( &stream, 0, sizeof ( stream ) );
+
+	if ( inflateInit2 ( &stream, -MAX_WBITS ) != Z_OK ) return false;
+
+	stream.next_in = (Bytef *) source;
+	stream.avail_in = (uInt) sourcesize;
+	stream.next_out = (Bytef *) target;
+	stream.avail_out = (uInt) targetsize;
+
+	int result = inflate ( &stream, Z_FINISH );
+	bool success = ( result == Z_STREAM_END && stream.total_out == (uLong) targetsize );
+
+	inflateEnd ( &stream );
+
+	return success;
+
+}
+
+static char *BglEntryContents ( BglEntry *entry )
+{
+
+	char *data = BglEntryData ( entry );
+	if ( !data || entry->compressionmethod == BGL_STORED ) return data;
+
+	if ( entry->inflated ) {
+
+		if ( entry != cachehead ) {
+			BglCacheUnlink ( entry );
+			BglCacheLink ( entry );
 		}
 
+		return entry->inflated;
+
+	}
+
+	char *inflated = new char [entry->uncompressedsize + 1];
+
+	if ( !BglInflate ( data, entry->compressedsize, inflated, entry->uncompressedsize ) ) {
+		delete [] inflated;
+		return NULL;
+	}
+
+	inflated [entry->uncompressedsize] = 0;
+	BglCache ( entry, inflated );
+
+	return inflated;
+
+}
+
+static void BglDeleteEntry ( BglEntry *entry )
+{
+
+	BglUncache ( entry );
+	delete [] entry->filename;
+	delete entry;
+
+}
+
+static void BglIndexArchive ( BglArchive *archive, char *apppath, char *id )
+{
+
+	if ( id ) {
+		archive->id = new char [strlen(id) + 1];
+		strcpy ( archive->id, id );
+	}
+	else 
+		archive->id = NULL;
+
+	archive->entries = NULL;
+
+	if ( !BglIndexCentralDirectory ( archive, apppath ) )
+		BglIndexLocalHeaders ( archive, apppath );
+
+}
+
+bool BglAddZipFile ( BglArchive *archive )
+{
+
+	if ( !archive ) return false;
+
+	//
+	// Restore the archive's own order, then append each entry 
+	// to its hash chain so earlier archives keep priority
+	//
+
+	BglEntry *ordered = NULL;
+
+	while ( archive->entries ) {
+		BglEntry *entry = archive->entries;
+		archive->entries = entry->next;
+		entry->next = ordered;
+		ordered = entry;
 	}
 
+	while ( ordered ) {
+
+		BglEntry *entry = ordered;
+		ordered = entry->next;
+		entry->next = NULL;
+
+		BglEntry **slot = &files [BglHash ( entry->filename )];
+		while ( *slot ) slot = &(*slot)->next;
+		*slot = entry;
+
+		++numfiles;
+
+	}
+
+	archives.PutData ( archive );
+
 	return true;
 
 }
 
-bool BglFileLoaded ( char *filename )
+static void BglFreeArchive ( BglArchive *archive )
 {
 
-	char *filenamecopy = new char [strlen(filename)+1];
-	strcpy ( filenamecopy, filename );
-	BglSlashify ( filenamecopy );
+	while ( archive->entries ) {
+		BglEntry *entry = archive->entries;
+		archive->entries = entry->next;
+		BglDeleteEntry ( entry );
+	}
 
-	LocalFileHeader *lfh = files.GetData ( filenamecopy );
+	if ( archive->mapped ) {
+#ifdef WIN32
+		UnmapViewOfFile ( archive->base );
+#else
+		munmap ( archive->base, archive->basesize );
+#endif
+	}
+	else
+		delete [] archive->base;
 
-	delete [] filenamecopy;
+	if ( archive->id ) delete [] archive->id;
 
-	return ( lfh != NULL );
+	delete archive;
 
 }
 
-void BglCloseZipFile_Recursive ( BTree <LocalFileHeader *> *files, 
-								 LList <char *> *removableids, 
-								 char *id )
+BglArchive *BglMapZipFile ( char *zipfile, char *apppath, char *id, unsigned int offset, BglFilterFunc *decrypt )
 {
 
-	assert (removableids);
-	assert (id);
+	char *base = NULL;
+	size_t basesize = 0;
+	bool mapped = false;
 
-	if ( !files ) return;										// Base case - end of the binary tree
-	
-	LocalFileHeader *lfh = files->data;
+	// Encrypted archives are mapped copy-on-write so they can be decrypted in place
+
+#ifdef WIN32
+
+	HANDLE file = CreateFileA ( zipfile, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	if ( file == INVALID_HANDLE_VALUE ) return NULL;
+
+	basesize = GetFileSize ( file, NULL );
+	HANDLE mapping = basesize > 0 ? CreateFileMappingA ( file, NULL, decrypt ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL ) : NULL;
+	if ( mapping ) {
+		base = (char *) MapViewOfFile ( mapping, decrypt ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0 );
+		mapped = ( base != NULL );
+		CloseHandle ( mapping );
+	}
+	CloseHandle ( file );
+
+#else
+
+	int file = open ( zipfile, O_RDONLY );
+	if ( file == -1 ) return NULL;
+
+	struct stat filestat;
+	if ( fstat ( file, &filestat ) == 0 && filestat.st_size > 0 ) {
+		basesize = (size_t) filestat.st_size;
+		void *view = mmap ( NULL, basesize, decrypt ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, file, 0 );
+		if ( view != MAP_FAILED ) {
+			base = (char *) view;
+			mapped = true;
+		}
+	}
+	close ( file );
+
+#endif
 
-	if ( lfh && lfh->id && strcmp ( lfh->id, id ) == 0 ) {
+	if ( !mapped ) {
 
-		// This one is a match and should be flagged for removal
-		removableids->PutData ( files->id );		
+		// Fall back to reading the whole file
+
+		FILE *input = fopen ( zipfile, "rb" );
+		if ( !input ) return NULL;
+
+		fseek ( input, 0, SEEK_END );
+		basesize = (size_t) ftell ( input );
+		fseek ( input, 0, SEEK_SET );
+
+		base = new char [basesize + 1];
+		basesize = fread ( base, 1, basesize, input );
+		fclose ( input );
 
 	}
 
-	// Recurse
+	if ( basesize < offset ) {
+		if ( mapped ) {
+#ifdef WIN32
+			UnmapViewOfFile ( base );
+#else
+			munmap ( base, basesize );
+#endif
+		}
+		else
+			delete [] base;
+		return NULL;
+	}
+
+	BglArchive *archive = new BglArchive ();
+	archive->base = base;
+	archive->basesize = basesize;
+	archive->mapped = mapped;
+	archive->data = base + offset;
+	archive->size = basesize - offset;
+	archive->decrypt = decrypt;
+
+	BglIndexArchive ( archive, apppath, id );
+
+	return archive;
 
-	BglCloseZipFile_Recursive ( files->Left (), removableids, id );
-	BglCloseZipFile_Recursive ( files->Right (), removableids, id );
+}
+
+bool BglOpenZipFile ( char *zipfile, char *apppath, char *id, unsigned int offset, BglFilterFunc *decrypt )
+{
+
+	return BglAddZipFile ( BglMapZipFile ( zipfile, apppath, id, offset, decrypt ) );
+
+}
+
+bool BglOpenZipFile ( FILE *file, char *apppath, char *id )
+{
+	
+	if ( !file ) return false;
+
+	// Read everything from the current position on
+
+	long start = ftell ( file );
+	fseek ( file, 0, SEEK_END );
+	size_t size = (size_t) ( ftell ( file ) - start );
+	fseek ( file, start, SEEK_SET );
+
+	BglArchive *archive = new BglArchive ();
+	archive->base = new char [size + 1];
+	archive->basesize = fread ( archive->base, 1, size, file );
+	archive->mapped = false;
+	archive->data = archive->base;
+	archive->size = archive->basesize;
+	archive->decrypt = NULL;
+
+	BglIndexArchive ( archive, apppath, id );
+
+	return BglAddZipFile ( archive );
+
+}
+
+bool BglFileLoaded ( char *filename )
+{
+
+	return ( BglLookup ( filename ) != NULL );
+
+}
+
+char *BglGetFileData ( char *filename, int *size )
+{
+
+	BglEntry *entry = BglLookup ( filename );
+	if ( !entry ) return NULL;
+
+	char *data = BglEntryContents ( entry );
+	if ( data && size ) *size = entry->uncompressedsize;
+
+	return data;
 
 }
 
 void BglCloseZipFile ( char *id )
 {
 
+	assert (id);
+
 	//
-	// Create a DArray of filenames to be removed 
-	// from our Binary Tree
+	// Unlink every entry belonging to this archive
 	//
 
-	LList <char *> removableids;
+	for ( int i = 0; i < BGL_HASHSIZE; ++i ) {
 
-	//
-	// Fill the DArray with a recursive search algorithm
-	//
+		BglEntry **slot = &files [i];
+
+		while ( *slot ) {
+
+			BglEntry *entry = *slot;
+
+			if ( entry->archive->id && strcmp ( entry->archive->id, id ) == 0 ) {
+				*slot = entry->next;
+				BglDeleteEntry ( entry );
+				--numfiles;
+			}
+			else
+				slot = &entry->next;
 
-	BglCloseZipFile_Recursive ( &files, &removableids, id );
+		}
+
+	}
 
 	//
-	// Run through that DArray, looking up the file, 
-	// deleting the data and removing it from the full btree
+	// Then release the archive itself
 	//
 
-	for ( int i = 0; i < removableids.Size (); ++i ) {
-		
-		char *filename = removableids.GetData (i);
-		assert (filename);
-		
-		LocalFileHeader *lfi = files.GetData (filename);
-		assert (lfi);
+	for ( int j = archives.Size () - 1; j >= 0; --j ) {
 
-		files.RemoveData ( filename );
+		BglArchive *archive = archives.GetData (j);
 
-		if ( lfi->filename )	delete [] lfi->filename;
-		if ( lfi->extrafield )	delete [] lfi->extrafield;
-		if ( lfi->data )		delete [] lfi->data;
-		if ( lfi->id )			delete [] lfi->id;
+		if ( archive->id && strcmp ( archive->id, id ) == 0 ) {
+			archives.RemoveData (j);
+			BglFreeArchive ( archive );
+		}
 
-		delete lfi;
-			
 	}
 
 }
@@ -247,15 +734,10 @@ void BglCloseZipFile ( char *id )
 bool BglExtractFile ( char *filename, char *target )
 {
 
-	char *filenamecopy = new char [strlen(filename)+1];
-	strcpy ( filenamecopy, filename );
-	BglSlashify ( filenamecopy );
+	int size = 0;
+	char *data = BglGetFileData ( filename, &size );
 
-	LocalFileHeader *lfh = files.GetData ( filenamecopy );
-
-	delete [] filenamecopy;
-
-	if ( lfh ) {
+	if ( data ) {
 
 		FILE *output;
 		
@@ -264,7 +746,7 @@ bool BglExtractFile ( char *filename, char *target )
 
 		if ( !output ) return false;
 
-		fwrite ( lfh->data, lfh->uncompressedsize, 1, output );
+		fwrite ( data, size, 1, output );
 
 		fclose ( output );
 
@@ -286,123 +768,113 @@ bool BglExtractFile ( char *filename, char *target )
 void BglExtractAllFiles ( char *zipfile )
 {
 
-	FILE *file = fopen ( zipfile, "rb" );
-	assert (file);
+	char apppath [] = "";
 
-	while ( !feof ( file ) ) {
+	BglArchive *archive = BglMapZipFile ( zipfile, apppath );
+	assert (archive);
 
-		LocalFileHeader fh;
+	for ( BglEntry *entry = archive->entries; entry; entry = entry->next ) {
 
-		fread ( &fh.signature, 4, 1, file );
-		fread ( &fh.version, 2, 1, file );
-		fread ( &fh.bitflag, 2, 1, file );
-		fread ( &fh.compressionmethod, 2, 1, file );
-		fread ( &fh.lastmodfiletime, 2, 1, file );
-		fread ( &fh.lastmodfiledate, 2, 1, file );
-		fread ( &fh.crc32, 4, 1, file );
-		fread ( &fh.compressedsize, 4, 1, file );
-		fread ( &fh.uncompressedsize, 4, 1, file );
-		fread ( &fh.filenamelength, 2, 1, file );
-		fread ( &fh.extrafieldlength, 2, 1, file );
+		char *data = BglEntryContents ( entry );
+		if ( !data ) continue;
 
-		if ( fh.filenamelength > 0 ) {
-			fh.filename = new char [fh.filenamelength];
-			fread ( fh.filename, fh.filenamelength, 1, file );
-			*(fh.filename + fh.filenamelength) = 0;
-		}
-		else 
-			fh.filename = NULL;
+		FILE *output = fopen ( entry->filename, "wb" );
+		assert (output);
 
-		if ( fh.extrafieldlength > 0 ) {
-			fh.extrafield = new char [fh.extrafieldlength+1];
-			fread ( fh.extrafield, fh.extrafieldlength, 1, file );
-			*(fh.extrafield + fh.extrafieldlength) = 0;
-		}
-		else
-			fh.extrafield = NULL;
+		fwrite ( data, entry->uncompressedsize, 1, output );
 
-		if ( fh.uncompressedsize > 0 ) {
-			fh.data = new char [fh.uncompressedsize];
-			fread ( fh.data, fh.uncompressedsize, 1, file );
-			*(fh.data + fh.uncompressedsize) = 0;
-		}
-		else
-			fh.data = NULL;
+		fclose ( output );
 
+		// One at a time - there is no need to keep them
 
-		if ( fh.compressionmethod == 0 &&
-			 fh.compressedsize == fh.uncompressedsize &&
-			 fh.filename ) {
+		BglUncache ( entry );
 
-			FILE *output = fopen ( fh.filename, "wb" );
-			assert (output);
+	}
 
-			fwrite ( fh.data, fh.uncompressedsize, 1, output );
+	BglFreeArchive ( archive );
 
-			fclose ( output );
+}
 
-		}
 
-	}
+static int BglCompareFilenames ( const void *a, const void *b )
+{
 
-	fclose ( file );
+	return strcmp ( *(char **) a, *(char **) b );
 
 }
 
-
 DArray <char *> *BglListFiles ( char *path, char *directory, char *filter )
 {
 
     char dirCopy [256];
-    sprintf ( dirCopy, "%s%s", path, directory );
+    sprintf ( dirCopy, "%s%s", path, directory ? directory : "" );
     BglSlashify ( dirCopy );
 
-    DArray <char *> *result = files.ConvertIndexToDArray();
+	size_t dirLength = strlen ( dirCopy );
+
+	//
+	// Collect the matches, then sort them by name
+	//
 
-    for ( int i = 0; i < result->Size(); ++i ) {
-        if ( result->ValidIndex(i) ) {
-        
-            char *fullPath = result->GetData(i);
-            char thisDir[256];
-            strncpy( thisDir, fullPath, strlen(dirCopy) );
-            thisDir[strlen(dirCopy)] = '\x0';
+	char **matches = new char * [numfiles + 1];
+	int nummatches = 0;
 
-            bool removeMe = false;
+	for ( int i = 0; i < BGL_HASHSIZE; ++i ) {
+		for ( BglEntry *entry = files [i]; entry; entry = entry->next ) {
 
-            if ( strcmp ( thisDir, dirCopy ) != 0 )         removeMe = true;                
-            if ( strstr ( fullPath, filter ) == NULL )      removeMe = true;
+			char *fullPath = entry->filename;
 
-            if ( removeMe )
-                result->RemoveData( i );
+			if ( strncmp ( fullPath, dirCopy, dirLength ) != 0 )		continue;
+			if ( filter && strstr ( fullPath, filter ) == NULL )		continue;
 
-        }
-    }
+			matches [nummatches++] = fullPath;
+
+		}
+	}
+
+	qsort ( matches, nummatches, sizeof ( char * ), BglCompareFilenames );
+
+    DArray <char *> *result = new DArray <char *> ();
+	result->SetSize ( nummatches );
+
+	for ( int j = 0; j < nummatches; ++j )
+		result->PutData ( matches [j], j );
+
+	delete [] matches;
 
     return result;
 
 }
 
 
-void BglCloseAllFiles( BTree<LocalFileHeader *> *files )
+void BglSetCacheSize ( unsigned int bytes )
 {
-	if ( !files ) return;
 
-	BglCloseAllFiles( files->Left() );
-	BglCloseAllFiles( files->Right() );
+	cachelimit = bytes;
 
-	LocalFileHeader *lfi = files->data;
-	if ( lfi ) {
-		if ( lfi->filename )	delete [] lfi->filename;
-		if ( lfi->extrafield )	delete [] lfi->extrafield;
-		if ( lfi->data )		delete [] lfi->data;
-		if ( lfi->id )			delete [] lfi->id;
-		delete lfi;
-	}
+	while ( cachesize > cachelimit && cachetail )
+		BglUncache ( cachetail );
 
-	files->Empty();
 }
 
 void BglCloseAllFiles()
 {
-	BglCloseAllFiles( &files );
+
+	for ( int i = 0; i < BGL_HASHSIZE; ++i ) {
+
+		while ( files [i] ) {
+			BglEntry *entry = files [i];
+			files [i] = entry->next;
+			BglDeleteEntry ( entry );
+		}
+
+	}
+
+	numfiles = 0;
+
+	for ( int j = 0; j < archives.Size (); ++j )
+		BglFreeArchive ( archives.GetData (j) );
+
+	archives.Empty ();
+
 }
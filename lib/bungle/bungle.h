@@ -21,11 +21,26 @@
 //#endif
 
 
-bool BglOpenZipFile ( char *zipfile, char *apppath, char *id = NULL );
+typedef void BglFilterFunc ( unsigned char *data, unsigned int length );
+struct BglArchive;
+
+// Maps the archive, which starts offset bytes into the file.
+// If decrypt is given, each entry is run through it the first time it is used
+bool BglOpenZipFile ( char *zipfile, char *apppath, char *id = NULL, 
+					  unsigned int offset = 0, BglFilterFunc *decrypt = NULL );
 bool BglOpenZipFile ( FILE *zipfile, char *apppath, char *id = NULL );
 
+// BglOpenZipFile in two steps - mapping is safe on any thread, and 
+// archives added first take priority over later ones with the same files
+BglArchive *BglMapZipFile ( char *zipfile, char *apppath, char *id = NULL, 
+							unsigned int offset = 0, BglFilterFunc *decrypt = NULL );
+bool BglAddZipFile ( BglArchive *archive );
+
 bool BglFileLoaded  ( char *filename );
 bool BglExtractFile ( char *filename, char *target = NULL );
+char *BglGetFileData ( char *filename, int *size );							// Do not free - deflated files are only
+																			// valid until the next BglGetFileData
+void BglSetCacheSize ( unsigned int bytes );								// Limit on inflated files kept in memory
 
 void BglCloseZipFile ( char *id );
 
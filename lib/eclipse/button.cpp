@@ -19,6 +19,9 @@ Button::Button ()
 
 	x = y = width = height = 0;
 	caption = name = tooltip = NULL;
+	dirty = false;
+	zorder = 0;
+	gridx1 = gridy1 = gridx2 = gridy2 = -1;
 	draw = NULL;
 	image_standard = image_highlighted = image_clicked = NULL;
 	mouseup = mousedown = mousemove = NULL;
@@ -32,6 +35,9 @@ Button::Button ( int newx, int newy, int newwidth, int newheight,
 {
 
 	caption = name = tooltip = NULL;
+	dirty = false;
+	zorder = 0;
+	gridx1 = gridy1 = gridx2 = gridy2 = -1;
 	SetProperties ( newx, newy, newwidth, newheight + FUDGE, newcaption, newname );
 	draw = NULL;
 	image_standard = image_highlighted = image_clicked = NULL;
@@ -153,7 +159,14 @@ void Button::RegisterMouseMoveFunction  ( void (*newmousemove) ( Button * ) )
 void Button::Dirty ()
 {
 
-	dirty = true;
+	EclUpdateButtonIndex ( this );
+
+	if ( !dirty ) {
+
+		dirty = true;
+		EclDirtyRectangle ( x, y, width, height );
+
+	}
 
 }
 
@@ -27,6 +27,9 @@ public:
 
 	bool dirty;
 
+	int zorder;									// Stacking order and the hit-test grid cells
+	int gridx1, gridy1, gridx2, gridy2;			// this button is filed under (see eclipse.cpp)
+
 	Image *image_standard;					// Used when this button is 
 	Image *image_highlighted;					// represented by an image
 	Image *image_clicked;
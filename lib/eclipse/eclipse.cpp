@@ -1,5 +1,8 @@
 
 #define FUDGE 10
+#define ECL_MAXDIRTYRECTANGLES 256
+#define ECL_GRIDCELLSIZE 64							// Hit-test grid cell size in pixels
+#define ECL_NAMEBUCKETS 1024							// Must be a power of two
 
 #include <string.h>
 #include <time.h>
@@ -58,6 +61,20 @@ public:
 local vector <dirtyrect> dirtyrectangles;
 local LList <char *> editablebuttons;						// List of editable buttons
 
+// Button lookup indexes
+// The screen is divided into a grid of cells, each holding the buttons that
+// overlap it, and names are hashed into buckets.  Both are kept up to date by
+// the functions that add, remove, restack and animate buttons - anything else
+// that moves or resizes a button must dirty it, which re-files it.
+// Buttons outside the screen are filed under the nearest edge cells.
+
+local vector <Button *> *buttongrid = NULL;
+local int gridwidth = 0;
+local int gridheight = 0;
+local vector <Button *> namebuckets [ECL_NAMEBUCKETS];
+local int topzorder = 0;									// Stacking order of the front / back buttons
+local int bottomzorder = 0;
+
 // Default button callbacks
 
 local void (*default_draw)      (Button *, bool, bool) = NULL;
@@ -72,6 +89,110 @@ local void (*superhighlight_draw) (Button *, bool, bool) = NULL;
 // ============================================================================
 
 
+local unsigned int EclHashName ( const char *name )
+{
+
+	unsigned int hash = 5381;
+	while ( *name ) hash = hash * 33 + (unsigned char) *name++;
+	return hash & ( ECL_NAMEBUCKETS - 1 );
+
+}
+
+local void EclRemoveFromVector ( vector <Button *> &list, Button *button )
+{
+
+	for ( size_t i = 0; i < list.size (); ++i ) {
+		if ( list [i] == button ) {
+			list [i] = list.back ();
+			list.pop_back ();
+			return;
+		}
+	}
+
+}
+
+local void EclGridCell ( int x, int y, int *cellx, int *celly )
+{
+
+	*cellx = x < 0 ? 0 : x / ECL_GRIDCELLSIZE;
+	*celly = y < 0 ? 0 : y / ECL_GRIDCELLSIZE;
+	if ( *cellx >= gridwidth )  *cellx = gridwidth - 1;
+	if ( *celly >= gridheight ) *celly = gridheight - 1;
+
+}
+
+local void EclResetIndex ( int width, int height )
+{
+
+	delete [] buttongrid;
+
+	gridwidth  = width  > 0 ? width  / ECL_GRIDCELLSIZE + 1 : 1;
+	gridheight = height > 0 ? height / ECL_GRIDCELLSIZE + 1 : 1;
+	buttongrid = new vector <Button *> [gridwidth * gridheight];
+
+	for ( int i = 0; i < ECL_NAMEBUCKETS; ++i )
+		namebuckets [i].clear ();
+
+	topzorder = bottomzorder = 0;
+
+}
+
+local void EclUnindexButton ( Button *button )
+{
+
+	if ( button->gridx1 == -1 ) return;
+
+	for ( int cy = button->gridy1; cy <= button->gridy2; ++cy )
+		for ( int cx = button->gridx1; cx <= button->gridx2; ++cx )
+			EclRemoveFromVector ( buttongrid [cy * gridwidth + cx], button );
+
+	button->gridx1 = button->gridy1 = button->gridx2 = button->gridy2 = -1;
+
+}
+
+local void EclIndexButton ( Button *button )
+{
+
+	if ( !buttongrid ) EclResetIndex ( 0, 0 );
+
+	// Hit-testing is inclusive of the right / bottom edges
+
+	EclGridCell ( button->x, button->y, &button->gridx1, &button->gridy1 );
+	EclGridCell ( button->x + button->width, button->y + button->height, &button->gridx2, &button->gridy2 );
+
+	for ( int cy = button->gridy1; cy <= button->gridy2; ++cy )
+		for ( int cx = button->gridx1; cx <= button->gridx2; ++cx )
+			buttongrid [cy * gridwidth + cx].push_back ( button );
+
+}
+
+void EclUpdateButtonIndex ( Button *button )
+{
+
+	if ( !button || button->gridx1 == -1 ) return;
+
+	int x1, y1, x2, y2;
+	EclGridCell ( button->x, button->y, &x1, &y1 );
+	EclGridCell ( button->x + button->width, button->y + button->height, &x2, &y2 );
+
+	if ( x1 != button->gridx1 || y1 != button->gridy1 ||
+		 x2 != button->gridx2 || y2 != button->gridy2 ) {
+		EclUnindexButton ( button );
+		EclIndexButton ( button );
+	}
+
+}
+
+local void EclAddButton ( Button *button )
+{
+
+	button->zorder = ++topzorder;
+	buttons.PutDataAtStart ( button );
+	namebuckets [EclHashName ( button->name )].push_back ( button );
+	EclIndexButton ( button );
+
+}
+
 void EclReset ( int width, int height )
 {
 
@@ -123,6 +244,8 @@ void EclReset ( int width, int height )
 	buttons.Empty ();
 //    anims.Empty ();
 	editablebuttons.Empty ();
+
+	EclResetIndex ( width, height );
         
 	superhighlight_borderwidth = 0;
     
@@ -148,7 +271,7 @@ void EclRegisterButton ( int x, int y, int width, int height,
 
 	Button *button = new Button ( x, y, width, height, caption, name );
 	if ( button ) {
-		buttons.PutDataAtStart ( button );
+		EclAddButton ( button );
 
 		EclRegisterButtonCallbacks ( name, default_draw, default_mouseup, 
 									 default_mousedown, default_mousemove );
@@ -178,7 +301,7 @@ void EclRegisterImageButton ( int x, int y, int width, int height,
 
 	Button *button = new Button ( x, y, width, height, caption, name );
 	if ( button ) {
-		buttons.PutDataAtStart ( button );
+		EclAddButton ( button );
 
 		EclRegisterButtonCallbacks ( name, default_draw, default_mouseup, 
 									 default_mousedown, default_mousemove );
@@ -223,6 +346,9 @@ void EclRemoveButton ( char *name )
 
 		EclDirtyRectangle ( button->x, button->y, button->width, button->height );
 
+		EclUnindexButton ( button );
+		EclRemoveFromVector ( namebuckets [EclHashName ( button->name )], button );
+
 		buttons.RemoveData ( index );
 		if ( button ) delete button;
 
@@ -247,6 +373,7 @@ void EclButtonBringToFront ( char *name )
 		Button *button = buttons [index];
 		buttons.RemoveData ( index );
 		buttons.PutDataAtStart ( button );
+		button->zorder = ++topzorder;
 		EclDirtyButton ( name );
 
 	}
@@ -270,6 +397,7 @@ void EclButtonSendToBack   ( char *name )
 		Button *button = buttons [index];
 		buttons.RemoveData ( index );
 		buttons.PutDataAtEnd ( button );
+		button->zorder = --bottomzorder;
 		EclDirtyButton ( name );
 
 	}
@@ -303,14 +431,14 @@ void EclRegisterButtonCallbacks ( char *name, void (*draw) (Button *, bool, bool
 								  void (*mousemove) (Button *) )
 {
 
-	int index = EclLookupIndex ( name );
+	Button *button = EclGetButton ( name );
 
-	if ( buttons.ValidIndex ( index ) ) {
+	if ( button ) {
 
-		buttons [index]->RegisterDrawFunction ( draw );
-		buttons [index]->RegisterMouseUpFunction ( mouseup );
-		buttons [index]->RegisterMouseDownFunction ( mousedown );
-		buttons [index]->RegisterMouseMoveFunction ( mousemove );
+		button->RegisterDrawFunction ( draw );
+		button->RegisterMouseUpFunction ( mouseup );
+		button->RegisterMouseDownFunction ( mousedown );
+		button->RegisterMouseMoveFunction ( mousemove );
 
 	}
 	else {
@@ -327,10 +455,10 @@ void EclRegisterButtonCallback ( char *name,
 								 void (*mouseup) (Button *) )
 {
 
-	int index = EclLookupIndex ( name );
+	Button *button = EclGetButton ( name );
 
-	if ( buttons.ValidIndex ( index ) )
-		buttons [index]->RegisterMouseUpFunction ( mouseup );
+	if ( button )
+		button->RegisterMouseUpFunction ( mouseup );
 
 #ifdef _DEBUG
 	else 
@@ -430,10 +558,12 @@ void EclHighlightNextEditableButton ()
 int  EclLookupIndex ( char *name )
 {
 
-	if ( name )
+	Button *button = EclGetButton ( name );
+
+	if ( button )
 		for ( int i = 0; i < buttons.Size (); ++i )
 			if ( buttons.ValidIndex ( i ) )		
-				if ( strcmp ( buttons [i]->name, name ) == 0 )
+				if ( buttons [i] == button )
 					return i;
 
 	return -1;
@@ -481,74 +611,34 @@ bool EclIsOccupied ( int x, int y, int w, int h )
 void EclDirtyButton ( char *name )
 {
 
-/********************************************************************
- *** Removed now that the screen is totally repainted every frame ***
- ********************************************************************
+	//
+	// The screen is repainted in full every frame, but idle () in opengl.cpp
+	// paces frames more slowly while nothing has been dirtied
+	//
 
 	Button *button = EclGetButton ( name );
 
-	if ( button ) {
-
-		if ( !button->dirty ) {
-				
-			button->Dirty ();
-
-			// Dirty any buttons that are above this one (ie have a lower index)
-			// This occurs recursivly - as multiple overlapping buttons need refreshing
-
-			int thisindex = EclLookupIndex (name);
-
-			for ( int i = thisindex - 1; i >= 0; --i )
-				if ( buttons.ValidIndex (i) ) {
-					Button *b = buttons [i];
-					if ( EclRectangleOverlap ( b->x, b->y, b->width, b->height,
-											   button->x, button->y, button->width, button->height ) )
-						EclDirtyButton ( b->name );
-				}
-
-		}
-
-	}
-#ifdef _DEBUG
-	else 
-		printf ( "ECL WARNING : EclDirtyButton called, button does not exist : %s\n", name );
-#endif
-*/
+	if ( button ) 
+		button->Dirty ();
 
 }
 
 void EclDirtyRectangle ( int x, int y, int w, int h )
 {
-/*
-	dirtyrect *d = new dirtyrect ();
-	d->x = x;
-	d->y = y;
-	d->width = w;
-	d->height = h;
-
-	dirtyrectangles.PutData ( d );
-*/
 
-/********************************************************************
- *** Removed now that the screen is totally repainted every frame ***
- ********************************************************************
+	if ( w <= 0 || h <= 0 ) return;
 
-    dirtyrectangles.push_back ( dirtyrect(x, y, w, h) );
+	// EclIsDamaged only asks whether there are any, so don't let them grow without bound
 
-	// Dirty any buttons in this area
+	if ( dirtyrectangles.size () < ECL_MAXDIRTYRECTANGLES )
+		dirtyrectangles.push_back ( dirtyrect(x, y, w, h) );
 
-	for ( int i = 0; i < buttons.Size (); ++i ) {
-		if ( buttons.ValidIndex (i) ) {
-			
-			Button *b = buttons.GetData (i);
+}
 
-			if ( EclRectangleOverlap ( x, y, w, h, b->x, b->y, b->width, b->height ) ) 
-				EclDirtyButton ( b->name );
-			
-		}
-	}
+bool EclIsDamaged ()
+{
 
-*/
+	return !dirtyrectangles.empty ();
 
 }
 
@@ -866,16 +956,25 @@ void EclUpdateSuperHighlights ( char *name )
 char *EclGetButtonAtCoord ( int x, int y )
 {
 
-	for ( int i = 0; i < buttons.Size (); ++i ) {
-		if ( buttons.ValidIndex (i) ) {
-			Button *b = buttons [i];
-			if ( x >= b->x && x <= b->x + b->width &&
-				 y >= b->y && y <= b->y + b->height )				 
-				return b->name;
-		}
+	if ( !buttongrid ) return NULL;
+
+	// Check only the buttons filed under this cell, taking the front-most
+
+	int cellx, celly;
+	EclGridCell ( x, y, &cellx, &celly );
+	vector <Button *> &cell = buttongrid [celly * gridwidth + cellx];
+
+	Button *result = NULL;
+
+	for ( size_t i = 0; i < cell.size (); ++i ) {
+		Button *b = cell [i];
+		if ( x >= b->x && x <= b->x + b->width &&
+			 y >= b->y && y <= b->y + b->height )
+			if ( !result || b->zorder > result->zorder )
+				result = b;
 	}
 
-	return NULL;
+	return result ? result->name : NULL;
 
 }
 
@@ -889,12 +988,19 @@ char *EclGetHighlightedButton ()
 Button *EclGetButton ( char *name )
 {
 
-	int index = EclLookupIndex ( name );
+	if ( !name ) return NULL;
 
-	if ( buttons.ValidIndex ( index ) )
-		return buttons [index];
-	else
-		return NULL;
+	// Names should be unique, but if not return the front-most as always
+
+	vector <Button *> &bucket = namebuckets [EclHashName ( name )];
+	Button *result = NULL;
+
+	for ( size_t i = 0; i < bucket.size (); ++i )
+		if ( strcmp ( bucket [i]->name, name ) == 0 )
+			if ( !result || bucket [i]->zorder > result->zorder )
+				result = bucket [i];
+
+	return result;
 
 }
 
@@ -1255,6 +1361,8 @@ void EclUpdateAllAnimations ()
 
 					}
 
+					EclUpdateButtonIndex ( anim->button );
+
 					// Update any SuperHighlights that exist on this button
 
 					if ( EclIsSuperHighlighted ( anim->buttonname ) )
@@ -1365,6 +1473,8 @@ void EclUpdateAllAnimations ()
 
 					}
 
+					EclUpdateButtonIndex ( anim->button );
+
 					// Update any SuperHighlights that exist on this button
 
 					if ( EclIsSuperHighlighted ( anim->buttonname ) )
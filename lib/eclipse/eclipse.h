@@ -78,12 +78,15 @@ void EclHighlightNextEditableButton ();
 // Graphical functions ========================================================
 
 void EclDirtyButton		  ( char *name );					// Tells eclipse that this needs re-drawing
+void EclUpdateButtonIndex ( Button *button );				// Re-files a moved / resized button for hit-testing
 void EclDirtyRectangle	  ( int x, int y, int w, int h );	// Tells eclipse to blank this area
 void EclDirtyClear        ();								// Clears all dirty buttons / rectangles
 void EclClearRectangle    ( int x, int y, int w, int h );   // Tells eclipse to blank this area (now)
 
 bool EclIsOccupied        ( int x, int y, int w, int h );	// True if there is a button here
 
+bool EclIsDamaged         ();								// Anything dirtied since the last EclDirtyClear
+
 void EclDrawAllButtons    ();
 void EclDrawButton        ( char *name );
 void EclDrawButton        ( int index );
@@ -105,6 +105,7 @@ GCI_GLUT_FUNC(Idle);
 GCI_GLUT_FUNC(Reshape);
 
 void GciTimerFunc(unsigned int millis, GciCallbackT *callback, int value);
+void GciWaitForEvent(unsigned int millis);			/* Sleeps until input arrives or millis have passed */
 
 /* Special Keys */
 
@@ -38,7 +38,6 @@ using namespace std;
 // Allegro5 globals
 static ALLEGRO_DISPLAY *display = NULL;
 static ALLEGRO_EVENT_QUEUE *eventQueue = NULL;
-static ALLEGRO_TIMER *timer = NULL;
 
 static unsigned _GciGetAccurateTime();
 
@@ -152,21 +151,12 @@ char *GciInitGraphicsLibrary(int graphics_flags,
     return strdup("Could not create Allegro5 event queue");
   }
 
-  // Create timer (60 FPS)
-  timer = al_create_timer(1.0 / 60.0);
-  if (!timer) {
-    al_destroy_event_queue(eventQueue);
-    al_destroy_display(display);
-    return strdup("Could not create Allegro5 timer");
-  }
-
   // Register event sources
+  // No frame timer - idle() paces frames itself, and timer events would wake
+  // GciWaitForEvent every tick
   al_register_event_source(eventQueue, al_get_display_event_source(display));
   al_register_event_source(eventQueue, al_get_keyboard_event_source());
   al_register_event_source(eventQueue, al_get_mouse_event_source());
-  al_register_event_source(eventQueue, al_get_timer_event_source(timer));
-
-  al_start_timer(timer);
 
   if (debugging) printf("done\n");
   if (debugging) printf(" Initialising OpenGL...\n");
@@ -235,6 +225,10 @@ public:
     return (al_get_time() * 1000) > expiryTime;
   };
 
+  double timeLeft() {
+    return expiryTime - al_get_time() * 1000;
+  };
+
   void invoke();
 
 private:
@@ -270,6 +264,32 @@ void GciTimerFunc(unsigned int millis, GciCallbackT *callback, int value)
   timerEvents.push_back(new Callback(millis, callback, value));
 }
 
+// Shortens a wait so it ends once the next GciTimerFunc callback is due
+static unsigned GciTimeToNextTimerEvent(unsigned millis)
+{
+  for (TimerList::iterator i = timerEvents.begin(); i != timerEvents.end(); i++) {
+    double left = (*i)->timeLeft();
+    if (left < 0)
+      return 0;
+    if (left < millis)
+      millis = (unsigned)left + 1;
+  }
+  return millis;
+}
+
+void GciWaitForEvent(unsigned int millis)
+{
+  millis = GciTimeToNextTimerEvent(millis);
+  if (millis == 0)
+    return;
+
+  // Leaves the event on the queue for the main loop to dispatch
+  if (eventQueue)
+    al_wait_for_event_timed(eventQueue, NULL, millis / 1000.0f);
+  else
+    al_rest(millis / 1000.0);
+}
+
 // Main event loop
 void GciMainLoop()
 {
@@ -399,10 +419,6 @@ bool GciIsInitGraphicsLibrary()
 
 void GciDeleteGraphicsLibrary()
 {
-  if (timer) {
-    al_destroy_timer(timer);
-    timer = NULL;
-  }
   if (eventQueue) {
     al_destroy_event_queue(eventQueue);
     eventQueue = NULL;
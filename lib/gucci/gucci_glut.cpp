@@ -3,6 +3,9 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#ifndef WIN32
+#include <unistd.h>
+#endif
 
 #include "gucci.h"
 #include "gucci_internal.h"
@@ -205,6 +208,16 @@ void GciTimerFunc(unsigned int millis, GciCallbackT *callback, int value)
   glutTimerFunc(millis, callback, value);
 }
 
+void GciWaitForEvent(unsigned int millis)
+{
+  // GLUT only calls idle when its queue is empty, so just sleep
+#ifdef WIN32
+  Sleep(millis);
+#else
+  usleep(millis * 1000);
+#endif
+}
+
 void GciMainLoop()
 {
   glutMainLoop ();
@@ -289,6 +289,10 @@ public:
     return SDL_GetTicks() > expiryTime;
   };
 
+  int timeLeft() {
+    return (int)(expiryTime - SDL_GetTicks());
+  };
+
   void invoke();
 
 private:
@@ -324,6 +328,37 @@ void GciTimerFunc(unsigned int millis, GciCallbackT *callback, int value)
   timerEvents.push_back(new Callback(millis, callback, value));
 }
 
+// Shortens a wait so it ends once the next GciTimerFunc callback is due
+static unsigned GciTimeToNextTimerEvent(unsigned millis)
+{
+  for (TimerList::iterator i = timerEvents.begin(); i != timerEvents.end(); i++) {
+    int left = (*i)->timeLeft();
+    if (left < 0)
+      return 0;
+    if ((unsigned)left < millis)
+      millis = (unsigned)left + 1;
+  }
+  return millis;
+}
+
+void GciWaitForEvent(unsigned int millis)
+{
+  millis = GciTimeToNextTimerEvent(millis);
+  if (millis == 0)
+    return;
+
+  // SDL 1.2 has no timed wait, so poll the queue without removing anything
+  unsigned until = _GciGetAccurateTime() + millis;
+  SDL_Event event;
+
+  SDL_PumpEvents();
+  while (SDL_PeepEvents(&event, 1, SDL_PEEKEVENT, SDL_ALLEVENTS) == 0 &&
+         _GciGetAccurateTime() < until) {
+    SDL_Delay(1);
+    SDL_PumpEvents();
+  }
+}
+
 void GciMainLoop()
 {
   finished = false;
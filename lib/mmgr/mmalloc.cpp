@@ -0,0 +1,583 @@
+
+/*
+
+  Release allocator
+
+	Small allocations come from per size class free lists, carved out of
+	64k chunks which are never given back.  Everything else goes straight
+	to malloc.  Every block has a 16 byte header saying which it was.
+
+	Each size class has its own spin lock, so threads only contend
+	when allocating the same size at the same time.
+
+  */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <new>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <execinfo.h>
+#endif
+
+#include "mmalloc.h"
+
+
+#define MM_GRANULARITY		16
+#define MM_NUMCLASSES		16								// Up to 256 bytes
+#define MM_CHUNKSIZE		( 64 * 1024 )
+#define MM_LARGE			0xffff
+
+#define MM_STACKDEPTH		16
+#define MM_SAMPLESLOTS		( 64 * 1024 )					// Power of two
+#define MM_SKIPFRAMES		4								// The allocator's own frames, down to operator new
+
+#ifdef WIN32
+#define MM_NOINLINE			__declspec(noinline)
+#else
+#define MM_NOINLINE			__attribute__((noinline))
+#endif
+
+
+union MmHeader
+{
+
+	struct {
+		size_t			size;
+		unsigned short	sizeclass;
+		unsigned short	sampled;
+	} info;
+
+	char pad [MM_GRANULARITY];
+
+};
+
+struct MmFreeBlock
+{
+
+	MmFreeBlock *next;
+
+};
+
+struct MmSizeClass
+{
+
+	std::atomic_flag lock;
+	MmFreeBlock *freelist;
+	size_t		reserved;
+
+};
+
+struct MmSample
+{
+
+	void	*address;										// NULL if unused
+	size_t	size;
+	int		depth;
+	void	*stack [MM_STACKDEPTH];
+
+};
+
+
+//
+// Everything here is zero or constant initialised, as operator new
+// can be called before any constructor has run
+//
+
+static MmSizeClass sizeclasses [MM_NUMCLASSES] = { 
+	{ ATOMIC_FLAG_INIT, NULL, 0 }, { ATOMIC_FLAG_INIT, NULL, 0 }, { ATOMIC_FLAG_INIT, NULL, 0 }, { ATOMIC_FLAG_INIT, NULL, 0 },
+	{ ATOMIC_FLAG_INIT, NULL, 0 }, { ATOMIC_FLAG_INIT, NULL, 0 }, { ATOMIC_FLAG_INIT, NULL, 0 }, { ATOMIC_FLAG_INIT, NULL, 0 },
+	{ ATOMIC_FLAG_INIT, NULL, 0 }, { ATOMIC_FLAG_INIT, NULL, 0 }, { ATOMIC_FLAG_INIT, NULL, 0 }, { ATOMIC_FLAG_INIT, NULL, 0 },
+	{ ATOMIC_FLAG_INIT, NULL, 0 }, { ATOMIC_FLAG_INIT, NULL, 0 }, { ATOMIC_FLAG_INIT, NULL, 0 }, { ATOMIC_FLAG_INIT, NULL, 0 }
+};
+
+static std::atomic <unsigned long long> numallocations ( 0 );
+static std::atomic <unsigned long long> numfrees ( 0 );
+static std::atomic <size_t> largebytes ( 0 );
+
+static std::atomic <unsigned int> samplerate ( 0 );
+static std::atomic <unsigned int> lastsamplerate ( 0 );
+static std::atomic <unsigned int> samplecounter ( 0 );
+static std::atomic_flag samplelock = ATOMIC_FLAG_INIT;
+static MmSample *samples = NULL;							// Open addressed by address
+
+
+static void MmLock ( std::atomic_flag *lock )
+{
+
+	while ( lock->test_and_set ( std::memory_order_acquire ) )
+		;
+
+}
+
+static void MmUnlock ( std::atomic_flag *lock )
+{
+
+	lock->clear ( std::memory_order_release );
+
+}
+
+static unsigned int MmSampleSlot ( void *address )
+{
+
+	size_t hash = (size_t) address / MM_GRANULARITY;
+	hash ^= hash >> 15;
+	return (unsigned int) ( hash * 2654435761u ) & ( MM_SAMPLESLOTS - 1 );
+
+}
+
+MM_NOINLINE static int MmCaptureStack ( void **stack )
+{
+
+	// Stack capture can allocate the first time round - that allocation
+	// mustn't be sampled too
+
+	static thread_local bool capturing = false;
+
+	if ( capturing ) return -1;
+	capturing = true;
+
+#ifdef WIN32
+	int depth = CaptureStackBackTrace ( MM_SKIPFRAMES, MM_STACKDEPTH, stack, NULL );
+#else
+	void *frames [MM_STACKDEPTH + MM_SKIPFRAMES];
+	int depth = backtrace ( frames, MM_STACKDEPTH + MM_SKIPFRAMES ) - MM_SKIPFRAMES;
+	if ( depth < 0 ) depth = 0;
+	memcpy ( stack, frames + MM_SKIPFRAMES, depth * sizeof ( void * ) );
+#endif
+
+	capturing = false;
+	return depth;
+
+}
+
+MM_NOINLINE static bool MmSampleAllocation ( void *address, size_t size )
+{
+
+	MmSample sample;
+	sample.depth = MmCaptureStack ( sample.stack );
+	if ( sample.depth < 0 ) return false;
+
+	sample.address = address;
+	sample.size = size;
+
+	// Dropped if the table is full
+
+	bool stored = false;
+	MmLock ( &samplelock );
+
+	if ( samples ) {
+		unsigned int slot = MmSampleSlot ( address );
+		for ( int probe = 0; probe < MM_SAMPLESLOTS && !stored; ++probe ) {
+			MmSample *candidate = &samples [ ( slot + probe ) & ( MM_SAMPLESLOTS - 1 ) ];
+			if ( candidate->address == NULL ) {
+				*candidate = sample;
+				stored = true;
+			}
+			if ( probe > 64 ) break;
+		}
+	}
+
+	MmUnlock ( &samplelock );
+	return stored;
+
+}
+
+static void MmUnsampleAllocation ( void *address )
+{
+
+	MmLock ( &samplelock );
+
+	if ( samples ) {
+
+		unsigned int slot = MmSampleSlot ( address );
+
+		for ( int probe = 0; probe <= 65; ++probe ) {
+
+			unsigned int index = ( slot + probe ) & ( MM_SAMPLESLOTS - 1 );
+			if ( samples [index].address == NULL ) break;
+			if ( samples [index].address != address ) continue;
+
+			// Backward shift, so later probes still find their entries
+
+			unsigned int hole = index;
+			unsigned int next = ( hole + 1 ) & ( MM_SAMPLESLOTS - 1 );
+
+			while ( samples [next].address ) {
+				unsigned int home = MmSampleSlot ( samples [next].address );
+				if ( ( ( next - home ) & ( MM_SAMPLESLOTS - 1 ) ) >= ( ( next - hole ) & ( MM_SAMPLESLOTS - 1 ) ) ) {
+					samples [hole] = samples [next];
+					hole = next;
+				}
+				next = ( next + 1 ) & ( MM_SAMPLESLOTS - 1 );
+			}
+
+			samples [hole].address = NULL;
+			break;
+
+		}
+
+	}
+
+	MmUnlock ( &samplelock );
+
+}
+
+MM_NOINLINE static void *MmAllocate ( size_t size )
+{
+
+	numallocations.fetch_add ( 1, std::memory_order_relaxed );
+
+	MmHeader *header;
+	unsigned int sizeclass = (unsigned int) ( size + MM_GRANULARITY - 1 ) / MM_GRANULARITY;
+	if ( size == 0 ) sizeclass = 1;
+
+	if ( size <= MM_NUMCLASSES * MM_GRANULARITY ) {
+
+		MmSizeClass *sc = &sizeclasses [sizeclass - 1];
+		MmLock ( &sc->lock );
+
+		if ( !sc->freelist ) {
+
+			// Carve up a new chunk
+
+			size_t blocksize = sizeof ( MmHeader ) + sizeclass * MM_GRANULARITY;
+			char *chunk = (char *) malloc ( MM_CHUNKSIZE );
+			if ( !chunk ) {
+				MmUnlock ( &sc->lock );
+				return NULL;
+			}
+
+			for ( size_t offset = 0; offset + blocksize <= MM_CHUNKSIZE; offset += blocksize ) {
+				MmFreeBlock *block = (MmFreeBlock *) ( chunk + offset );
+				block->next = sc->freelist;
+				sc->freelist = block;
+			}
+
+			sc->reserved += MM_CHUNKSIZE;
+
+		}
+
+		header = (MmHeader *) sc->freelist;
+		sc->freelist = sc->freelist->next;
+
+		MmUnlock ( &sc->lock );
+
+		header->info.sizeclass = (unsigned short) sizeclass;
+
+	}
+	else {
+
+		if ( size > SIZE_MAX - sizeof ( MmHeader ) ) return NULL;		// Header would wrap the size round
+
+		header = (MmHeader *) malloc ( sizeof ( MmHeader ) + size );
+		if ( !header ) return NULL;
+
+		header->info.sizeclass = MM_LARGE;
+		largebytes.fetch_add ( size, std::memory_order_relaxed );
+
+	}
+
+	header->info.size = size;
+	header->info.sampled = 0;
+
+	void *address = header + 1;
+
+	unsigned int rate = samplerate.load ( std::memory_order_relaxed );
+	if ( rate > 0 && samplecounter.fetch_add ( 1, std::memory_order_relaxed ) % rate == 0 )
+		header->info.sampled = MmSampleAllocation ( address, size ) ? 1 : 0;
+
+	return address;
+
+}
+
+static void MmFree ( void *address )
+{
+
+	if ( !address ) return;
+
+	numfrees.fetch_add ( 1, std::memory_order_relaxed );
+
+	MmHeader *header = (MmHeader *) address - 1;
+
+	if ( header->info.sampled ) MmUnsampleAllocation ( address );
+
+	if ( header->info.sizeclass == MM_LARGE ) {
+		largebytes.fetch_sub ( header->info.size, std::memory_order_relaxed );
+		free ( header );
+		return;
+	}
+
+	MmSizeClass *sc = &sizeclasses [header->info.sizeclass - 1];
+	MmFreeBlock *block = (MmFreeBlock *) header;
+
+	MmLock ( &sc->lock );
+	block->next = sc->freelist;
+	sc->freelist = block;
+	MmUnlock ( &sc->lock );
+
+}
+
+void MmGetStats ( MmStats *stats )
+{
+
+	stats->allocations = numallocations.load ();
+	stats->frees = numfrees.load ();
+	stats->largebytes = largebytes.load ();
+	stats->smallbytes = 0;
+
+	for ( int i = 0; i < MM_NUMCLASSES; ++i ) {
+		MmLock ( &sizeclasses [i].lock );
+		stats->smallbytes += sizeclasses [i].reserved;
+		MmUnlock ( &sizeclasses [i].lock );
+	}
+
+}
+
+void MmSetSampling ( unsigned int rate )
+{
+
+	// The table lives outside the allocator it is watching
+
+	if ( rate > 0 ) {
+
+		// Starting afresh - samples from an earlier run are forgotten
+
+		MmLock ( &samplelock );
+		if ( !samples ) samples = (MmSample *) calloc ( MM_SAMPLESLOTS, sizeof ( MmSample ) );
+		else if ( samplerate.load () == 0 ) memset ( samples, 0, MM_SAMPLESLOTS * sizeof ( MmSample ) );
+		MmUnlock ( &samplelock );
+
+		lastsamplerate.store ( rate );
+
+		void *stack [MM_STACKDEPTH];
+		MmCaptureStack ( stack );									// Gets any first time setup out of the way
+
+	}
+
+	samplerate.store ( rate );
+
+}
+
+unsigned int MmGetSampling ()
+{
+
+	return samplerate.load ();
+
+}
+
+struct MmProfileLine
+{
+
+	size_t	bytes;
+	int		count;
+	MmSample *sample;
+
+};
+
+static int MmCompareSamples ( const void *a, const void *b )
+{
+
+	const MmSample *samplea = (const MmSample *) a;
+	const MmSample *sampleb = (const MmSample *) b;
+
+	if ( samplea->depth != sampleb->depth ) return samplea->depth - sampleb->depth;
+	return memcmp ( samplea->stack, sampleb->stack, samplea->depth * sizeof ( void * ) );
+
+}
+
+static int MmCompareProfileLines ( const void *a, const void *b )
+{
+
+	size_t bytesa = ((MmProfileLine *) a)->bytes;
+	size_t bytesb = ((MmProfileLine *) b)->bytes;
+	return bytesa < bytesb ? 1 : bytesa > bytesb ? -1 : 0;
+
+}
+
+bool MmDumpHeapProfile ( const char *filename )
+{
+
+	unsigned int rate = lastsamplerate.load ();
+	if ( rate == 0 ) rate = 1;
+
+	//
+	// Copy the samples, so nothing allocates while the lock is held
+	//
+
+	MmSample *copy = (MmSample *) malloc ( MM_SAMPLESLOTS * sizeof ( MmSample ) );
+	MmProfileLine *lines = (MmProfileLine *) malloc ( MM_SAMPLESLOTS * sizeof ( MmProfileLine ) );
+	if ( !copy || !lines ) {
+		free ( copy );
+		free ( lines );
+		return false;
+	}
+
+	int numsamples = 0;
+
+	MmLock ( &samplelock );
+	if ( samples ) {
+		for ( int i = 0; i < MM_SAMPLESLOTS; ++i )
+			if ( samples [i].address ) copy [numsamples++] = samples [i];
+	}
+	MmUnlock ( &samplelock );
+
+	//
+	// Group them by call stack
+	//
+
+	qsort ( copy, numsamples, sizeof ( MmSample ), MmCompareSamples );
+
+	int numlines = 0;
+
+	for ( int i = 0; i < numsamples; ++i ) {
+
+		if ( numlines == 0 || MmCompareSamples ( lines [numlines - 1].sample, &copy [i] ) != 0 ) {
+			lines [numlines].bytes = 0;
+			lines [numlines].count = 0;
+			lines [numlines].sample = &copy [i];
+			++numlines;
+		}
+
+		lines [numlines - 1].bytes += copy [i].size;
+		++lines [numlines - 1].count;
+
+	}
+
+	qsort ( lines, numlines, sizeof ( MmProfileLine ), MmCompareProfileLines );
+
+	//
+	// Write them out, biggest first, scaled up by the sampling rate
+	//
+
+	FILE *file = fopen ( filename, "wt" );
+
+	if ( file ) {
+
+		MmStats stats;
+		MmGetStats ( &stats );
+
+		fprintf ( file, "Heap profile - 1 in %u allocations sampled, %d live samples\n", rate, numsamples );
+		fprintf ( file, "%llu allocations, %llu frees, %u KB small blocks reserved, %u KB in large blocks\n\n",
+				  stats.allocations, stats.frees, (unsigned int) ( stats.smallbytes / 1024 ), (unsigned int) ( stats.largebytes / 1024 ) );
+
+		for ( int i = 0; i < numlines; ++i ) {
+
+			fprintf ( file, "~%u KB in ~%u allocations\n", 
+					  (unsigned int) ( lines [i].bytes * rate / 1024 ), lines [i].count * rate );
+
+			MmSample *sample = lines [i].sample;
+
+#ifdef WIN32
+			for ( int j = 0; j < sample->depth; ++j )
+				fprintf ( file, "\t%p\n", sample->stack [j] );
+#else
+			char **symbols = backtrace_symbols ( sample->stack, sample->depth );
+			for ( int j = 0; j < sample->depth; ++j )
+				fprintf ( file, "\t%s\n", symbols ? symbols [j] : "?" );
+			free ( symbols );
+#endif
+
+			fprintf ( file, "\n" );
+
+		}
+
+		fclose ( file );
+
+	}
+
+	free ( copy );
+	free ( lines );
+
+	return file != NULL;
+
+}
+
+
+#if !defined(USE_MMGR) && !defined(USE_SYSTEM_ALLOCATOR)
+
+// ============================================================
+// Global operators ===========================================
+
+
+void *operator new ( size_t size )
+{
+
+	void *address = MmAllocate ( size );
+	if ( !address ) throw std::bad_alloc ();
+	return address;
+
+}
+
+void *operator new[] ( size_t size )
+{
+
+	void *address = MmAllocate ( size );
+	if ( !address ) throw std::bad_alloc ();
+	return address;
+
+}
+
+void *operator new ( size_t size, const std::nothrow_t & ) throw ()
+{
+
+	return MmAllocate ( size );
+
+}
+
+void *operator new[] ( size_t size, const std::nothrow_t & ) throw ()
+{
+
+	return MmAllocate ( size );
+
+}
+
+void operator delete ( void *address ) throw ()
+{
+
+	MmFree ( address );
+
+}
+
+void operator delete[] ( void *address ) throw ()
+{
+
+	MmFree ( address );
+
+}
+
+void operator delete ( void *address, const std::nothrow_t & ) throw ()
+{
+
+	MmFree ( address );
+
+}
+
+void operator delete[] ( void *address, const std::nothrow_t & ) throw ()
+{
+
+	MmFree ( address );
+
+}
+
+void operator delete ( void *address, size_t ) throw ()
+{
+
+	MmFree ( address );
+
+}
+
+void operator delete[] ( void *address, size_t ) throw ()
+{
+
+	MmFree ( address );
+
+}
+
+#endif
@@ -0,0 +1,38 @@
+
+/*
+
+  Release allocator
+
+	Replaces the global operator new and delete with a size class
+	allocator, unless USE_MMGR (the full tracker) or USE_SYSTEM_ALLOCATOR 
+	is defined.  Optionally samples one in every N allocations, with the
+	call stack of each, to show where the heap is going.
+
+  */
+
+
+#ifndef _included_mmalloc_h
+#define _included_mmalloc_h
+
+#include <stddef.h>
+
+
+struct MmStats
+{
+
+	unsigned long long allocations;				// Since the start
+	unsigned long long frees;
+	size_t	smallbytes;							// Reserved for small size classes
+	size_t	largebytes;							// Live allocations bigger than that
+
+};
+
+
+void	MmGetStats			( MmStats *stats );
+
+void	MmSetSampling		( unsigned int rate );						// 1 in rate allocations, 0 to stop
+unsigned int MmGetSampling	();
+
+bool	MmDumpHeapProfile	( const char *filename );					// Live sampled memory, by call stack
+
+#endif
@@ -1,5 +1,5 @@
-// Remove memory debugging
-#if 0
+// Memory debugging - define USE_MMGR everywhere to track every allocation
+#ifdef USE_MMGR
 
 // ---------------------------------------------------------------------------------------------------------------------------------
 //                                                      
@@ -413,7 +413,7 @@ static	sAllocUnit	*findAllocUnit(const void *reportedAddress)
 	// addresses will be on four-, eight- or even sixteen-byte boundaries. If we didn't do this, the hash index would not have
 	// very good coverage.
 
-	unsigned int	hashIndex = (reinterpret_cast<unsigned int>(const_cast<void *>(reportedAddress)) >> 4) & (hashSize - 1);
+	unsigned int	hashIndex = ((unsigned int) reinterpret_cast<size_t>(const_cast<void *>(reportedAddress)) >> 4) & (hashSize - 1);
 	sAllocUnit	*ptr = hashTable[hashIndex];
 	while(ptr)
 	{
@@ -531,8 +531,8 @@ static	void	dumpAllocations(FILE *fp)
 		{
 			fprintf(fp, "%06d 0x%08X 0x%08X 0x%08X 0x%08X 0x%08X %-8s    %c       %c    %s\r\n",
 				ptr->allocationNumber,
-				reinterpret_cast<unsigned int>(ptr->reportedAddress), ptr->reportedSize,
-				reinterpret_cast<unsigned int>(ptr->actualAddress), ptr->actualSize,
+				(unsigned int) reinterpret_cast<size_t>(ptr->reportedAddress), ptr->reportedSize,
+				(unsigned int) reinterpret_cast<size_t>(ptr->actualAddress), ptr->actualSize,
 				m_calcUnused(ptr),
 				allocationTypes[ptr->allocationType],
 				ptr->breakOnDealloc ? 'Y':'N',
@@ -1169,7 +1169,7 @@ void	*m_allocator(const char *sourceFile, const unsigned int sourceLine, const c
 
 		// Insert the new allocation into the hash table
 
-		unsigned int	hashIndex = (reinterpret_cast<unsigned int>(au->reportedAddress) >> 4) & (hashSize - 1);
+		unsigned int	hashIndex = ((unsigned int) reinterpret_cast<size_t>(au->reportedAddress) >> 4) & (hashSize - 1);
 		if (hashTable[hashIndex]) hashTable[hashIndex]->prev = au;
 		au->next = hashTable[hashIndex];
 		au->prev = NULL;
@@ -1204,7 +1204,7 @@ void	*m_allocator(const char *sourceFile, const unsigned int sourceLine, const c
 
 		// Log the result
 
-		if (alwaysLogAll) log("[+] ---->             addr 0x%08X", reinterpret_cast<unsigned int>(au->reportedAddress));
+		if (alwaysLogAll) log("[+] ---->             addr 0x%08X", (unsigned int) reinterpret_cast<size_t>(au->reportedAddress));
 
 		// Resetting the globals insures that if at some later time, somebody calls our memory manager from an unknown
 		// source (i.e. they didn't include our H file) then we won't think it was the last allocation.
@@ -1355,7 +1355,7 @@ void	*m_reallocator(const char *sourceFile, const unsigned int sourceLine, const
 			// Remove this allocation unit from the hash table
 
 			{
-				unsigned int	hashIndex = (reinterpret_cast<unsigned int>(oldReportedAddress) >> 4) & (hashSize - 1);
+				unsigned int	hashIndex = ((unsigned int) reinterpret_cast<size_t>(oldReportedAddress) >> 4) & (hashSize - 1);
 				if (hashTable[hashIndex] == au)
 				{
 					hashTable[hashIndex] = hashTable[hashIndex]->next;
@@ -1369,7 +1369,7 @@ void	*m_reallocator(const char *sourceFile, const unsigned int sourceLine, const
 
 			// Re-insert it back into the hash table
 
-			hashIndex = (reinterpret_cast<unsigned int>(au->reportedAddress) >> 4) & (hashSize - 1);
+			hashIndex = ((unsigned int) reinterpret_cast<size_t>(au->reportedAddress) >> 4) & (hashSize - 1);
 			if (hashTable[hashIndex]) hashTable[hashIndex]->prev = au;
 			au->next = hashTable[hashIndex];
 			au->prev = NULL;
@@ -1403,7 +1403,7 @@ void	*m_reallocator(const char *sourceFile, const unsigned int sourceLine, const
 
 		// Log the result
 
-		if (alwaysLogAll) log("[~] ---->             addr 0x%08X", reinterpret_cast<unsigned int>(au->reportedAddress));
+		if (alwaysLogAll) log("[~] ---->             addr 0x%08X", (unsigned int) reinterpret_cast<size_t>(au->reportedAddress));
 
 		// Resetting the globals insures that if at some later time, somebody calls our memory manager from an unknown
 		// source (i.e. they didn't include our H file) then we won't think it was the last allocation.
@@ -1447,7 +1447,7 @@ void	m_deallocator(const char *sourceFile, const unsigned int sourceLine, const
 
 		// Log the request
 
-		if (alwaysLogAll) log("[-] ----- %8s of addr 0x%08X           by %s", allocationTypes[deallocationType], reinterpret_cast<unsigned int>(const_cast<void *>(reportedAddress)), ownerString(sourceFile, sourceLine, sourceFunc));
+		if (alwaysLogAll) log("[-] ----- %8s of addr 0x%08X           by %s", allocationTypes[deallocationType], (unsigned int) reinterpret_cast<size_t>(const_cast<void *>(reportedAddress)), ownerString(sourceFile, sourceLine, sourceFunc));
 
 		// We should only ever get here with a null pointer if they try to do so with a call to free() (delete[] and delete will
 		// both bail before they get here.) So, since ANSI allows free(NULL), we'll not bother trying to actually free the allocated
@@ -1495,7 +1495,7 @@ void	m_deallocator(const char *sourceFile, const unsigned int sourceLine, const
 
 			// Remove this allocation unit from the hash table
 
-			unsigned int	hashIndex = (reinterpret_cast<unsigned int>(au->reportedAddress) >> 4) & (hashSize - 1);
+			unsigned int	hashIndex = ((unsigned int) reinterpret_cast<size_t>(au->reportedAddress) >> 4) & (hashSize - 1);
 			if (hashTable[hashIndex] == au)
 			{
 				hashTable[hashIndex] = au->next;
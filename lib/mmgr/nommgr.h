@@ -1,5 +1,5 @@
-// Remove memory debugging
-#if 0
+// Memory debugging - define USE_MMGR everywhere to track every allocation
+#ifdef USE_MMGR
 
 // ---------------------------------------------------------------------------------------------------------------------------------
 //                                                 _     
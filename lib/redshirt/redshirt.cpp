@@ -31,6 +31,8 @@ const int SIZE_RSFILENAME = 256;
 static char tempfilename [SIZE_RSFILENAME] = "";                         // Returned by RsArchiveFileOpen
 static char rsapppath [SIZE_RSFILENAME] = "";
 static char tempdir[SIZE_RSFILENAME] = "";
+static char *filedata = NULL;                                            // Returned by RsArchiveFileData
+static int filedatasize = 0;
 static bool rsInitialised = false;
 
 #define BUFFER_SIZE 16384
@@ -398,15 +400,39 @@ void RsFileClose ( char *filename, FILE *file )
 }
 
 
-bool RsLoadArchive ( char *filename )
+static unsigned int RsEncryptedHeaderSize ( char *filename )
+{
+
+	// Bytes before the encrypted data, or 0 if the file is not encrypted
+
+	FILE *input = fopen ( filename, "rb" );
+	if ( !input ) return 0;
+
+	unsigned int result = 0;
+
+	char newmarker [SIZE_MARKER];
+	if ( fread ( newmarker, SIZE_MARKER, 1, input ) == 1 ) {
+		if ( strcmp ( newmarker, marker2 ) == 0 )
+			result = SIZE_MARKER + HashResultSize ();
+		else if ( strcmp ( newmarker, marker ) == 0 )
+			result = SIZE_MARKER;
+	}
+
+	fclose ( input );
+
+	return result;
+
+}
+
+BglArchive *RsMapArchive ( char *filename )
 {
 
 	char fullfilename [SIZE_RSFILENAME];
 	sprintf ( fullfilename, "%s%s", rsapppath, filename );
 
-	FILE *archive = RsFileOpen ( fullfilename, "rb" );
+	bool found = RsFileExists ( fullfilename );
 
-	if ( !archive ) {
+	if ( !found ) {
 		int len = (int) strlen ( rsapppath );
 		if ( len >= 5 ) {
 			char c1 = rsapppath[ len - 5 ];
@@ -423,21 +449,42 @@ bool RsLoadArchive ( char *filename )
 
 				fullfilename[ len - 4 ] = '\0';
 				strcat( fullfilename, filename );
-				archive = RsFileOpen ( fullfilename, "rb" );
+				found = RsFileExists ( fullfilename );
 			}
 		}
 
-		if ( !archive ) return false;
+		if ( !found ) return NULL;
 	}
 
-	bool result = BglOpenZipFile ( archive, rsapppath, filename );						// use the short filename as the id
+	//
+	// The archive is mapped rather than decrypted to a temp file up front -
+	// encrypted entries are decrypted one at a time as they are used
+	//
+
+	unsigned int headersize = RsEncryptedHeaderSize ( fullfilename );
+
+	return BglMapZipFile ( fullfilename, rsapppath, filename,								// use the short filename as the id
+						   headersize, headersize > 0 ? decryptBuffer : NULL );
 
-	RsFileClose ( filename, archive );
+}
+
+bool RsAddArchive ( char *filename, BglArchive *archive )
+{
+
+	bool result = BglAddZipFile ( archive );
 
 	if ( result ) printf ( "Successfully loaded data archive %s\n", filename );
 	else		  printf ( "Failed to load data archive %s\n", filename );
 
 	return result;
+
+}
+
+bool RsLoadArchive ( char *filename )
+{
+
+	return RsAddArchive ( filename, RsMapArchive ( filename ) );
+
 }
 
 FILE *RsArchiveFileOpen	( char *filename, char *mode )
@@ -536,6 +583,54 @@ bool RsArchiveFileLoaded ( char *filename )
 
 }
 
+char *RsArchiveFileData ( char *filename, int *size )
+{
+
+    //
+    // WARNING
+    // Like BglGetFileData, the data returned belongs to this
+    // library and is only valid until the next call
+    //
+
+	char fullfilename [SIZE_RSFILENAME];
+	sprintf ( fullfilename, "%s%s", rsapppath, filename );
+
+	if ( RsFileExists ( fullfilename ) ) {
+
+		FILE *file = fopen ( fullfilename, "rb" );
+		if ( !file ) return NULL;
+
+		fseek ( file, 0, SEEK_END );
+		int filesize = (int) ftell ( file );
+		fseek ( file, 0, SEEK_SET );
+
+		if ( filesize < 0 ) {
+			fclose ( file );
+			return NULL;
+		}
+
+		if ( filesize > filedatasize || !filedata ) {
+			delete [] filedata;
+			filedata = new char [filesize + 1];
+			filedatasize = filesize;
+		}
+
+		bool success = fread ( filedata, 1, filesize, file ) == (size_t) filesize;
+		fclose ( file );
+
+		if ( !success ) return NULL;
+		if ( size ) *size = filesize;
+		return filedata;
+
+	}
+
+	if ( BglFileLoaded ( fullfilename ) )
+		return BglGetFileData ( fullfilename, size );
+
+	return NULL;
+
+}
+
 void RsArchiveFileClose	( char *filename, FILE *file )
 {
 
@@ -680,6 +775,10 @@ void RsCleanUp ()
 
 	BglCloseAllFiles();
 
+	delete [] filedata;
+	filedata = NULL;
+	filedatasize = 0;
+
 }
 
 
@@ -16,6 +16,8 @@
 
 #include "tosser.h"
 
+struct BglArchive;
+
 //#ifdef _DEBUG
 //#include "slasher.h"
 //#endif
@@ -55,9 +57,13 @@ void  RsFileClose		( char *filename, FILE *file );
 
 bool RsLoadArchive			( char *filename );
 
+BglArchive *RsMapArchive	( char *filename );									// RsLoadArchive in two steps - map on any
+bool RsAddArchive			( char *filename, BglArchive *archive );			// thread, then add in order of priority
+
 FILE *RsArchiveFileOpen		( char *filename, char *mode );		      // Looks for file apppath/filename					
 char *RsArchiveFileOpen		( char *filename );					      // Opens from filename first, then from zip file
 bool RsArchiveFileLoaded	( char *filename );
+char *RsArchiveFileData		( char *filename, int *size );		      // Contents in memory, without extracting to a temp file
 
 void RsArchiveFileClose		( char *filename, FILE *file = NULL );
 
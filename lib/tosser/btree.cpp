@@ -347,7 +347,10 @@ DArray <T> *BTree <T> :: ConvertToDArray ()
 {
     
     DArray <T> *darray = new DArray <T>;
-    RecursiveConvertToDArray ( darray, this );
+    darray->SetSize ( Size () );                // Sized up front, so each item is a direct store
+
+    int index = 0;
+    RecursiveConvertToDArray ( darray, this, &index );
     
     return darray;
     
@@ -358,39 +361,42 @@ DArray <char *> *BTree <T> :: ConvertIndexToDArray ()
 {
     
     DArray <char *> *darray = new DArray <char *>;
-    RecursiveConvertIndexToDArray ( darray, this );
+    darray->SetSize ( Size () );                // Sized up front, so each item is a direct store
+
+    int index = 0;
+    RecursiveConvertIndexToDArray ( darray, this, &index );
     
     return darray;
     
 }
 
 template <class T>
-void BTree <T> :: RecursiveConvertToDArray ( DArray <T> *darray, BTree <T> *btree )
+void BTree <T> :: RecursiveConvertToDArray ( DArray <T> *darray, BTree <T> *btree, int *index )
 {
     
     assert (darray);
     
     if ( !btree ) return;            // Base case
     
-    if ( btree->id ) darray->PutData ( btree->data );
+    if ( btree->id ) darray->PutData ( btree->data, (*index)++ );
     
-    RecursiveConvertToDArray ( darray, btree->Left  () );
-    RecursiveConvertToDArray ( darray, btree->Right () );
+    RecursiveConvertToDArray ( darray, btree->Left  (), index );
+    RecursiveConvertToDArray ( darray, btree->Right (), index );
     
 }
 
 template <class T>
-void BTree <T> :: RecursiveConvertIndexToDArray ( DArray <char *> *darray, BTree <T> *btree )
+void BTree <T> :: RecursiveConvertIndexToDArray ( DArray <char *> *darray, BTree <T> *btree, int *index )
 {
     
     assert (darray);
     
     if ( !btree ) return;            // Base case
     
-    if ( btree->id ) darray->PutData ( btree->id );
+    if ( btree->id ) darray->PutData ( btree->id, (*index)++ );
     
-    RecursiveConvertIndexToDArray ( darray, btree->Left  () );
-    RecursiveConvertIndexToDArray ( darray, btree->Right () );
+    RecursiveConvertIndexToDArray ( darray, btree->Left  (), index );
+    RecursiveConvertIndexToDArray ( darray, btree->Right (), index );
     
 }
 
@@ -0,0 +1,202 @@
+
+#ifndef _included_tosser_deque
+#define _included_tosser_deque
+
+#include <assert.h>
+
+#include "tosser.h"
+
+#define DEQUE_MINCAPACITY 16
+
+template <class T>
+Deque <T>::Deque ()
+{
+
+	data = NULL;
+	capacity = 0;
+	start = 0;
+	numitems = 0;
+
+}
+
+template <class T>
+Deque <T>::~Deque ()
+{
+
+	Empty ();
+
+}
+
+template <class T>
+void Deque <T>::Grow ()
+{
+
+	int newcapacity = capacity ? capacity * 2 : DEQUE_MINCAPACITY;
+	T *newdata = new T [newcapacity];
+
+	for ( int i = 0; i < numitems; ++i )
+		newdata [i] = Slot (i);
+
+	delete [] data;
+	data = newdata;
+	capacity = newcapacity;
+	start = 0;
+
+}
+
+template <class T>
+void Deque <T>::PutData ( const T &newdata )
+{
+
+	PutDataAtEnd ( newdata );
+
+}
+
+template <class T>
+void Deque <T>::PutDataAtEnd ( const T &newdata )
+{
+
+	if ( numitems == capacity ) Grow ();
+
+	Slot ( numitems ) = newdata;
+	++numitems;
+
+}
+
+template <class T>
+void Deque <T>::PutDataAtStart ( const T &newdata )
+{
+
+	if ( numitems == capacity ) Grow ();
+
+	start = ( start - 1 ) & ( capacity - 1 );
+	data [start] = newdata;
+	++numitems;
+
+}
+
+template <class T>
+void Deque <T>::PutDataAtIndex ( const T &newdata, int index )
+{
+
+	if ( index <= 0 ) {
+		PutDataAtStart ( newdata );
+		return;
+	}
+
+	if ( index >= numitems ) {
+		PutDataAtEnd ( newdata );
+		return;
+	}
+
+	if ( numitems == capacity ) Grow ();
+
+	if ( index < numitems / 2 ) {
+
+		// Move the front half down a slot
+
+		start = ( start - 1 ) & ( capacity - 1 );
+		for ( int i = 0; i < index; ++i )
+			Slot (i) = Slot (i + 1);
+
+	}
+	else {
+
+		// Move the back half up a slot
+
+		for ( int i = numitems; i > index; --i )
+			Slot (i) = Slot (i - 1);
+
+	}
+
+	Slot (index) = newdata;
+	++numitems;
+
+}
+
+template <class T>
+T Deque <T>::GetData ( int index )
+{
+
+	if ( index < 0 || index >= numitems )
+		return (T) 0;
+
+	return Slot (index);
+
+}
+
+template <class T>
+void Deque <T>::RemoveData ( int index )
+{
+
+	if ( index < 0 || index >= numitems )
+		return;
+
+	if ( index < numitems / 2 ) {
+
+		for ( int i = index; i > 0; --i )
+			Slot (i) = Slot (i - 1);
+
+		start = ( start + 1 ) & ( capacity - 1 );
+
+	}
+	else {
+
+		for ( int i = index; i < numitems - 1; ++i )
+			Slot (i) = Slot (i + 1);
+
+	}
+
+	--numitems;
+
+}
+
+template <class T>
+int Deque <T>::FindData ( const T &newdata )
+{
+
+	for ( int i = 0; i < numitems; ++i )
+		if ( Slot (i) == newdata )
+			return i;
+
+	return -1;
+
+}
+
+template <class T>
+int Deque <T>::Size ()
+{
+
+	return numitems;
+
+}
+
+template <class T>
+bool Deque <T>::ValidIndex ( int index )
+{
+
+	return ( index >= 0 && index < numitems );
+
+}
+
+template <class T>
+void Deque <T>::Empty ()
+{
+
+	delete [] data;
+	data = NULL;
+	capacity = 0;
+	start = 0;
+	numitems = 0;
+
+}
+
+template <class T>
+T Deque <T>::operator [] ( int index )
+{
+
+	return GetData (index);
+
+}
+
+#endif
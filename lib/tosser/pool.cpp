@@ -0,0 +1,201 @@
+
+#ifndef _included_tosser_pool
+#define _included_tosser_pool
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include <new>
+
+#include "tosser.h"
+
+// Blocks are big enough for a T or a free list link, and keep malloc's alignment.
+// Each is headed by the Pool it belongs to, so delete can find it, and each slab
+// by a link to the next
+
+#define POOL_ALIGNMENT 16
+#define POOL_OBJECTSIZE ( ( ( sizeof ( T ) > sizeof ( PoolBlock ) ? sizeof ( T ) : sizeof ( PoolBlock ) ) \
+						   + POOL_ALIGNMENT - 1 ) & ~( (size_t) POOL_ALIGNMENT - 1 ) )
+#define POOL_BLOCKSIZE ( POOL_ALIGNMENT + POOL_OBJECTSIZE )
+#define POOL_SLABSIZE ( POOL_ALIGNMENT + POOL_BLOCKSIZE * slabsize )
+
+#define POOL_OWNER(block) ( *(Pool <T> **) ( (char *) (block) - POOL_ALIGNMENT ) )
+
+template <class T>
+thread_local Pool <T> *Pool <T>::arena = NULL;
+
+template <class T>
+void *Pool <T>::Allocate ()
+{
+
+	while ( lock.test_and_set ( std::memory_order_acquire ) )
+		;
+
+	if ( !freelist ) {
+
+		char *slab = (char *) malloc ( POOL_SLABSIZE );
+
+		if ( !slab ) {
+			lock.clear ( std::memory_order_release );
+			return NULL;
+		}
+
+		( (PoolSlab *) slab )->next = slabs;
+		slabs = (PoolSlab *) slab;
+
+		for ( int i = slabsize - 1; i >= 0; --i ) {
+			PoolBlock *block = (PoolBlock *) ( slab + POOL_ALIGNMENT + i * POOL_BLOCKSIZE + POOL_ALIGNMENT );
+			POOL_OWNER ( block ) = this;
+			block->next = freelist;
+			freelist = block;
+		}
+
+		++numslabs;
+
+	}
+
+	PoolBlock *block = freelist;
+	freelist = block->next;
+
+	++numlive;
+	++numallocations;
+
+	lock.clear ( std::memory_order_release );
+
+	return block;
+
+}
+
+template <class T>
+void Pool <T>::Free ( void *block )
+{
+
+	if ( !block ) return;
+
+	while ( lock.test_and_set ( std::memory_order_acquire ) )
+		;
+
+	PoolBlock *freed = (PoolBlock *) block;
+	freed->next = freelist;
+	freelist = freed;
+
+	--numlive;
+	assert ( numlive >= 0 );
+
+	lock.clear ( std::memory_order_release );
+
+}
+
+template <class T>
+bool Pool <T>::Release ()
+{
+
+	while ( lock.test_and_set ( std::memory_order_acquire ) )
+		;
+
+	if ( numlive > 0 ) {
+		lock.clear ( std::memory_order_release );
+		return false;
+	}
+
+	while ( slabs ) {
+		PoolSlab *next = slabs->next;
+		free ( slabs );
+		slabs = next;
+	}
+
+	freelist = NULL;
+	numslabs = 0;
+
+	lock.clear ( std::memory_order_release );
+
+	return true;
+
+}
+
+template <class T>
+Pool <T> *Pool <T>::UseArena ( Pool <T> *newarena )
+{
+
+	Pool <T> *previous = arena;
+	arena = newarena;
+	return previous;
+
+}
+
+#ifndef USE_MMGR
+
+template <class T>
+void *Pool <T>::New ( size_t size )
+{
+
+	if ( size != sizeof ( T ) ) return ::operator new ( size );
+
+	void *block = arena ? arena->Allocate () : Allocate ();
+	if ( !block ) throw std::bad_alloc ();
+	return block;
+
+}
+
+template <class T>
+void Pool <T>::Delete ( void *block, size_t size )
+{
+
+	if ( !block ) return;
+
+	if ( size != sizeof ( T ) ) ::operator delete ( block );
+	else						POOL_OWNER ( block )->Free ( block );
+
+}
+
+#endif
+
+template <class T>
+int Pool <T>::NumLive () const
+{
+
+	return numlive;
+
+}
+
+template <class T>
+int Pool <T>::NumSlabs () const
+{
+
+	return numslabs;
+
+}
+
+template <class T>
+size_t Pool <T>::BytesReserved () const
+{
+
+	return (size_t) numslabs * POOL_SLABSIZE;
+
+}
+
+template <class T>
+unsigned long long Pool <T>::NumAllocations () const
+{
+
+	return numallocations;
+
+}
+
+template <class T>
+void Pool <T>::Print ( FILE *file, const char *name )
+{
+
+	fprintf ( file, "Pool %-12s : %8d live, %10llu allocated in total, %6d KB reserved\n",
+			 name, numlive, numallocations, (int) ( BytesReserved () / 1024 ) );
+
+}
+
+#undef POOL_OWNER
+#undef POOL_SLABSIZE
+#undef POOL_BLOCKSIZE
+#undef POOL_OBJECTSIZE
+#undef POOL_ALIGNMENT
+
+#endif
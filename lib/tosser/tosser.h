@@ -9,7 +9,9 @@
 #ifndef _included_tosser_h
 #define _included_tosser_h
 
+#include <stdio.h>
 #include <iostream>
+#include <atomic>
 using namespace std;
 
 #include "mmgr.h"
@@ -149,8 +151,8 @@ protected :
     BTree *ltree;
     BTree *rtree;
     
-    void RecursiveConvertToDArray ( DArray <T> *darray, BTree <T> *btree );
-    void RecursiveConvertIndexToDArray ( DArray <char *> *darray, BTree <T> *btree );
+    void RecursiveConvertToDArray ( DArray <T> *darray, BTree <T> *btree, int *index );
+    void RecursiveConvertIndexToDArray ( DArray <char *> *darray, BTree <T> *btree, int *index );
     
     void AppendRight ( BTree <T> *tempright );                            // Used by Remove
     
@@ -187,6 +189,151 @@ public :
     
 };
 
+//=================================================================
+// Double ended queue
+// source :: deque.cpp
+// Use : A list with the same interface as LList, held in a ring buffer
+// Any index is fast to read, and either end is fast to add to or remove from
+// Adding or removing in the middle moves the items on the shorter side
+
+template <class T>
+class Deque
+{
+
+protected:
+
+	T *data;
+	int capacity;                          // Always a power of two (or 0)
+	int start;                             // Slot holding index 0
+	int numitems;
+
+	void Grow ();
+	T &Slot ( int index ) const { return data [ ( start + index ) & ( capacity - 1 ) ]; }
+
+public:
+
+	Deque ();
+	~Deque ();
+
+	void PutData        ( const T &newdata );     // Adds in data at the end
+	void PutDataAtEnd   ( const T &newdata );
+	void PutDataAtStart ( const T &newdata );
+	void PutDataAtIndex ( const T &newdata, int index );
+
+	T GetData          ( int index );
+	void RemoveData    ( int index );
+	int  FindData      ( const T &data );         // -1 means 'not found'
+
+	int Size ();
+	bool ValidIndex ( int index );
+
+	void Empty ();
+
+	T operator [] ( int index );
+
+};
+
+//=================================================================
+// Object pool
+// source :: pool.cpp
+// Use : Storage for a class that is created and deleted constantly
+// Put POOL_MEMBERS ( Class ) in the class and POOL_DEFINE ( Class, slabsize ) 
+// in its source file, to give it a static Pool and an operator new / delete using it.
+// Blocks come from slabs and are reused, slabs are kept until Release
+//
+// Any other Pool of the class can be used as an arena - while a PoolArena is
+// in scope, new takes blocks from it instead, and delete gives every block
+// back to the Pool it came from. Release frees an arena's slabs all at once
+
+template <class T>
+class Pool
+{
+
+protected:
+
+	struct PoolBlock { PoolBlock *next; };
+	struct PoolSlab { PoolSlab *next; };
+
+	PoolBlock *freelist;
+	PoolSlab *slabs;
+	int slabsize;                          // Blocks per slab
+
+	std::atomic_flag lock;
+
+	int numslabs;
+	int numlive;
+	unsigned long long numallocations;
+
+	static thread_local Pool *arena;       // Where new takes blocks from on this thread, if set
+
+public:
+
+	// Constant initialised, so pooled objects can be created during other files' static init.
+	// There is no destructor - objects may still be deleted after exit starts, so the
+	// slabs are left for the system to reclaim. Arenas call Release when they are done
+
+	constexpr Pool ( int newslabsize = 256 )
+		: freelist ( NULL ), slabs ( NULL ), slabsize ( newslabsize ), lock ATOMIC_FLAG_INIT,
+		  numslabs ( 0 ), numlive ( 0 ), numallocations ( 0 ) {}
+
+	void *Allocate ();
+	void Free ( void *block );
+	bool Release ();                                 // Frees every slab, if no block is still in use
+
+	static Pool *UseArena ( Pool *newarena );        // Returns the arena it replaces, NULL for none
+
+#ifndef USE_MMGR
+	void *New ( size_t size );                       // For operator new / delete - 
+	void Delete ( void *block, size_t size );        // other sizes (subclasses) use the heap
+#endif
+
+	int NumLive () const;
+	int NumSlabs () const;
+	size_t BytesReserved () const;
+	unsigned long long NumAllocations () const;
+
+	void Print ( FILE *file, const char *name );
+
+};
+
+// Allocations of T come from the arena for as long as this is in scope
+
+template <class T>
+class PoolArena
+{
+
+protected:
+
+	Pool <T> *previous;
+
+public:
+
+	PoolArena ( Pool <T> *arena )	{ previous = Pool <T>::UseArena ( arena ); }
+	~PoolArena ()					{ Pool <T>::UseArena ( previous ); }
+
+};
+
+// Under mmgr the operators are left out, so the tracker still sees every allocation
+
+#ifndef USE_MMGR
+
+#define POOL_MEMBERS(T)                                                            \
+	static Pool <T> pool;                                                          \
+	static void *operator new ( size_t size );                                     \
+	static void operator delete ( void *block, size_t size );
+
+#define POOL_DEFINE(T, slabsize)                                                   \
+	Pool <T> T::pool ( slabsize );                                                 \
+	void *T::operator new ( size_t size ) { return pool.New ( size ); }            \
+	void T::operator delete ( void *block, size_t size ) { pool.Delete ( block, size ); }
+
+#else
+
+#define POOL_MEMBERS(T)             static Pool <T> pool;
+#define POOL_DEFINE(T, slabsize)    Pool <T> T::pool ( slabsize );
+
+#endif
+
 
 
 
@@ -194,7 +341,9 @@ public :
 
 #include "llist.cpp"
 #include "darray.cpp"
+#include "deque.cpp"
 #include "btree.cpp"
+#include "pool.cpp"
 
 #include "nommgr.h"
 
@@ -0,0 +1,369 @@
+
+/*
+
+  Bungle repacking command line application
+  Rewrites a data archive with its files deflated (or stored),
+  and compares the size and load time of the two
+
+  Build with "make bglpack" in uplink/src, or with the redshirt, bungle,
+  mmgr and unrar libraries, zlib and pthreads, eg
+	g++ -I../../lib/bungle -I../../lib/redshirt -I../../lib/tosser -I../../lib/mmgr -I../../contrib
+		bglpack.cpp -L../../lib/bungle -L../../lib/redshirt -L../../lib/mmgr -L../../contrib/unrar
+		-lredshirt -lbungle -lunrar -lmmgr -lz -lpthread
+
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#include <zlib.h>
+
+#include "tosser.h"
+#include "bungle.h"
+#include "redshirt.h"
+
+
+struct PackEntry
+{
+
+	char	*filename;
+	unsigned long crc;
+	int		size;
+
+	int		method;
+	int		compressedsize;
+	unsigned int headeroffset;
+
+};
+
+
+void incorrectusage ( char *filename )
+{
+
+	printf ( "Usage :\n" );
+	printf ( "to Deflate : %s source.dat target.dat\n", filename );
+	printf ( "to Store   : %s -s source.dat target.dat\n", filename );
+	printf ( "\n" );
+	printf ( "Encrypted archives are re-encrypted.  Load times are only cold\n" );
+	printf ( "if the operating system's file cache has been flushed first.\n" );
+	printf ( "\n" );
+
+	exit (1);
+
+}
+
+static double TimeNow ()
+{
+
+	using namespace std::chrono;
+	return duration <double, std::milli> ( steady_clock::now ().time_since_epoch () ).count ();
+
+}
+
+static long FileSize ( char *filename )
+{
+
+	FILE *file = fopen ( filename, "rb" );
+	if ( !file ) return 0;
+
+	fseek ( file, 0, SEEK_END );
+	long size = ftell ( file );
+	fclose ( file );
+
+	return size;
+
+}
+
+static void WriteShort ( FILE *file, unsigned int value )
+{
+
+	fputc ( value & 0xff, file );
+	fputc ( ( value >> 8 ) & 0xff, file );
+
+}
+
+static void WriteInt ( FILE *file, unsigned int value )
+{
+
+	WriteShort ( file, value & 0xffff );
+	WriteShort ( file, ( value >> 16 ) & 0xffff );
+
+}
+
+static bool Deflate ( char *source, int sourcesize, char *target, int *targetsize )
+{
+
+	// Raw deflate stream, as zip entries have no zlib header
+
+	z_stream stream;
+	memset ( &stream, 0, sizeof ( stream ) );
+
+	if ( deflateInit2 ( &stream, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY ) != Z_OK ) 
+		return false;
+
+	stream.next_in = (Bytef *) source;
+	stream.avail_in = (uInt) sourcesize;
+	stream.next_out = (Bytef *) target;
+	stream.avail_out = (uInt) *targetsize;
+
+	bool success = ( deflate ( &stream, Z_FINISH ) == Z_STREAM_END );
+	*targetsize = (int) stream.total_out;
+
+	deflateEnd ( &stream );
+
+	return success;
+
+}
+
+static bool LoadArchive ( char *filename, double *opentime, double *readtime, 
+						  PackEntry **entries, int *numentries )
+{
+
+	//
+	// Opening only maps and indexes the archive -
+	// reading every file is what a full load costs
+	//
+
+	double start = TimeNow ();
+
+	if ( !RsAddArchive ( filename, RsMapArchive ( filename ) ) ) return false;
+
+	*opentime = TimeNow () - start;
+
+	char path [] = "";
+	DArray <char *> *files = BglListFiles ( path );
+
+	PackEntry *loaded = new PackEntry [files->Size () + 1];
+
+	start = TimeNow ();
+
+	for ( int i = 0; i < files->Size (); ++i ) {
+
+		int size = 0;
+		char *data = BglGetFileData ( files->GetData (i), &size );
+
+		loaded [i].filename = new char [strlen ( files->GetData (i) ) + 1];
+		strcpy ( loaded [i].filename, files->GetData (i) );
+		loaded [i].size = data ? size : -1;
+		loaded [i].crc = data ? crc32 ( crc32 ( 0L, Z_NULL, 0 ), (Bytef *) data, (uInt) size ) : 0;
+
+	}
+
+	*readtime = TimeNow () - start;
+
+	*entries = loaded;
+	*numentries = files->Size ();
+
+	delete files;
+
+	return true;
+
+}
+
+static bool WriteArchive ( char *filename, PackEntry *entries, int numentries, bool compress )
+{
+
+	FILE *output = fopen ( filename, "wb" );
+	if ( !output ) return false;
+
+	//
+	// Local headers and data
+	//
+
+	for ( int i = 0; i < numentries; ++i ) {
+
+		PackEntry *entry = &entries [i];
+
+		int size = 0;
+		char *data = BglGetFileData ( entry->filename, &size );
+		if ( !data ) {
+			printf ( "Failed to read %s\n", entry->filename );
+			fclose ( output );
+			return false;
+		}
+
+		// Stored if deflating doesn't help
+
+		char *packed = NULL;
+		entry->method = 0;
+		entry->compressedsize = size;
+
+		if ( compress && size > 0 ) {
+			int packedsize = (int) compressBound ( (uLong) size ) + 64;
+			packed = new char [packedsize];
+			if ( Deflate ( data, size, packed, &packedsize ) && packedsize < size ) {
+				entry->method = 8;
+				entry->compressedsize = packedsize;
+			}
+		}
+
+		size_t filenamelength = strlen ( entry->filename );
+		entry->headeroffset = (unsigned int) ftell ( output );
+
+		WriteInt ( output, 0x04034b50 );
+		WriteShort ( output, 20 );								// Version needed
+		WriteShort ( output, 0 );								// Flags
+		WriteShort ( output, entry->method );
+		WriteShort ( output, 0 );								// Time
+		WriteShort ( output, 0x21 );							// Date - 1st January 1980
+		WriteInt ( output, (unsigned int) entry->crc );
+		WriteInt ( output, entry->compressedsize );
+		WriteInt ( output, size );
+		WriteShort ( output, (unsigned int) filenamelength );
+		WriteShort ( output, 0 );								// Extra field
+		fwrite ( entry->filename, filenamelength, 1, output );
+		fwrite ( entry->method == 8 ? packed : data, entry->compressedsize, 1, output );
+
+		if ( packed ) delete [] packed;
+
+	}
+
+	//
+	// Central directory
+	//
+
+	unsigned int cdoffset = (unsigned int) ftell ( output );
+
+	for ( int i = 0; i < numentries; ++i ) {
+
+		PackEntry *entry = &entries [i];
+		size_t filenamelength = strlen ( entry->filename );
+
+		WriteInt ( output, 0x02014b50 );
+		WriteShort ( output, 20 );								// Version made by
+		WriteShort ( output, 20 );								// Version needed
+		WriteShort ( output, 0 );
+		WriteShort ( output, entry->method );
+		WriteShort ( output, 0 );
+		WriteShort ( output, 0x21 );
+		WriteInt ( output, (unsigned int) entry->crc );
+		WriteInt ( output, entry->compressedsize );
+		WriteInt ( output, entry->size );
+		WriteShort ( output, (unsigned int) filenamelength );
+		WriteShort ( output, 0 );								// Extra field
+		WriteShort ( output, 0 );								// Comment
+		WriteShort ( output, 0 );								// Disk number
+		WriteShort ( output, 0 );								// Internal attributes
+		WriteInt ( output, 0 );									// External attributes
+		WriteInt ( output, entry->headeroffset );
+		fwrite ( entry->filename, filenamelength, 1, output );
+
+	}
+
+	unsigned int cdsize = (unsigned int) ftell ( output ) - cdoffset;
+
+	WriteInt ( output, 0x06054b50 );
+	WriteShort ( output, 0 );
+	WriteShort ( output, 0 );
+	WriteShort ( output, numentries );
+	WriteShort ( output, numentries );
+	WriteInt ( output, cdsize );
+	WriteInt ( output, cdoffset );
+	WriteShort ( output, 0 );
+
+	bool success = ( ferror ( output ) == 0 );
+	fclose ( output );
+
+	return success;
+
+}
+
+static void FreeEntries ( PackEntry *entries, int numentries )
+{
+
+	for ( int i = 0; i < numentries; ++i )
+		delete [] entries [i].filename;
+
+	delete [] entries;
+
+}
+
+int main ( int argc, char *argv [] )
+{
+
+	//
+	// Introduction
+	//
+
+	printf ( "Bungle repacking utility\n" );
+
+	char *appname = ( argc > 0 ) ? argv [0] : (char *) "bglpack";
+
+	bool compress = true;
+	int firstarg = 1;
+
+	if ( argc > 1 && strcmp ( argv [1], "-s" ) == 0 ) {
+		compress = false;
+		firstarg = 2;
+	}
+
+	if ( argc != firstarg + 2 ) incorrectusage ( appname );
+
+	char *source = argv [firstarg];
+	char *target = argv [firstarg + 1];
+
+	if ( strcmp ( source, target ) == 0 ) incorrectusage ( appname );
+
+	//
+	// Load the source and write it out again
+	//
+
+	PackEntry *entries = NULL;
+	int numentries = 0;
+	double sourceopen, sourceread;
+
+	if ( !LoadArchive ( source, &sourceopen, &sourceread, &entries, &numentries ) ) return 1;
+
+	printf ( "Repacking %d files into %s ... ", numentries, target );
+
+	if ( !WriteArchive ( target, entries, numentries, compress ) ||
+		 ( RsFileEncryptedNoVerify ( source ) && !RsEncryptFile ( target ) ) ) {
+		printf ( "failed\n" );
+		remove ( target );
+		return 1;
+	}
+
+	printf ( "done\n" );
+
+	RsCloseArchive ( source );
+
+	//
+	// Load the result back, checking every file survived
+	//
+
+	PackEntry *packed = NULL;
+	int numpacked = 0;
+	double targetopen, targetread;
+
+	if ( !LoadArchive ( target, &targetopen, &targetread, &packed, &numpacked ) ) return 1;
+
+	int mismatches = ( numpacked == numentries ) ? 0 : abs ( numpacked - numentries );
+
+	for ( int i = 0; i < numentries && i < numpacked; ++i )
+		if ( packed [i].size != entries [i].size || packed [i].crc != entries [i].crc ||
+			 strcmp ( packed [i].filename, entries [i].filename ) != 0 )
+			++mismatches;
+
+	RsCloseArchive ( target );
+
+	//
+	// Report
+	//
+
+	printf ( "\n" );
+	printf ( "%-40s %12s %10s %10s\n", "Archive", "Disk bytes", "Open ms", "Read ms" );
+	printf ( "%-40s %12ld %10.2f %10.2f\n", source, FileSize ( source ), sourceopen, sourceread );
+	printf ( "%-40s %12ld %10.2f %10.2f\n", target, FileSize ( target ), targetopen, targetread );
+	printf ( "\n" );
+
+	if ( mismatches > 0 ) printf ( "%d files differ after repacking\n", mismatches );
+
+	FreeEntries ( entries, numentries );
+	FreeEntries ( packed, numpacked );
+
+	return mismatches > 0 ? 1 : 0;
+
+}
@@ -0,0 +1,139 @@
+
+/*
+
+  HD UI layout compiler command line application
+  Compiles layout and texture atlas XML into the binary files the HD UI
+  maps at load time, written next to each XML file (.hdl and .hda)
+
+  Atlases are compiled first, so Image elements in the layouts can be
+  resolved to atlas indices rather than looked up by name at load time, eg
+	hdlayoutc -a graphics/uplinkHD_atlas_00.xml layouts/MainMenu/MainMenu.xml ...
+  An atlas already compiled can be given instead of its XML, and is read
+  rather than written, eg
+	hdlayoutc -a graphics/uplinkHD_atlas_00.hda layouts/MainMenu/MainMenu.xml
+
+  "make layouts" in uplink/src builds this and compiles the atlases and
+  layouts in uplink/mod/uplinkHD, and is part of "make". To build it by
+  hand, with tinyxml2, eg
+	g++ -I../../uplink/src/hd_ui hdlayoutc.cpp ../../uplink/src/hd_ui/hd_layout_binary.cpp -ltinyxml2
+
+  */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <tinyxml2.h>
+
+#include "hd_layout_binary.h"
+
+using namespace HDUI;
+
+
+static bool WriteFile ( const std::string &path, const std::vector <char> &bytes )
+{
+
+	FILE *file = fopen ( path.c_str (), "wb" );
+	if ( !file ) {
+		printf ( "Failed to open %s for writing\n", path.c_str () );
+		return false;
+	}
+
+	bool ok = fwrite ( bytes.data (), 1, bytes.size (), file ) == bytes.size ();
+	ok = ( fclose ( file ) == 0 ) && ok;
+
+	if ( !ok ) printf ( "Failed to write %s\n", path.c_str () );
+	return ok;
+
+}
+
+static bool IsCompiledAtlas ( const char *path )
+{
+
+	size_t length = strlen ( path );
+	size_t extlength = strlen ( ATLAS_BINARY_EXT );
+	return length > extlength && strcmp ( path + length - extlength, ATLAS_BINARY_EXT ) == 0;
+
+}
+
+static bool Compile ( const char *xmlpath, bool isatlas, const std::vector <const BinaryImage *> &atlases,
+					  std::vector <char> &bytes )
+{
+
+	tinyxml2::XMLDocument doc;
+	if ( doc.LoadFile ( xmlpath ) != tinyxml2::XML_SUCCESS ) {
+		printf ( "Failed to load %s\n", xmlpath );
+		return false;
+	}
+
+	bool ok = isatlas ? CompileAtlas ( doc, bytes ) : CompileLayout ( doc, atlases, bytes );
+	if ( !ok || !StampSource ( bytes, xmlpath ) ) {
+		printf ( "Failed to compile %s\n", xmlpath );
+		return false;
+	}
+
+	std::string outpath = CompiledPath ( xmlpath, isatlas ? ATLAS_BINARY_EXT : LAYOUT_BINARY_EXT );
+	if ( !WriteFile ( outpath, bytes ) ) return false;
+
+	printf ( "%s -> %s (%d bytes)\n", xmlpath, outpath.c_str (), (int) bytes.size () );
+	return true;
+
+}
+
+int main ( int argc, char **argv )
+{
+
+	if ( argc < 2 ) {
+		printf ( "Usage: hdlayoutc [-a atlas.xml|atlas" ATLAS_BINARY_EXT "]... layout.xml...\n" );
+		return 1;
+	}
+
+	std::vector <std::unique_ptr <BinaryImage> > atlasimages;
+	std::vector <const BinaryImage *> atlases;
+	int failed = 0;
+	int compiled = 0;
+
+	for ( int i = 1; i < argc; ++i ) {
+
+		bool isatlas = strcmp ( argv[i], "-a" ) == 0;
+		if ( isatlas && ++i >= argc ) {
+			printf ( "-a needs an atlas file\n" );
+			return 1;
+		}
+
+		if ( isatlas && IsCompiledAtlas ( argv[i] ) ) {
+			BinaryImage *image = new BinaryImage ();
+			if ( !image->Map ( argv[i] ) || !image->IsAtlas () ) {
+				printf ( "Failed to read compiled atlas %s\n", argv[i] );
+				delete image;
+				++failed;
+				continue;
+			}
+			atlasimages.push_back ( std::unique_ptr <BinaryImage> ( image ) );
+			atlases.push_back ( image );
+			continue;
+		}
+
+		std::vector <char> bytes;
+		if ( !Compile ( argv[i], isatlas, atlases, bytes ) ) {
+			++failed;
+			continue;
+		}
+		++compiled;
+
+		if ( isatlas ) {
+			BinaryImage *image = new BinaryImage ();
+			image->Adopt ( bytes );
+			atlasimages.push_back ( std::unique_ptr <BinaryImage> ( image ) );
+			atlases.push_back ( image );
+		}
+
+	}
+
+	printf ( "Compiled %d files, %d failed\n", compiled, failed );
+	return failed ? 1 : 0;
+
+}
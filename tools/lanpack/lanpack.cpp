@@ -0,0 +1,164 @@
+
+/*
+
+  LAN template packing command line application
+  Compiles the LAN text files in data/lans/ into binary templates (.lan)
+  written next to each text file, stamped with the text file's time and size
+  so LoadLAN can spot a template left behind by an edit. Checks each template
+  reads back the same as the text it came from, and compares the time to
+  compile the text against validating the template.
+  tests/lantemplate_test checks the LANs built from both forms match
+
+  "make lans" in uplink/src builds this and packs the LANs in the data
+  directories, and is part of "make". To build it by hand, eg
+	g++ -I../../uplink/src -I../../lib/tosser -I../../lib/mmgr
+		lanpack.cpp ../../uplink/src/world/generator/lantemplate.cpp
+
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#include "world/generator/lantemplate.h"
+
+
+#define TIMINGRUNS 1000
+
+
+static char *ReadFile ( char *filename, int *size )
+{
+
+	FILE *file = fopen ( filename, "rb" );
+	if ( !file ) return NULL;
+
+	fseek ( file, 0, SEEK_END );
+	*size = (int) ftell ( file );
+	fseek ( file, 0, SEEK_SET );
+
+	char *data = new char [*size + 1];
+	bool success = fread ( data, 1, *size, file ) == (size_t) *size;
+	fclose ( file );
+
+	if ( !success ) {
+		delete [] data;
+		return NULL;
+	}
+
+	return data;
+
+}
+
+static bool WriteFile ( char *filename, char *data, int size )
+{
+
+	FILE *file = fopen ( filename, "wb" );
+	if ( !file ) return false;
+
+	bool success = fwrite ( data, 1, size, file ) == (size_t) size;
+	success = ( fclose ( file ) == 0 ) && success;
+	return success;
+
+}
+
+static double Microseconds ( std::chrono::steady_clock::time_point start )
+{
+
+	std::chrono::duration <double, std::micro> elapsed = std::chrono::steady_clock::now () - start;
+	return elapsed.count () / TIMINGRUNS;
+
+}
+
+static bool PackLAN ( char *filename )
+{
+
+	int textsize = 0;
+	char *text = ReadFile ( filename, &textsize );
+	if ( !text ) {
+		printf ( "Failed to read %s\n", filename );
+		return false;
+	}
+
+	int size = 0;
+	char *compiled = LanTemplate::Compile ( text, textsize, &size );
+	if ( !compiled ) {
+		printf ( "Failed to compile %s\n", filename );
+		delete [] text;
+		return false;
+	}
+
+	char templatename [256];
+	LanTemplate::TemplateFilename ( filename, templatename, sizeof(templatename) );
+
+	if ( !LanTemplate::Stamp ( compiled, filename ) ) {
+		printf ( "Failed to stamp %s\n", templatename );
+		delete [] compiled;
+		delete [] text;
+		return false;
+	}
+
+	if ( !WriteFile ( templatename, compiled, size ) ) {
+		printf ( "Failed to write %s\n", templatename );
+		delete [] compiled;
+		delete [] text;
+		return false;
+	}
+
+	//
+	// Read the template back
+
+	int readsize = 0;
+	char *readback = ReadFile ( templatename, &readsize );
+	bool identical = readback && readsize == size && memcmp ( readback, compiled, size ) == 0 &&
+					 LanTemplate::IsValid ( readback, readsize );
+
+	LanTemplateHeader *header = (LanTemplateHeader *) compiled;
+	printf ( "%s -> %s : %d systems, %d links, %d subnets, %d data, %d -> %d bytes, %s\n",
+			 filename, templatename, header->numsystems, header->numlinks, header->numsubnets, header->numdata,
+			 textsize, size, identical ? "identical" : "MISMATCH" );
+
+	//
+	// Time both load paths from memory
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now ();
+	for ( int i = 0; i < TIMINGRUNS; ++i ) {
+		int ignored = 0;
+		delete [] LanTemplate::Compile ( text, textsize, &ignored );
+	}
+	double textus = Microseconds ( start );
+
+	start = std::chrono::steady_clock::now ();
+	int valid = 0;
+	for ( int i = 0; i < TIMINGRUNS; ++i )
+		valid += LanTemplate::IsValid ( readback, readsize ) ? 1 : 0;
+	double binaryus = Microseconds ( start );
+
+	printf ( "    text %.2fus, template %.2fus\n", textus, binaryus );
+
+	delete [] readback;
+	delete [] compiled;
+	delete [] text;
+
+	return identical && valid == TIMINGRUNS;
+
+}
+
+int main ( int argc, char **argv )
+{
+
+	if ( argc < 2 ) {
+		printf ( "Usage: lanpack lanfile.txt...\n" );
+		return 1;
+	}
+
+	int failed = 0;
+
+	for ( int i = 1; i < argc; ++i )
+		if ( !PackLAN ( argv [i] ) ) ++failed;
+
+	printf ( "Packed %d LANs, %d failed\n", argc - 1 - failed, failed );
+	return failed ? 1 : 0;
+
+}
@@ -20,6 +20,7 @@
 #include "redshirt.h"
 #include "soundgarden.h"
 #include "vanbakel.h"
+#include "mmalloc.h"
 
 #include "app/app.h"
 #include "app/globals.h"
@@ -36,6 +37,10 @@
 
 #include "world/world.h"
 #include "world/player.h"
+#include "world/message.h"
+#include "world/computer/databank.h"
+#include "world/computer/logbank.h"
+#include "world/computer/recordbank.h"
 #include "world/generator/worldgenerator.h"
 
 #include "interface/interface.h"
@@ -281,8 +286,8 @@ void App::LoadGame ( char *username )
 		printf ( "failed\n" );
 		printf ( "App::LoadGame, Failed to load user profile\n" );
 
-		EclReset ( GetOptions ()->GetOptionValue ("graphics_screenwidth"),
-		           GetOptions ()->GetOptionValue ("graphics_screenheight") );
+		EclReset ( GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+		           GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
 		GetMainMenu ()->RunScreen ( MAINMENU_LOGIN );
 
 		return;
@@ -323,8 +328,8 @@ void App::LoadGame ( char *username )
 			game->GetWorld ()->GetPlayer ()->GetConnection ()->Connect ();
 
             game->GetInterface ()->GetLocalInterface ()->Remove ();
-            EclReset ( app->GetOptions ()->GetOptionValue ("graphics_screenwidth"),
-				       app->GetOptions ()->GetOptionValue ("graphics_screenheight") );
+            EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+				       app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
 			game->GetInterface ()->GetRemoteInterface ()->RunNewLocation ();
 			game->GetInterface ()->GetRemoteInterface ()->RunScreen ( 10 );
 
@@ -342,8 +347,8 @@ void App::LoadGame ( char *username )
 	else {											// This is a Game Over game
 
 		game->SetGameSpeed ( GAMESPEED_PAUSED );
-        EclReset ( app->GetOptions ()->GetOptionValue ("graphics_screenwidth"),
-				   app->GetOptions ()->GetOptionValue ("graphics_screenheight") );
+        EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+				   app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
 		mainmenu->RunScreen ( MAINMENU_OBITUARY );
 
 	}
@@ -501,8 +506,10 @@ void App::Close ()
 
     closed = true;
 
-    EclReset ( app->GetOptions ()->GetOptionValue ("graphics_screenwidth"),
-			   app->GetOptions ()->GetOptionValue ("graphics_screenheight") );
+	if ( MmGetSampling () > 0 ) DumpHeapProfile ();
+
+    EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+			   app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
 
 	if ( game ) game->ExitGame ();
 
@@ -544,6 +551,32 @@ void App::Close ()
 
 }
 
+void App::DumpHeapProfile ()
+{
+
+	char filename [256];
+	UplinkSnprintf ( filename, sizeof ( filename ), "%sheapprofile.log", app->userpath );
+
+	if ( !MmDumpHeapProfile ( filename ) ) return;
+
+	// The object pools go after the allocator's own figures
+
+	FILE *file = fopen ( filename, "at" );
+
+	if ( file ) {
+
+		AccessLog::pool.Print ( file, "AccessLog" );
+		Data::pool.Print ( file, "Data" );
+		Record::pool.Print ( file, "Record" );
+		Message::pool.Print ( file, "Message" );
+		fclose ( file );
+
+	}
+
+	printf ( "Written heap profile to %s\n", filename );
+
+}
+
 bool App::Closed ()
 {
 
@@ -609,8 +642,8 @@ void App::Update ()
 		app->SaveGame ( game->GetWorld ()->GetPlayer ()->handle );				
 		game->SetGameSpeed ( GAMESPEED_PAUSED );
 
-        EclReset ( app->GetOptions ()->GetOptionValue ("graphics_screenwidth"),
-				   app->GetOptions ()->GetOptionValue ("graphics_screenheight") );
+        EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+				   app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
 
 		if ( game->GetWorld ()->GetPlayer ()->gateway.nuked )
 			mainmenu->RunScreen ( MAINMENU_CONNECTIONLOST );
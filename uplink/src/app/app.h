@@ -84,6 +84,7 @@ public:
 	void UnRegisterPhoneDialler ( PhoneDialler *phoneDiallerScreen );
 
     static void CoreDump ();             
+	void DumpHeapProfile ();				// Live sampled allocations, to heapprofile.log
 
 	// Common functions
 
@@ -424,9 +424,13 @@ DArray <char *> *ListSubdirs ( char *directory )
 
 }
 
+static int colourLookups = 0;
+
 void SetColour ( char *colourName )
 {
 
+    ++colourLookups;
+
     if ( !app || 
          !app->GetOptions () || 
          !app->GetOptions()->GetColour( colourName ) ) {
@@ -443,6 +447,23 @@ void SetColour ( char *colourName )
 
 }
 
+void SetColour ( int colourHandle )
+{
+
+    ColourOption *col = app->GetOptions ()->GetColour ( colourHandle );
+    glColor3f ( col->r, col->g, col->b );
+
+}
+
+int TakeColourLookups ()
+{
+
+    int result = colourLookups;
+    colourLookups = 0;
+    return result;
+
+}
+
 
 unsigned *getRetAddress(unsigned *mBP)
 {
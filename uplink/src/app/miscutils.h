@@ -26,7 +26,9 @@ bool RemoveFile             ( const char *filename );
 DArray <char *> *ListDirectory  ( char *directory, char *filter );
 DArray <char *> *ListSubdirs ( char *directory );
 
-void SetColour              ( char *colourName );                    // calls glColour3f
+void SetColour              ( char *colourName );                    // calls glColour3f - looks the name up
+void SetColour              ( int colourHandle );                    // No lookup - use in anything run every frame
+int  TakeColourLookups      ();                                      // Named SetColour calls since the last take
 
 void PrintStackTrace();
 
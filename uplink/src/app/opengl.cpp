@@ -17,6 +17,7 @@
 #include "vanbakel.h"
 #include "gucci.h"
 #include "soundgarden.h"
+#include "mmalloc.h"
 
 #include "options/options.h"
 
@@ -29,6 +30,7 @@
 #include "mainmenu/mainmenu.h"
 #include "mainmenu/mainmenuscreen.h"
 #include "hd_ui/hd_screens.h"
+#include "hd_ui/hd_allegro5.h"
 
 #include "view/view.h"
 
@@ -63,11 +65,31 @@ local void passivemouse(int,int);
 local void resize(int, int);
 local void drawcube(int, int, int);
 local void idle(void);
+local void buttonanimations_changed ( Option *option );
+local void fasterbuttonanimations_changed ( Option *option );
 
 local int lastidleupdate = 0;
 local int mouseX = 0;
 local int mouseY = 0;
 
+// Frame pacing and frame statistics - see display () and idle ()
+
+#define DISPLAY_MAXFRAMEINTERVAL 100			// Frame length when nothing is moving on screen (ms)
+
+#define FRAMESTATS_WIDTH  420
+#define FRAMESTATS_HEIGHT 30
+
+local struct {
+	float frametime;							// ms spent in the last drawn frame
+	int framesdrawn;
+	int drawcalls;								// HD UI primitives in the last drawn frame
+	float animtime;								// ms spent in each phase of the last idle update
+	float soundtime;
+	float worldtime;
+	float sleeptime;
+	int colourlookups;							// Named SetColour calls in the last drawn frame
+} framestats = { 0.0f, 0, 0, 0.0f, 0.0f, 0.0f, 0.0f, 0 };
+
 // ============================================================================
 
 
@@ -78,8 +100,8 @@ void opengl_initialise (int argc, char **argv)
 	if ( app->GetOptions ()->IsOptionEqualTo ( "game_debugstart", 1 ) )
 		debugging = true;
 
-	int screenWidth = app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" );
-	int screenHeight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenWidth = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+	int screenHeight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	bool runFullScreen = app->GetOptions ()->IsOptionEqualTo ( "graphics_fullscreen", 1 ) &&
 						!app->GetOptions ()->IsOptionEqualTo ( "graphics_safemode", 1 );
 	int screenDepth = app->GetOptions ()->GetOptionValue ( "graphics_screendepth" );
@@ -197,6 +219,22 @@ bool opengl_setSoftwareRendering ( bool softwareRendering )
 
 #endif
 
+local void buttonanimations_changed ( Option *option )
+{
+
+	if ( option && option->value == 0 )	EclDisableAnimations ();
+	else								EclEnableAnimations ();
+
+}
+
+local void fasterbuttonanimations_changed ( Option *option )
+{
+
+	if ( option && option->value != 0 )	EclEnableFasterAnimations ();
+	else								EclDisableFasterAnimations ();
+
+}
+
 local void init(void)
 {
 
@@ -216,8 +254,8 @@ local void init(void)
 	// ====================================================================== 
 	// Fix for Riva TNT cards (these don't automatically clear the background
 	// UPDATE : Should now 	be covered by the GLUT_NORMAL_DAMAGED code in display()
-	// int screenwidth = app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" );
-	// int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	// int screenwidth = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+	// int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	// clear_draw ( 0, 0, screenwidth, screenheight );
 	// ======================================================================
 
@@ -260,25 +298,44 @@ local void init(void)
 	glHint ( GL_LINE_SMOOTH_HINT,	 GL_NICEST );
 	glHint ( GL_POINT_SMOOTH_HINT,	 GL_NICEST );
 
-    EclReset ( app->GetOptions ()->GetOptionValue ("graphics_screenwidth"),
-			   app->GetOptions ()->GetOptionValue ("graphics_screenheight") );
+    EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+			   app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
 	EclRegisterClearDrawFunction      ( clear_draw );
 	EclRegisterDefaultButtonCallbacks ( button_draw, NULL, button_click, button_highlight );
 	EclRegisterSuperHighlightFunction ( 3, superhighlight_draw );
 
-	if ( app->GetOptions ()->GetOption ("graphics_buttonanimations") &&
-		 app->GetOptions ()->GetOption ("graphics_buttonanimations")->value == 0 ) {
+	buttonanimations_changed ( app->GetOptions ()->GetOption ("graphics_buttonanimations") );
+	fasterbuttonanimations_changed ( app->GetOptions ()->GetOption ("graphics_fasterbuttonanimations") );
 
-		EclDisableAnimations ();
+	app->GetOptions ()->AddOptionListener ( "graphics_buttonanimations", buttonanimations_changed );
+	app->GetOptions ()->AddOptionListener ( "graphics_fasterbuttonanimations", fasterbuttonanimations_changed );
 
-	}
+}
 
-	if ( app->GetOptions ()->GetOption ("graphics_fasterbuttonanimations") &&
-		 app->GetOptions ()->GetOption ("graphics_fasterbuttonanimations")->value != 0 ) {
+local void framestats_draw ( int x, int y )
+{
 
-		EclEnableFasterAnimations ();
+	char stats [128];
+	UplinkSnprintf ( stats, sizeof ( stats ), "%.1fms  drawn %d  calls %d  colours %d",
+					 framestats.frametime, framestats.framesdrawn,
+					 framestats.drawcalls, framestats.colourlookups );
+
+	char phases [128];
+	UplinkSnprintf ( phases, sizeof ( phases ), "anims %.1f  sound %.1f  world %.1f  draw %.1f  sleep %.1f",
+					 framestats.animtime, framestats.soundtime, framestats.worldtime,
+					 framestats.frametime, framestats.sleeptime );
+
+	glColor4f ( 0.0f, 0.0f, 0.0f, 1.0f );
+	glBegin ( GL_QUADS );
+		glVertex2i ( x, y );
+		glVertex2i ( x + FRAMESTATS_WIDTH, y );
+		glVertex2i ( x + FRAMESTATS_WIDTH, y + FRAMESTATS_HEIGHT );
+		glVertex2i ( x, y + FRAMESTATS_HEIGHT );
+	glEnd ();
 
-	}
+	glColor4f ( 1.0f, 1.0f, 1.0f, 1.0f );
+	GciDrawText ( x + 4, y + 11, stats );
+	GciDrawText ( x + 4, y + 25, phases );
 
 }
 
@@ -289,51 +346,14 @@ void display(void)
 
 	if ( !GciAppVisible () ) return;
 
-	/*
-
-	// 
-	// If the display was damaged (eg by other window activity)
-	// Then we need to blank and both buffers now
-	//
-
-	static bool firsttime = true;
-	if (firsttime) {
-		firsttime = false;
-		EclDirtyRectangle ( 0, 0, app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" ), 
-								  app->GetOptions ()->GetOptionValue ( "graphics_screenheight" ) );
-	}
-
-	if (GciLayerDamaged())
-		EclDirtyRectangle ( 0, 0, app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" ), 
-								  app->GetOptions ()->GetOptionValue ( "graphics_screenheight" ) );
-
-	//
-	// If safe mode redraw EVERYTHING
-	//
-
-	int numFlips = 2;
-	if ( //numFlips == 1 ||
-		app->GetOptions ()->IsOptionEqualTo ( "graphics_safemode", 1 ) ) {
-		EclDirtyRectangle ( 0, 0, app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" ), 
-								  app->GetOptions ()->GetOptionValue ( "graphics_screenheight" ) );
-	}
-
-	//
-	// Draw the world into both buffers
-	//
-
-
-	for ( int i = 0; i < numFlips; ++i ) {
+	int screenwidth  = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
+	bool showstats = app->GetOptions ()->IsOptionEqualTo ( OPTION_SHOWFRAMESTATS, 1 );
 
-	*/
+	int starttime = (int) EclGetAccurateTime ();
 
 		//  Draw the Eclipse buttons
 
-		////For speed testing
-		//static int counter = 0;
-		//int inter1, inter2;
-		//inter1 = (int) ( EclGetAccurateTime () * 100 );
-
 		glPushMatrix ();
 		glLoadIdentity ();
 		glMatrixMode ( GL_PROJECTION );
@@ -341,14 +361,14 @@ void display(void)
 		glLoadIdentity ();
 		glPushAttrib ( GL_ALL_ATTRIB_BITS );
         
-		glOrtho ( 0.0, app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" ), 
-					   app->GetOptions ()->GetOptionValue ( "graphics_screenheight" ), 0.0, -1.0, 1.0 );
+		glOrtho ( 0.0, screenwidth, screenheight, 0.0, -1.0, 1.0 );
 
 		glTranslatef ( 0.375f, 0.375f, 0.0f );
 
+		HDUI::Allegro5System::ResetDrawCalls ();
+
 		// Added by Franois for testing new display
-		EclClearRectangle ( 0, 0, app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" ), 
-								  app->GetOptions ()->GetOptionValue ( "graphics_screenheight" ) );
+		EclClearRectangle ( 0, 0, screenwidth, screenheight );
         
                 // DEBUG: Test rectangle
                 glColor4f(0.0f, 0.0f, 1.0f, 1.0f);
@@ -361,38 +381,28 @@ void display(void)
 		// EclDrawAllButtons (); // Replaced by HD UI
                 HDUI::HDUIManager::GetInstance().Draw();
 
+		framestats.drawcalls = HDUI::Allegro5System::GetDrawCalls ();
+		framestats.colourlookups = TakeColourLookups ();
+
+		if ( showstats ) framestats_draw ( 0, 0 );
+
 		glPopAttrib ();
 		glPopMatrix ();
 		glMatrixMode ( GL_MODELVIEW );
 		glPopMatrix ();
 
-		//  Swap the buffers, do it all again to the new back-buffer
+		//  Swap the buffers - the one present per frame
+		//  (No glFinish here - the swap already waits on the GPU where it needs to)
 		GciSwapBuffers();
-	/*
-	}
-	*/
-	glFinish();
-
-	////For speed testing
-	//inter2 = (int) ( EclGetAccurateTime () * 100 );
-	//counter++;
-	////if ( counter % 5 == 0 ) {
-	//	FILE *debugfile = fopen("c:/uplink_time.txt", "a");
-	//	if ( debugfile ) {
-	//		fprintf(debugfile, "Total Draw: %d\n", inter2 - inter1);
-	//		fclose(debugfile);
-	//	}
-	////}
-
-	/*
 
 	//
-	// Finished drawing to the two buffers - clear all dirty areas
+	// Finished drawing - clear all dirty areas, which idle () checks to see if anything is changing
 	//
 
 	EclDirtyClear ();
 
-	*/
+	framestats.frametime = (float) ( (int) EclGetAccurateTime () - starttime );
+	++framestats.framesdrawn;
 
 }
 
@@ -499,6 +509,25 @@ void specialkeyboard (int key, int x, int y)
 
 			break;
 
+#ifdef CHEATMODES_ENABLED
+	#if !defined(USE_MMGR) && !defined(USE_SYSTEM_ALLOCATOR)		// Only the pooled allocator samples
+
+		case GCI_KEY_F11:							// Heap profile
+
+			if ( MmGetSampling () > 0 ) {
+				app->DumpHeapProfile ();
+				MmSetSampling ( 0 );
+			}
+			else {
+				int rate = app->GetOptions ()->GetOptionValue ( "game_heapsample" );
+				MmSetSampling ( rate > 0 ? rate : 1024 );
+			}
+
+			break;
+
+	#endif
+#endif
+
 
 #ifndef DEMOGAME
 
@@ -520,40 +549,49 @@ void idle ()
 
     if ( app->Closed () ) return;
 
-	int timesincelastupdate = (int) ( EclGetAccurateTime () - lastidleupdate );
+	//
+	// Update everything, timing each phase for the frame stats overlay
+	//
 
-#ifdef WIN32
-	if ( timesincelastupdate < 16 )
-		Sleep( 16 - timesincelastupdate ); // Play nice with other apps. May cause issues on some systems.
-#endif
+	double phasestart = EclGetAccurateTime ();
+	EclUpdateAllAnimations ();
+	double phaseanims = EclGetAccurateTime ();
+    SgUpdate ();
+	double phasesound = EclGetAccurateTime ();
+	app->Update ();
+	IRCInterface::ProcessMessages ();
+	double phaseworld = EclGetAccurateTime ();
 
-	//int EclAnimationsRunning();
+	framestats.animtime = (float) ( phaseanims - phasestart );
+	framestats.soundtime = (float) ( phasesound - phaseanims );
+	framestats.worldtime = (float) ( phaseworld - phasesound );
 
-	////For speed testing
-	//static int counter = 0;
-	//int inter1, inter2, inter3, inter4;
+	if ( app->Closed () ) return;
 
-	//inter1 = (int) ( EclGetAccurateTime () * 100 );
-	EclUpdateAllAnimations ();		
-	//inter2 = (int) ( EclGetAccurateTime () * 100 );
-    SgUpdate ();
-	//inter3 = (int) ( EclGetAccurateTime () * 100 );
-	app->Update ();
-	//inter4 = (int) ( EclGetAccurateTime () * 100 );
+	//
+	// Sleep until the next frame is due, waking early on input.
+	// With nothing moving on screen there is no need to run at the full rate
+	//
 
-	//counter++;
-	//if ( counter % 5 == 0 ) {
-	//	FILE *debugfile = fopen("c:/uplink_time.txt", "a");
-	//	if ( debugfile ) {
-	//		fprintf(debugfile, "Total update: %d, %d, %d, %d\n", inter4 - inter1, inter2 - inter1, inter3 - inter2, inter4 - inter3);
-	//		fclose(debugfile);
-	//	}
-	//}
+	int framerate = app->GetOptions ()->GetOptionValue ( OPTION_FRAMERATE );
 
-	lastidleupdate = (int) EclGetAccurateTime ();
+	if ( framerate > 0 ) {
+
+		int framelength = 1000 / framerate;
+		bool busy = EclAnimationsRunning () || EclIsDamaged () || ( game && game->IsRunning () );
+		if ( !busy && framelength < DISPLAY_MAXFRAMEINTERVAL )
+			framelength = DISPLAY_MAXFRAMEINTERVAL;
+
+		int timetonextframe = lastidleupdate + framelength - (int) phaseworld;
+		if ( timetonextframe > framelength ) timetonextframe = framelength;		// Clock went backwards
 
-	//if (EclAnimationsRunning()) 
-	//	GciPostRedisplay ();
+		if ( timetonextframe > 0 ) 
+			GciWaitForEvent ( timetonextframe );
+
+	}
+
+	lastidleupdate = (int) EclGetAccurateTime ();
+	framestats.sleeptime = (float) ( lastidleupdate - phaseworld );
 
 }
 
@@ -639,7 +677,7 @@ void passivemouse ( int x, int y )
 	mouseX = x;
 	mouseY = y;
 
-    bool showSWMouse = app->GetOptions ()->IsOptionEqualTo ( "graphics_softwaremouse", 1 );
+    bool showSWMouse = app->GetOptions ()->IsOptionEqualTo ( OPTION_SOFTWAREMOUSE, 1 );
 
 	if ( showSWMouse ) {
 
@@ -656,6 +694,7 @@ void passivemouse ( int x, int y )
 		EclDirtyRectangle ( mouse->x, mouse->y, mouse->width, mouse->height );
 		EclGetButton ( "mouse" )->x = x + 1;
 		EclGetButton ( "mouse" )->y = y + 1;
+		EclUpdateButtonIndex ( mouse );
 		EclDirtyRectangle ( mouse->x, mouse->y, mouse->width, mouse->height );
 
 	}
@@ -692,7 +731,7 @@ void mousemove(int x, int y)
     if ( ScrollBox::IsGrabInProgress() ) ScrollBox::UpdateGrabScroll();
 
 
-    bool showSWMouse = app->GetOptions ()->IsOptionEqualTo ( "graphics_softwaremouse", 1 );
+    bool showSWMouse = app->GetOptions ()->IsOptionEqualTo ( OPTION_SOFTWAREMOUSE, 1 );
 
 	if ( showSWMouse ) {
 
@@ -709,6 +748,7 @@ void mousemove(int x, int y)
 		EclDirtyRectangle ( mouse->x, mouse->y, mouse->width, mouse->height );
 		EclGetButton ( "mouse" )->x = x + 1;
 		EclGetButton ( "mouse" )->y = y + 1;
+		EclUpdateButtonIndex ( mouse );
 		EclDirtyRectangle ( mouse->x, mouse->y, mouse->width, mouse->height );
 
 	}
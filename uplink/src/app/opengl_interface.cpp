@@ -92,7 +92,7 @@ void clear_draw ( int x, int y, int w, int h )
 
 #else
 
-    SetColour ( "Background" );
+    SetColour ( COLOUR_BACKGROUND );
 
 	glBegin ( GL_QUADS );
 
@@ -145,7 +145,7 @@ void button_draw ( Button *button, bool highlighted, bool clicked )
 
 #else
 	
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
  	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
  	glEnable ( GL_SCISSOR_TEST );
 
@@ -153,24 +153,24 @@ void button_draw ( Button *button, bool highlighted, bool clicked )
 	
 	glBegin ( GL_QUADS );
 
-		if		( clicked )		SetColour ( "ButtonClickedA" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedA" );
-		else					SetColour ( "ButtonNormalA" );
+		if		( clicked )		SetColour ( COLOUR_BUTTONCLICKEDA );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDA );
+		else					SetColour ( COLOUR_BUTTONNORMALA );
 		glVertex2i ( button->x, button->y + button->height );
 
-		if      ( clicked )		SetColour ( "ButtonClickedB" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedB" );
-		else					SetColour ( "ButtonNormalB" );
+		if      ( clicked )		SetColour ( COLOUR_BUTTONCLICKEDB );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDB );
+		else					SetColour ( COLOUR_BUTTONNORMALB );
 		glVertex2i ( button->x, button->y );
 
-		if		( clicked )		SetColour ( "ButtonClickedA" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedA" );
-		else					SetColour ( "ButtonNormalA" );
+		if		( clicked )		SetColour ( COLOUR_BUTTONCLICKEDA );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDA );
+		else					SetColour ( COLOUR_BUTTONNORMALA );
 		glVertex2i ( button->x + button->width, button->y );
 
-		if		( clicked )		SetColour ( "ButtonClickedB" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedB" );
-		else					SetColour ( "ButtonNormalB" );
+		if		( clicked )		SetColour ( COLOUR_BUTTONCLICKEDB );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDB );
+		else					SetColour ( COLOUR_BUTTONNORMALB );
 		glVertex2i ( button->x + button->width, button->y + button->height );
 
 	glEnd ();
@@ -181,7 +181,7 @@ void button_draw ( Button *button, bool highlighted, bool clicked )
 	int xpos = (button->x + button->width  / 2) - ( GciTextWidth ( button->caption ) / 2 );
 	int ypos = (button->y + button->height / 2) + 2;
 
-    SetColour ( "DefaultText" );
+    SetColour ( COLOUR_DEFAULTTEXT );
     GciDrawText ( xpos, ypos, button->caption );
 
  	glDisable ( GL_SCISSOR_TEST );
@@ -190,7 +190,7 @@ void button_draw ( Button *button, bool highlighted, bool clicked )
 void imagebutton_draw ( Button *button, bool highlighted, bool clicked )
 {
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -214,7 +214,7 @@ void imagebutton_draw ( Button *button, bool highlighted, bool clicked )
 void imagebutton_draw ( Button *button, bool highlighted, bool clicked, Image *standard_i_ref, Image *highlighted_i_ref, Image *clicked_i_ref )
 {
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -237,7 +237,7 @@ void imagebutton_draw ( Button *button, bool highlighted, bool clicked, Image *s
 void imagebutton_draw_blend ( Button *button, bool highlighted, bool clicked )
 {
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -298,7 +298,7 @@ void imagebutton_drawtextured ( Button *button, bool highlighted, bool clicked )
 
 	// ============================================================
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 	glBlendFunc ( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
@@ -341,7 +341,7 @@ void imagebutton_drawtextured ( Button *button, bool highlighted, bool clicked )
 
 	glPushAttrib ( GL_ALL_ATTRIB_BITS );
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -520,11 +520,11 @@ void text_draw ( Button *button, bool highlighted, bool clicked )
 
 	UplinkAssert (button);
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
-	SetColour ( "DefaultText" );    
+	SetColour ( COLOUR_DEFAULTTEXT );    
 
 	// Print the text
 
@@ -591,7 +591,7 @@ void textbutton_draw  ( Button *button, bool highlighted, bool clicked )
 
 	UplinkAssert (button);
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -604,7 +604,7 @@ void textbutton_draw  ( Button *button, bool highlighted, bool clicked )
 	// Draw a box around the text if highlighted
 	if ( highlighted || clicked ) {
 
-		SetColour ( "TextBorder" );
+		SetColour ( COLOUR_TEXTBORDER );
 		border_draw ( button );	
 
 	}
@@ -666,7 +666,7 @@ void textbox_draw ( Button *button, bool highlighted, bool clicked )
 
 	UplinkAssert (  button );
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -674,24 +674,24 @@ void textbox_draw ( Button *button, bool highlighted, bool clicked )
 
 	glBegin ( GL_QUADS );
 
-		if		( clicked )		SetColour ( "ButtonClickedA" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedA" );
-		else					SetColour ( "ButtonNormalA" );
+		if		( clicked )		SetColour ( COLOUR_BUTTONCLICKEDA );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDA );
+		else					SetColour ( COLOUR_BUTTONNORMALA );
 		glVertex2i ( button->x, button->y + button->height );
 
-		if      ( clicked )		SetColour ( "ButtonClickedB" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedB" );
-		else					SetColour ( "ButtonNormalB" );
+		if      ( clicked )		SetColour ( COLOUR_BUTTONCLICKEDB );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDB );
+		else					SetColour ( COLOUR_BUTTONNORMALB );
 		glVertex2i ( button->x, button->y );
 
-		if		( clicked )		SetColour ( "ButtonClickedA" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedA" );
-		else					SetColour ( "ButtonNormalA" );
+		if		( clicked )		SetColour ( COLOUR_BUTTONCLICKEDA );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDA );
+		else					SetColour ( COLOUR_BUTTONNORMALA );
 		glVertex2i ( button->x + button->width, button->y );
 
-		if		( clicked )		SetColour ( "ButtonClickedB" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedB" );
-		else					SetColour ( "ButtonNormalB" );
+		if		( clicked )		SetColour ( COLOUR_BUTTONCLICKEDB );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDB );
+		else					SetColour ( COLOUR_BUTTONNORMALB );
 		glVertex2i ( button->x + button->width, button->y + button->height );
 
 	glEnd ();
@@ -998,7 +998,7 @@ void button_assignbitmaps_blend ( char *name, char *standard_f, char *highlighte
 	ColourOption *col;
 	if ( app && 
 	     app->GetOptions () && 
-	     ( col = app->GetOptions ()->GetColour( "Background" ) ) ) {
+	     ( col = app->GetOptions ()->GetColour( COLOUR_BACKGROUND ) ) ) {
 
 		br = col->r;
 		bg = col->g;
@@ -1043,7 +1043,7 @@ void button_assignbitmap_blend ( char *name, char *standard_f )
 	ColourOption *col;
 	if ( app && 
 	     app->GetOptions () && 
-	     ( col = app->GetOptions ()->GetColour( "Background" ) ) ) {
+	     ( col = app->GetOptions ()->GetColour( COLOUR_BACKGROUND ) ) ) {
 
 		br = col->r;
 		bg = col->g;
@@ -1094,8 +1094,8 @@ void tooltip_update ( char *newtooltip )
 
 		// The tooltip button has been removed / never created
 		// So create it now
-		int screenwidth = app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" );
-		int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+		int screenwidth = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		EclRegisterButton ( 0, screenheight - 15, 500, 15, "", "tooltip" );
 		EclRegisterButtonCallbacks ( "tooltip", textbutton_draw, NULL, NULL, NULL );
 		EclButtonSendToBack ( "tooltip" );
@@ -1187,7 +1187,7 @@ void draw_stextbox ( Button *button, bool highlighted, bool clicked )
 
 	UplinkAssert (button);
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -1204,24 +1204,24 @@ void draw_stextbox ( Button *button, bool highlighted, bool clicked )
 
 	glBegin ( GL_QUADS );
 
-		if		( clicked )		SetColour ( "ButtonClickedA" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedA" );
-		else					SetColour ( "ButtonNormalA" );
+		if		( clicked )		SetColour ( COLOUR_BUTTONCLICKEDA );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDA );
+		else					SetColour ( COLOUR_BUTTONNORMALA );
 		glVertex2i ( button->x, button->y + button->height );
 
-		if      ( clicked )		SetColour ( "ButtonClickedB" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedB" );
-		else					SetColour ( "ButtonNormalB" );
+		if      ( clicked )		SetColour ( COLOUR_BUTTONCLICKEDB );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDB );
+		else					SetColour ( COLOUR_BUTTONNORMALB );
 		glVertex2i ( button->x, button->y );
 
-		if		( clicked )		SetColour ( "ButtonClickedA" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedA" );
-		else					SetColour ( "ButtonNormalA" );
+		if		( clicked )		SetColour ( COLOUR_BUTTONCLICKEDA );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDA );
+		else					SetColour ( COLOUR_BUTTONNORMALA );
 		glVertex2i ( button->x + button->width, button->y );
 
-		if		( clicked )		SetColour ( "ButtonClickedB" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedB" );
-		else					SetColour ( "ButtonNormalB" );
+		if		( clicked )		SetColour ( COLOUR_BUTTONCLICKEDB );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDB );
+		else					SetColour ( COLOUR_BUTTONNORMALB );
 		glVertex2i ( button->x + button->width, button->y + button->height );
 
 	glEnd ();
@@ -1235,7 +1235,7 @@ void draw_stextbox ( Button *button, bool highlighted, bool clicked )
 
 	int maxnumlines = (button->height - 10 ) / 15;
 
-	SetColour ( "DefaultText" );    
+	SetColour ( COLOUR_DEFAULTTEXT );    
 
 	LList <char *> *wrappedtext = wordwraptext ( button->caption, button->width );
 
@@ -1269,24 +1269,24 @@ void draw_scrollbox  ( Button *button, bool highlighted, bool clicked )
 
 	glBegin ( GL_QUADS );
 
-		if		( clicked )		SetColour ( "ButtonClickedA" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedA" );
-		else					SetColour ( "ButtonNormalA" );
+		if		( clicked )		SetColour ( COLOUR_BUTTONCLICKEDA );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDA );
+		else					SetColour ( COLOUR_BUTTONNORMALA );
 		glVertex2i ( button->x, button->y + button->height );
 
-		if      ( clicked )		SetColour ( "ButtonClickedB" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedB" );
-		else					SetColour ( "ButtonNormalB" );
+		if      ( clicked )		SetColour ( COLOUR_BUTTONCLICKEDB );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDB );
+		else					SetColour ( COLOUR_BUTTONNORMALB );
 		glVertex2i ( button->x, button->y );
 
-		if		( clicked )		SetColour ( "ButtonClickedA" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedA" );
-		else					SetColour ( "ButtonNormalA" );
+		if		( clicked )		SetColour ( COLOUR_BUTTONCLICKEDA );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDA );
+		else					SetColour ( COLOUR_BUTTONNORMALA );
 		glVertex2i ( button->x + button->width, button->y );
 
-		if		( clicked )		SetColour ( "ButtonClickedB" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedB" );
-		else					SetColour ( "ButtonNormalB" );
+		if		( clicked )		SetColour ( COLOUR_BUTTONCLICKEDB );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDB );
+		else					SetColour ( COLOUR_BUTTONNORMALB );
 		glVertex2i ( button->x + button->width, button->y + button->height );
 
 	glEnd ();
@@ -1326,13 +1326,13 @@ void draw_msgboxbox ( Button *button, bool highlighted, bool clicked )
 {
 
 	glBegin ( GL_QUADS );
-		SetColour ( "PanelBackgroundA" );		glVertex2i ( button->x, button->y + button->height );
-		SetColour ( "PanelBackgroundB" );		glVertex2i ( button->x, button->y );
-		SetColour ( "PanelBackgroundA" );		glVertex2i ( button->x + button->width, button->y );
-		SetColour ( "PanelBackgroundB" );		glVertex2i ( button->x + button->width, button->y + button->height );
+		SetColour ( COLOUR_PANELBACKGROUNDA );		glVertex2i ( button->x, button->y + button->height );
+		SetColour ( COLOUR_PANELBACKGROUNDB );		glVertex2i ( button->x, button->y );
+		SetColour ( COLOUR_PANELBACKGROUNDA );		glVertex2i ( button->x + button->width, button->y );
+		SetColour ( COLOUR_PANELBACKGROUNDB );		glVertex2i ( button->x + button->width, button->y + button->height );
 	glEnd ();
 
-	SetColour ( "PanelBorder" );
+	SetColour ( COLOUR_PANELBORDER );
 	border_draw ( button );
 
 }
@@ -1351,8 +1351,8 @@ void create_msgbox ( char *title, char *message, void (*closeclick) (Button *) /
 
 		// Blank out the background
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 		EclRegisterButton ( 0, 0, screenw, screenh, "", "", "msgbox_background" );
 		EclRegisterButtonCallbacks ( "msgbox_background", draw_msgboxbackground, NULL, NULL, NULL );
@@ -1392,8 +1392,8 @@ void create_yesnomsgbox ( char *title, char *message, void (*yesclick) (Button *
 
 		// Blank out the background
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 		EclRegisterButton ( 0, 0, screenw, screenh, "", "", "msgbox_background" );
 		EclRegisterButtonCallbacks ( "msgbox_background", draw_msgboxbackground, NULL, NULL, NULL );
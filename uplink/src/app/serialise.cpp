@@ -449,6 +449,114 @@ void DeleteLListData ( LList <UplinkObject *> *llist )
 
 }
 
+void SaveDeque ( Deque <UplinkObject *> *deque, FILE *file )
+{
+
+	UplinkAssert ( deque );
+
+	int size = deque->Size ();
+	int nbitem = 0;
+	for ( int i = 0; i < size; ++i )
+		if ( deque->GetData (i) )
+			nbitem++;
+
+	if ( nbitem > MAX_ITEMS_DATA_STRUCTURE ) {
+		UplinkPrintAbortArgs ( "WARNING: SaveDeque, number of items appears to be too big, size=%d, maxsize=%d",
+		                       nbitem, MAX_ITEMS_DATA_STRUCTURE );
+		nbitem = MAX_ITEMS_DATA_STRUCTURE;
+	}
+
+	fwrite ( &nbitem, sizeof(nbitem), 1, file );
+
+	nbitem = 0;
+	for ( int i = 0; i < size && nbitem < MAX_ITEMS_DATA_STRUCTURE; ++i ) {
+		UplinkObject *uo = deque->GetData (i);
+		if ( uo ) {
+			int OBJECTID = uo->GetOBJECTID ();
+			UplinkAssert ( OBJECTID != 0 );
+			fwrite ( &OBJECTID, sizeof(int), 1, file );
+			uo->Save ( file );
+			nbitem++;
+		}
+	}
+
+}
+
+bool LoadDeque ( Deque <UplinkObject *> *deque, FILE *file )
+{
+
+	if ( !deque ) {
+		UplinkPrintAssert ( deque );
+		return false;
+	}
+
+	int size;
+	if ( !FileReadData ( &size, sizeof(size), 1, file ) ) return false;
+
+    if ( size < 0 || size > MAX_ITEMS_DATA_STRUCTURE ) {
+		UplinkPrintAbortArgs ( "WARNING: LoadDeque, number of items appears to be wrong, size=%d", size );
+		return false;
+    }
+
+	for ( int i = 0; i < size; ++i ) {
+	
+		int OBJECTID;
+		if ( !FileReadData ( &OBJECTID, sizeof(int), 1, file ) ) return false;
+		UplinkObject *uo = CreateUplinkObject ( OBJECTID );
+
+		if ( !uo || !uo->Load ( file ) ) {
+			if ( uo ) delete uo;
+			return false;
+		}
+		deque->PutData ( uo );
+
+	}
+
+	return true;
+
+}
+
+void PrintDeque ( Deque <UplinkObject *> *deque )
+{
+
+	UplinkAssert ( deque );
+
+	for ( int i = 0; i < deque->Size (); ++i ) {
+
+		printf ( "Index = %d\n", i );
+
+		if ( deque->GetData (i) )
+			deque->GetData (i)->Print ();
+
+		else
+			printf ( "NULL\n" );
+
+	}
+
+}
+
+void DeleteDequeData ( Deque <UplinkObject *> *deque )
+{
+
+	UplinkAssert ( deque );
+
+	for ( int i = 0; i < deque->Size (); ++i )
+		if ( deque->GetData (i) )
+			delete deque->GetData (i);
+
+}
+
+void DeleteDequeData ( Deque <char *> *deque )
+{
+
+	UplinkAssert ( deque );
+
+	for ( int i = 0; i < deque->Size (); ++i )
+		if ( deque->GetData (i) )
+			delete [] deque->GetData (i);
+
+}
+
 void SaveLList ( LList <char *> *llist, FILE *file )
 {
 
@@ -43,6 +43,12 @@ bool LoadLList       ( LList <char *> *llist, FILE *file );
 void PrintLList		 ( LList <char *> *llist );
 void DeleteLListData ( LList <char *> *llist );
 
+void SaveDeque       ( Deque <UplinkObject *> *deque, FILE *file );			// Same format as an LList
+bool LoadDeque       ( Deque <UplinkObject *> *deque, FILE *file );
+void PrintDeque      ( Deque <UplinkObject *> *deque );
+void DeleteDequeData ( Deque <UplinkObject *> *deque );
+void DeleteDequeData ( Deque <char *> *deque );
+
 void SaveDArray       ( DArray <UplinkObject *> *darray, FILE *file );
 bool LoadDArray       ( DArray <UplinkObject *> *darray, FILE *file );
 void PrintDArray      ( DArray <UplinkObject *> *darray );
@@ -267,8 +267,8 @@ bool Game::LoadGame ( FILE *file )
 
         //UplinkAbort ( "This save game file is from an older version of Uplink" );        
 
-		EclReset ( app->GetOptions ()->GetOptionValue ("graphics_screenwidth"),
-		           app->GetOptions ()->GetOptionValue ("graphics_screenheight") );
+		EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+		           app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
         app->GetMainMenu ()->RunScreen ( MAINMENU_LOGIN );
 
         char message [256];
@@ -284,8 +284,8 @@ bool Game::LoadGame ( FILE *file )
 
 	if ( !Load ( file ) ) {
 
-		EclReset ( app->GetOptions ()->GetOptionValue ("graphics_screenwidth"),
-		           app->GetOptions ()->GetOptionValue ("graphics_screenheight") );
+		EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+		           app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
         app->GetMainMenu ()->RunScreen ( MAINMENU_LOGIN );
 
         create_msgbox ( "Error", "Failed to load user profile\n"
@@ -624,7 +624,7 @@ void ScriptLibrary::Script31 ()
 void ScriptLibrary::DrawConnection ( Button *button, bool highlighted, bool clicked )
 {
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -1306,16 +1306,16 @@ void ExitGameClick ( Button *button )
 void NewPatchOKClick ( Button *button )
 {
 
-//    EclReset ( app->GetOptions ()->GetOptionValue ("graphics_screenwidth"),
-//			   app->GetOptions ()->GetOptionValue ("graphics_screenheight") );
+//    EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+//			   app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
 //
 //    app->GetMainMenu ()->RunScreen ( MAINMENU_LOGIN );
 
     bool setScreenRes = EclGetButton ( "newpatch_screenrestoggle" )->caption[0] == '1';
     bool newUser = EclGetButton ( "newpatch_newusertoggle" )->caption[0] == '1';
 
-    EclReset ( app->GetOptions ()->GetOptionValue ("graphics_screenwidth"),
-			   app->GetOptions ()->GetOptionValue ("graphics_screenheight") );
+    EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+			   app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
 
     create_msgbox ( "Shutdown", "Patch changes complete.\nUplink must now be restarted." );		
     EclRegisterButtonCallback ( "msgbox_close", ExitGameClick );
@@ -1405,8 +1405,8 @@ void ToggleBoxClick ( Button *button )
 void ScriptLibrary::Script47 ()
 {
 
-    EclReset ( app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" ),
-               app->GetOptions ()->GetOptionValue ( "graphics_screenheight" ) );
+    EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+               app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
 
 
     EclRegisterButton ( 120, 40, 405, 52, " ", " ", "newpatch_title" );
@@ -1491,8 +1491,8 @@ void ScriptLibrary::Script51 ()
 	app->SaveGame ( game->GetWorld ()->GetPlayer ()->handle );				
 	game->SetGameSpeed ( GAMESPEED_PAUSED );
 
-    EclReset ( app->GetOptions ()->GetOptionValue ("graphics_screenwidth"),
-			   app->GetOptions ()->GetOptionValue ("graphics_screenheight") );
+    EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+			   app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
 
 	app->GetMainMenu ()->RunScreen ( MAINMENU_LOGIN );
 	
@@ -20,6 +20,8 @@ int Allegro5System::baseHeight = 1080;
 float Allegro5System::scaleX = 1.0f;
 float Allegro5System::scaleY = 1.0f;
 bool Allegro5System::initialized = false;
+int Allegro5System::drawCalls = 0;
+bool Allegro5System::held = false;
 
 bool Allegro5System::Initialize(int width, int height, bool fullscreen) {
   if (initialized)
@@ -157,42 +159,67 @@ bool Allegro5System::ProcessEvents() {
 
 void Allegro5System::BeginFrame() { al_set_target_backbuffer(display); }
 
-void Allegro5System::EndFrame() { al_flip_display(); }
+// Presenting is left to GciSwapBuffers, so the frame is flipped exactly once
+// after the rest of the display has been drawn on top
+void Allegro5System::EndFrame() { HoldDrawing(false); }
+
+// Allegro batches held bitmap draws that share a texture (normally the atlas),
+// but only bitmap and font calls are allowed while held, so everything else
+// releases the hold first
+void Allegro5System::HoldDrawing(bool hold) {
+  if (held == hold)
+    return;
+  al_hold_bitmap_drawing(hold);
+  held = hold;
+}
 
 void Allegro5System::Clear(float r, float g, float b, float a) {
+  HoldDrawing(false);
   al_clear_to_color(al_map_rgba_f(r, g, b, a));
+  drawCalls++;
 }
 
+int Allegro5System::GetDrawCalls() { return drawCalls; }
+
+void Allegro5System::ResetDrawCalls() { drawCalls = 0; }
+
 void Allegro5System::DrawRectFilled(float x, float y, float w, float h, float r,
                                     float g, float b, float a) {
+  HoldDrawing(false);
   float sx = ScaleX(x);
   float sy = ScaleY(y);
   float sw = ScaleW(w);
   float sh = ScaleH(h);
   al_draw_filled_rectangle(sx, sy, sx + sw, sy + sh, al_map_rgba_f(r, g, b, a));
+  drawCalls++;
 }
 
 void Allegro5System::DrawRectOutline(float x, float y, float w, float h,
                                      float r, float g, float b, float a,
                                      float thickness) {
+  HoldDrawing(false);
   float sx = ScaleX(x);
   float sy = ScaleY(y);
   float sw = ScaleW(w);
   float sh = ScaleH(h);
   al_draw_rectangle(sx, sy, sx + sw, sy + sh, al_map_rgba_f(r, g, b, a),
                     thickness);
+  drawCalls++;
 }
 
 void Allegro5System::DrawLine(float x1, float y1, float x2, float y2, float r,
                               float g, float b, float a, float thickness) {
+  HoldDrawing(false);
   al_draw_line(ScaleX(x1), ScaleY(y1), ScaleX(x2), ScaleY(y2),
                al_map_rgba_f(r, g, b, a), thickness);
+  drawCalls++;
 }
 
 void Allegro5System::DrawGradientVertical(float x, float y, float w, float h,
                                           float r1, float g1, float b1,
                                           float a1, float r2, float g2,
                                           float b2, float a2) {
+  HoldDrawing(false);
   float sx = ScaleX(x);
   float sy = ScaleY(y);
   float sw = ScaleW(w);
@@ -225,6 +252,7 @@ void Allegro5System::DrawGradientVertical(float x, float y, float w, float h,
   vertices[3].color = al_map_rgba_f(r2, g2, b2, a2);
 
   al_draw_prim(vertices, NULL, NULL, 0, 4, ALLEGRO_PRIM_TRIANGLE_FAN);
+  drawCalls++;
 }
 
 ALLEGRO_FONT *Allegro5System::LoadFont(const char *path, int size) {
@@ -247,8 +275,10 @@ void Allegro5System::DrawText(ALLEGRO_FONT *font, float x, float y,
   else if (align == 2)
     flags = ALLEGRO_ALIGN_RIGHT;
 
+  HoldDrawing(true);
   al_draw_text(font, al_map_rgba_f(r, g, b, a), ScaleX(x), ScaleY(y), flags,
                text);
+  drawCalls++;
 }
 
 ALLEGRO_BITMAP *Allegro5System::LoadBitmap(const char *path) {
@@ -263,17 +293,21 @@ void Allegro5System::DrawBitmap(ALLEGRO_BITMAP *bmp, float x, float y,
                                 float alpha) {
   if (!bmp)
     return;
+  HoldDrawing(true);
   al_draw_tinted_bitmap(bmp, al_map_rgba_f(1, 1, 1, alpha), ScaleX(x),
                         ScaleY(y), 0);
+  drawCalls++;
 }
 
 void Allegro5System::DrawBitmapScaled(ALLEGRO_BITMAP *bmp, float x, float y,
                                       float w, float h, float alpha) {
   if (!bmp)
     return;
+  HoldDrawing(true);
   al_draw_tinted_scaled_bitmap(
       bmp, al_map_rgba_f(1, 1, 1, alpha), 0, 0, al_get_bitmap_width(bmp),
       al_get_bitmap_height(bmp), ScaleX(x), ScaleY(y), ScaleW(w), ScaleH(h), 0);
+  drawCalls++;
 }
 
 void Allegro5System::SetBaseResolution(int bw, int bh) {
@@ -36,6 +36,10 @@ public:
     static void BeginFrame();
     static void EndFrame();
     static void Clear(float r, float g, float b, float a = 1.0f);
+
+    // Primitive draw calls issued since the last reset
+    static int GetDrawCalls();
+    static void ResetDrawCalls();
     
     // Drawing primitives
     static void DrawRectFilled(float x, float y, float w, float h, 
@@ -78,6 +82,11 @@ private:
     static float scaleX;
     static float scaleY;
     static bool initialized;
+    static int drawCalls;
+
+    // Bitmap and text draws are held so runs from one texture are batched
+    static bool held;
+    static void HoldDrawing(bool hold);
 };
 
 // Utility to parse hex color strings
@@ -3,7 +3,9 @@
  */
 
 #include "hd_atlas.h"
+#include "hd_layout_binary.h"
 #include <tinyxml2.h>
+#include <algorithm>
 #include <cstdio>
 #include <vector>
 #include <memory>
@@ -16,14 +18,15 @@ namespace HDUI {
 
 TextureAtlas::TextureAtlas()
     : atlasImage(nullptr)
+    , stamp(0)
 {
 }
 
 TextureAtlas::~TextureAtlas() {
     // Destroy sub-bitmaps first
-    for (auto& pair : subTextures) {
-        if (pair.second.subBitmap) {
-            al_destroy_bitmap(pair.second.subBitmap);
+    for (auto& sub : subTextures) {
+        if (sub.subBitmap) {
+            al_destroy_bitmap(sub.subBitmap);
         }
     }
     subTextures.clear();
@@ -36,25 +39,36 @@ TextureAtlas::~TextureAtlas() {
 }
 
 bool TextureAtlas::Load(const std::string& xmlPath) {
-    tinyxml2::XMLDocument doc;
+    BinaryImage image;
+    std::string binaryPath = CompiledPath(xmlPath, ATLAS_BINARY_EXT);
     
-    if (doc.LoadFile(xmlPath.c_str()) != tinyxml2::XML_SUCCESS) {
-        fprintf(stderr, "HD_UI: Failed to load atlas XML: %s\n", xmlPath.c_str());
-        return false;
+    bool compiled = image.Map(binaryPath);
+    if (compiled && !image.IsAtlas()) {
+        fprintf(stderr, "HD_UI: Ignoring invalid compiled atlas: %s\n", binaryPath.c_str());
+        compiled = false;
+    } else if (compiled && image.IsStaleFor(xmlPath)) {
+        fprintf(stderr, "HD_UI: Compiled atlas is out of date, using XML: %s\n", binaryPath.c_str());
+        compiled = false;
     }
     
-    tinyxml2::XMLElement* root = doc.FirstChildElement("TextureAtlas");
-    if (!root) {
-        fprintf(stderr, "HD_UI: No <TextureAtlas> root in: %s\n", xmlPath.c_str());
-        return false;
+    if (!compiled) {
+        tinyxml2::XMLDocument doc;
+        
+        if (doc.LoadFile(xmlPath.c_str()) != tinyxml2::XML_SUCCESS) {
+            fprintf(stderr, "HD_UI: Failed to load atlas XML: %s\n", xmlPath.c_str());
+            return false;
+        }
+        
+        std::vector<char> bytes;
+        if (!CompileAtlas(doc, bytes)) {
+            fprintf(stderr, "HD_UI: Failed to compile atlas: %s\n", xmlPath.c_str());
+            return false;
+        }
+        image.Adopt(bytes);
     }
     
-    // Get image path (relative to XML file)
-    const char* imgPath = root->Attribute("imagePath");
-    if (!imgPath) {
-        fprintf(stderr, "HD_UI: No imagePath attribute in atlas: %s\n", xmlPath.c_str());
-        return false;
-    }
+    const AtlasFileHeader& header = image.Atlas();
+    stamp = header.stamp;
     
     // Build full path (same directory as XML)
     std::string baseDir = xmlPath;
@@ -65,7 +79,7 @@ bool TextureAtlas::Load(const std::string& xmlPath) {
         baseDir = "";
     }
     
-    imagePath = baseDir + imgPath;
+    imagePath = baseDir + image.String(header.imagePath);
     
     // Load the atlas image
     atlasImage = al_load_bitmap(imagePath.c_str());
@@ -79,45 +93,53 @@ bool TextureAtlas::Load(const std::string& xmlPath) {
            al_get_bitmap_width(atlasImage),
            al_get_bitmap_height(atlasImage));
     
-    // Parse all SubTexture elements
-    int count = 0;
-    for (tinyxml2::XMLElement* elem = root->FirstChildElement("SubTexture");
-         elem != nullptr;
-         elem = elem->NextSiblingElement("SubTexture"))
-    {
+    // Entries are already sorted by name, keep that order so compiled
+    // layouts can index straight into subTextures
+    const AtlasEntry* entries = image.Entries();
+    subTextures.reserve(header.numEntries);
+    
+    for (uint32_t i = 0; i < header.numEntries; i++) {
         SubTexture sub;
-        const char* name = elem->Attribute("name");
-        if (!name) continue;
-        
-        sub.name = name;
-        elem->QueryIntAttribute("x", &sub.x);
-        elem->QueryIntAttribute("y", &sub.y);
-        elem->QueryIntAttribute("width", &sub.width);
-        elem->QueryIntAttribute("height", &sub.height);
+        sub.name = image.String(entries[i].name);
+        sub.x = entries[i].x;
+        sub.y = entries[i].y;
+        sub.width = entries[i].width;
+        sub.height = entries[i].height;
         
         // Create sub-bitmap for this region
         sub.subBitmap = al_create_sub_bitmap(atlasImage, 
                                               sub.x, sub.y, 
                                               sub.width, sub.height);
         
-        subTextures[sub.name] = sub;
-        count++;
+        subTextures.push_back(sub);
     }
     
-    printf("HD_UI: Loaded %d sub-textures from atlas\n", count);
+    printf("HD_UI: Loaded %d sub-textures from atlas\n", (int)subTextures.size());
     return true;
 }
 
+int TextureAtlas::FindTexture(const std::string& name) const {
+    auto it = std::lower_bound(subTextures.begin(), subTextures.end(), name,
+        [](const SubTexture& sub, const std::string& key) { return sub.name < key; });
+    if (it != subTextures.end() && it->name == name) {
+        return (int)(it - subTextures.begin());
+    }
+    return -1;
+}
+
 ALLEGRO_BITMAP* TextureAtlas::GetTexture(const std::string& name) {
-    auto it = subTextures.find(name);
-    if (it != subTextures.end()) {
-        return it->second.subBitmap;
+    return GetTexture(FindTexture(name));
+}
+
+ALLEGRO_BITMAP* TextureAtlas::GetTexture(int index) {
+    if (index < 0 || index >= (int)subTextures.size()) {
+        return nullptr;
     }
-    return nullptr;
+    return subTextures[index].subBitmap;
 }
 
 bool TextureAtlas::HasTexture(const std::string& name) const {
-    return subTextures.find(name) != subTextures.end();
+    return FindTexture(name) != -1;
 }
 
 // ============================================================================
@@ -164,6 +186,17 @@ ALLEGRO_BITMAP* AtlasManager::GetTexture(const std::string& name) {
     return nullptr;
 }
 
+ALLEGRO_BITMAP* AtlasManager::GetTexture(uint32_t stamp, int index) {
+    if (index < 0) return nullptr;
+    
+    for (auto& atlas : atlases) {
+        if (atlas->GetStamp() == stamp) {
+            return atlas->GetTexture(index);
+        }
+    }
+    return nullptr;
+}
+
 void AtlasManager::ClearAll() {
     atlases.clear();
 }
@@ -8,8 +8,8 @@
 #include <vector>
 #include <memory>
 
+#include <cstdint>
 #include <string>
-#include <map>
 #include <allegro5/allegro.h>
 
 namespace HDUI {
@@ -27,22 +27,31 @@ public:
     TextureAtlas();
     ~TextureAtlas();
     
-    // Load atlas from XML definition file
+    // Load atlas from XML definition file, or its compiled form if current
     bool Load(const std::string& xmlPath);
     
     // Get a sub-texture by name
     ALLEGRO_BITMAP* GetTexture(const std::string& name);
     
+    // Get a sub-texture by its index in the compiled atlas
+    ALLEGRO_BITMAP* GetTexture(int index);
+    
     // Check if texture exists
     bool HasTexture(const std::string& name) const;
     
     // Get atlas image path
     const std::string& GetImagePath() const { return imagePath; }
     
+    // Hash of the atlas contents, matched against compiled layouts
+    uint32_t GetStamp() const { return stamp; }
+    
 private:
+    int FindTexture(const std::string& name) const;
+    
     ALLEGRO_BITMAP* atlasImage;
     std::string imagePath;
-    std::map<std::string, SubTexture> subTextures;
+    uint32_t stamp;
+    std::vector<SubTexture> subTextures; // Sorted by name
 };
 
 // Global atlas manager - caches loaded atlases
@@ -59,6 +68,10 @@ public:
     // Get texture by name (searches all loaded atlases)
     ALLEGRO_BITMAP* GetTexture(const std::string& name);
     
+    // Get texture by an index from a compiled layout, null if no loaded
+    // atlas has that stamp
+    ALLEGRO_BITMAP* GetTexture(uint32_t stamp, int index);
+    
     // Clear all loaded atlases
     void ClearAll();
     
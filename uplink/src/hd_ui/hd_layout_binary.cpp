@@ -0,0 +1,535 @@
+/*
+ * HD_UI Compiled Layouts Implementation
+ */
+
+#include "hd_layout_binary.h"
+#include <tinyxml2.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace HDUI {
+
+static const char LAYOUT_MAGIC[4] = { 'H', 'D', 'L', 'B' };
+static const char ATLAS_MAGIC[4] = { 'H', 'D', 'A', 'B' };
+
+// ============================================================================
+// BinaryImage
+// ============================================================================
+
+BinaryImage::BinaryImage()
+    : data(nullptr)
+    , size(0)
+    , mapped(false)
+{
+}
+
+BinaryImage::~BinaryImage() {
+    Release();
+}
+
+void BinaryImage::Release() {
+#ifndef WIN32
+    if (mapped) {
+        munmap((void*)data, size);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+    mapped = false;
+    owned.clear();
+}
+
+bool BinaryImage::Map(const std::string& path) {
+    Release();
+
+#ifdef WIN32
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    std::vector<char> bytes(length > 0 ? (size_t)length : 0);
+    bool ok = length > 0 && fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    fclose(file);
+
+    if (!ok) return false;
+    Adopt(bytes);
+    return true;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+
+    void* addr = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) return false;
+
+    data = (const char*)addr;
+    size = (size_t)st.st_size;
+    mapped = true;
+    return true;
+#endif
+}
+
+void BinaryImage::Adopt(std::vector<char>& bytes) {
+    Release();
+    owned.swap(bytes);
+    data = owned.data();
+    size = owned.size();
+}
+
+// True if count elements of elemSize starting at offset fit in the file
+static bool InBounds(size_t fileSize, uint64_t offset, uint64_t count, size_t elemSize) {
+    if (offset > fileSize || offset % 4 != 0) return false;
+    return count <= (fileSize - offset) / elemSize;
+}
+
+bool BinaryImage::CheckHeader(const char* magic, size_t headerSize) const {
+    if (!data || size < headerSize) return false;
+
+    const BinaryFileHeader& header = *(const BinaryFileHeader*)data;
+    if (memcmp(header.magic, magic, 4) != 0) return false;
+    if (header.version != LAYOUT_BINARY_VERSION) return false;
+
+    if (header.stringsSize == 0) return false;
+    if (!InBounds(size, header.stringsOffset, header.stringsSize, 1)) return false;
+    return data[header.stringsOffset + header.stringsSize - 1] == '\0';
+}
+
+bool BinaryImage::IsLayout() const {
+    if (!CheckHeader(LAYOUT_MAGIC, sizeof(LayoutFileHeader))) return false;
+
+    const LayoutFileHeader& header = Layout();
+    return header.numNodes > 0
+        && InBounds(size, header.nodesOffset, header.numNodes, sizeof(LayoutNode))
+        && InBounds(size, header.stopsOffset, header.numStops, sizeof(LayoutGradStop));
+}
+
+bool BinaryImage::IsAtlas() const {
+    if (!CheckHeader(ATLAS_MAGIC, sizeof(AtlasFileHeader))) return false;
+
+    const AtlasFileHeader& header = Atlas();
+    return InBounds(size, header.entriesOffset, header.numEntries, sizeof(AtlasEntry));
+}
+
+bool BinaryImage::IsStaleFor(const std::string& sourcePath) const {
+    struct stat st;
+    if (stat(sourcePath.c_str(), &st) != 0) return false;
+
+    const BinaryFileHeader& header = *(const BinaryFileHeader*)data;
+    return header.sourceMtime != (int64_t)st.st_mtime
+        || header.sourceSize != (uint64_t)st.st_size;
+}
+
+const char* BinaryImage::String(uint32_t offset) const {
+    const BinaryFileHeader& header = *(const BinaryFileHeader*)data;
+    if (offset >= header.stringsSize) return "";
+    return data + header.stringsOffset + offset;
+}
+
+int BinaryImage::FindEntry(const char* name) const {
+    const AtlasEntry* entries = Entries();
+    int lo = 0;
+    int hi = (int)Atlas().numEntries;
+
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        int cmp = strcmp(String(entries[mid].name), name);
+        if (cmp == 0) return mid;
+        if (cmp < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return -1;
+}
+
+// ============================================================================
+// Compiler
+// ============================================================================
+
+std::string CompiledPath(const std::string& xmlPath, const char* ext) {
+    size_t len = xmlPath.size();
+    if (len >= 4 && xmlPath.compare(len - 4, 4, ".xml") == 0) {
+        return xmlPath.substr(0, len - 4) + ext;
+    }
+    return xmlPath + ext;
+}
+
+bool StampSource(std::vector<char>& out, const std::string& sourcePath) {
+    struct stat st;
+    if (out.size() < sizeof(BinaryFileHeader) || stat(sourcePath.c_str(), &st) != 0) {
+        return false;
+    }
+
+    BinaryFileHeader header;
+    memcpy(&header, out.data(), sizeof(header));
+    header.sourceMtime = (int64_t)st.st_mtime;
+    header.sourceSize = (uint64_t)st.st_size;
+    memcpy(out.data(), &header, sizeof(header));
+    return true;
+}
+
+namespace {
+
+class StringTable {
+public:
+    StringTable() { bytes.push_back('\0'); }
+
+    uint32_t Intern(const char* s) {
+        if (!s || !*s) return 0;
+
+        auto it = offsets.find(s);
+        if (it != offsets.end()) return it->second;
+
+        uint32_t offset = (uint32_t)bytes.size();
+        bytes.insert(bytes.end(), s, s + strlen(s) + 1);
+        offsets[s] = offset;
+        return offset;
+    }
+
+    std::vector<char> bytes;
+
+private:
+    std::map<std::string, uint32_t> offsets;
+};
+
+void Append(std::vector<char>& out, const void* src, size_t len) {
+    const char* p = (const char*)src;
+    out.insert(out.end(), p, p + len);
+}
+
+uint32_t AlignTo8(std::vector<char>& out) {
+    while (out.size() % 8 != 0) out.push_back('\0');
+    return (uint32_t)out.size();
+}
+
+// Attribute readers, returning def when the attribute is missing or malformed
+float FloatAttr(const tinyxml2::XMLElement* elem, const char* name, float def) {
+    float val = def;
+    elem->QueryFloatAttribute(name, &val);
+    return val;
+}
+
+int IntAttr(const tinyxml2::XMLElement* elem, const char* name, int def) {
+    int val = def;
+    elem->QueryIntAttribute(name, &val);
+    return val;
+}
+
+const char* StringAttr(const tinyxml2::XMLElement* elem, const char* name, const char* def) {
+    const char* val = elem->Attribute(name);
+    return val ? val : def;
+}
+
+class LayoutCompiler {
+public:
+    explicit LayoutCompiler(const std::vector<const BinaryImage*>& atlases)
+        : atlases(atlases) {}
+
+    void AddRoot(const tinyxml2::XMLElement* root, int width, int height);
+
+    std::vector<LayoutNode> nodes;
+    std::vector<LayoutGradStop> stops;
+    StringTable strings;
+
+private:
+    void AddElement(const tinyxml2::XMLElement* elem, size_t parent);
+    void AddChildren(const tinyxml2::XMLElement* elem, size_t index);
+    void AddCommon(const tinyxml2::XMLElement* elem, LayoutNode& node);
+    void ResolveTexture(LayoutNode& node, const char* file);
+
+    const std::vector<const BinaryImage*>& atlases;
+};
+
+LayoutNode EmptyNode(LayoutNodeType type) {
+    LayoutNode node;
+    memset(&node, 0, sizeof(node));
+    node.type = (uint8_t)type;
+    node.alpha = 1.0f;
+    node.texture = -1;
+    return node;
+}
+
+void LayoutCompiler::AddRoot(const tinyxml2::XMLElement* root, int width, int height) {
+    LayoutNode node = EmptyNode(LayoutNodeType::Container);
+    node.name = strings.Intern(StringAttr(root, "name", "layout"));
+    node.w = (float)width;
+    node.h = (float)height;
+    nodes.push_back(node);
+
+    AddChildren(root, 0);
+}
+
+void LayoutCompiler::AddChildren(const tinyxml2::XMLElement* elem, size_t index) {
+    for (const tinyxml2::XMLElement* child = elem->FirstChildElement();
+         child != nullptr;
+         child = child->NextSiblingElement())
+    {
+        // GradStops are read by their Gradient
+        if (strcmp(child->Name(), "GradStop") != 0) {
+            AddElement(child, index);
+        }
+    }
+}
+
+void LayoutCompiler::AddElement(const tinyxml2::XMLElement* elem, size_t parent) {
+    const char* tagName = elem->Name();
+    bool hasChildren = true;
+    LayoutNode node;
+
+    if (strcmp(tagName, "Container") == 0) {
+        node = EmptyNode(LayoutNodeType::Container);
+        AddCommon(elem, node);
+    } else if (strcmp(tagName, "Gradient") == 0) {
+        node = EmptyNode(LayoutNodeType::Gradient);
+        AddCommon(elem, node);
+        node.subtype = strings.Intern(StringAttr(elem, "subtype", "gradVertical"));
+        node.firstStop = (uint32_t)stops.size();
+
+        for (const tinyxml2::XMLElement* child = elem->FirstChildElement("GradStop");
+             child != nullptr;
+             child = child->NextSiblingElement("GradStop"))
+        {
+            LayoutGradStop stop;
+            stop.location = FloatAttr(child, "location", 0.0f);
+            stop.fillColor = strings.Intern(StringAttr(child, "fillColor", "000000"));
+            stops.push_back(stop);
+        }
+
+        node.numStops = (uint32_t)stops.size() - node.firstStop;
+    } else if (strcmp(tagName, "Rectangle") == 0) {
+        node = EmptyNode(LayoutNodeType::Rectangle);
+        AddCommon(elem, node);
+        node.subtype = strings.Intern(StringAttr(elem, "subtype", "filled"));
+        node.fillColor = strings.Intern(StringAttr(elem, "fillColor", "FFFFFF"));
+        node.fillAlpha = FloatAttr(elem, "fillA", 1.0f);
+        node.strokeColor = strings.Intern(StringAttr(elem, "strokeColor", "FFFFFF"));
+        node.strokeWidth = FloatAttr(elem, "strokeW", 1.0f);
+        hasChildren = false;
+    } else if (strcmp(tagName, "Line") == 0) {
+        node = EmptyNode(LayoutNodeType::Line);
+        AddCommon(elem, node);
+        node.x1 = FloatAttr(elem, "x1", 0.0f);
+        node.y1 = FloatAttr(elem, "y1", 0.0f);
+        node.x2 = FloatAttr(elem, "x2", 0.0f);
+        node.y2 = FloatAttr(elem, "y2", 0.0f);
+        node.strokeColor = strings.Intern(StringAttr(elem, "strokeColor", "FFFFFF"));
+        node.strokeWidth = FloatAttr(elem, "strokeW", 1.0f);
+        hasChildren = false;
+    } else if (strcmp(tagName, "TextPoint") == 0) {
+        node = EmptyNode(LayoutNodeType::TextPoint);
+        AddCommon(elem, node);
+        node.text = strings.Intern(StringAttr(elem, "text", ""));
+        node.font = strings.Intern(StringAttr(elem, "font", "AeroMaticsRegular"));
+        node.fontSize = IntAttr(elem, "size", 18);
+        node.fillColor = strings.Intern(StringAttr(elem, "fillColor", "FFFFFF"));
+
+        // Values follow the TextAlign enum
+        const char* align = StringAttr(elem, "align", "left");
+        if (strcmp(align, "center") == 0) node.align = (uint8_t)1;
+        else if (strcmp(align, "right") == 0) node.align = (uint8_t)2;
+        else node.align = (uint8_t)0;
+        hasChildren = false;
+    } else if (strcmp(tagName, "Image") == 0) {
+        node = EmptyNode(LayoutNodeType::Image);
+        AddCommon(elem, node);
+        const char* file = StringAttr(elem, "file", "");
+        node.file = strings.Intern(file);
+        ResolveTexture(node, file);
+        hasChildren = false;
+    } else if (strcmp(tagName, "ButtonStandard") == 0) {
+        node = EmptyNode(LayoutNodeType::ButtonStandard);
+        AddCommon(elem, node);
+    } else if (strcmp(tagName, "ButtonTextField") == 0) {
+        node = EmptyNode(LayoutNodeType::ButtonTextField);
+        AddCommon(elem, node);
+    } else {
+        fprintf(stderr, "HD_UI: Unknown element type: %s\n", tagName);
+        // Try parsing as generic container
+        node = EmptyNode(LayoutNodeType::Container);
+        AddCommon(elem, node);
+    }
+
+    size_t index = nodes.size();
+    nodes.push_back(node);
+    nodes[parent].numChildren++;
+
+    if (hasChildren) {
+        AddChildren(elem, index);
+    }
+}
+
+void LayoutCompiler::AddCommon(const tinyxml2::XMLElement* elem, LayoutNode& node) {
+    node.name = strings.Intern(StringAttr(elem, "name", ""));
+    node.x = FloatAttr(elem, "x", 0.0f);
+    node.y = FloatAttr(elem, "y", 0.0f);
+    node.w = FloatAttr(elem, "w", 0.0f);
+    node.h = FloatAttr(elem, "h", 0.0f);
+    node.alpha = FloatAttr(elem, "alpha", 1.0f);
+
+    // Values follow the ScalingType and ArrangeType enums
+    const char* scaling = StringAttr(elem, "scalingType", "scaleNormal");
+    if (strcmp(scaling, "scaleByHeight") == 0) node.scalingType = 1;
+    else if (strcmp(scaling, "scaleByWidth") == 0) node.scalingType = 2;
+    else node.scalingType = 0;
+
+    const char* arrange = StringAttr(elem, "arrangeType", "arrangeFree");
+    if (strcmp(arrange, "arrangeHorizontal") == 0) node.arrangeType = 1;
+    else if (strcmp(arrange, "arrangeVertical") == 0) node.arrangeType = 2;
+    else node.arrangeType = 0;
+
+    node.arrangePadding = FloatAttr(elem, "arrangePadding", 0.0f);
+}
+
+void LayoutCompiler::ResolveTexture(LayoutNode& node, const char* file) {
+    if (!*file) return;
+
+    for (const BinaryImage* atlas : atlases) {
+        int index = atlas->FindEntry(file);
+        if (index >= 0) {
+            node.atlasStamp = atlas->Atlas().stamp;
+            node.texture = index;
+            return;
+        }
+    }
+}
+
+void StartFile(std::vector<char>& out, const char* magic, size_t headerSize) {
+    out.assign(headerSize, '\0');
+    BinaryFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, magic, 4);
+    header.version = LAYOUT_BINARY_VERSION;
+    memcpy(out.data(), &header, sizeof(header));
+}
+
+void FinishFile(std::vector<char>& out, const StringTable& strings, BinaryFileHeader& header) {
+    header.stringsOffset = AlignTo8(out);
+    header.stringsSize = (uint32_t)strings.bytes.size();
+    Append(out, strings.bytes.data(), strings.bytes.size());
+}
+
+} // namespace
+
+bool CompileLayout(const tinyxml2::XMLDocument& doc,
+                   const std::vector<const BinaryImage*>& atlases,
+                   std::vector<char>& out)
+{
+    const tinyxml2::XMLElement* root = doc.FirstChildElement("layout");
+    if (!root) {
+        fprintf(stderr, "HD_UI: No <layout> root element\n");
+        return false;
+    }
+
+    LayoutFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.width = IntAttr(root, "w", 1920);
+    header.height = IntAttr(root, "h", 1080);
+
+    LayoutCompiler compiler(atlases);
+    compiler.AddRoot(root, header.width, header.height);
+
+    StartFile(out, LAYOUT_MAGIC, sizeof(header));
+    memcpy(&header.file, out.data(), sizeof(header.file));
+
+    header.nodesOffset = AlignTo8(out);
+    header.numNodes = (uint32_t)compiler.nodes.size();
+    Append(out, compiler.nodes.data(), compiler.nodes.size() * sizeof(LayoutNode));
+
+    header.stopsOffset = AlignTo8(out);
+    header.numStops = (uint32_t)compiler.stops.size();
+    Append(out, compiler.stops.data(), compiler.stops.size() * sizeof(LayoutGradStop));
+
+    FinishFile(out, compiler.strings, header.file);
+    memcpy(out.data(), &header, sizeof(header));
+    return true;
+}
+
+bool CompileAtlas(const tinyxml2::XMLDocument& doc, std::vector<char>& out) {
+    const tinyxml2::XMLElement* root = doc.FirstChildElement("TextureAtlas");
+    if (!root) {
+        fprintf(stderr, "HD_UI: No <TextureAtlas> root element\n");
+        return false;
+    }
+
+    const char* imagePath = root->Attribute("imagePath");
+    if (!imagePath) {
+        fprintf(stderr, "HD_UI: No imagePath attribute in atlas\n");
+        return false;
+    }
+
+    // Sorted by name, later duplicates replace earlier ones
+    std::map<std::string, AtlasEntry> sorted;
+    for (const tinyxml2::XMLElement* elem = root->FirstChildElement("SubTexture");
+         elem != nullptr;
+         elem = elem->NextSiblingElement("SubTexture"))
+    {
+        const char* name = elem->Attribute("name");
+        if (!name) continue;
+
+        AtlasEntry entry;
+        entry.name = 0;
+        entry.x = IntAttr(elem, "x", 0);
+        entry.y = IntAttr(elem, "y", 0);
+        entry.width = IntAttr(elem, "width", 0);
+        entry.height = IntAttr(elem, "height", 0);
+        sorted[name] = entry;
+    }
+
+    StringTable strings;
+    std::vector<AtlasEntry> entries;
+    entries.reserve(sorted.size());
+
+    // FNV-1a over the image path and every entry, so layouts compiled
+    // against a different version of the atlas do not use its indices
+    uint32_t stamp = 2166136261u;
+    auto hash = [&stamp](const void* p, size_t len) {
+        const unsigned char* bytes = (const unsigned char*)p;
+        for (size_t i = 0; i < len; i++) {
+            stamp = (stamp ^ bytes[i]) * 16777619u;
+        }
+    };
+    hash(imagePath, strlen(imagePath) + 1);
+
+    for (auto& pair : sorted) {
+        AtlasEntry entry = pair.second;
+        entry.name = strings.Intern(pair.first.c_str());
+        entries.push_back(entry);
+
+        hash(pair.first.c_str(), pair.first.size() + 1);
+        hash(&entry.x, sizeof(int32_t) * 4);
+    }
+
+    AtlasFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.imagePath = strings.Intern(imagePath);
+    header.stamp = stamp;
+
+    StartFile(out, ATLAS_MAGIC, sizeof(header));
+    memcpy(&header.file, out.data(), sizeof(header.file));
+
+    header.entriesOffset = AlignTo8(out);
+    header.numEntries = (uint32_t)entries.size();
+    Append(out, entries.data(), entries.size() * sizeof(AtlasEntry));
+
+    FinishFile(out, strings, header.file);
+    memcpy(out.data(), &header, sizeof(header));
+    return true;
+}
+
+} // namespace HDUI
@@ -0,0 +1,172 @@
+/*
+ * HD_UI Compiled Layouts
+ * Binary form of the layout and atlas XML, written offline by hdlayoutc
+ * and mapped straight into memory at load time
+ */
+
+#ifndef _included_hd_layout_binary_h
+#define _included_hd_layout_binary_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tinyxml2 {
+    class XMLDocument;
+}
+
+namespace HDUI {
+
+// Bump whenever any of the structures below change
+const uint32_t LAYOUT_BINARY_VERSION = 1;
+
+// Compiled files sit beside their XML with these extensions
+#define LAYOUT_BINARY_EXT ".hdl"
+#define ATLAS_BINARY_EXT  ".hda"
+
+// All offsets are in bytes from the start of the file and all strings are
+// offsets into a single table of interned, NUL terminated strings (offset 0
+// is always the empty string). Files are native endian.
+
+struct BinaryFileHeader {
+    char magic[4];
+    uint32_t version;
+    int64_t sourceMtime;    // Modification time and size of the XML this
+    uint64_t sourceSize;    // was compiled from, used to spot stale files
+    uint32_t stringsOffset;
+    uint32_t stringsSize;
+};
+
+enum class LayoutNodeType : uint8_t {
+    Container,
+    Gradient,
+    Rectangle,
+    Line,
+    TextPoint,
+    Image,
+    ButtonStandard,
+    ButtonTextField
+};
+
+// One element of the layout tree. Nodes are stored in pre-order with the
+// <layout> root first, each followed by its numChildren direct children.
+struct LayoutNode {
+    uint8_t type;           // LayoutNodeType
+    uint8_t scalingType;    // ScalingType
+    uint8_t arrangeType;    // ArrangeType
+    uint8_t align;          // TextAlign
+    uint32_t numChildren;
+    uint32_t name;
+    float x, y, w, h;
+    float alpha;
+    float arrangePadding;
+
+    // Type specific, unused fields are zero
+    uint32_t subtype;
+    uint32_t fillColor;
+    uint32_t strokeColor;
+    uint32_t text;
+    uint32_t font;
+    uint32_t file;
+    float fillAlpha;
+    float strokeWidth;
+    float x1, y1, x2, y2;
+    int32_t fontSize;
+    uint32_t firstStop;
+    uint32_t numStops;
+
+    // Image files found in an atlas at compile time, texture is -1 otherwise
+    uint32_t atlasStamp;
+    int32_t texture;
+};
+
+struct LayoutGradStop {
+    float location;
+    uint32_t fillColor;
+};
+
+struct LayoutFileHeader {
+    BinaryFileHeader file;  // "HDLB"
+    int32_t width;
+    int32_t height;
+    uint32_t nodesOffset;
+    uint32_t numNodes;
+    uint32_t stopsOffset;
+    uint32_t numStops;
+};
+
+// Sub-textures are sorted by name, so an entry's index is stable for a
+// given atlas and can be baked into compiled layouts
+struct AtlasEntry {
+    uint32_t name;
+    int32_t x, y, width, height;
+};
+
+struct AtlasFileHeader {
+    BinaryFileHeader file;  // "HDAB"
+    uint32_t imagePath;
+    uint32_t stamp;         // Hash of the atlas contents
+    uint32_t entriesOffset;
+    uint32_t numEntries;
+};
+
+// Read only view of a compiled file, either mapped from disk or compiled
+// into memory from XML
+class BinaryImage {
+public:
+    BinaryImage();
+    ~BinaryImage();
+
+    bool Map(const std::string& path);
+    void Adopt(std::vector<char>& bytes);
+
+    // Checks the header and that every table lies inside the file
+    bool IsLayout() const;
+    bool IsAtlas() const;
+
+    // True if the XML at sourcePath has changed since this was compiled.
+    // A missing source is not stale, so layouts can ship compiled only.
+    bool IsStaleFor(const std::string& sourcePath) const;
+
+    const LayoutFileHeader& Layout() const { return *(const LayoutFileHeader*)data; }
+    const LayoutNode* Nodes() const { return (const LayoutNode*)(data + Layout().nodesOffset); }
+    const LayoutGradStop* Stops() const { return (const LayoutGradStop*)(data + Layout().stopsOffset); }
+
+    const AtlasFileHeader& Atlas() const { return *(const AtlasFileHeader*)data; }
+    const AtlasEntry* Entries() const { return (const AtlasEntry*)(data + Atlas().entriesOffset); }
+
+    const char* String(uint32_t offset) const;
+
+    // Index of the named atlas entry, or -1
+    int FindEntry(const char* name) const;
+
+private:
+    BinaryImage(const BinaryImage&) = delete;
+    BinaryImage& operator=(const BinaryImage&) = delete;
+
+    void Release();
+    bool CheckHeader(const char* magic, size_t headerSize) const;
+
+    const char* data;
+    size_t size;
+    bool mapped;
+    std::vector<char> owned;
+};
+
+// Returns the compiled file name for an XML path
+std::string CompiledPath(const std::string& xmlPath, const char* ext);
+
+// Compile parsed XML into a binary image. Image files in layouts are looked
+// up in the given compiled atlases.
+bool CompileLayout(const tinyxml2::XMLDocument& doc,
+                   const std::vector<const BinaryImage*>& atlases,
+                   std::vector<char>& out);
+bool CompileAtlas(const tinyxml2::XMLDocument& doc, std::vector<char>& out);
+
+// Record the source XML's size and time in a compiled image
+bool StampSource(std::vector<char>& out, const std::string& sourcePath);
+
+} // namespace HDUI
+
+#endif // _included_hd_layout_binary_h
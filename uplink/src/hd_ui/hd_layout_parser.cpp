@@ -3,6 +3,7 @@
  */
 
 #include "hd_layout_parser.h"
+#include "hd_atlas.h"
 #include <tinyxml2.h>
 #include <cstdio>
 #include <map>
@@ -16,6 +17,7 @@ namespace HDUI {
 LayoutParser::LayoutParser()
     : layoutWidth(1920)
     , layoutHeight(1080)
+    , loadedCompiled(false)
 {
 }
 
@@ -27,42 +29,41 @@ void LayoutParser::SetAssetBasePath(const std::string& path) {
 }
 
 std::unique_ptr<UIObject> LayoutParser::LoadLayout(const std::string& filepath) {
-    tinyxml2::XMLDocument doc;
-    
-    if (doc.LoadFile(filepath.c_str()) != tinyxml2::XML_SUCCESS) {
-        fprintf(stderr, "HD_UI: Failed to load layout: %s\n", filepath.c_str());
-        return nullptr;
+    BinaryImage image;
+    std::string binaryPath = CompiledPath(filepath, LAYOUT_BINARY_EXT);
+    
+    bool compiled = image.Map(binaryPath);
+    if (compiled && !image.IsLayout()) {
+        fprintf(stderr, "HD_UI: Ignoring invalid compiled layout: %s\n", binaryPath.c_str());
+        compiled = false;
+    } else if (compiled && image.IsStaleFor(filepath)) {
+        fprintf(stderr, "HD_UI: Compiled layout is out of date, using XML: %s\n", binaryPath.c_str());
+        compiled = false;
     }
     
-    tinyxml2::XMLElement* root = doc.FirstChildElement("layout");
-    if (!root) {
-        fprintf(stderr, "HD_UI: No <layout> root element in: %s\n", filepath.c_str());
-        return nullptr;
-    }
+    loadedCompiled = compiled;
     
-    // Get layout dimensions
-    layoutWidth = GetIntAttr(root, "w", 1920);
-    layoutHeight = GetIntAttr(root, "h", 1080);
-    
-    // Create root container
-    auto layout = std::unique_ptr<UIContainer>(new UIContainer());
-    layout->name = GetStringAttr(root, "name", "layout");
-    layout->w = (float)layoutWidth;
-    layout->h = (float)layoutHeight;
-    
-    // Parse all child elements
-    for (tinyxml2::XMLElement* child = root->FirstChildElement();
-         child != nullptr;
-         child = child->NextSiblingElement())
-    {
-        auto childObj = ParseElement(child);
-        if (childObj) {
-            layout->AddChild(std::move(childObj));
+    if (!compiled) {
+        tinyxml2::XMLDocument doc;
+        
+        if (doc.LoadFile(filepath.c_str()) != tinyxml2::XML_SUCCESS) {
+            fprintf(stderr, "HD_UI: Failed to load layout: %s\n", filepath.c_str());
+            return nullptr;
         }
+        
+        std::vector<char> bytes;
+        if (!CompileLayout(doc, std::vector<const BinaryImage*>(), bytes)) {
+            fprintf(stderr, "HD_UI: Failed to compile layout: %s\n", filepath.c_str());
+            return nullptr;
+        }
+        image.Adopt(bytes);
     }
     
-    printf("HD_UI: Loaded layout '%s' (%dx%d)\n", 
-           layout->name.c_str(), layoutWidth, layoutHeight);
+    auto layout = BuildLayout(image);
+    if (layout) {
+        printf("HD_UI: Loaded layout '%s' (%dx%d)\n", 
+               layout->name.c_str(), layoutWidth, layoutHeight);
+    }
     
     return layout;
 }
@@ -75,248 +76,143 @@ std::unique_ptr<UIObject> LayoutParser::ParseLayout(const std::string& xml) {
         return nullptr;
     }
     
-    tinyxml2::XMLElement* root = doc.FirstChildElement("layout");
-    if (!root) {
+    std::vector<char> bytes;
+    if (!CompileLayout(doc, std::vector<const BinaryImage*>(), bytes)) {
         return nullptr;
     }
     
-    layoutWidth = GetIntAttr(root, "w", 1920);
-    layoutHeight = GetIntAttr(root, "h", 1080);
-    
-    auto layout = std::unique_ptr<UIContainer>(new UIContainer());
-    layout->name = GetStringAttr(root, "name", "layout");
-    layout->w = (float)layoutWidth;
-    layout->h = (float)layoutHeight;
-    
-    for (tinyxml2::XMLElement* child = root->FirstChildElement();
-         child != nullptr;
-         child = child->NextSiblingElement())
-    {
-        auto childObj = ParseElement(child);
-        if (childObj) {
-            layout->AddChild(std::move(childObj));
-        }
+    BinaryImage image;
+    image.Adopt(bytes);
+    return BuildLayout(image);
+}
+
+std::unique_ptr<UIObject> LayoutParser::BuildLayout(const BinaryImage& image) {
+    const LayoutFileHeader& header = image.Layout();
+    layoutWidth = header.width;
+    layoutHeight = header.height;
+    
+    uint32_t index = 0;
+    auto layout = BuildNode(image, index);
+    if (!layout || index != header.numNodes) {
+        fprintf(stderr, "HD_UI: Corrupt compiled layout\n");
+        return nullptr;
     }
     
     return layout;
 }
 
-std::unique_ptr<UIObject> LayoutParser::ParseElement(tinyxml2::XMLElement* elem) {
-    if (!elem) return nullptr;
+std::unique_ptr<UIObject> LayoutParser::BuildNode(const BinaryImage& image, uint32_t& index) {
+    const LayoutFileHeader& header = image.Layout();
+    if (index >= header.numNodes) return nullptr;
     
-    const char* tagName = elem->Name();
+    const LayoutNode& node = image.Nodes()[index++];
     std::unique_ptr<UIObject> obj;
     
-    if (strcmp(tagName, "Container") == 0) {
-        obj = ParseContainer(elem);
-    } else if (strcmp(tagName, "Gradient") == 0) {
-        obj = ParseGradient(elem);
-    } else if (strcmp(tagName, "Rectangle") == 0) {
-        obj = ParseRectangle(elem);
-    } else if (strcmp(tagName, "Line") == 0) {
-        obj = ParseLine(elem);
-    } else if (strcmp(tagName, "TextPoint") == 0) {
-        obj = ParseTextPoint(elem);
-    } else if (strcmp(tagName, "Image") == 0) {
-        obj = ParseImage(elem);
-    } else if (strcmp(tagName, "ButtonStandard") == 0) {
-        obj = ParseButtonStandard(elem);
-    } else if (strcmp(tagName, "ButtonTextField") == 0) {
-        obj = ParseButtonTextField(elem);
-    } else if (strcmp(tagName, "GradStop") == 0) {
-        // GradStop is handled by ParseGradient parent
-        return nullptr;
-    } else {
-        fprintf(stderr, "HD_UI: Unknown element type: %s\n", tagName);
-        // Try parsing as generic container
-        obj = ParseContainer(elem);
+    switch ((LayoutNodeType)node.type) {
+    case LayoutNodeType::Gradient: {
+        if (node.firstStop > header.numStops || node.numStops > header.numStops - node.firstStop) {
+            return nullptr;
+        }
+        
+        auto gradient = std::unique_ptr<UIGradient>(new UIGradient());
+        gradient->subtype = image.String(node.subtype);
+        
+        const LayoutGradStop* stops = image.Stops() + node.firstStop;
+        for (uint32_t i = 0; i < node.numStops; i++) {
+            UIGradient::GradStop stop;
+            stop.location = stops[i].location;
+            stop.fillColor = image.String(stops[i].fillColor);
+            gradient->stops.push_back(stop);
+        }
+        obj = std::move(gradient);
+        break;
     }
     
-    return obj;
-}
-
-std::unique_ptr<UIObject> LayoutParser::ParseContainer(tinyxml2::XMLElement* elem) {
-    auto obj = std::unique_ptr<UIContainer>(new UIContainer());
-    ParseCommonAttributes(elem, obj.get());
-    
-    // Parse children
-    for (tinyxml2::XMLElement* child = elem->FirstChildElement();
-         child != nullptr;
-         child = child->NextSiblingElement())
-    {
-        auto childObj = ParseElement(child);
-        if (childObj) {
-            obj->AddChild(std::move(childObj));
-        }
+    case LayoutNodeType::Rectangle: {
+        auto rect = std::unique_ptr<UIRectangle>(new UIRectangle());
+        rect->subtype = image.String(node.subtype);
+        rect->fillColor = image.String(node.fillColor);
+        rect->fillAlpha = node.fillAlpha;
+        rect->strokeColor = image.String(node.strokeColor);
+        rect->strokeWidth = node.strokeWidth;
+        obj = std::move(rect);
+        break;
     }
     
-    return obj;
-}
-
-std::unique_ptr<UIObject> LayoutParser::ParseGradient(tinyxml2::XMLElement* elem) {
-    auto obj = std::unique_ptr<UIGradient>(new UIGradient());
-    ParseCommonAttributes(elem, obj.get());
-    obj->subtype = GetStringAttr(elem, "subtype", "gradVertical");
+    case LayoutNodeType::Line: {
+        auto line = std::unique_ptr<UILine>(new UILine());
+        line->x1 = node.x1;
+        line->y1 = node.y1;
+        line->x2 = node.x2;
+        line->y2 = node.y2;
+        line->strokeColor = image.String(node.strokeColor);
+        line->strokeWidth = node.strokeWidth;
+        obj = std::move(line);
+        break;
+    }
     
-    // Parse GradStop children
-    for (tinyxml2::XMLElement* child = elem->FirstChildElement("GradStop");
-         child != nullptr;
-         child = child->NextSiblingElement("GradStop"))
-    {
-        UIGradient::GradStop stop;
-        stop.location = GetFloatAttr(child, "location", 0.0f);
-        stop.fillColor = GetStringAttr(child, "fillColor", "000000");
-        obj->stops.push_back(stop);
+    case LayoutNodeType::TextPoint: {
+        auto text = std::unique_ptr<UITextPoint>(new UITextPoint());
+        text->text = image.String(node.text);
+        text->font = image.String(node.font);
+        text->fontSize = node.fontSize;
+        text->fillColor = image.String(node.fillColor);
+        text->align = (TextAlign)node.align;
+        obj = std::move(text);
+        break;
     }
     
-    // Parse other children
-    for (tinyxml2::XMLElement* child = elem->FirstChildElement();
-         child != nullptr;
-         child = child->NextSiblingElement())
-    {
-        if (strcmp(child->Name(), "GradStop") != 0) {
-            auto childObj = ParseElement(child);
-            if (childObj) {
-                obj->AddChild(std::move(childObj));
+    case LayoutNodeType::Image: {
+        auto img = std::unique_ptr<UIImage>(new UIImage());
+        img->file = image.String(node.file);
+        
+        // Load the bitmap if we have an asset path, using the atlas index
+        // resolved by the compiler when it still matches the loaded atlas
+        if (!img->file.empty() && !assetBasePath.empty()) {
+            ALLEGRO_BITMAP* tex = AtlasManager::GetInstance().GetTexture(node.atlasStamp, node.texture);
+            if (tex) {
+                img->bitmap = (void*)tex;
+                img->ownsbitmap = false;
+            } else {
+                img->LoadBitmap(assetBasePath);
             }
         }
+        obj = std::move(img);
+        break;
     }
     
-    return obj;
-}
-
-std::unique_ptr<UIObject> LayoutParser::ParseRectangle(tinyxml2::XMLElement* elem) {
-    auto obj = std::unique_ptr<UIRectangle>(new UIRectangle());
-    ParseCommonAttributes(elem, obj.get());
-    
-    obj->subtype = GetStringAttr(elem, "subtype", "filled");
-    obj->fillColor = GetStringAttr(elem, "fillColor", "FFFFFF");
-    obj->fillAlpha = GetFloatAttr(elem, "fillA", 1.0f);
-    obj->strokeColor = GetStringAttr(elem, "strokeColor", "FFFFFF");
-    obj->strokeWidth = GetFloatAttr(elem, "strokeW", 1.0f);
-    
-    return obj;
-}
-
-std::unique_ptr<UIObject> LayoutParser::ParseLine(tinyxml2::XMLElement* elem) {
-    auto obj = std::unique_ptr<UILine>(new UILine());
-    ParseCommonAttributes(elem, obj.get());
+    case LayoutNodeType::ButtonStandard:
+        obj = std::unique_ptr<UIObject>(new UIButtonStandard());
+        break;
     
-    obj->x1 = GetFloatAttr(elem, "x1", 0.0f);
-    obj->y1 = GetFloatAttr(elem, "y1", 0.0f);
-    obj->x2 = GetFloatAttr(elem, "x2", 0.0f);
-    obj->y2 = GetFloatAttr(elem, "y2", 0.0f);
-    obj->strokeColor = GetStringAttr(elem, "strokeColor", "FFFFFF");
-    obj->strokeWidth = GetFloatAttr(elem, "strokeW", 1.0f);
+    case LayoutNodeType::ButtonTextField:
+        obj = std::unique_ptr<UIObject>(new UIButtonTextField());
+        break;
     
-    return obj;
-}
-
-std::unique_ptr<UIObject> LayoutParser::ParseTextPoint(tinyxml2::XMLElement* elem) {
-    auto obj = std::unique_ptr<UITextPoint>(new UITextPoint());
-    ParseCommonAttributes(elem, obj.get());
-    
-    obj->text = GetStringAttr(elem, "text", "");
-    obj->font = GetStringAttr(elem, "font", "AeroMaticsRegular");
-    obj->fontSize = GetIntAttr(elem, "size", 18);
-    obj->fillColor = GetStringAttr(elem, "fillColor", "FFFFFF");
-    
-    std::string align = GetStringAttr(elem, "align", "left");
-    if (align == "center") obj->align = TextAlign::Center;
-    else if (align == "right") obj->align = TextAlign::Right;
-    else obj->align = TextAlign::Left;
-    
-    return obj;
-}
-
-std::unique_ptr<UIObject> LayoutParser::ParseImage(tinyxml2::XMLElement* elem) {
-    auto obj = std::unique_ptr<UIImage>(new UIImage());
-    ParseCommonAttributes(elem, obj.get());
-    
-    obj->file = GetStringAttr(elem, "file", "");
-    
-    // Load the bitmap if we have an asset path
-    if (!obj->file.empty() && !assetBasePath.empty()) {
-        obj->LoadBitmap(assetBasePath);
-    }
-    
-    return obj;
-}
-
-std::unique_ptr<UIObject> LayoutParser::ParseButtonStandard(tinyxml2::XMLElement* elem) {
-    auto obj = std::unique_ptr<UIButtonStandard>(new UIButtonStandard());
-    ParseCommonAttributes(elem, obj.get());
-    
-    // Parse children (gfxStandard, gfxHover, gfxClick, etc.)
-    for (tinyxml2::XMLElement* child = elem->FirstChildElement();
-         child != nullptr;
-         child = child->NextSiblingElement())
-    {
-        auto childObj = ParseElement(child);
-        if (childObj) {
-            obj->AddChild(std::move(childObj));
-        }
+    default:
+        obj = std::unique_ptr<UIObject>(new UIContainer());
+        break;
     }
     
-    return obj;
-}
-
-std::unique_ptr<UIObject> LayoutParser::ParseButtonTextField(tinyxml2::XMLElement* elem) {
-    auto obj = std::unique_ptr<UIButtonTextField>(new UIButtonTextField());
-    ParseCommonAttributes(elem, obj.get());
-    
-    // Parse children
-    for (tinyxml2::XMLElement* child = elem->FirstChildElement();
-         child != nullptr;
-         child = child->NextSiblingElement())
-    {
-        auto childObj = ParseElement(child);
-        if (childObj) {
-            obj->AddChild(std::move(childObj));
-        }
+    obj->name = image.String(node.name);
+    obj->x = node.x;
+    obj->y = node.y;
+    obj->w = node.w;
+    obj->h = node.h;
+    obj->alpha = node.alpha;
+    obj->scalingType = (ScalingType)node.scalingType;
+    obj->arrangeType = (ArrangeType)node.arrangeType;
+    obj->arrangePadding = node.arrangePadding;
+    
+    for (uint32_t i = 0; i < node.numChildren; i++) {
+        auto child = BuildNode(image, index);
+        if (!child) return nullptr;
+        obj->AddChild(std::move(child));
     }
     
     return obj;
 }
 
-void LayoutParser::ParseCommonAttributes(tinyxml2::XMLElement* elem, UIObject* obj) {
-    obj->name = GetStringAttr(elem, "name", "");
-    obj->x = GetFloatAttr(elem, "x", 0.0f);
-    obj->y = GetFloatAttr(elem, "y", 0.0f);
-    obj->w = GetFloatAttr(elem, "w", 0.0f);
-    obj->h = GetFloatAttr(elem, "h", 0.0f);
-    obj->alpha = GetFloatAttr(elem, "alpha", 1.0f);
-    
-    std::string scalingStr = GetStringAttr(elem, "scalingType", "scaleNormal");
-    if (scalingStr == "scaleByHeight") obj->scalingType = ScalingType::ScaleByHeight;
-    else if (scalingStr == "scaleByWidth") obj->scalingType = ScalingType::ScaleByWidth;
-    else obj->scalingType = ScalingType::ScaleNormal;
-    
-    std::string arrangeStr = GetStringAttr(elem, "arrangeType", "arrangeFree");
-    if (arrangeStr == "arrangeHorizontal") obj->arrangeType = ArrangeType::ArrangeHorizontal;
-    else if (arrangeStr == "arrangeVertical") obj->arrangeType = ArrangeType::ArrangeVertical;
-    else obj->arrangeType = ArrangeType::ArrangeFree;
-    
-    obj->arrangePadding = GetFloatAttr(elem, "arrangePadding", 0.0f);
-}
-
-float LayoutParser::GetFloatAttr(tinyxml2::XMLElement* elem, const char* name, float def) {
-    float val = def;
-    elem->QueryFloatAttribute(name, &val);
-    return val;
-}
-
-int LayoutParser::GetIntAttr(tinyxml2::XMLElement* elem, const char* name, int def) {
-    int val = def;
-    elem->QueryIntAttribute(name, &val);
-    return val;
-}
-
-std::string LayoutParser::GetStringAttr(tinyxml2::XMLElement* elem, const char* name, const char* def) {
-    const char* val = elem->Attribute(name);
-    return val ? std::string(val) : std::string(def);
-}
-
 // ============================================================================
 // LayoutManager
 // ============================================================================
@@ -1,23 +1,19 @@
 /*
  * HD_UI Layout Parser
- * Parses XML layout files into UIObject trees using TinyXML2
+ * Builds UIObject trees from compiled layouts, compiling the XML on the fly
+ * when there is no up to date binary beside it
  */
 
 #ifndef _included_hd_layout_parser_h
 #define _included_hd_layout_parser_h
 
 #include "hd_ui_object.h"
+#include "hd_layout_binary.h"
 #include <string>
 #include <memory>
 #include <map>
 
 
-// Forward declare tinyxml2 types
-namespace tinyxml2 {
-    class XMLElement;
-    class XMLDocument;
-}
-
 namespace HDUI {
 
 class LayoutParser {
@@ -25,7 +21,7 @@ public:
     LayoutParser();
     ~LayoutParser();
     
-    // Load a layout from XML file
+    // Load a layout from XML file, or its compiled form if that is current
     std::unique_ptr<UIObject> LoadLayout(const std::string& filepath);
     
     // Parse a layout from XML string
@@ -34,35 +30,22 @@ public:
     // Set base path for finding assets (images, fonts)
     void SetAssetBasePath(const std::string& path);
     
+    // True if the last LoadLayout mapped a compiled layout rather than the XML
+    bool LoadedCompiled() const { return loadedCompiled; }
+    
     // Get layout dimensions
     int GetLayoutWidth() const { return layoutWidth; }
     int GetLayoutHeight() const { return layoutHeight; }
     
 private:
-    // Parse element tree recursively
-    std::unique_ptr<UIObject> ParseElement(tinyxml2::XMLElement* elem);
-    
-    // Element type parsers
-    std::unique_ptr<UIObject> ParseContainer(tinyxml2::XMLElement* elem);
-    std::unique_ptr<UIObject> ParseGradient(tinyxml2::XMLElement* elem);
-    std::unique_ptr<UIObject> ParseRectangle(tinyxml2::XMLElement* elem);
-    std::unique_ptr<UIObject> ParseLine(tinyxml2::XMLElement* elem);
-    std::unique_ptr<UIObject> ParseTextPoint(tinyxml2::XMLElement* elem);
-    std::unique_ptr<UIObject> ParseImage(tinyxml2::XMLElement* elem);
-    std::unique_ptr<UIObject> ParseButtonStandard(tinyxml2::XMLElement* elem);
-    std::unique_ptr<UIObject> ParseButtonTextField(tinyxml2::XMLElement* elem);
-    
-    // Parse common attributes into UIObject
-    void ParseCommonAttributes(tinyxml2::XMLElement* elem, UIObject* obj);
-    
-    // Helper to read attributes with defaults
-    float GetFloatAttr(tinyxml2::XMLElement* elem, const char* name, float def = 0.0f);
-    int GetIntAttr(tinyxml2::XMLElement* elem, const char* name, int def = 0);
-    std::string GetStringAttr(tinyxml2::XMLElement* elem, const char* name, const char* def = "");
+    // Build the tree from a compiled layout
+    std::unique_ptr<UIObject> BuildLayout(const BinaryImage& image);
+    std::unique_ptr<UIObject> BuildNode(const BinaryImage& image, uint32_t& index);
     
     std::string assetBasePath;
     int layoutWidth;
     int layoutHeight;
+    bool loadedCompiled;
 };
 
 // Layout manager - caches loaded layouts
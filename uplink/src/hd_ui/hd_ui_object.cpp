@@ -25,6 +25,9 @@ UIObject::UIObject()
     , arrangePadding(0)
     , isHovered(false)
     , isPressed(false)
+    , absX(0), absY(0)
+    , transformDirty(true)
+    , styleDirty(true)
 {
 }
 
@@ -76,6 +79,7 @@ void UIObject::OnClick() {
 void UIObject::AddChild(std::unique_ptr<UIObject> child) {
     if (child) {
         child->parent = this;
+        child->InvalidateTransform();
         children.push_back(std::move(child));
     }
 }
@@ -120,15 +124,38 @@ void UIObject::ClearChildren() {
     children.clear();
 }
 
+void UIObject::SetPosition(float newX, float newY) {
+    x = newX;
+    y = newY;
+    InvalidateTransform();
+}
+
+void UIObject::InvalidateTransform() {
+    // Children are relative to us, so they move too
+    if (transformDirty) return;
+    transformDirty = true;
+    for (auto& child : children) {
+        if (child) child->InvalidateTransform();
+    }
+}
+
+void UIObject::ResolveTransform() const {
+    absX = x;
+    absY = y;
+    if (parent) {
+        absX += parent->GetAbsoluteX();
+        absY += parent->GetAbsoluteY();
+    }
+    transformDirty = false;
+}
+
 float UIObject::GetAbsoluteX() const {
-    float absX = x;
-    if (parent) absX += parent->GetAbsoluteX();
+    if (transformDirty) ResolveTransform();
     return absX;
 }
 
 float UIObject::GetAbsoluteY() const {
-    float absY = y;
-    if (parent) absY += parent->GetAbsoluteY();
+    if (transformDirty) ResolveTransform();
     return absY;
 }
 
@@ -157,15 +184,22 @@ void UIContainer::Draw() {
 UIGradient::UIGradient() : UIObject(), subtype("gradVertical") {}
 UIGradient::~UIGradient() {}
 
+void UIGradient::ResolveStyle() {
+    // Only the first and last stops are drawn
+    if (stops.size() < 2) return;
+    topColor = Color::FromHex(stops.front().fillColor.c_str());
+    bottomColor = Color::FromHex(stops.back().fillColor.c_str());
+}
+
 void UIGradient::Draw() {
     if (!visible || stops.size() < 2) return;
+    EnsureStyle();
     
     float ax = GetAbsoluteX();
     float ay = GetAbsoluteY();
     
-    // Get first and last stop colors
-    Color c1 = Color::FromHex(stops.front().fillColor.c_str());
-    Color c2 = Color::FromHex(stops.back().fillColor.c_str());
+    Color c1 = topColor;
+    Color c2 = bottomColor;
     c1.a *= alpha;
     c2.a *= alpha;
     
@@ -185,32 +219,34 @@ UIRectangle::UIRectangle()
     , subtype("filled")
     , fillAlpha(1.0f)
     , strokeWidth(1.0f)
+    , drawFill(false)
+    , drawStroke(false)
 {}
 
 UIRectangle::~UIRectangle() {}
 
+void UIRectangle::ResolveStyle() {
+    fill = Color::FromHex(fillColor.c_str());
+    stroke = Color::FromHex(strokeColor.c_str());
+    drawFill = (subtype == "filled" || subtype == "strokedFill");
+    drawStroke = (subtype == "stroked" || subtype == "strokedFill");
+}
+
 void UIRectangle::Draw() {
     if (!visible) return;
+    EnsureStyle();
     
     float ax = GetAbsoluteX();
     float ay = GetAbsoluteY();
     
-    Color fill = Color::FromHex(fillColor.c_str());
-    fill.a = fillAlpha * alpha;
-    
-    Color stroke = Color::FromHex(strokeColor.c_str());
-    stroke.a *= alpha;
-    
-    if (subtype == "filled" || subtype == "strokedFill") {
+    if (drawFill) {
         Allegro5System::DrawRectFilled(ax, ay, w, h,
-            fill.r, fill.g, fill.b, fill.a);
+            fill.r, fill.g, fill.b, fillAlpha * alpha);
     }
     
-    if (subtype == "stroked" || subtype == "strokedFill") {
-        if (strokeWidth > 0) {
-            Allegro5System::DrawRectOutline(ax, ay, w, h,
-                stroke.r, stroke.g, stroke.b, stroke.a, strokeWidth);
-        }
+    if (drawStroke && strokeWidth > 0) {
+        Allegro5System::DrawRectOutline(ax, ay, w, h,
+            stroke.r, stroke.g, stroke.b, stroke.a * alpha, strokeWidth);
     }
     
     UIObject::Draw();
@@ -228,13 +264,18 @@ UILine::UILine()
 
 UILine::~UILine() {}
 
+void UILine::ResolveStyle() {
+    stroke = Color::FromHex(strokeColor.c_str());
+}
+
 void UILine::Draw() {
     if (!visible) return;
+    EnsureStyle();
     
     float ax = GetAbsoluteX();
     float ay = GetAbsoluteY();
     
-    Color c = Color::FromHex(strokeColor.c_str());
+    Color c = stroke;
     c.a *= alpha;
     
     Allegro5System::DrawLine(ax + x1, ay + y1, ax + x2, ay + y2,
@@ -255,13 +296,18 @@ UITextPoint::UITextPoint()
 
 UITextPoint::~UITextPoint() {}
 
+void UITextPoint::ResolveStyle() {
+    fill = Color::FromHex(fillColor.c_str());
+}
+
 void UITextPoint::Draw() {
     if (!visible || text.empty()) return;
+    EnsureStyle();
     
     float ax = GetAbsoluteX();
     float ay = GetAbsoluteY();
     
-    Color c = Color::FromHex(fillColor.c_str());
+    Color c = fill;
     c.a *= alpha;
     
     // TODO: Use actual font from font manager
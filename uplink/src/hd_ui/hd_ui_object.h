@@ -11,6 +11,8 @@
 #include <memory>
 #include <functional>
 
+#include "hd_allegro5.h"
+
 namespace HDUI {
 
 // Forward declarations
@@ -74,9 +76,15 @@ public:
     void ClearChildren();
     
     // Coordinate helpers
+    // Absolute positions are cached - move laid out objects with SetPosition
+    void SetPosition(float newX, float newY);
+    void InvalidateTransform();
     float GetAbsoluteX() const;
     float GetAbsoluteY() const;
     bool ContainsPoint(float px, float py) const;
+
+    // Call after changing colour strings so they are parsed again
+    void InvalidateStyle() { styleDirty = true; }
     
     // State
     bool isHovered;
@@ -88,6 +96,23 @@ public:
     
     // Type identification
     virtual const char* GetTypeName() const { return "UIObject"; }
+
+protected:
+    // Parses colour strings into the cached colours used by Draw
+    virtual void ResolveStyle() {}
+    void EnsureStyle() {
+        if (styleDirty) {
+            ResolveStyle();
+            styleDirty = false;
+        }
+    }
+
+private:
+    void ResolveTransform() const;
+
+    mutable float absX, absY;
+    mutable bool transformDirty;
+    bool styleDirty;
 };
 
 // Text rendering alignment
@@ -123,6 +148,12 @@ public:
     
     void Draw() override;
     const char* GetTypeName() const override { return "Gradient"; }
+
+protected:
+    void ResolveStyle() override;
+
+private:
+    Color topColor, bottomColor;
 };
 
 // Rectangle
@@ -139,6 +170,13 @@ public:
     
     void Draw() override;
     const char* GetTypeName() const override { return "Rectangle"; }
+
+protected:
+    void ResolveStyle() override;
+
+private:
+    Color fill, stroke;
+    bool drawFill, drawStroke;
 };
 
 // Line
@@ -153,6 +191,12 @@ public:
     
     void Draw() override;
     const char* GetTypeName() const override { return "Line"; }
+
+protected:
+    void ResolveStyle() override;
+
+private:
+    Color stroke;
 };
 
 // Text point (single line text)
@@ -169,6 +213,12 @@ public:
     
     void Draw() override;
     const char* GetTypeName() const override { return "TextPoint"; }
+
+protected:
+    void ResolveStyle() override;
+
+private:
+    Color fill;
 };
 
 // Image
@@ -87,8 +87,8 @@ void AnalyserInterface::SystemClick ( Button *button )
 void AnalyserInterface::ConnectionDraw ( Button *button, bool highlighted, bool clicked )
 {
 
-	int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-	int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+	int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+	int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	int paneltop = (int)(100.0 * ( (screenw * PANELSIZE) / 188.0 ) + 30);
 	int panelwidth = (int)(screenw * PANELSIZE);
 
@@ -106,13 +106,13 @@ void AnalyserInterface::ConnectionDraw ( Button *button, bool highlighted, bool
 	//
 
 	glBegin ( GL_QUADS );
-		SetColour("PanelBackgroundA");		glVertex2i ( button->x, button->y + button->height );
-		SetColour("PanelBackgroundB");  	glVertex2i ( button->x, button->y );
-		SetColour("PanelBackgroundA");		glVertex2i ( button->x + button->width, button->y );
-		SetColour("PanelBackgroundB");		glVertex2i ( button->x + button->width, button->y + button->height );
+		SetColour(COLOUR_PANELBACKGROUNDA);		glVertex2i ( button->x, button->y + button->height );
+		SetColour(COLOUR_PANELBACKGROUNDB);  	glVertex2i ( button->x, button->y );
+		SetColour(COLOUR_PANELBACKGROUNDA);		glVertex2i ( button->x + button->width, button->y );
+		SetColour(COLOUR_PANELBACKGROUNDB);		glVertex2i ( button->x + button->width, button->y + button->height );
 	glEnd ();
 
-	SetColour("PanelBorder");
+	SetColour(COLOUR_PANELBORDER);
 	border_draw ( button );
 
 	//
@@ -198,8 +198,8 @@ void AnalyserInterface::Create ()
 
 		UplinkStrncpy ( remotehost, " ", sizeof ( remotehost ) );
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		int paneltop = (int)(100.0 * ( (screenw * PANELSIZE) / 188.0 )) + 30;
 		int panelwidth = (int)(screenw * PANELSIZE);
 
@@ -297,8 +297,8 @@ void AnalyserInterface::Update ()
 
 		// Get screen dimensions
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		int paneltop = (int)(100.0 * ( (screenw * PANELSIZE) / 188.0 )) + 30;
 		int panelwidth = (int)(screenw * PANELSIZE);
 
@@ -150,7 +150,7 @@ void CheatInterface::ShowLANClick ( Button *button )
 
 			LanComputerLink *link = lan->links.GetData(j);
 			UplinkAssert (link);
-			link->visible = LANLINKVISIBLE_AWARE;
+			link->IncreaseVisibility ( LANLINKVISIBLE_AWARE );
 
 		}
 	}
@@ -180,8 +180,8 @@ void CheatInterface::Create ()
 
 		LocalInterfaceScreen::Create ();
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		int paneltop = (int)(100.0 * ( (screenw * PANELSIZE) / 188.0 )) + 30;
 		int panelwidth = (int)(screenw * PANELSIZE);
 
@@ -144,8 +144,8 @@ void EmailInterface::Create ()
 
 	if ( !IsVisible () ) {
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		int paneltop = (int)(100.0 * ( screenw * PANELSIZE / 188.0 )) + 30;
 		int panelwidth = (int)(screenw * PANELSIZE);
 
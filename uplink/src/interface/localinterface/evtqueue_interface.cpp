@@ -96,7 +96,7 @@ void EventQueueInterface::EventDraw ( Button *button, bool highlighted, bool cli
 
 		button_draw ( button, highlighted, clicked );
 
-		int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+		int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 		glEnable ( GL_SCISSOR_TEST );
 
@@ -131,8 +131,8 @@ void EventQueueInterface::EventClick ( Button *button )
 
 	if ( index < game->GetWorld ()->scheduler.events.Size () ) {
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		int paneltop = (int)(100.0 * ( screenw * PANELSIZE / 188.0 )) + 30;
 		int panelwidth = (int)(screenw * PANELSIZE);
 
@@ -186,8 +186,8 @@ void EventQueueInterface::Create ()
 
 	if ( !IsVisible () ) {
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		int paneltop = (int)(100.0 * ( screenw * PANELSIZE / 188.0 )) + 30;
 		int panelwidth = (int)(screenw * PANELSIZE);
 
@@ -69,7 +69,7 @@ static void FinanceInterfaceTextDrawSplit ( Button *button, bool highlighted, bo
 	if ( !button->caption )
 		return;
 
-	SetColour ( "DefaultText" );
+	SetColour ( COLOUR_DEFAULTTEXT );
 
 	int xdistance[] = {0, 55, 150, 220};
 	char splitString[256];
@@ -107,7 +107,7 @@ void FinanceInterface::DrawAccountsTitle ( Button *button, bool highlighted, boo
 
 	FinanceInterfaceTextDrawSplit ( button, highlighted, clicked );
 
-	SetColour ( "TitleText" );
+	SetColour ( COLOUR_TITLETEXT );
 
 	glBegin ( GL_LINES );
 		glVertex2i ( button->x, button->y + button->height );
@@ -242,7 +242,7 @@ void FinanceInterface::Create ()
 
 		LocalInterfaceScreen::Create ();
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
 		int paneltop = (int) ( 100.0 * ( (screenw * PANELSIZE) / 188.0 ) + 30 );
 		int panelwidth = (int) ( screenw * PANELSIZE );
 
@@ -319,7 +319,7 @@ void FinanceInterface::Update ()
 
 		if ( previousnumaccounts < game->GetWorld ()->GetPlayer ()->accounts.Size () ) {
 
-			int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
+			int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
 			int paneltop = (int) ( 100.0 * ( (screenw * PANELSIZE) / 188.0 ) + 30 );
 			int panelwidth = (int) ( screenw * PANELSIZE );
 
@@ -97,8 +97,8 @@ void HUDInterface::CloseGame ()
 	app->SaveGame ( game->GetWorld ()->GetPlayer ()->handle );
 	game->SetGameSpeed ( GAMESPEED_PAUSED );
 
-    EclReset ( app->GetOptions ()->GetOptionValue ("graphics_screenwidth"),
-			   app->GetOptions ()->GetOptionValue ("graphics_screenheight") );
+    EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+			   app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
 	app->GetMainMenu ()->RunScreen ( MAINMENU_LOGIN );
 
 }
@@ -501,7 +501,7 @@ void HUDInterface::Create ()
 
 	if ( !IsVisible () ) {
 
-		int screenh = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 		// Main world map 
 
@@ -631,7 +631,7 @@ void HUDInterface::AddUpgrade ( char upgrade )
         if ( theUpgrade ) {
 
             int xPos = 195 + 27 * insertedAt;
-		    int screenh = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+		    int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 		    EclRegisterButton ( 60, screenh - 42, 24, 24, theUpgrade->name, theUpgrade->tooltip, theUpgrade->buttonName );
 		    button_assignbitmaps ( theUpgrade->buttonName, theUpgrade->buttonFilename, theUpgrade->buttonFilename_h, theUpgrade->buttonFilename_c );
@@ -671,8 +671,8 @@ void HUDInterface::Update ()
 
 	if ( IsVisible () ) {
 
-		int screenw = app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" );
-		int screenh = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 		// Update the location, date/time 
 
@@ -51,7 +51,7 @@ void HWInterface::ShowGatewayClick ( Button *button )
 void HWInterface::MiniTitleDraw ( Button *button, bool highlighted, bool clicked )
 {
 
-	SetColour ( "TitleText" );
+	SetColour ( COLOUR_TITLETEXT );
 	GciDrawText ( button->x + 10, button->y + 10, button->caption, HELVETICA_18 );
 
 }
@@ -61,8 +61,8 @@ void HWInterface::CreateHWInterface ()
 
 	if ( !IsVisibleHWInterface () ) {
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		//int paneltop = SX(100) + 30;
 		int paneltop = (int) ( 100.0 * ( (screenw * PANELSIZE) / 188.0 ) + 30 );
 		int panelwidth = (int) ( screenw * PANELSIZE );
@@ -34,8 +34,11 @@
 #define min(a,b) (((a) < (b)) ? (a) : (b))
 
 bool IRCInterface::connected = false;
-LList <UplinkIRCMessage *> IRCInterface::buffer;
-LList <UplinkIRCUser *> IRCInterface::users;
+UplinkIRCMessage *IRCInterface::buffer [IRCBUFFERSIZE];
+int IRCInterface::bufferStart = 0;
+int IRCInterface::bufferSize = 0;
+BTree <UplinkIRCUser *> IRCInterface::users;
+DArray <UplinkIRCUser *> *IRCInterface::sortedUsers = NULL;
 
 char IRCInterface::channelName[256];
 
@@ -66,7 +69,7 @@ void IRCInterface::MainTextDraw ( Button *button, bool highlighted, bool clicked
 
     // Clipping
 
-	int screenh = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenh - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -89,10 +92,9 @@ void IRCInterface::MainTextDraw ( Button *button, bool highlighted, bool clicked
 
         int thisRow = baseOffset + i + 1;
 
-		if ( buffer.ValidIndex (thisRow) ) {
+		UplinkIRCMessage *msg = GetLine (thisRow);
 
-			UplinkIRCMessage *msg = buffer.GetData(thisRow);
-			UplinkAssert (msg);
+		if ( msg ) {
 
 			int xpos = button->x + 10;
 			int ypos = button->y + 10 + i * 15;
@@ -107,12 +109,13 @@ void IRCInterface::MainTextDraw ( Button *button, bool highlighted, bool clicked
             glColor3f( msg->red, msg->green, msg->blue );
           	GciDrawText ( xpos, ypos, msg->text );
 			
-            AddEmoticons ( i, ":)", imgSmileyHappy );
-            AddEmoticons ( i, "=)", imgSmileyHappy );
-            AddEmoticons ( i, ":-)", imgSmileyHappy );
-            AddEmoticons ( i, ":(", imgSmileySad );
-            AddEmoticons ( i, ":-(", imgSmileySad );
-            AddEmoticons ( i, ";)", imgSmileyWink );
+            // Smileys were found when the line was added
+
+            Image *smileys [] = { imgSmileyHappy, imgSmileySad, imgSmileyWink };
+
+            for ( int s = 0; s < msg->numSmileys; ++s )
+                if ( smileys [msg->smileyType [s]] )
+                    smileys [msg->smileyType [s]]->Draw ( xpos + msg->smileyX [s], ypos - 7 );
 
 		}
 
@@ -122,51 +125,6 @@ void IRCInterface::MainTextDraw ( Button *button, bool highlighted, bool clicked
 
 }
 
-void IRCInterface::AddEmoticons ( int row, char *smiley, Image *imgSmiley )
-{
-
-    ScrollBox *scrollBox = ScrollBox::GetScrollBox( "ircscroller" );
-    if ( !scrollBox ) return;
-    int baseOffset = scrollBox->currentIndex;
-	if ( scrollBox->numItems < scrollBox->windowSize )
-		baseOffset = scrollBox->numItems - scrollBox->windowSize;
-
-    int thisRow = baseOffset + row + 1;
-
-	if ( buffer.ValidIndex (thisRow) ) {
-
-		UplinkIRCMessage *msg = buffer.GetData(thisRow);
-		UplinkAssert (msg);
-
-        Button *button = EclGetButton ( "irc_maintext" );
-        if ( !button ) return;
-
-		int xpos = button->x + 10;
-		int ypos = button->y + 10 + row * 15;
-        if ( msg->user ) xpos += 80;
-        
-        if ( imgSmiley ) {
-
-            char *nextSmiley = strstr ( msg->text, smiley );
-            
-            while ( nextSmiley ) {
-                char textSoFar [2048];
-				size_t lenCopy = min ( (nextSmiley - msg->text) + 1, sizeof ( textSoFar ) );
-                strncpy ( textSoFar, msg->text, lenCopy );
-                //textSoFar [ nextSmiley-msg->text ] = '\x0';
-				textSoFar [ lenCopy - 1 ] = '\x0';
-                int smileyXpos = xpos + GciTextWidth ( textSoFar );
-                nextSmiley = strstr ( (nextSmiley+2), smiley );
-
-                imgSmiley->Draw ( smileyXpos, ypos - 7 );                
-            }
-
-        }
-
-    }
-
-}
-
 void IRCInterface::ConnectDraw ( Button *button, bool highlighted, bool clicked )
 {
 
@@ -190,7 +148,7 @@ void IRCInterface::BackBlackoutDraw ( Button *button, bool highlighted, bool cli
 void IRCInterface::UserListDraw ( Button *button, bool highlighted, bool clicked )
 {
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -204,19 +162,21 @@ void IRCInterface::UserListDraw ( Button *button, bool highlighted, bool clicked
     if ( connected ) {
 
         int xpos = button->x + 20;
+        DArray <UplinkIRCUser *> *sorted = GetSortedUsers ();
 
         for ( int i = 0; i < numRows; ++i ) {
 
-            if ( users.ValidIndex( i + baseOffset ) ) {
+            if ( sorted->ValidIndex( i + baseOffset ) ) {
 
+                UplinkIRCUser *user = sorted->GetData(i + baseOffset);
                 int ypos = button->y + 20 + i * 17;
             
-                if ( users.GetData(i + baseOffset)->status == 0 ) 
+                if ( user->status == 0 ) 
                     glColor3f ( 1.0f, 1.0f, 1.0f );
                 else
                     glColor3f ( 1.0f, 0.5f, 0.5f );
 
-                GciDrawText ( xpos, ypos, users.GetData(i + baseOffset)->name ); 
+                GciDrawText ( xpos, ypos, user->name ); 
 
             }
 
@@ -247,12 +207,7 @@ void IRCInterface::ConnectClick ( Button *button )
         
         ResetUsers();
         thisint->RemoveTalkWindow();
-
-		for ( int i = 0; i < buffer.Size (); ++i )
-			if ( buffer.ValidIndex ( i ) )
-				delete buffer.GetData ( i );
-
-		buffer.Empty();
+		EmptyBuffer();
 
 		connected = false;
         
@@ -261,12 +216,7 @@ void IRCInterface::ConnectClick ( Button *button )
 
 		thisint->CreateTalkWindow();
         ResetUsers ();
-        
-		for ( int i = 0; i < buffer.Size (); ++i )
-			if ( buffer.ValidIndex ( i ) )
-				delete buffer.GetData ( i );
-
-		buffer.Empty();
+		EmptyBuffer();
 
 		winSockInit = new WinsockInit();
         cIrcSession = new CIrcSession();
@@ -365,8 +315,8 @@ void IRCInterface::AddText ( char *user, const char *text, float r, float g, flo
 
 	// Break up the text into word wrapped lines
 	
-	int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-	int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+	int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+	int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	//int mainWidth = (int) ( screenw * 0.65 );
 	// Dimension to match linksscreen_interface.cpp
 	int mainWidth = 50 + SY(375) + 15;
@@ -385,10 +335,24 @@ void IRCInterface::AddText ( char *user, const char *text, float r, float g, flo
 			char *theLine = wrapped->GetData(i);
 			UplinkAssert (theLine);
 			if ( strlen(theLine) > 0 ) {
-				UplinkIRCMessage *msg = new UplinkIRCMessage ();
+
+				// Once full, the oldest line makes way
+
+				UplinkIRCMessage *msg;
+				if ( bufferSize < IRCBUFFERSIZE ) {
+					msg = new UplinkIRCMessage ();
+					buffer [( bufferStart + bufferSize ) % IRCBUFFERSIZE] = msg;
+					++bufferSize;
+				}
+				else {
+					msg = buffer [bufferStart];
+					bufferStart = ( bufferStart + 1 ) % IRCBUFFERSIZE;
+				}
+
 				char *thisuser = ( i == 0 ? user : NULL );
 				msg->Set ( thisuser, theLine, r, g, b );
-				buffer.PutDataAtEnd( msg );
+				msg->FindEmoticons ();
+
 			}
 		}
 
@@ -399,14 +363,6 @@ void IRCInterface::AddText ( char *user, const char *text, float r, float g, flo
 		delete wrapped;
 	}
 	
-	// Trim the buffer to size
-
-	while ( buffer.ValidIndex( IRCBUFFERSIZE ) ) {
-		UplinkIRCMessage *msg = buffer.GetData( 0 );
-		delete msg;
-		buffer.RemoveData( 0 );
-	}
-
     // Update the scrollbox
 
     ScrollBox *scrollBox = ScrollBox::GetScrollBox( "ircscroller" );
@@ -415,7 +371,7 @@ void IRCInterface::AddText ( char *user, const char *text, float r, float g, flo
         if ( scrollBox->numItems <= scrollBox->windowSize || ( scrollBox->currentIndex == scrollBox->numItems - scrollBox->windowSize ) )
             viewingNewest = true;
 
-        scrollBox->SetNumItems( buffer.Size() );        
+        scrollBox->SetNumItems( bufferSize );        
 		if ( viewingNewest ) {
 			if ( scrollBox->numItems < scrollBox->windowSize )
 				scrollBox->SetCurrentIndex ( 0 );
@@ -430,14 +386,50 @@ void IRCInterface::AddText ( char *user, const char *text, float r, float g, flo
 
 }
 
-void IRCInterface::ResetUsers ()
+UplinkIRCMessage *IRCInterface::GetLine ( int index )
 {
 
-    while ( users.ValidIndex(0) ) {
-        UplinkIRCUser *user = users.GetData(0);
-        delete user;
-        users.RemoveData(0);
-    }
+	if ( index < 0 || index >= bufferSize ) return NULL;
+	return buffer [( bufferStart + index ) % IRCBUFFERSIZE];
+
+}
+
+void IRCInterface::EmptyBuffer ()
+{
+
+	for ( int i = 0; i < bufferSize; ++i )
+		delete buffer [( bufferStart + i ) % IRCBUFFERSIZE];
+
+	bufferStart = 0;
+	bufferSize = 0;
+
+}
+
+int IRCInterface::CompareUsers ( UplinkIRCUser *const *user1, UplinkIRCUser *const *user2 )
+{
+
+	// Channel ops first, then alphabetically ignoring case
+
+	if ( (*user1)->status != (*user2)->status )
+		return (*user2)->status - (*user1)->status;
+
+	for ( const char *a = (*user1)->name, *b = (*user2)->name; ; ++a, ++b ) {
+		int ca = tolower ( (unsigned char) *a );
+		int cb = tolower ( (unsigned char) *b );
+		if ( ca != cb || ca == 0 ) return ca - cb;
+	}
+
+}
+
+void IRCInterface::UsersChanged ()
+{
+
+	// The sorted list is rebuilt the next time it is drawn
+
+	if ( sortedUsers ) {
+		delete sortedUsers;
+		sortedUsers = NULL;
+	}
 
     ScrollBox *scrollBox = ScrollBox::GetScrollBox( "irc_userscroll" );
     if ( scrollBox ) scrollBox->SetNumItems( users.Size() );
@@ -445,6 +437,32 @@ void IRCInterface::ResetUsers ()
 
 }
 
+DArray <UplinkIRCUser *> *IRCInterface::GetSortedUsers ()
+{
+
+	if ( !sortedUsers ) {
+		sortedUsers = users.ConvertToDArray ();
+		sortedUsers->Sort ( CompareUsers );
+	}
+
+	return sortedUsers;
+
+}
+
+void IRCInterface::ResetUsers ()
+{
+
+	DArray <UplinkIRCUser *> *allUsers = users.ConvertToDArray ();
+	for ( int i = 0; i < allUsers->Size (); ++i )
+		if ( allUsers->ValidIndex (i) )
+			delete allUsers->GetData (i);
+	delete allUsers;
+
+	users.Empty ();
+	UsersChanged ();
+
+}
+
 void IRCInterface::AddUser ( char *name )
 {
 
@@ -470,70 +488,53 @@ void IRCInterface::AddUser ( char *name )
     else
         user->Set( name );
 
-    // Insert in order
-
-    bool inserted = false;
-    char *lowerCaseName = LowerCaseString (name);
-
-    for ( int i = 0; i < users.Size(); ++i ) {
-        UplinkIRCUser *thisUser = users.GetData(i);
-        UplinkAssert (thisUser);
-        char *lowerCaseThisUser = LowerCaseString ( thisUser->name );
-        if ( ( user->status == 1 && thisUser->status == 0 )                                                            ||
-             (user->status == 1 && thisUser->status == 1 && strcmp ( lowerCaseName, lowerCaseThisUser ) < 0 )          ||
-             (user->status == 0 && thisUser->status == 0 && strcmp ( lowerCaseName, lowerCaseThisUser ) < 0 ) ) {
-
-            users.PutDataAtIndex ( user, i );
-            inserted = true;
-            delete [] lowerCaseThisUser;
-            break;
-        }
-        delete [] lowerCaseThisUser;
+    users.PutData ( user->name, user );
+    UsersChanged ();
 
-    }
+}
 
-    if ( !inserted ) users.PutDataAtEnd ( user );
+void IRCInterface::RemoveUser ( char *name )
+{
+    
+    UplinkIRCUser *user = GetUser ( name );
+    if ( !user ) return;
 
-    delete [] lowerCaseName;
+    users.RemoveData ( name );
+    delete user;
+    UsersChanged ();
 
-    // Update the scrollbar
+}
 
-    ScrollBox *scrollBox = ScrollBox::GetScrollBox( "irc_userscroll" );
-    if ( scrollBox ) scrollBox->SetNumItems( users.Size() );
+void IRCInterface::RenameUser ( char *name, char *newname )
+{
 
-    // Update the screen
+    UplinkIRCUser *user = GetUser ( name );
+    if ( !user ) return;
 
-    EclDirtyButton ( "irc_userlist" );
+    users.RemoveData ( name );
+    user->Set ( newname );
+    users.PutData ( user->name, user );
+    UsersChanged ();
 
 }
 
-void IRCInterface::RemoveUser ( char *name )
+void IRCInterface::SetUserStatus ( char *name, int status )
 {
-    
-    for ( int i = 0; i < users.Size(); ++i ) {
-        UplinkIRCUser *user = users.GetData(i);
-        UplinkAssert (user);
-        if ( strcmp ( user->name, name ) == 0 ) {
-            users.RemoveData( i );
-            ScrollBox *scrollBox = ScrollBox::GetScrollBox( "irc_userscroll" );
-            if ( scrollBox ) scrollBox->SetNumItems( users.Size() );
-            return;
-        }
-    }
+
+    UplinkIRCUser *user = GetUser ( name );
+    if ( !user || user->status == status ) return;
+
+    user->status = status;
+    UsersChanged ();
 
 }
 
 UplinkIRCUser *IRCInterface::GetUser ( char *name )
 {
 
-    for ( int i = 0; i < users.Size(); ++i ) {
-        UplinkIRCUser *user = users.GetData(i);
-        UplinkAssert (user);
-        if ( strcmp ( user->name, name ) == 0 )
-            return user;        
-    }
+    BTree <UplinkIRCUser *> *tree = users.LookupTree ( name );
+    return tree ? tree->data : NULL;
 
-    return NULL;
 }
 
 
@@ -541,6 +542,7 @@ UplinkIRCMessage::UplinkIRCMessage ()
 {
 	user = NULL;
     text = NULL;
+    numSmileys = 0;
 }
 
 UplinkIRCMessage::~UplinkIRCMessage ()
@@ -575,6 +577,40 @@ void UplinkIRCMessage::Set ( char *newuser, char *newtext, float r, float g, flo
 }
 
 
+void UplinkIRCMessage::FindEmoticons ()
+{
+
+	static const struct { const char *text; int type; } smileys [] = {
+		{ ":)", IRCSMILEY_HAPPY }, { "=)", IRCSMILEY_HAPPY }, { ":-)", IRCSMILEY_HAPPY },
+		{ ":(", IRCSMILEY_SAD }, { ":-(", IRCSMILEY_SAD }, { ";)", IRCSMILEY_WINK }
+	};
+
+	numSmileys = 0;
+	if ( !text ) return;
+
+	for ( int i = 0; i < (int) ( sizeof ( smileys ) / sizeof ( smileys [0] ) ); ++i ) {
+
+		for ( char *next = strstr ( text, smileys [i].text ); next && numSmileys < IRCMAXSMILEYS; 
+			  next = strstr ( next + 2, smileys [i].text ) ) {
+
+			// Positioned by the width of the text in front of it
+
+			char textSoFar [2048];
+			size_t lenCopy = min ( (size_t) ( next - text ) + 1, sizeof ( textSoFar ) );
+			strncpy ( textSoFar, text, lenCopy );
+			textSoFar [ lenCopy - 1 ] = '\x0';
+
+			smileyX [numSmileys] = GciTextWidth ( textSoFar );
+			smileyType [numSmileys] = smileys [i].type;
+			++numSmileys;
+
+		}
+
+	}
+
+}
+
+
 UplinkIRCUser::UplinkIRCUser ()
 {
     name = NULL;
@@ -613,8 +649,8 @@ void IRCInterface::CreateTalkWindow()
 	//
 	// Main text box
 
-	int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-	int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+	int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+	int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	//int mainWidth = (int) ( screenw * 0.65 );
 	//int mainHeight = (int) ( screenh * 0.8 );
 	// Dimension to match linksscreen_interface.cpp
@@ -630,7 +666,7 @@ void IRCInterface::CreateTalkWindow()
 	int numRows = mainHeight / 15;
     ScrollBox::CreateScrollBox( "ircscroller", 
                                 (30 + mainWidth) - 15, 30, 15, mainHeight, 
-								buffer.Size(), numRows, ( buffer.Size() < numRows )? 0 : buffer.Size() - numRows, 
+								bufferSize, numRows, ( bufferSize < numRows )? 0 : bufferSize - numRows, 
                                 TextScrollChange );                
 
 	//
@@ -675,8 +711,8 @@ void IRCInterface::Create ()
 		//
 		// Title button
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		int paneltop = (int) ( 100.0 * ( (screenw * PANELSIZE) / 188.0 ) + 30 );
 		int panelwidth = (int) ( screenw * PANELSIZE );
 
@@ -824,11 +860,22 @@ void IRCInterface::Remove ()
 		
 }
 
+void IRCInterface::ProcessMessages ()
+{
+
+    //
+    // The network thread queues up everything it receives.
+    // Handle a frame's worth here, so a burst of traffic is spread over 
+    // several frames rather than holding one up
+
+    if ( !uplinkIRCMonitor ) return;
+
+    CCrossThreadsMessagingDevice::ProcessMessages ( IRCMESSAGESPERFRAME );
+
+}
+
 void IRCInterface::Update ()
 {	
-//#ifndef WIN32
-    CCrossThreadsMessagingDevice::ProcessMessages ();
-//#endif
 }
 
 bool IRCInterface::IsVisible ()
@@ -871,6 +918,13 @@ void UplinkIRCMonitor::OnIrcDefault( const CIrcMessage* pmsg )
 }
 
 
+void UplinkIRCMonitor::OnIrcDisconnected ()
+{
+
+    IRCInterface::AddText( NULL, "Connection closed", COLOUR_JOINPART );
+
+}
+
 bool UplinkIRCMonitor::Received_RPL_WELCOME(const CIrcMessage* pmsg)
 {
 
@@ -1076,11 +1130,8 @@ bool UplinkIRCMonitor::Received_MODE (const CIrcMessage* pmsg)
 
     IRCInterface::AddText( NULL, parsedMessage, COLOUR_MODE );
 
-    UplinkIRCUser *user = IRCInterface::GetUser( GETIRCPARAM(2) );
-    if ( user ) {
-        int newStatus = strchr( GETIRCPARAM(1), '+' ) ? 1 : 0;
-        user->status = newStatus;
-    }
+    int newStatus = strchr( GETIRCPARAM(1), '+' ) ? 1 : 0;
+    IRCInterface::SetUserStatus( GETIRCPARAM(2), newStatus );
 
     return true;
 
@@ -1098,12 +1149,7 @@ bool UplinkIRCMonitor::Received_NICK (const CIrcMessage* pmsg)
     
     IRCInterface::AddText( NULL, parsedMessage, COLOUR_JOINPART );
     
-    UplinkIRCUser *user = IRCInterface::GetUser( (char *) pmsg->prefix.sNick.c_str() );
-    if ( user ) user->Set( GETIRCPARAM(0) );
-
-    // Update the screen
-
-    EclDirtyButton ( "irc_userlist" );
+    IRCInterface::RenameUser( (char *) pmsg->prefix.sNick.c_str(), GETIRCPARAM(0) );
 
     return true;
 
@@ -26,6 +26,12 @@ class UplinkIRCUser;
 using namespace irc;
 
 #define IRCBUFFERSIZE 200
+#define IRCMESSAGESPERFRAME 256                         // Most inbound messages handled in one frame
+#define IRCMAXSMILEYS 8
+
+#define IRCSMILEY_HAPPY 0
+#define IRCSMILEY_SAD   1
+#define IRCSMILEY_WINK  2
 
 // ============================================================================
 
@@ -45,7 +51,9 @@ protected:
 
     static void TextScrollChange    ( char *name, int newValue );
     static void UserScrollChange    ( char *name, int newValue );
-    static void AddEmoticons        ( int row, char *smiley, Image *imgSmiley );
+
+    static int CompareUsers         ( UplinkIRCUser *const *user1, UplinkIRCUser *const *user2 );
+    static void UsersChanged        ();
 
 protected:
 
@@ -56,8 +64,13 @@ protected:
 public:
 
 	static bool connected;
-	static LList<UplinkIRCMessage *> buffer;
-    static LList<UplinkIRCUser *> users;
+
+	static UplinkIRCMessage *buffer [IRCBUFFERSIZE];      // Ring of the newest lines
+	static int bufferStart;                               // Oldest line
+	static int bufferSize;
+
+    static BTree <UplinkIRCUser *> users;                 // Indexed on name
+    static DArray <UplinkIRCUser *> *sortedUsers;         // Ops first, then by name - NULL until needed
 
     static char channelName [256];
 
@@ -79,10 +92,18 @@ public:
 	static void AddText ( char *user, const char *text, 
 						  float r = 1.0, float g = 1.0, float b = 1.0 );
 
+    static UplinkIRCMessage *GetLine ( int index );         // 0 is the oldest, NULL if out of range
+    static void EmptyBuffer         ();
+
     static void ResetUsers          ();
     static void AddUser             ( char *name );
     static void RemoveUser          ( char *name );    
+    static void RenameUser          ( char *name, char *newname );
+    static void SetUserStatus       ( char *name, int status );
     static UplinkIRCUser *GetUser   ( char *name );
+    static DArray <UplinkIRCUser *> *GetSortedUsers ();
+
+    static void ProcessMessages     ();                     // Called once a frame, whether visible or not
 
 	void Create ();
 	void Remove ();
@@ -103,6 +124,7 @@ public:
 	~UplinkIRCMessage ();
 
 	void Set ( char *newuser, char *newtext, float r, float g, float b );
+	void FindEmoticons ();                                  // Lays out the smileys once, rather than every draw
 
 public:
 
@@ -112,6 +134,10 @@ public:
 	float green;
 	float blue;
 
+	int numSmileys;
+	int smileyX [IRCMAXSMILEYS];                            // Pixels from the start of the text
+	int smileyType [IRCMAXSMILEYS];
+
 };
 
 class UplinkIRCUser
@@ -138,6 +164,7 @@ public:
     
 
     void OnIrcDefault               (const CIrcMessage* pmsg);        
+    void OnIrcDisconnected          ();
     bool Received_PRIVMSG           (const CIrcMessage* pmsg);
 	bool Received_JOIN              (const CIrcMessage* pmsg);
     bool Received_PART              (const CIrcMessage* pmsg);
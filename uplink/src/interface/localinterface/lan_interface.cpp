@@ -88,6 +88,119 @@ void CycleStipplePattern ()
 
 }
 
+//
+// Link geometry for the LAN background, in screen coordinates
+// Rebuilt only when the LAN, its visible links, the scroll offset
+// or the player's connection change. Each colour is one draw call
+
+struct LanVertexList
+{
+    float *data;                                // x, y pairs
+    int size;                                   // In vertices
+    int capacity;
+};
+
+struct LanPathLink
+{
+    float path [8];                             // From GetLinkPath
+    int numPoints;
+    int toIndex;                                // Positions of the ends in the connection
+    int fromIndex;
+};
+
+static LanVertexList linkPoints = { NULL, 0, 0 };           // Quads at the known ends of links
+static LanVertexList linkLines = { NULL, 0, 0 };            // Fully known links, as line segments
+static LanVertexList pathLines = { NULL, 0, 0 };            // Links along the connection, as line segments,
+static int pathAdminSize = 0;                               // those up to the sys admin first
+static DArray <LanPathLink *> pathLinks;
+
+static LanComputer *geometryLan = NULL;
+static int geometryNumLinks = -1;
+static int geometryLinkChanges = -1;
+static int geometryX = 0;
+static int geometryY = 0;
+static int geometryOffsetX = 0;
+static int geometryOffsetY = 0;
+static int geometrySysAdminIndex = -1;
+static DArray <int> geometryConnection;
+
+static void AddVertex ( LanVertexList *list, float x, float y )
+{
+
+    if ( list->size == list->capacity ) {
+        int newCapacity = list->capacity ? list->capacity * 2 : 256;
+        float *newData = new float [newCapacity * 2];
+        if ( list->data ) {
+            memcpy ( newData, list->data, list->size * 2 * sizeof(float) );
+            delete [] list->data;
+        }
+        list->data = newData;
+        list->capacity = newCapacity;
+    }
+
+    list->data [list->size * 2] = x;
+    list->data [list->size * 2 + 1] = y;
+    ++list->size;
+
+}
+
+static void AddQuad ( LanVertexList *list, int x, int y )
+{
+
+    AddVertex ( list, (float) (x - 2), (float) (y - 2) );
+    AddVertex ( list, (float) (x + 2), (float) (y - 2) );
+    AddVertex ( list, (float) (x + 2), (float) (y + 2) );
+    AddVertex ( list, (float) (x - 2), (float) (y + 2) );
+
+}
+
+static void AddPath ( LanVertexList *list, float *path, int numPoints )
+{
+
+    for ( int p = 0; p < numPoints - 1; ++p ) {
+        AddVertex ( list, path [p * 2], path [p * 2 + 1] );
+        AddVertex ( list, path [p * 2 + 2], path [p * 2 + 3] );
+    }
+
+}
+
+// Is this link of the connection between the player and the sys admin?
+
+static bool IsAdminPathLink ( LanPathLink *pathLink, int sysAdminIndex )
+{
+
+    int toIndex = pathLink->toIndex;
+    int fromIndex = pathLink->fromIndex;
+
+    return ( sysAdminIndex >= toIndex && toIndex >= fromIndex ) ||
+           ( sysAdminIndex >= fromIndex && fromIndex >= toIndex );
+
+}
+
+// Orders pathLines so the links up to the sys admin come first
+// Only done again when the sys admin moves or the connection changes
+
+static void UpdatePathColours ( int sysAdminIndex )
+{
+
+    if ( sysAdminIndex == geometrySysAdminIndex && pathLines.size > 0 )
+        return;
+
+    geometrySysAdminIndex = sysAdminIndex;
+    pathLines.size = 0;
+
+    for ( int i = 0; i < pathLinks.Size (); ++i )
+        if ( IsAdminPathLink ( pathLinks.GetData (i), sysAdminIndex ) )
+            AddPath ( &pathLines, pathLinks.GetData (i)->path, pathLinks.GetData (i)->numPoints );
+
+    pathAdminSize = pathLines.size;
+
+    for ( int i = 0; i < pathLinks.Size (); ++i )
+        if ( !IsAdminPathLink ( pathLinks.GetData (i), sysAdminIndex ) )
+            AddPath ( &pathLines, pathLinks.GetData (i)->path, pathLinks.GetData (i)->numPoints );
+
+}
+
 LanInterfaceObject *LanInterface::GetLanInterfaceObject( int TYPE )
 {
 
@@ -105,7 +218,7 @@ void LanInterface::TitleClick ( Button *button )
 void LanInterface::LanBackgroundDraw ( Button *button, bool highlighted, bool clicked )
 {
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -114,8 +227,7 @@ void LanInterface::LanBackgroundDraw ( Button *button, bool highlighted, bool cl
 	border_draw ( button );
 
 
-    Button *background = EclGetButton ( "lan_background" );
-    UplinkAssert (background);
+    Button *background = button;
 
 	//
 	// Lookup computer details
@@ -211,113 +323,57 @@ void LanInterface::LanBackgroundDraw ( Button *button, bool highlighted, bool cl
 	//
 	// Draw connecting lines
 
-    glLineWidth ( 2.0f );
-    glColor4f ( 0.0f, 0.5f, 0.6f, 1.0f );   
+    UpdateLinkGeometry ( lanComp, button );
 
-    for ( int i = 0; i < lanComp->links.Size(); ++i ) {
-        if ( lanComp->links.ValidIndex(i) ) {
+    glEnableClientState ( GL_VERTEX_ARRAY );
 
-            LanComputerLink *link = lanComp->links.GetData(i);
-            UplinkAssert (link);
+    glColor4f ( 0.0f, 0.5f, 0.6f, 1.0f );
 
-            if ( link->visible > LANLINKVISIBLE_NONE ) {
-
-				UplinkAssert (lanComp->systems.ValidIndex(link->from));
-				UplinkAssert (lanComp->systems.ValidIndex(link->to));
-                LanComputerSystem *from = lanComp->systems.GetData( link->from );
-                LanComputerSystem *to = lanComp->systems.GetData( link->to );
-                UplinkAssert (from);
-                UplinkAssert (to);
-
-                LanInterfaceObject *fromSystem = &lanInterfaceObjects[from->TYPE];
-                LanInterfaceObject *toSystem = &lanInterfaceObjects[to->TYPE];
-                UplinkAssert (fromSystem);
-                UplinkAssert (toSystem);
-
-				//
-				// Work out connecting points for link
-
-                int fromX = (int) ( background->x + (from->x) + fromSystem->width * link->fromX + offsetX );
-                int fromY = (int) ( background->y + (from->y) + fromSystem->height * link->fromY + offsetY );
-                int toX = (int) ( background->x + (to->x) + toSystem->width * link->toX + offsetX );
-                int toY = (int) ( background->y + (to->y) + toSystem->height * link->toY + offsetY );
-
-				// 
-				// Draw the FROM link point
-
-				if ( link->visible == LANLINKVISIBLE_FROMAWARE ||
-					 link->visible >= LANLINKVISIBLE_AWARE ) {
-
-					glBegin ( GL_QUADS );
-						glVertex2i ( fromX - 2, fromY - 2 );
-						glVertex2i ( fromX + 2, fromY - 2 );
-						glVertex2i ( fromX + 2, fromY + 2 );
-						glVertex2i ( fromX - 2, fromY + 2 );
-					glEnd ();
-
-				}
+    if ( linkPoints.size > 0 ) {
+        glVertexPointer ( 2, GL_FLOAT, 0, linkPoints.data );
+        glDrawArrays ( GL_QUADS, 0, linkPoints.size );
+    }
 
-				// 
-				// Draw the TO link point
+    if ( linkLines.size > 0 ) {
+        glLineWidth ( 2.0 );
+        glVertexPointer ( 2, GL_FLOAT, 0, linkLines.data );
+        glDrawArrays ( GL_LINES, 0, linkLines.size );
+    }
 
-				if ( link->visible == LANLINKVISIBLE_TOAWARE ||
-					 link->visible >= LANLINKVISIBLE_AWARE ) {
+    //
+    // Links along the player's connection, red up to the sys admin
 
-					glBegin ( GL_QUADS );
-						glVertex2i ( toX - 2, toY - 2 );
-						glVertex2i ( toX + 2, toY - 2 );
-						glVertex2i ( toX + 2, toY + 2 );
-						glVertex2i ( toX - 2, toY + 2 );
-					glEnd ();
+    if ( pathLinks.Size () > 0 ) {
 
-				}
+        UpdatePathColours ( LanMonitor::GetNodeIndex( LanMonitor::sysAdminCurrentSystem ) );
 
-				//
-				// Draw the link itself
+		glEnable ( GL_LINE_STIPPLE );
+        glLineStipple ( 2, stipplepattern );
+        glVertexPointer ( 2, GL_FLOAT, 0, pathLines.data );
 
-				if ( link->visible >= LANLINKVISIBLE_AWARE ) {
+        glColor4f ( 0.3f, 0.3f, 0.9f, 1.0f );
+        glLineWidth ( 4.0 );
+        glDrawArrays ( GL_LINES, 0, pathLines.size );
 
-                    glLineWidth ( 2.0 );
-					DrawLink ( link, (float) fromX, (float) fromY, (float) toX, (float) toY );
-                    glLineWidth ( 1.0 );
+        glLineWidth ( 2.0 );
 
-                    int toIndex = LanMonitor::GetNodeIndex( link->to );
-                    int fromIndex = LanMonitor::GetNodeIndex( link->from );
-                    int sysAdminIndex = LanMonitor::GetNodeIndex( LanMonitor::sysAdminCurrentSystem );
-
-					if ( toIndex != -1 && fromIndex != -1 && 
-                         ( toIndex == fromIndex - 1 || fromIndex == toIndex - 1 ) ) {
-												
-						glEnable ( GL_LINE_STIPPLE );
-                        glLineStipple ( 2, stipplepattern );
-                        
-                        glColor4f ( 0.3f, 0.3f, 0.9f, 1.0f );
-                        glLineWidth ( 4.0 );
-                        DrawLink ( link, (float) fromX, (float) fromY, (float) toX, (float) toY );
-                        
-                        if ( ( sysAdminIndex >= toIndex && toIndex >= fromIndex ) ||
-                             ( sysAdminIndex >= fromIndex && fromIndex >= toIndex ) )
-                            glColor4f ( 1.0f, 0.0f, 0.0f, 1.0f );
-
-                        else
-                            glColor4f ( 1.0f, 1.0f, 1.0f, 1.0f );                           
-
-                        glLineWidth ( 2.0 );
-                        DrawLink ( link, (float) fromX, (float) fromY, (float) toX, (float) toY );
-                        
-                        glColor4f ( 0.0f, 0.5f, 0.6f, 1.0f );   
-		                glDisable ( GL_LINE_STIPPLE );
-                        glLineWidth ( 1.0 );
+        if ( pathAdminSize > 0 ) {
+            glColor4f ( 1.0f, 0.0f, 0.0f, 1.0f );
+            glDrawArrays ( GL_LINES, 0, pathAdminSize );
+        }
 
-					}
-						
-				}
+        if ( pathLines.size > pathAdminSize ) {
+            glColor4f ( 1.0f, 1.0f, 1.0f, 1.0f );
+            glDrawArrays ( GL_LINES, pathAdminSize, pathLines.size - pathAdminSize );
+        }
 
-            }
+		glDisable ( GL_LINE_STIPPLE );
 
-        }
     }
 
+    glDisableClientState ( GL_VERTEX_ARRAY );
+    glLineWidth ( 1.0 );
+
 
 
     //
@@ -419,44 +475,34 @@ void LanInterface::LanBackgroundDraw ( Button *button, bool highlighted, bool cl
 
 }
 
-void LanInterface::DrawLink ( LanComputerLink *link, 
-							float fromX, float fromY,
-							float toX, float toY )
+int LanInterface::GetLinkPath ( LanComputerLink *link, 
+							    float fromX, float fromY,
+							    float toX, float toY, float *path )
 {
 
+    path [0] = fromX;
+    path [1] = fromY;
+
     if ( (link->fromY == 1.0 && link->toY == 0.0) ||				  // Bottom to top
 		 (link->fromY == 0.0 && link->toY == 1.0) ) {                 // Top to bottom
 
-		glBegin ( GL_LINE_STRIP );
-			glVertex2f ( fromX, fromY );
-			if ( fromX > toX ) {
-				glVertex2f ( fromX, fromY + (toY - fromY) * link->fromX );
-				glVertex2f ( toX, fromY + (toY - fromY) * link->fromX );
-			}
-			else {
-				glVertex2f ( fromX, fromY + (toY - fromY) * (1.0f - link->fromX) );
-				glVertex2f ( toX, fromY + (toY - fromY) * (1.0f - link->fromX) );
-			}
-
-			glVertex2f ( toX, toY );
-		glEnd ();
+		float midY = fromX > toX ? fromY + (toY - fromY) * link->fromX
+								 : fromY + (toY - fromY) * (1.0f - link->fromX);
+		path [2] = fromX;	path [3] = midY;
+		path [4] = toX;		path [5] = midY;
+		path [6] = toX;		path [7] = toY;
+		return 4;
 
 	}
 	else if ( (link->fromX == 1.0 && link->toX == 0.0) ||               // Right to left
 			  (link->fromX == 0.0 && link->toX == 1.0) ) {				// Left to right
 
-		glBegin ( GL_LINE_STRIP );
-			glVertex2f ( fromX, fromY );
-            if ( fromY > toY ) {
-                glVertex2f ( fromX + (toX - fromX) * link->fromY, fromY );
-                glVertex2f ( fromX + (toX - fromX) * link->fromY, toY );
-            }
-            else {
-                glVertex2f ( fromX + (toX - fromX) * (1.0f - link->fromY), fromY );
-                glVertex2f ( fromX + (toX - fromX) * (1.0f - link->fromY), toY );
-            }                
-			glVertex2f ( toX, toY );
-		glEnd ();
+		float midX = fromY > toY ? fromX + (toX - fromX) * link->fromY
+								 : fromX + (toX - fromX) * (1.0f - link->fromY);
+		path [2] = midX;	path [3] = fromY;
+		path [4] = midX;	path [5] = toY;
+		path [6] = toX;		path [7] = toY;
+		return 4;
 
 	}
 	else if ( (link->fromY == 0 && link->toX == 0) ||				// Top to left
@@ -464,34 +510,126 @@ void LanInterface::DrawLink ( LanComputerLink *link,
 			  (link->fromY == 1 && link->toX == 0) ||				// Bottom to left
 			  (link->fromY == 0 && link->toX == 1) ) {				// Top to right
 
-		glBegin ( GL_LINE_STRIP );
-			glVertex2f ( fromX, fromY );
-			glVertex2f ( fromX, toY );
-			glVertex2f ( toX, toY );
-		glEnd ();
+		path [2] = fromX;	path [3] = toY;
+		path [4] = toX;		path [5] = toY;
+		return 3;
 
 	}
-	else if ( (link->fromX == 1 && link->toY == 0) ||					// Right to top
-			  (link->fromX == 0 && link->toY == 1) ||					// Left to bottom
-			  (link->fromX == 0 && link->toY == 0) ||					// Left to top
-			  (link->fromX == 1 && link->toY == 1) ) {					// Right to bottom
-
-		glBegin ( GL_LINE_STRIP );
-			glVertex2f ( fromX, fromY );
-			glVertex2f ( toX, fromY );
-			glVertex2f ( toX, toY );
-		glEnd ();
+	else {																// Right/left to top/bottom, or anything else
+
+		path [2] = toX;		path [3] = fromY;
+		path [4] = toX;		path [5] = toY;
+		return 3;
 
 	}
-	else {																// Fuck knows
 
-		glBegin ( GL_LINE_STRIP );
-			glVertex2f ( fromX, fromY );
-			glVertex2f ( toX, fromY );
-			glVertex2f ( toX, toY );
-		glEnd ();
+}
 
-	}
+void LanInterface::UpdateLinkGeometry ( LanComputer *lanComp, Button *background )
+{
+
+    //
+    // Is the cached geometry still current?
+
+    bool current = lanComp == geometryLan &&
+                   lanComp->links.Size () == geometryNumLinks &&
+                   LanComputerLink::changes == geometryLinkChanges &&
+                   background->x == geometryX && background->y == geometryY &&
+                   offsetX == geometryOffsetX && offsetY == geometryOffsetY &&
+                   LanMonitor::connection.Size () == geometryConnection.Size ();
+
+    for ( int i = 0; current && i < geometryConnection.Size (); ++i )
+        current = LanMonitor::connection.GetData (i) == geometryConnection.GetData (i);
+
+    if ( current ) return;
+
+    geometryLan = lanComp;
+    geometryNumLinks = lanComp->links.Size ();
+    geometryLinkChanges = LanComputerLink::changes;
+    geometryX = background->x;
+    geometryY = background->y;
+    geometryOffsetX = offsetX;
+    geometryOffsetY = offsetY;
+
+    geometryConnection.Empty ();
+    for ( int i = 0; i < LanMonitor::connection.Size (); ++i )
+        geometryConnection.PutData ( LanMonitor::connection.GetData (i) );
+
+    linkPoints.size = 0;
+    linkLines.size = 0;
+    pathLines.size = 0;
+    for ( int i = 0; i < pathLinks.Size (); ++i )
+        if ( pathLinks.ValidIndex (i) )
+            delete pathLinks.GetData (i);
+    pathLinks.Empty ();
+
+    //
+    // Rebuild
+
+    for ( int i = 0; i < lanComp->links.Size(); ++i ) {
+        if ( lanComp->links.ValidIndex(i) ) {
+
+            LanComputerLink *link = lanComp->links.GetData(i);
+            UplinkAssert (link);
+
+            if ( link->visible > LANLINKVISIBLE_NONE ) {
+
+				UplinkAssert (lanComp->systems.ValidIndex(link->from));
+				UplinkAssert (lanComp->systems.ValidIndex(link->to));
+                LanComputerSystem *from = lanComp->systems.GetData( link->from );
+                LanComputerSystem *to = lanComp->systems.GetData( link->to );
+                UplinkAssert (from);
+                UplinkAssert (to);
+
+                LanInterfaceObject *fromSystem = &lanInterfaceObjects[from->TYPE];
+                LanInterfaceObject *toSystem = &lanInterfaceObjects[to->TYPE];
+                UplinkAssert (fromSystem);
+                UplinkAssert (toSystem);
+
+				//
+				// Work out connecting points for link
+
+                int fromX = (int) ( background->x + (from->x) + fromSystem->width * link->fromX + offsetX );
+                int fromY = (int) ( background->y + (from->y) + fromSystem->height * link->fromY + offsetY );
+                int toX = (int) ( background->x + (to->x) + toSystem->width * link->toX + offsetX );
+                int toY = (int) ( background->y + (to->y) + toSystem->height * link->toY + offsetY );
+
+				if ( link->visible == LANLINKVISIBLE_FROMAWARE ||
+					 link->visible >= LANLINKVISIBLE_AWARE )
+					AddQuad ( &linkPoints, fromX, fromY );
+
+				if ( link->visible == LANLINKVISIBLE_TOAWARE ||
+					 link->visible >= LANLINKVISIBLE_AWARE )
+					AddQuad ( &linkPoints, toX, toY );
+
+				if ( link->visible >= LANLINKVISIBLE_AWARE ) {
+
+                    float path [8];
+                    int numPoints = GetLinkPath ( link, (float) fromX, (float) fromY, (float) toX, (float) toY, path );
+
+                    AddPath ( &linkLines, path, numPoints );
+
+                    int toIndex = LanMonitor::GetNodeIndex( link->to );
+                    int fromIndex = LanMonitor::GetNodeIndex( link->from );
+
+					if ( toIndex != -1 && fromIndex != -1 && 
+                         ( toIndex == fromIndex - 1 || fromIndex == toIndex - 1 ) ) {
+
+                        LanPathLink *pathLink = new LanPathLink ();
+                        memcpy ( pathLink->path, path, sizeof(path) );
+                        pathLink->numPoints = numPoints;
+                        pathLink->toIndex = toIndex;
+                        pathLink->fromIndex = fromIndex;
+                        pathLinks.PutData ( pathLink );
+
+					}
+
+				}
+
+            }
+
+        }
+    }
 
 }
 
@@ -504,7 +642,7 @@ void LanInterface::LanSystemDraw ( Button *button, bool highlighted, bool clicke
 
     Button *background = EclGetButton ( "lan_background" );
     UplinkAssert (background);
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( background->x, screenheight - (background->y + background->height), background->width - 2, background->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -827,6 +965,7 @@ void LanInterface::GenerateClick ( Button *button )
         LanComputer *lanComp = (LanComputer *) comp;
         lanComp->systems.Empty ();
         lanComp->links.Empty ();
+        lanComp->InvalidateIndex ();
         
         switch (size)
         {
@@ -848,7 +987,7 @@ void LanInterface::GenerateClick ( Button *button )
 void LanInterface::TitleDraw ( Button *button, bool highlighted, bool clicked )
 {
 
-	SetColour ( "TitleText" );
+	SetColour ( COLOUR_TITLETEXT );
 	GciDrawText ( button->x + 10, button->y + 10, button->caption, HELVETICA_18 );
 
 }
@@ -865,7 +1004,7 @@ void LanInterface::PanelBackgroundDraw ( Button *button, bool highlighted, bool
 		glVertex2i ( button->x + button->width, button->y + button->height );
 	glEnd ();
 
-	SetColour ( "PanelBorder" );
+	SetColour ( COLOUR_PANELBORDER );
 	border_draw ( button );
 
 }
@@ -936,8 +1075,8 @@ void LanInterface::SelectSystem ( int systemIndex )
     //
     // Update the side panel
 
-	int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-	int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+	int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+	int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	//int paneltop = SY(100) + 30;
 	int paneltop = (int) ( 100.0 * ( (screenw * PANELSIZE) / 188.0 ) + 30 );
 	int panelwidth = (int) ( screenw * PANELSIZE );
@@ -1142,8 +1281,8 @@ void LanInterface::Create ()
     
     if ( !IsVisible () ) {
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		//int paneltop = SY(100) + 30;
 		int paneltop = (int) ( 100.0 * ( (screenw * PANELSIZE) / 188.0 ) + 30 );
 		int panelwidth = (int) ( screenw * PANELSIZE );
@@ -81,9 +81,11 @@ protected:
 
     static void GenerateClick       ( Button *button );
 
-	static void DrawLink ( LanComputerLink *link, 
-							float fromX, float fromY,
-							float toX, float toY );
+	static int GetLinkPath ( LanComputerLink *link,                   // Fills up to 4 points, returns how many
+							 float fromX, float fromY,
+							 float toX, float toY, float *path );
+
+    static void UpdateLinkGeometry ( LanComputer *lanComp, Button *background );
 
     static void ScrollClick ( Button *button );
 
@@ -35,13 +35,13 @@ void LocalInterfaceScreen::BackgroundDraw ( Button *button, bool highlighted, bo
 {
    
 	glBegin ( GL_QUADS );		
-		SetColour ( "PanelBackgroundA" );		glVertex2i ( button->x, button->y + button->height );
-		SetColour ( "PanelBackgroundB" );		glVertex2i ( button->x, button->y );
-		SetColour ( "PanelBackgroundA" );		glVertex2i ( button->x + button->width, button->y );
-		SetColour ( "PanelBackgroundB" );		glVertex2i ( button->x + button->width, button->y + button->height );
+		SetColour ( COLOUR_PANELBACKGROUNDA );		glVertex2i ( button->x, button->y + button->height );
+		SetColour ( COLOUR_PANELBACKGROUNDB );		glVertex2i ( button->x, button->y );
+		SetColour ( COLOUR_PANELBACKGROUNDA );		glVertex2i ( button->x + button->width, button->y );
+		SetColour ( COLOUR_PANELBACKGROUNDB );		glVertex2i ( button->x + button->width, button->y + button->height );
 	glEnd ();
 
-	SetColour ( "PanelBorder" );
+	SetColour ( COLOUR_PANELBORDER );
 	border_draw ( button );
 
 }
@@ -68,8 +68,8 @@ void LocalInterfaceScreen::CreateHeight ( int panelheight )
 
 	if ( !IsVisible () ) {
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		//int paneltop = SY(100) + 30;
 		int paneltop = (int) ( 100.0 * ( (screenw * PANELSIZE) / 188.0 ) + 30 );
 		int panelwidth = (int) ( screenw * PANELSIZE );
@@ -177,8 +177,8 @@ void MemoryInterface::MemoryBlockHighlight ( Button *button )
 
 	// Dirty all blocks that shared the old currentprogramindex;
 
-	int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-	int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+	int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+	int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	int paneltop = (int) ( 100.0 * ( (screenw * PANELSIZE) / 188.0 ) + 30 );
 	int numrows = ((screenh - 50) - (paneltop + 50)) / 10;
 
@@ -247,8 +247,8 @@ void MemoryInterface::ScrollChange ( char *scrollname, int newValue )
 
     baseoffset = newValue;
 
-	int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-	int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+	int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+	int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	int paneltop = (int) ( 100.0 * ( (screenw * PANELSIZE) / 188.0 ) + 30 );
 	int numrows = ((screenh - 50) - (paneltop + 50)) / 10;
 
@@ -267,8 +267,8 @@ void MemoryInterface::Create ()
 
 	if ( !IsVisible () ) {
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		int paneltop = (int) ( 100.0 * ( (screenw * PANELSIZE) / 188.0 ) + 30 );
 		int panelwidth = (int) ( screenw * PANELSIZE );
 
@@ -314,8 +314,8 @@ void MemoryInterface::Remove ()
 		EclRemoveButton ( "memory_capacity" );
         ScrollBox::RemoveScrollBox( "memory_scroll" );
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		int paneltop = (int) ( 100.0 * ( (screenw * PANELSIZE) / 188.0 ) + 30 );
 		int numrows = ((screenh - 50) - (paneltop + 50)) / 10;
 
@@ -364,8 +364,8 @@ void MemoryInterface::Update ()
 			// Something has changed
 			// Invalidate all the buttons
 
-			int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-			int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+			int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+			int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 			int paneltop = (int) ( 100.0 * ( (screenw * PANELSIZE) / 188.0 ) + 30 );
 			int numrows = ((screenh - 50) - (paneltop + 50)) / 10;
 
@@ -50,7 +50,7 @@ void StatusInterface::TitleClick ( Button *button )
 void StatusInterface::MiniTitleDraw ( Button *button, bool highlighted, bool clicked )
 {
 
-	SetColour ( "TitleText" );
+	SetColour ( COLOUR_TITLETEXT );
 	GciDrawText ( button->x + 10, button->y + 10, button->caption, HELVETICA_18 );
 
 }
@@ -62,8 +62,8 @@ void StatusInterface::Create ()
 
 		LocalInterfaceScreen::Create ();
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		int paneltop = (int) ( 100.0 * ( (screenw * PANELSIZE) / 188.0 ) + 30 );
 		int panelwidth = (int) ( screenw * PANELSIZE );
 
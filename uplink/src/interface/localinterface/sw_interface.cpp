@@ -100,24 +100,24 @@ void SWInterface::SoftwareDraw ( Button *button, bool highlighted, bool clicked
 
 	glBegin ( GL_QUADS );
 
-		if		( clicked )		SetColour ( "ButtonClickedA" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedA" );
-		else					SetColour ( "ButtonNormalA" );
+		if		( clicked )		SetColour ( COLOUR_BUTTONCLICKEDA );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDA );
+		else					SetColour ( COLOUR_BUTTONNORMALA );
 		glVertex2i ( button->x, button->y + button->height );
 
-		if      ( clicked )		SetColour ( "ButtonClickedB" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedB" );
-		else					SetColour ( "ButtonNormalB" );
+		if      ( clicked )		SetColour ( COLOUR_BUTTONCLICKEDB );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDB );
+		else					SetColour ( COLOUR_BUTTONNORMALB );
 		glVertex2i ( button->x, button->y );
 
-		if		( clicked )		SetColour ( "ButtonClickedA" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedA" );
-		else					SetColour ( "ButtonNormalA" );
+		if		( clicked )		SetColour ( COLOUR_BUTTONCLICKEDA );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDA );
+		else					SetColour ( COLOUR_BUTTONNORMALA );
 		glVertex2i ( button->x + button->width, button->y );
 
-		if		( clicked )		SetColour ( "ButtonClickedB" );
-		else if ( highlighted ) SetColour ( "ButtonHighlightedB" );
-		else					SetColour ( "ButtonNormalB" );
+		if		( clicked )		SetColour ( COLOUR_BUTTONCLICKEDB );
+		else if ( highlighted ) SetColour ( COLOUR_BUTTONHIGHLIGHTEDB );
+		else					SetColour ( COLOUR_BUTTONNORMALB );
 		glVertex2i ( button->x + button->width, button->y + button->height );
 
 	glEnd ();
@@ -378,7 +378,7 @@ void SWInterface::ToggleSoftwareMenu ()
 
 		// Create the "start" menu
 
-        int screenH = app->GetOptions()->GetOptionValue("graphics_screenheight");
+        int screenH = app->GetOptions()->GetOptionValue ( OPTION_SCREENHEIGHT );
         int yPos = screenH - 90;
 
 		EclRegisterButton ( 3, yPos, 100, 15, "File Utilities", "Eg file copiers, deleters, encrypters etc", "hud_swmenu 1" );
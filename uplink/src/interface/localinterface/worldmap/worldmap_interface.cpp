@@ -536,7 +536,7 @@ void WorldMapInterface::DrawWorldMapLarge ( Button *button, bool highlighted, bo
     //
     // Clipping
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -696,7 +696,7 @@ void WorldMapInterface::DrawLocation ( Button *button, bool highlighted, bool cl
         Button *largemap = EclGetButton ( "worldmap_largemap" );
         UplinkAssert (largemap);
 
-        int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+        int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		int scissorX = largemap->x;
 		int scissorY = screenheight - (largemap->y + largemap->height);
 		int scissorW = largemap->width;
@@ -779,8 +779,8 @@ void WorldMapInterface::CreateWorldMapInterface ( int SIZE )
 void WorldMapInterface::CreateWorldMapInterface_Small ()
 {
 
-    int screenw = app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" );
-    int screenh = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+    int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+    int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
     int fullsizeX = (int) ( screenw * PANELSIZE );
     int fullsizeY = (int) ( 100.0 * ( fullsizeX / 188.0 ) );
@@ -873,13 +873,13 @@ int WorldMapInterface::GetLargeMapY1()
 
 int WorldMapInterface::GetLargeMapWidth()
 {
-    int screenw = app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" );
+    int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
     return screenw - GetLargeMapX1() * 2;
 }
 
 int WorldMapInterface::GetLargeMapHeight()
 {
-    int screenh = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+    int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
     return (int) ( 316.0 * ( GetLargeMapWidth() / 595.0 ) );
 }
 
@@ -1398,7 +1398,7 @@ void WorldMapInterface::Create ( int SIZE )
 {
 //    cout << "Creating Worldmap Interface\n";
     
-    layout = new WorldMapLayout(GetLargeMapRect());
+    layout = new WorldMapLayout(GetLargeMapRect(), app->GetOptions ()->GetOptionValue ( "graphics_layoutthreads" ));
     ProgramLayoutEngine();
     
     CreateWorldMapInterface ( SIZE );
@@ -1439,6 +1439,7 @@ void WorldMapInterface::ScrollX ( float x )
         if ( button ) {
             button->x = GetScaledX ( vl->x, WORLDMAP_LARGE ) + x1 - 3;
             button->y = GetScaledY ( vl->y, WORLDMAP_LARGE ) + y1 - 3;            
+            EclUpdateButtonIndex ( button );
         }
         
     }
@@ -1459,6 +1460,7 @@ void WorldMapInterface::ScrollX ( float x )
 			if ( vl ) {
 				button->x = GetScaledX ( vl->x, WORLDMAP_LARGE ) + x1 - 3;
 				button->y = GetScaledY ( vl->y, WORLDMAP_LARGE ) + y1 - 3;
+				EclUpdateButtonIndex ( button );
 			}
         }
 
@@ -1502,6 +1504,7 @@ void WorldMapInterface::ScrollY ( float y )
         if ( button ) {
             button->x = GetScaledX ( vl->x, WORLDMAP_LARGE ) + x1 - 3;
             button->y = GetScaledY ( vl->y, WORLDMAP_LARGE ) + y1 - 3;
+            EclUpdateButtonIndex ( button );
         }
         
     }
@@ -1522,6 +1525,7 @@ void WorldMapInterface::ScrollY ( float y )
 			if ( vl ) {
 				button->x = GetScaledX ( vl->x, WORLDMAP_LARGE ) + x1 - 3;
 				button->y = GetScaledY ( vl->y, WORLDMAP_LARGE ) + y1 - 3;
+				EclUpdateButtonIndex ( button );
 			}
         }
 
@@ -1575,6 +1579,7 @@ void WorldMapInterface::SetZoom ( float z )
         if ( button ) {
             button->x = GetScaledX ( vl->x, WORLDMAP_LARGE ) + x1 - 3;
             button->y = GetScaledY ( vl->y, WORLDMAP_LARGE ) + y1 - 3;            
+            EclUpdateButtonIndex ( button );
         }
         
     }
@@ -1595,6 +1600,7 @@ void WorldMapInterface::SetZoom ( float z )
 			if ( vl ) {
 				button->x = GetScaledX ( vl->x, WORLDMAP_LARGE ) + x1 - 3;
 				button->y = GetScaledY ( vl->y, WORLDMAP_LARGE ) + y1 - 3;
+				EclUpdateButtonIndex ( button );
 			}
         }
 
@@ -8,6 +8,10 @@
 #include <math.h>
 #include <stdio.h>
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "eclipse.h"
 
 #include "app/app.h"
@@ -290,62 +294,102 @@ int WorldMapInterfaceLabel::GetLabelPosition() const
     return labelPos;
 }
 
+int WorldMapInterfaceLabel::NumPossibleLabelPositions() const
+{
+    return numPossLabelPos;
+}
+
+int WorldMapInterfaceLabel::GetPossibleLabelPosition(int i) const
+{
+    UplinkAssert (i >= 0 && i < numPossLabelPos);
+    return possLabelPos[i];
+}
+
 void WorldMapInterfaceLabel::SetLabelPosition (int n)
+{
+    MapRectangle r = GetExtentAt(n);
+
+    labelPos = n;
+    SetPosition(r.x1, r.y1);
+}
+
+MapRectangle WorldMapInterfaceLabel::GetExtentAt (int n) const
 {
     const MapRectangle &fp = featurePoint->GetExtent();
     const MapRectangle &cp = GetExtent();
 
-    labelPos = n;
+    int px = 0, py = 0;
     
     switch (n) {
     
     case 0:
         // Top Centre
-        SetPosition(fp.x1 - cp.width / 2, fp.y1 - cp.height - 1);
+        px = fp.x1 - cp.width / 2; py = fp.y1 - cp.height - 1;
         break;
         
     case 1:
         // Bottom Centre
-        SetPosition(fp.x1 - cp.width / 2, fp.y2() + 1);
+        px = fp.x1 - cp.width / 2; py = fp.y2() + 1;
         break;
         
         
     case 2:
         // Bottom Right
-        SetPosition(fp.x2() + 1, fp.y2() + 1);
+        px = fp.x2() + 1; py = fp.y2() + 1;
         break;
         
     case 3:
         // Right
-        SetPosition(fp.x2() + 2, fp.y1);
+        px = fp.x2() + 2; py = fp.y1;
         break;
         
     case 4: 
         // Top Right
-        SetPosition(fp.x2() + 1, fp.y1 - cp.height + 1);
+        px = fp.x2() + 1; py = fp.y1 - cp.height + 1;
         break;
         
     case 5:
         // Top Left
-        SetPosition(fp.x1 - cp.width, fp.y1 - cp.height + 1);
+        px = fp.x1 - cp.width; py = fp.y1 - cp.height + 1;
         break;
         
     case 6:
         // Left
-        SetPosition(fp.x1 - cp.width - 2, fp.y1);        
+        px = fp.x1 - cp.width - 2; py = fp.y1;        
         break;
         
     case 7:
         // Bottom Left
-        SetPosition(fp.x1 - cp.width, fp.y2() + 1);
+        px = fp.x1 - cp.width; py = fp.y2() + 1;
         break;
         
     default:
         UplinkAssert(0);
     };
+    
+    return MapRectangle(px, py, cp.width, cp.height);
 }
 
 
+MapRectangle WorldMapInterfaceLabel::GetReach () const
+{
+    // Bounds of every position this label can be moved to
+    
+    MapRectangle reach = GetExtent();
+    
+    for (int i = 0; i < numPossLabelPos; i++) {
+	MapRectangle r = GetExtentAt(possLabelPos[i]);
+	int x2 = reach.Max(reach.x2(), r.x2());
+	int y2 = reach.Max(reach.y2(), r.y2());
+	reach.x1 = reach.Min(reach.x1, r.x1);
+	reach.y1 = reach.Min(reach.y1, r.y1);
+	reach.width = x2 - reach.x1 + 1;
+	reach.height = y2 - reach.y1 + 1;
+    }
+    
+    return reach;
+}
+
 bool WorldMapInterfaceLabel::Overlaps (WorldMapInterfaceObject *other) const
 {
     return GetExtent().intersects(other->GetExtent());
@@ -359,17 +403,32 @@ WorldMapObjectiveFunction::WorldMapObjectiveFunction(const MapRectangle &mapRect
       mapHeight(mapRect.height)
 {
     shadeScreen = new int [mapWidth * mapHeight];
+    summedArea = new int [(mapWidth + 1) * (mapHeight + 1)];
+    labelsSize = 0;
+    labelRects = NULL;
+    labelReach = NULL;
+    neighbourStart = NULL;
+    neighbours = NULL;
     Reset();
 }
 
 WorldMapObjectiveFunction::~WorldMapObjectiveFunction()
 {
     delete [] shadeScreen;
+    delete [] summedArea;
+    if (labelRects) delete [] labelRects;
+    if (labelReach) delete [] labelReach;
+    if (neighbourStart) delete [] neighbourStart;
+    if (neighbours) delete [] neighbours;
 }
 
 void WorldMapObjectiveFunction::Reset()
 {
     memset(shadeScreen, 0, mapWidth * mapHeight * sizeof(int));
+    summedAreaDirty = true;
+    numLabels = 0;
+    neighboursDirty = true;
+    undoIndex = -1;
     cost = 0;
 }
 
@@ -383,8 +442,23 @@ static inline int penalty( int numOverlaps )
     return numOverlaps;
 }
 
+static inline int overlapArea( const int *a, const int *b )
+{
+    int width = (a[2] < b[2] ? a[2] : b[2]) - (a[0] > b[0] ? a[0] : b[0]) + 1;
+    if (width <= 0)
+	return 0;
+    
+    int height = (a[3] < b[3] ? a[3] : b[3]) - (a[1] > b[1] ? a[1] : b[1]) + 1;
+    if (height <= 0)
+	return 0;
+    
+    return width * height;
+}
+
 void WorldMapObjectiveFunction::AddRect( const MapRectangle& rect )
 {
+    UplinkAssert (numLabels == 0);
+    
     MapRectangle r = clipRect.intersection(rect);
     
     if (r.isNull())
@@ -403,52 +477,437 @@ void WorldMapObjectiveFunction::AddRect( const MapRectangle& rect )
 		cost += penalty(line[x]);
 	}
     }
+    
+    summedAreaDirty = true;
+}
+
+void WorldMapObjectiveFunction::AddObject( const WorldMapInterfaceObject *m )
+{
+    AddRect(m->GetExtent());
 }
 
-void WorldMapObjectiveFunction::SubRect( const MapRectangle& rect )
+void WorldMapObjectiveFunction::BuildSummedArea()
 {
-    MapRectangle r = clipRect.intersection(rect);
+    // A label over a pixel already covered by n features adds
+    // the same penalty the shade screen would, n + 1
     
-    if (r.isNull())
-	return;
+    int stride = mapWidth + 1;
+    memset(summedArea, 0, stride * sizeof(int));
     
-    r.x1 -= clipRect.x1;
-    r.y1 -= clipRect.y1;
-    
-    int x2 = r.x2(), y2 = r.y2();
-    
-    for (int y = r.y1; y <= y2; y++) {
+    for (int y = 0; y < mapHeight; y++) {
 	int *line = shadeScreen + y * mapWidth;
-	for (int x = r.x1; x <= x2; x++) {
-	    line[x]--;
+	int *above = summedArea + y * stride;
+	int *sums = above + stride;
+	int rowSum = 0;
+	sums[0] = 0;
+	for (int x = 0; x < mapWidth; x++) {
 	    if (line[x] != 0)
-		cost -= penalty(1 + line[x]);
+		rowSum += penalty(line[x] + 1);
+	    sums[x + 1] = above[x + 1] + rowSum;
 	}
     }
+    
+    summedAreaDirty = false;
 }
 
-void WorldMapObjectiveFunction::AddObject( const WorldMapInterfaceObject *m )
+void WorldMapObjectiveFunction::BuildNeighbours()
 {
-    AddRect(m->GetExtent());
+    // Labels only move between their own positions, so the labels
+    // that can ever overlap each other are known up front
+    
+    if (neighbourStart) delete [] neighbourStart;
+    if (neighbours) delete [] neighbours;
+    
+    neighbourStart = new int [numLabels + 1];
+    for (int i = 0; i <= numLabels; i++)
+	neighbourStart[i] = 0;
+    
+    for (int i = 0; i < numLabels; i++)
+	for (int j = i + 1; j < numLabels; j++)
+	    if (overlapArea(labelReach + i * 4, labelReach + j * 4)) {
+		neighbourStart[i + 1]++;
+		neighbourStart[j + 1]++;
+	    }
+    
+    for (int i = 0; i < numLabels; i++)
+	neighbourStart[i + 1] += neighbourStart[i];
+    
+    neighbours = new int [neighbourStart[numLabels] > 0 ? neighbourStart[numLabels] : 1];
+    int *next = new int [numLabels > 0 ? numLabels : 1];
+    for (int i = 0; i < numLabels; i++)
+	next[i] = neighbourStart[i];
+    
+    for (int i = 0; i < numLabels; i++)
+	for (int j = i + 1; j < numLabels; j++)
+	    if (overlapArea(labelReach + i * 4, labelReach + j * 4)) {
+		neighbours[next[i]++] = j;
+		neighbours[next[j]++] = i;
+	    }
+    
+    delete [] next;
+    neighboursDirty = false;
+}
+
+void WorldMapObjectiveFunction::ClipLabel( const MapRectangle& rect, int *r ) const
+{
+    MapRectangle c = clipRect.intersection(rect);
+    
+    r[0] = c.x1 - clipRect.x1;
+    r[1] = c.y1 - clipRect.y1;
+    r[2] = r[0] + c.width - 1;
+    r[3] = r[1] + c.height - 1;
+}
+
+int WorldMapObjectiveFunction::FeatureCost( const int *r ) const
+{
+    if (r[2] < r[0] || r[3] < r[1])
+	return 0;
+    
+    int stride = mapWidth + 1;
+    const int *top = summedArea + r[1] * stride;
+    const int *bottom = summedArea + (r[3] + 1) * stride;
+    
+    return bottom[r[2] + 1] - bottom[r[0]] - top[r[2] + 1] + top[r[0]];
 }
 
-void WorldMapObjectiveFunction::SubObject( const WorldMapInterfaceObject *m )
+int WorldMapObjectiveFunction::LabelOverlap( int index, const int *r ) const
 {
-    SubRect(m->GetExtent());
+    // Pixels shared with other labels, each worth the penalty of two overlaps
+    
+    int overlap = 0;
+    
+    for (int i = neighbourStart[index]; i < neighbourStart[index + 1]; i++)
+	overlap += overlapArea(r, labelRects + neighbours[i] * 4);
+    
+    return overlap * penalty(2);
+}
+
+void WorldMapObjectiveFunction::AddLabel( const MapRectangle& rect, const MapRectangle& reach )
+{
+    if (summedAreaDirty)
+	BuildSummedArea();
+    
+    if (numLabels == labelsSize) {
+	int newSize = labelsSize ? labelsSize * 2 : 64;
+	int *newRects = new int [newSize * 4];
+	int *newReach = new int [newSize * 4];
+	if (labelRects) {
+	    memcpy(newRects, labelRects, numLabels * 4 * sizeof(int));
+	    memcpy(newReach, labelReach, numLabels * 4 * sizeof(int));
+	    delete [] labelRects;
+	    delete [] labelReach;
+	}
+	labelRects = newRects;
+	labelReach = newReach;
+	labelsSize = newSize;
+    }
+    
+    int *r = labelRects + numLabels * 4;
+    ClipLabel(rect, r);
+    ClipLabel(reach, labelReach + numLabels * 4);
+    
+    int overlap = 0;
+    for (int i = 0; i < numLabels; i++)
+	overlap += overlapArea(r, labelRects + i * 4);
+    
+    cost += FeatureCost(r) + overlap * penalty(2);
+    numLabels++;
+    neighboursDirty = true;
+}
+
+void WorldMapObjectiveFunction::MoveLabel( int index, const MapRectangle& rect )
+{
+    UplinkAssert (index >= 0 && index < numLabels);
+    
+    if (neighboursDirty)
+	BuildNeighbours();
+    
+    int *r = labelRects + index * 4;
+    int moved [4];
+    ClipLabel(rect, moved);
+    
+    undoIndex = index;
+    undoCost = cost;
+    memcpy(undoRect, r, sizeof(undoRect));
+    
+    cost -= FeatureCost(r) + LabelOverlap(index, r);
+    cost += FeatureCost(moved) + LabelOverlap(index, moved);
+    
+    memcpy(r, moved, sizeof(moved));
+}
+
+void WorldMapObjectiveFunction::UndoMove()
+{
+    UplinkAssert (undoIndex != -1);
+    
+    memcpy(labelRects + undoIndex * 4, undoRect, sizeof(undoRect));
+    cost = undoCost;
+    undoIndex = -1;
 }
 
 // ==============================================================================
 
-WorldMapLayout::WorldMapLayout(const MapRectangle &newMapRectangle)
-    : mapRectangle(newMapRectangle),
-      objective(newMapRectangle)
+// Everything a chain needs, copied from the labels on the main thread
+// so the workers never touch the interface objects
+
+struct WorldMapLayoutLabel
 {
+    int numPositions;
+    int positions [8];
+    int extents [8][4];                 // x, y, width, height at each position
+    int reach [4];
+};
+
+struct WorldMapLayoutJob
+{
+    WorldMapLayoutJob(const MapRectangle &newMapRect) : mapRect(newMapRect) {}
+
+    MapRectangle mapRect;
+    unsigned int seed;
+    
+    int numFeatures;
+    int *features;                      // x, y, width, height
+    
+    int numLabels;
+    WorldMapLayoutLabel *labels;
+    
+    int numChains;
+    int *chainPositions;                // numLabels per chain
+    int *chainCosts;
+    int best;
+    
+    std::atomic <int> running;
+    std::atomic <bool> cancelled;
+    std::atomic <WorldMapLayoutJob *> *published;
+};
+
+// One thread per chain. Every job goes to all of them at once, and a
+// new job is only handed out once they have all finished the last
+
+struct WorldMapLayoutPool
+{
+    int numWorkers;
+    std::thread *workers;
+    
+    std::mutex lock;
+    std::condition_variable wake;       // A new job, or quit
+    std::condition_variable idle;       // The last busy worker has finished
+    WorldMapLayoutJob *job;
+    unsigned int generation;            // Bumped for each job
+    int busy;
+    bool quit;
+};
+
+static int ChainRandom( unsigned int *state, int range )
+{
+    *state = *state * 1103515245 + 12345;
+    return (int) ((*state >> 8) % (unsigned int) range);
+}
+
+static float ChainUniform( unsigned int *state )
+{
+    *state = *state * 1103515245 + 12345;
+    return (float) (*state >> 8) / (float) 0xFFFFFF;
+}
+
+static MapRectangle ChainExtent( const WorldMapLayoutLabel *l, int pos )
+{
+    const int *e = l->extents[pos];
+    return MapRectangle(e[0], e[1], e[2], e[3]);
+}
+
+static void AnnealChain( WorldMapLayoutJob *job, int chain )
+{
+    // The same schedule PartialLayoutLabels used to run 20 moves at a time
+    
+    int n = job->numLabels;
+    int *positions = job->chainPositions + chain * n;
+    unsigned int random = job->seed * 2654435761u + chain * 40503u + 1;
+    
+    WorldMapObjectiveFunction objective(job->mapRect);
+    
+    for (int f = 0; f < job->numFeatures; f++) {
+	const int *r = job->features + f * 4;
+	objective.AddRect(MapRectangle(r[0], r[1], r[2], r[3]));
+    }
+    
+    for (int i = 0; i < n; i++) {
+	const WorldMapLayoutLabel *l = job->labels + i;
+	positions[i] = l->positions[ChainRandom(&random, l->numPositions)];
+	objective.AddLabel(ChainExtent(l, positions[i]), 
+			   MapRectangle(l->reach[0], l->reach[1], l->reach[2], l->reach[3]));
+    }
+    
+    float E = (float) objective.GetCost();
+    float T = 10.0f / log(3.0f);
+    int iteration = 0, moveNumber = 0, numGoodMoves = 0;
+    int totalMoves = 0;
+    bool complete = (n == 0);
+    
+    while (!complete && !job->cancelled) {
+	
+	for (int i = 0; E > 0 && i < 20; i++) {
+	    int index = ChainRandom(&random, n);
+	    const WorldMapLayoutLabel *l = job->labels + index;
+	    
+	    int origPos = positions[index];
+	    
+	    positions[index] = l->positions[ChainRandom(&random, l->numPositions)];
+	    objective.MoveLabel(index, ChainExtent(l, positions[index]));
+	    
+	    float deltaE = objective.GetCost() - E;
+	    
+	    if (deltaE < 0)
+		numGoodMoves++;
+	    else {
+		float expX = -deltaE/T;
+		if ( expX > 700.0f )
+		    expX = 700.0f;
+		else if ( expX < -700.0f )
+		    expX = -700.0f;
+		
+		if (ChainUniform(&random) <= 1.0 - exp(expX)) {
+		    objective.UndoMove();
+		    positions[index] = origPos;
+		    deltaE = 0;
+		}
+	    }
+	    
+	    E += deltaE;
+	}
+	
+	moveNumber += 20;
+	totalMoves += 20;
+	
+	if (numGoodMoves >= 5*n || moveNumber >= 10*n) {
+	    
+	    if (E <= 0 || numGoodMoves <= 0 || iteration > 20)
+		complete = true;
+	    
+	    iteration++;
+	    moveNumber = 0;
+	    numGoodMoves = 0;
+	    T -= T / 10.0f;
+	}
+	
+	// The schedule normally ends well before this. Counting moves rather
+	// than time keeps the layout the same however busy the machine is
+	
+	if (totalMoves >= WORLDMAPLAYOUT_MAXMOVES * n)
+	    complete = true;
+    }
+    
+    job->chainCosts[chain] = objective.GetCost();
+}
+
+static void LayoutWorker( WorldMapLayoutPool *pool, int chain )
+{
+    unsigned int seen = 0;
+    
+    while (true) {
+	
+	WorldMapLayoutJob *job;
+	
+	{
+	    std::unique_lock <std::mutex> hold(pool->lock);
+	    while (!pool->quit && pool->generation == seen)
+		pool->wake.wait(hold);
+	    
+	    if (pool->quit)
+		return;
+	    
+	    seen = pool->generation;
+	    job = pool->job;
+	}
+	
+	AnnealChain(job, chain);
+	
+	// The last chain to finish picks the cheapest, lowest chain first
+	// so a given seed and thread count always give the same layout
+	
+	if (job->running.fetch_sub(1) == 1) {
+	    job->best = 0;
+	    for (int c = 1; c < job->numChains; c++)
+		if (job->chainCosts[c] < job->chainCosts[job->best])
+		    job->best = c;
+	    
+	    job->published->store(job);
+	}
+	
+	std::lock_guard <std::mutex> hold(pool->lock);
+	if (--pool->busy == 0)
+	    pool->idle.notify_all();
+    }
+}
+
+static WorldMapLayoutPool *CreatePool( int numWorkers )
+{
+    WorldMapLayoutPool *pool = new WorldMapLayoutPool();
+    pool->numWorkers = numWorkers;
+    pool->job = NULL;
+    pool->generation = 0;
+    pool->busy = 0;
+    pool->quit = false;
+    
+    pool->workers = new std::thread [numWorkers];
+    for (int c = 0; c < numWorkers; c++)
+	pool->workers[c] = std::thread(LayoutWorker, pool, c);
+    
+    return pool;
+}
+
+static void WaitForWorkers( WorldMapLayoutPool *pool )
+{
+    std::unique_lock <std::mutex> hold(pool->lock);
+    while (pool->busy > 0)
+	pool->idle.wait(hold);
+}
+
+static void DeletePool( WorldMapLayoutPool *pool )
+{
+    WaitForWorkers(pool);
+    
+    {
+	std::lock_guard <std::mutex> hold(pool->lock);
+	pool->quit = true;
+    }
+    pool->wake.notify_all();
+    
+    for (int c = 0; c < pool->numWorkers; c++)
+	pool->workers[c].join();
+    
+    delete [] pool->workers;
+    delete pool;
+}
+
+// ==============================================================================
+
+WorldMapLayout::WorldMapLayout(const MapRectangle &newMapRectangle, int newNumThreads, unsigned int newSeed)
+    : numThreads(newNumThreads),
+      seed(newSeed),
+      mapRectangle(newMapRectangle),
+      pool(NULL),
+      job(NULL),
+      published(NULL)
+{
+    if (numThreads <= 0) {
+	numThreads = (int) std::thread::hardware_concurrency();
+	if (numThreads > WORLDMAPLAYOUT_MAXTHREADS)
+	    numThreads = WORLDMAPLAYOUT_MAXTHREADS;
+    }
+    if (numThreads <= 0)
+	numThreads = 1;
+    
     Reset();
 }
 
 WorldMapLayout::~WorldMapLayout()
 {
+    StopLayout();
     DeleteLocations();
+    
+    if (pool)
+	DeletePool(pool);
 }
 
 void WorldMapLayout::Reset ()
@@ -465,11 +924,8 @@ void WorldMapLayout::ResetTemp ()
 
 void WorldMapLayout::ResetLayoutParameters()
 {
+    StopLayout();
     layoutStarted = false;
-    iteration = moveNumber = numGoodMoves = 0;
-    T = 0.0;
-    E = -1.0;
-    objective.Reset();
 }
 
 void WorldMapLayout::DeleteLocations()
@@ -502,16 +958,19 @@ void WorldMapLayout::AddLocation ( int x, int y, const char *name, const char *i
     thelabel->SetBasePosition( x, y );
     labels.PutData (thelabel);
     
-	if ( !tempForConnection ) {
-		if ( layoutStarted ) 
-			ResetLayoutParameters();
-    
+	if ( layoutStarted ) 
+		ResetLayoutParameters();
+
+	if ( !tempForConnection )
 		layoutComplete = false;
-	}
 }
 
 void WorldMapLayout::DeleteLocationsTemp()
 {
+	// A running layout holds labels by index
+	if ( layoutStarted )
+		ResetLayoutParameters();
+
 	int i = 0;
 	while ( i < locations.Size () ) {
 		if ( locations.GetData ( i )->tempForConnection ) {
@@ -533,106 +992,141 @@ bool WorldMapLayout::IsLayoutComplete() const
 
 void WorldMapLayout::StartLayout()
 {
-     layoutStarted = true;
+    layoutStarted = true;
     
-    // Initial Random Layout
+    // Snapshot the locations and labels for the workers
     
-    for ( int i = 0; i < labels.Size (); ++i ) {
+    job = new WorldMapLayoutJob(mapRectangle);
+    job->seed = seed;
+    job->numFeatures = locations.Size() * 2;
+    job->features = new int [job->numFeatures * 4 + 1];
+    
+    for ( int il = 0; il < locations.Size (); ++il ) {
 	
-	WorldMapInterfaceLabel *l = labels.GetData (i);
+	WorldMapInterfaceObject *l = locations.GetData (il);
 	UplinkAssert (l);
-	l->SetRandomLabelPosition();
-	objective.AddObject(l);
+	
+	// The location itself and its feature-point neighbourhood
+	
+	MapRectangle r = l->GetExtent();
+	int *f = job->features + il * 8;
+	f[0] = r.x1;            f[1] = r.y1;            f[2] = r.width;         f[3] = r.height;
+	f[4] = r.x1 - r.width;  f[5] = r.y1 - r.height; f[6] = r.width * 3;     f[7] = r.height * 3;
     }
     
-    for ( int il = 0; il < locations.Size (); ++il ) {
+    job->numLabels = labels.Size();
+    job->labels = new WorldMapLayoutLabel [job->numLabels + 1];
+    
+    for ( int i = 0; i < labels.Size (); ++i ) {
 	
-	WorldMapInterfaceObject *l = locations.GetData (il);
+	WorldMapInterfaceLabel *l = labels.GetData (i);
 	UplinkAssert (l);
-	objective.AddObject(l);
+	WorldMapLayoutLabel *jl = job->labels + i;
 	
-	// Add in feature-point neighbourhood 
+	jl->numPositions = l->NumPossibleLabelPositions();
+	for (int p = 0; p < jl->numPositions; p++)
+	    jl->positions[p] = l->GetPossibleLabelPosition(p);
 	
-	MapRectangle n = l->GetExtent();
-	n.x1 -= n.width;
-	n.y1 -= n.height;
-	n.width *= 3;
-	n.height *= 3;
+	if (jl->numPositions == 0) {
+	    // Doesn't fit anywhere on the map, so stays put
+	    jl->numPositions = 1;
+	    jl->positions[0] = l->GetLabelPosition();
+	}
+	
+	for (int pos = 0; pos < 8; pos++) {
+	    MapRectangle r = l->GetExtentAt(pos);
+	    jl->extents[pos][0] = r.x1;
+	    jl->extents[pos][1] = r.y1;
+	    jl->extents[pos][2] = r.width;
+	    jl->extents[pos][3] = r.height;
+	}
 	
-	objective.AddRect(n);
+	MapRectangle reach = l->GetReach();
+	jl->reach[0] = reach.x1;
+	jl->reach[1] = reach.y1;
+	jl->reach[2] = reach.width;
+	jl->reach[3] = reach.height;
+    }
+    
+    job->numChains = numThreads;
+    job->chainPositions = new int [job->numChains * job->numLabels + 1];
+    job->chainCosts = new int [job->numChains];
+    job->best = 0;
+    job->running = job->numChains;
+    job->cancelled = false;
+    job->published = &published;
+    
+    if (!pool)
+	pool = CreatePool(numThreads);
+    
+    {
+	std::lock_guard <std::mutex> hold(pool->lock);
+	pool->job = job;
+	pool->generation++;
+	pool->busy = pool->numWorkers;
     }
+    pool->wake.notify_all();
+}
+
+void WorldMapLayout::StopLayout()
+{
+    if (!job)
+	return;
+    
+    job->cancelled = true;
+    WaitForWorkers(pool);
+    published = NULL;
     
-     E = (float) objective.GetCost();
-     T = 10.0f / log(3.0f);
+    delete [] job->features;
+    delete [] job->labels;
+    delete [] job->chainPositions;
+    delete [] job->chainCosts;
+    delete job;
+    job = NULL;
 }
 
-void WorldMapLayout::PartialLayoutLabels()
+void WorldMapLayout::FinishLayout( WorldMapLayoutJob *finished )
 {
-    int n = labels.Size();
+    UplinkAssert (finished && finished == job);
     
+    // Every chain is done, though the last worker may not be waiting again yet
+    
+    WaitForWorkers(pool);
+    
+    int *positions = job->chainPositions + job->best * job->numLabels;
+    for ( int i = 0; i < labels.Size (); ++i )
+	labels.GetData (i)->SetLabelPosition(positions[i]);
+    
+    StopLayout();
+    
+    layoutComplete = true;
+}
+
+void WorldMapLayout::PartialLayoutLabels()
+{
     if (layoutComplete) 
         return;
     
     if (!layoutStarted)
         StartLayout();
     
-    for (int i = 0; E > 0 && i < 20; i++) {
-        WorldMapInterfaceLabel *l = labels.GetData(NumberGenerator::RandomNumber(n));
-	    
-        int origLabelPos = l->GetLabelPosition();
-	    
-        objective.SubObject(l);
-        l->SetRandomLabelPosition();
-        objective.AddObject(l);
-	    
-        float deltaE = objective.GetCost() - E;
-
-        if (deltaE < 0)
-            numGoodMoves++;
-        else {
-			float expX = -deltaE/T;
-			// exp: X >= 7.097827e+002 = INEXACT+OVERFLOW, X <= -7.083964e+002 = INEXACT+UNDERFLOW
-			if ( expX > 700.0f )
-				expX = 700.0f;
-			else if ( expX < -700.0f )
-				expX = -700.0f;
-
-            if (NumberGenerator::RandomUniformNumber() <= 1.0 - exp(expX)) {
-		    
-                objective.SubObject(l);
-                l->SetLabelPosition(origLabelPos);
-                objective.AddObject(l);
-		    
-                deltaE = 0;
-            }
-        }
-	    
-        E += deltaE;
-    }
-    
-    moveNumber += 20;
-        
-    if (numGoodMoves >= 5*n || moveNumber >= 10*n) {
-        
-        if (E <= 0 || numGoodMoves <= 0 || iteration > 20)
-            layoutComplete = true;
-            
-        iteration++;
-        moveNumber = 0;
-        numGoodMoves = 0;
-        T -= T / 10.0f;
-    }
-    
+    WorldMapLayoutJob *finished = published.exchange(NULL);
+    if (finished)
+	FinishLayout(finished);
 }
 
 void WorldMapLayout::FullLayoutLabels()
 {
+    if (layoutComplete) 
+        return;
     
-    int startTime = (int) EclGetAccurateTime();
+    if (!layoutStarted)
+        StartLayout();
     
-    while (!layoutComplete && EclGetAccurateTime() - startTime < 1500)
-        PartialLayoutLabels();
-
+    // Each chain gives up after WORLDMAPLAYOUT_MAXMOVES a label
+    
+    WaitForWorkers(pool);
+    FinishLayout(published.exchange(NULL));
 }
     
 LList <WorldMapInterfaceObject *> &
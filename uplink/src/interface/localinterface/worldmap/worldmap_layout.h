@@ -5,9 +5,18 @@
 #define WORLDMAPOBJECT_LOCATION		2
 #define WORLDMAPOBJECT_GATEWAY		3
 
+#define WORLDMAPLAYOUT_SEED         1
+#define WORLDMAPLAYOUT_MAXMOVES     250         // Moves per label each annealing chain may try
+#define WORLDMAPLAYOUT_MAXTHREADS   8           // When left to one per core
+
+#include <atomic>
+
 #include "rectangle.h"
 #include "tosser.h"
 
+struct WorldMapLayoutJob;
+struct WorldMapLayoutPool;
+
 class WorldMapInterfaceObject
 {
 
@@ -58,7 +67,12 @@ public:
     void SetRandomLabelPosition();
 
     int GetLabelPosition() const;
+    int NumPossibleLabelPositions() const;
+    int GetPossibleLabelPosition(int i) const;
+    
     virtual MapRectangle GetExtent() const;
+    MapRectangle GetExtentAt(int n) const;
+    MapRectangle GetReach() const;
     bool Overlaps(WorldMapInterfaceObject *label) const;
     
     virtual void Draw( int xOffset = 0, int yOffset = 0, float zoom = 1.0  );
@@ -89,27 +103,63 @@ public:
     
     int GetCost() const;
     
-    void AddObject( const WorldMapInterfaceObject *m );
-    void SubObject( const WorldMapInterfaceObject *m );
+    // Fixed features (locations and their neighbourhoods) go in first.
+    // Each label is then scored against a summed area table of them,
+    // plus its overlap with the labels that can reach it
     
+    void AddObject( const WorldMapInterfaceObject *m );
     void AddRect( const MapRectangle& r );
-    void SubRect( const MapRectangle& r );
+    
+    void AddLabel( const MapRectangle& r, const MapRectangle& reach );
+    void MoveLabel( int index, const MapRectangle& r );
+    void UndoMove();                                        // Puts back the last label moved
     
     void Reset();
     
+protected:
+    
+    void BuildSummedArea();
+    void BuildNeighbours();
+    void ClipLabel( const MapRectangle& rect, int *r ) const;
+    int FeatureCost( const int *r ) const;
+    int LabelOverlap( int index, const int *r ) const;
+    
 protected:
     
     int cost;
     int mapWidth, mapHeight;
-    int *shadeScreen;
+    int *shadeScreen;                   // Number of fixed features over each pixel
+    int *summedArea;                    // (mapWidth+1) * (mapHeight+1) sums of the cost of a label over each pixel
+    bool summedAreaDirty;
     MapRectangle clipRect;
     
+    int numLabels;
+    int labelsSize;
+    int *labelRects;                    // x1, y1, x2, y2 per label, clipped to the map
+    int *labelReach;                    // Bounds of every position each label can take
+    
+    // The labels that can overlap label i are neighbours [neighbourStart[i]] to neighbours [neighbourStart[i+1] - 1]
+    int *neighbourStart;
+    int *neighbours;
+    bool neighboursDirty;
+    
+    int undoIndex;
+    int undoRect [4];
+    int undoCost;
+    
 };
 
+// Labels are laid out on worker threads, one seeded annealing chain
+// per thread, and the cheapest chain is published when they all finish.
+// Until then the labels stay where they were. The threads are started
+// with the first layout and kept for the next
+
 class WorldMapLayout {
 public:
     
-    WorldMapLayout(const MapRectangle &newMapRectangle);
+    WorldMapLayout(const MapRectangle &newMapRectangle, 
+		   int newNumThreads = 0,                           // 0 for one per core, up to WORLDMAPLAYOUT_MAXTHREADS
+		   unsigned int newSeed = WORLDMAPLAYOUT_SEED);
     ~WorldMapLayout();
     
     void Reset ();
@@ -117,8 +167,8 @@ public:
     void AddLocation ( int x, int y, const char *name, const char *ip = NULL, bool tempForConnection = false );
     void DeleteLocationsTemp ();
     
-    void PartialLayoutLabels();
-    void FullLayoutLabels();
+    void PartialLayoutLabels();                             // Takes the layout if it has been published
+    void FullLayoutLabels();                                // Waits for the layout
     
     bool IsLayoutComplete() const;
     
@@ -132,16 +182,15 @@ public:
 protected:
     
     void StartLayout();
+    void StopLayout();
+    void FinishLayout( WorldMapLayoutJob *finished );
     void DeleteLocations();
     void ResetLayoutParameters();
     
 protected:
     
-    int iteration;
-    int moveNumber;
-    int numGoodMoves;
-    float T;                                                // temperature
-    float E;                                                // current value of the objective function
+    int numThreads;
+    unsigned int seed;
     
     bool layoutComplete;
     bool layoutStarted;
@@ -149,7 +198,10 @@ protected:
     MapRectangle mapRectangle;
     LList <WorldMapInterfaceObject *> locations;
     LList <WorldMapInterfaceLabel *> labels;
-    WorldMapObjectiveFunction objective;
+    
+    WorldMapLayoutPool *pool;
+    WorldMapLayoutJob *job;                                 // Owned here while the workers run
+    std::atomic <WorldMapLayoutJob *> published;            // Set by the last worker to finish
     
 };
 
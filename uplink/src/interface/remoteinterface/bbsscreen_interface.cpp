@@ -41,7 +41,7 @@
 
 
 int BBSScreenInterface::baseoffset = 0;
-int BBSScreenInterface::currentselect = -1;
+Mission *BBSScreenInterface::currentselect = NULL;
 int BBSScreenInterface::previousnummessages = 0;
 int BBSScreenInterface::previousupdate = 0;
 
@@ -56,17 +56,20 @@ void BBSScreenInterface::ClickBBSButton ( Button *button )
 
 	index += baseoffset;
 
-	// Dirty the old button
-	char oldname [128];
-	UplinkSnprintf ( oldname, sizeof ( oldname ), "BBmessage %d", currentselect - baseoffset );
-	EclDirtyButton ( oldname );
+	// Dirty the old button, wherever it has moved to
 
 	CompanyUplink *cu = (CompanyUplink *) game->GetWorld ()->GetCompany ( "Uplink" );
 	UplinkAssert ( cu );
 
+	if ( currentselect ) {
+		char oldname [128];
+		UplinkSnprintf ( oldname, sizeof ( oldname ), "BBmessage %d", cu->missions.FindData ( currentselect ) - baseoffset );
+		EclDirtyButton ( oldname );
+	}
+
 	if ( cu->GetMission ( index ) ) {
 
-		currentselect = index;
+		currentselect = cu->GetMission ( index );
 
 		if ( game->GetWorld ()->GetPlayer ()->rating.uplinkrating >= cu->GetMission (index)->minuplinkrating ) 
 			EclRegisterCaptionChange ( "bbs_details", cu->GetMission (index)->GetDetails (), 2000 );
@@ -85,7 +88,7 @@ void BBSScreenInterface::DrawBBSButton ( Button *button, bool highlighted, bool
 	sscanf ( button->name, "BBmessage %d", &index );
 	index += baseoffset;
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -100,20 +103,20 @@ void BBSScreenInterface::DrawBBSButton ( Button *button, bool highlighted, bool
 
 	if ( mission ) {
 		
-		if ( index == currentselect ) {
+		if ( mission == currentselect ) {
 
 			glBegin ( GL_QUADS );
-				SetColour ( "PanelHighlightA" );        glVertex2i ( button->x, button->y );
-				SetColour ( "PanelHighlightB" );        glVertex2i ( button->x + button->width, button->y );
-				SetColour ( "PanelHighlightA" );        glVertex2i ( button->x + button->width, button->y + button->height );
-				SetColour ( "PanelHighlightB" );        glVertex2i ( button->x, button->y + button->height );
+				SetColour ( COLOUR_PANELHIGHLIGHTA );        glVertex2i ( button->x, button->y );
+				SetColour ( COLOUR_PANELHIGHLIGHTB );        glVertex2i ( button->x + button->width, button->y );
+				SetColour ( COLOUR_PANELHIGHLIGHTA );        glVertex2i ( button->x + button->width, button->y + button->height );
+				SetColour ( COLOUR_PANELHIGHLIGHTB );        glVertex2i ( button->x, button->y + button->height );
 			glEnd ();
 
 		}
 
 		if ( highlighted ) {
 
-			SetColour ( "PanelHighlightBorder" );
+			SetColour ( COLOUR_PANELHIGHLIGHTBORDER );
 			border_draw ( button );
 
 		}
@@ -158,13 +161,13 @@ void BBSScreenInterface::DrawDetails ( Button *button, bool highlighted, bool cl
 {
 
 	glBegin ( GL_QUADS );
-		SetColour ( "PanelBackgroundA" );       glVertex2i ( button->x, button->y + button->height );
-		SetColour ( "PanelBackgroundB" );       glVertex2i ( button->x, button->y );
-		SetColour ( "PanelBackgroundA" );       glVertex2i ( button->x + button->width, button->y );
-		SetColour ( "PanelBackgroundB" );       glVertex2i ( button->x + button->width, button->y + button->height );
+		SetColour ( COLOUR_PANELBACKGROUNDA );       glVertex2i ( button->x, button->y + button->height );
+		SetColour ( COLOUR_PANELBACKGROUNDB );       glVertex2i ( button->x, button->y );
+		SetColour ( COLOUR_PANELBACKGROUNDA );       glVertex2i ( button->x + button->width, button->y );
+		SetColour ( COLOUR_PANELBACKGROUNDB );       glVertex2i ( button->x + button->width, button->y + button->height );
 	glEnd ();
 
-    SetColour ( "PanelBorder" );
+    SetColour ( COLOUR_PANELBORDER );
 	border_draw ( button );
 
 	text_draw ( button, highlighted, clicked );
@@ -216,7 +219,8 @@ void BBSScreenInterface::AcceptClick ( Button *button )
 	CompanyUplink *cu = (CompanyUplink *) game->GetWorld ()->GetCompany ( "Uplink" );
 	UplinkAssert ( cu );
 
-	Mission *mission = cu->GetMission ( currentselect );
+	int index = currentselect ? cu->missions.FindData ( currentselect ) : -1;
+	Mission *mission = cu->GetMission ( index );
 
 	if ( mission ) {
 
@@ -249,9 +253,9 @@ void BBSScreenInterface::AcceptClick ( Button *button )
 
 			game->GetWorld ()->GetPlayer ()->GiveMission ( mission );
 		
-			cu->missions.RemoveData ( currentselect );
+			cu->missions.RemoveData ( index );
 		
-			currentselect = -1;
+			currentselect = NULL;
 			EclRegisterCaptionChange ( "bbs_details", " " );
 
 		}		
@@ -274,7 +278,7 @@ void BBSScreenInterface::ContactClick ( Button *button )
 	CompanyUplink *cu = (CompanyUplink *) game->GetWorld ()->GetCompany ( "Uplink" );
 	UplinkAssert ( cu );
 
-	Mission *mission = cu->GetMission ( currentselect );
+	Mission *mission = currentselect && cu->missions.FindData ( currentselect ) != -1 ? currentselect : NULL;
 
 	// Get the bbs screen
 
@@ -345,7 +349,7 @@ bool BBSScreenInterface::EscapeKeyPressed ()
 
 int BBSScreenInterface::NumItemsOnScreen ()
 {
-    int screenheight = app->GetOptions()->GetOptionValue( "graphics_screenheight" );
+    int screenheight = app->GetOptions()->GetOptionValue ( OPTION_SCREENHEIGHT );
     int availablePixels = screenheight - 200 - 45;
     return availablePixels/20;
 }
@@ -390,7 +394,7 @@ void BBSScreenInterface::Create ( ComputerScreen *newcs )
         ScrollBox::CreateScrollBox ( "bbs_scroll", 22 + SY(388), 47, 15, NumItemsOnScreen() * 20, cu->missions.Size(), 12, 0, ScrollChange );
 
 		baseoffset = 0;
-		currentselect = -1;
+		currentselect = NULL;
 
 	}
 
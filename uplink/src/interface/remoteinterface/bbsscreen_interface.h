@@ -14,6 +14,7 @@
 
 class ComputerScreen;
 class BBSScreen;
+class Mission;
 
 // ============================================================================
 
@@ -24,7 +25,7 @@ class BBSScreenInterface : public RemoteInterfaceScreen
 protected:
 
 	static int baseoffset;
-	static int currentselect;
+	static Mission *currentselect;				// Stays put as the board changes - check it is still there before use
 
 	static int previousnummessages;
 	static int previousupdate;
@@ -15,6 +15,8 @@
 #include "app/miscutils.h"
 #include "app/opengl_interface.h"
 
+#include "options/options.h"
+
 #include "game/game.h"
 #include "game/data/data.h"
 
@@ -88,20 +90,20 @@ void ChangeGatewayScreenInterface::GatewayButtonDraw ( Button *button, bool high
 		if ( index % 2 == 0 ) {
 
 			glBegin ( GL_QUADS );
-				SetColour ( "DarkPanelA" );     glVertex2i ( button->x, button->y + button->height );
-				SetColour ( "DarkPanelB" );     glVertex2i ( button->x, button->y );
-				SetColour ( "DarkPanelA" );     glVertex2i ( button->x + button->width, button->y );
-				SetColour ( "DarkPanelB" );     glVertex2i ( button->x + button->width, button->y + button->height );
+				SetColour ( COLOUR_DARKPANELA );     glVertex2i ( button->x, button->y + button->height );
+				SetColour ( COLOUR_DARKPANELB );     glVertex2i ( button->x, button->y );
+				SetColour ( COLOUR_DARKPANELA );     glVertex2i ( button->x + button->width, button->y );
+				SetColour ( COLOUR_DARKPANELB );     glVertex2i ( button->x + button->width, button->y + button->height );
 			glEnd ();
 
 		}
 		else {
 
 			glBegin ( GL_QUADS );
-				SetColour ( "DarkPanelB" );     glVertex2i ( button->x, button->y + button->height );
-				SetColour ( "DarkPanelA" );     glVertex2i ( button->x, button->y );
-				SetColour ( "DarkPanelB" );     glVertex2i ( button->x + button->width, button->y );
-				SetColour ( "DarkPanelA" );     glVertex2i ( button->x + button->width, button->y + button->height );
+				SetColour ( COLOUR_DARKPANELB );     glVertex2i ( button->x, button->y + button->height );
+				SetColour ( COLOUR_DARKPANELA );     glVertex2i ( button->x, button->y );
+				SetColour ( COLOUR_DARKPANELB );     glVertex2i ( button->x + button->width, button->y );
+				SetColour ( COLOUR_DARKPANELA );     glVertex2i ( button->x + button->width, button->y + button->height );
 			glEnd ();
 
 		}
@@ -110,13 +112,13 @@ void ChangeGatewayScreenInterface::GatewayButtonDraw ( Button *button, bool high
 
 	if ( highlighted ) {
 
-		SetColour ( "PanelHighlightBorder" );
+		SetColour ( COLOUR_PANELHIGHLIGHTBORDER );
 		border_draw ( button );
 
 	}
     else if ( index == thisint->currentselect ) {
 
-        SetColour ( "PanelBorder" );
+        SetColour ( COLOUR_PANELBORDER );
         border_draw ( button );
 
     }
@@ -126,8 +128,8 @@ void ChangeGatewayScreenInterface::GatewayButtonDraw ( Button *button, bool high
 	int price = thisint->GetGatewayPrice(index);
 	bool hasmoney = ( game->GetWorld ()->GetPlayer ()->GetBalance () >= price );
 
-	if ( hasmoney ) 	SetColour ( "DefaultText" );
-	else				SetColour ( "DimmedText" );
+	if ( hasmoney ) 	SetColour ( COLOUR_DEFAULTTEXT );
+	else				SetColour ( COLOUR_DIMMEDTEXT );
 
 	char cost [16];
 	UplinkSnprintf ( cost, sizeof ( cost ), "%dc", price );
@@ -483,6 +483,8 @@ void ConsoleScreenInterface::RunCommand_DELETEALL ( char *dir )
 
 			}
 
+			comp->logbank.InvalidateIndex ();
+
 		}
 		else if ( strcmp ( dir, "usr" ) == 0 ) {
 
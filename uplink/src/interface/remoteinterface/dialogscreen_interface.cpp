@@ -45,7 +45,7 @@ void DialogScreenInterface::PasswordBoxDraw ( Button *button, bool highlighted,
 
 	UplinkAssert (button);
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -18,6 +18,8 @@
 #include "app/miscutils.h"
 #include "app/opengl_interface.h"
 
+#include "options/options.h"
+
 #include "game/game.h"
 #include "game/data/data.h"
 
@@ -147,25 +149,25 @@ void HWSalesScreenInterface::DrawHWButton ( Button *button, bool highlighted, bo
 		if ( index == currentselect ) {
 
 			glBegin ( GL_QUADS );
-				SetColour ( "PanelHighlightA" );        glVertex2i ( button->x, button->y );
-				SetColour ( "PanelHighlightB" );        glVertex2i ( button->x + button->width, button->y );
-				SetColour ( "PanelHighlightA" );        glVertex2i ( button->x + button->width, button->y + button->height );
-				SetColour ( "PanelHighlightB" );        glVertex2i ( button->x, button->y + button->height );
+				SetColour ( COLOUR_PANELHIGHLIGHTA );        glVertex2i ( button->x, button->y );
+				SetColour ( COLOUR_PANELHIGHLIGHTB );        glVertex2i ( button->x + button->width, button->y );
+				SetColour ( COLOUR_PANELHIGHLIGHTA );        glVertex2i ( button->x + button->width, button->y + button->height );
+				SetColour ( COLOUR_PANELHIGHLIGHTB );        glVertex2i ( button->x, button->y + button->height );
 			glEnd ();
 
 		}
 
 		if ( highlighted || index == currentselect ) {
 
-			SetColour ( "PanelBorder" );
+			SetColour ( COLOUR_PANELBORDER );
 			border_draw ( button );
 
 		}
 
 		bool hasmoney = ( game->GetWorld ()->GetPlayer ()->GetBalance () >= sv->cost );
 
-		if ( hasmoney ) 	SetColour ( "DefaultText" );
-		else                SetColour ( "DimmedText" );
+		if ( hasmoney ) 	SetColour ( COLOUR_DEFAULTTEXT );
+		else                SetColour ( COLOUR_DIMMEDTEXT );
 
 		char name [SIZE_SALE_TITLE];		
 		char cost [32];
@@ -182,13 +184,13 @@ void HWSalesScreenInterface::DrawDetails ( Button *button, bool highlighted, boo
 {
 
 	glBegin ( GL_QUADS );
-		SetColour ( "PanelBackgroundA" );       glVertex2i ( button->x, button->y + button->height );
-		SetColour ( "PanelBackgroundB" );       glVertex2i ( button->x, button->y );
-		SetColour ( "PanelBackgroundA" );       glVertex2i ( button->x + button->width, button->y );
-		SetColour ( "PanelBackgroundB" );       glVertex2i ( button->x + button->width, button->y + button->height );
+		SetColour ( COLOUR_PANELBACKGROUNDA );       glVertex2i ( button->x, button->y + button->height );
+		SetColour ( COLOUR_PANELBACKGROUNDB );       glVertex2i ( button->x, button->y );
+		SetColour ( COLOUR_PANELBACKGROUNDA );       glVertex2i ( button->x + button->width, button->y );
+		SetColour ( COLOUR_PANELBACKGROUNDB );       glVertex2i ( button->x + button->width, button->y + button->height );
 	glEnd ();
 
-	SetColour ( "PanelBorder" );
+	SetColour ( COLOUR_PANELBORDER );
 	border_draw ( button );
 
 	text_draw ( button, highlighted, clicked );
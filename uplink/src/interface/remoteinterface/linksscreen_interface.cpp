@@ -60,15 +60,19 @@ LinksScreenInterface::LinksScreenInterface ()
 	iadd_h_tif = get_assignbitmap ( "add_h.tif" );
 	iadd_c_tif = get_assignbitmap ( "add_c.tif" );
 
+	lastfilter = NULL;
+
 }
 
 LinksScreenInterface::~LinksScreenInterface ()
 {
     
-    DeleteLListData ( &fulllist );
+    DeleteDequeData ( &fulllist );
 	fulllist.Empty ();
-    DeleteLListData ( &filteredlist );
 	filteredlist.Empty ();
+	searchindex.Empty ();
+
+	if ( lastfilter ) delete [] lastfilter;
 
 	if ( ilink_tif ) {
 		delete ilink_tif;
@@ -110,7 +114,7 @@ void LinksScreenInterface::LinkClick ( Button *button )
 	sscanf ( button->name, "linksscreen_link %d", &fileindex );
 	fileindex += baseoffset;
 
-	LList <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
+	Deque <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
 
 	if ( filteredlist->ValidIndex (fileindex) ) {
 
@@ -152,7 +156,7 @@ void LinksScreenInterface::LinkDraw ( Button *button, bool highlighted, bool cli
 	sscanf ( button->name, "linksscreen_link %d", &linkindex );
 	linkindex += baseoffset;
 
-	LList <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;	
+	Deque <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;	
     char *link = filteredlist->ValidIndex(linkindex) ? filteredlist->GetData (linkindex) : NULL;
 
 	/*
@@ -172,25 +176,25 @@ void LinksScreenInterface::LinkDraw ( Button *button, bool highlighted, bool cli
 		if ( linkindex % 2 == 0 ) {
 
 			glBegin ( GL_QUADS );
-				SetColour ( "DarkPanelB" );   glVertex2i ( button->x, button->y );
-				SetColour ( "DarkPanelA" );   glVertex2i ( button->x + button->width, button->y );
-				SetColour ( "DarkPanelB" );   glVertex2i ( button->x + button->width, button->y + button->height );
-				SetColour ( "DarkPanelA" );   glVertex2i ( button->x, button->y + button->height );
+				SetColour ( COLOUR_DARKPANELB );   glVertex2i ( button->x, button->y );
+				SetColour ( COLOUR_DARKPANELA );   glVertex2i ( button->x + button->width, button->y );
+				SetColour ( COLOUR_DARKPANELB );   glVertex2i ( button->x + button->width, button->y + button->height );
+				SetColour ( COLOUR_DARKPANELA );   glVertex2i ( button->x, button->y + button->height );
 			glEnd ();
 
 		}
 		else {
 
 			glBegin ( GL_QUADS );
-				SetColour ( "DarkPanelA" );   glVertex2i ( button->x, button->y );
-				SetColour ( "DarkPanelB" );   glVertex2i ( button->x + button->width, button->y );
-				SetColour ( "DarkPanelA" );   glVertex2i ( button->x + button->width, button->y + button->height );
-				SetColour ( "DarkPanelB" );   glVertex2i ( button->x, button->y + button->height );
+				SetColour ( COLOUR_DARKPANELA );   glVertex2i ( button->x, button->y );
+				SetColour ( COLOUR_DARKPANELB );   glVertex2i ( button->x + button->width, button->y );
+				SetColour ( COLOUR_DARKPANELA );   glVertex2i ( button->x + button->width, button->y + button->height );
+				SetColour ( COLOUR_DARKPANELB );   glVertex2i ( button->x, button->y + button->height );
 			glEnd ();
 
 		}
 
-		SetColour ( "DefaultText" );
+		SetColour ( COLOUR_DEFAULTTEXT );
 
 		// Draw the text
 
@@ -209,7 +213,7 @@ void LinksScreenInterface::LinkDraw ( Button *button, bool highlighted, bool cli
 		// Draw a bounding box
 		if ( highlighted ) {
 
-			SetColour ( "PanelHighlightBorder" );
+			SetColour ( COLOUR_PANELHIGHLIGHTBORDER );
 			border_draw ( button );
 
 		}
@@ -227,7 +231,7 @@ void LinksScreenInterface::LinkMouseDown ( Button *button )
 	sscanf ( button->name, "linksscreen_link %d", &linkindex );
 	linkindex += baseoffset;
 
-	LList <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
+	Deque <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
 
 	if ( filteredlist->ValidIndex (linkindex) ) {
 
@@ -246,7 +250,7 @@ void LinksScreenInterface::LinkMouseMove ( Button *button )
 	sscanf ( button->name, "linksscreen_link %d", &linkindex );
 	linkindex += baseoffset;
 
-	LList <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
+	Deque <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
 
 	if ( filteredlist->ValidIndex (linkindex) ) {
  
@@ -265,7 +269,7 @@ void LinksScreenInterface::DeleteLinkDraw ( Button *button, bool highlighted, bo
 	sscanf ( button->name, "linksscreen_deletelink %d", &linkindex );
 	linkindex += baseoffset;
 
-	LList <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
+	Deque <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
     char *link = filteredlist->ValidIndex(linkindex) ? filteredlist->GetData (linkindex) : NULL;
 
 	if ( link ) 
@@ -295,7 +299,7 @@ void LinksScreenInterface::DeleteLinkClick ( Button *button )
 	sscanf ( button->name, "linksscreen_deletelink %d", &linkindex );
 	linkindex += baseoffset;
 
-	LList <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
+	Deque <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
 	char *link = filteredlist->ValidIndex (linkindex) ? filteredlist->GetData (linkindex) : NULL;
 
 	if ( link && game->GetWorld ()->GetPlayer ()->HasLink (link) &&
@@ -334,7 +338,7 @@ void LinksScreenInterface::AddLinkDraw ( Button *button, bool highlighted, bool
 	sscanf ( button->name, "linksscreen_addlink %d", &linkindex );
 	linkindex += baseoffset;
 
-	LList <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
+	Deque <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
     char *link = filteredlist->ValidIndex (linkindex) ? filteredlist->GetData (linkindex) : NULL;
 
 	if ( link && !game->GetWorld ()->GetPlayer ()->HasLink (link) ) 
@@ -357,7 +361,7 @@ void LinksScreenInterface::AddLinkClick ( Button *button )
 	sscanf ( button->name, "linksscreen_addlink %d", &linkindex );
 	linkindex += baseoffset;
 
-	LList <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
+	Deque <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
     char *link = filteredlist->ValidIndex(linkindex) ? filteredlist->GetData (linkindex) : NULL;
 
 	if ( link && !game->GetWorld ()->GetPlayer ()->HasLink (link) )
@@ -374,7 +378,7 @@ void LinksScreenInterface::ShowLinkDraw ( Button *button, bool highlighted, bool
 	sscanf ( button->name, "linksscreen_showlink %d", &linkindex );
 	linkindex += baseoffset;
 
-	LList <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
+	Deque <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
     char *link = filteredlist->ValidIndex(linkindex) ? filteredlist->GetData (linkindex) : NULL;
 
     if ( link ) {
@@ -422,7 +426,7 @@ void LinksScreenInterface::ShowLinkClick ( Button *button )
 	sscanf ( button->name, "linksscreen_showlink %d", &linkindex );
 	linkindex += baseoffset;
 
-	LList <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
+	Deque <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
 
 	char *link = filteredlist->GetData (linkindex);
 
@@ -457,7 +461,7 @@ void LinksScreenInterface::ShowLinkMouseMove ( Button *button )
 	sscanf ( button->name, "linksscreen_showlink %d", &linkindex );
 	linkindex += baseoffset;
 
-	LList <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
+	Deque <char *> *filteredlist = &((LinksScreenInterface *) game->GetInterface ()->GetRemoteInterface ()->GetInterfaceScreen ())->filteredlist;
 
 	char *link = filteredlist->GetData (linkindex);
 
@@ -542,11 +546,10 @@ void LinksScreenInterface::SetFullList ( LList <char *> *newfulllist )
 
 	UplinkAssert (newfulllist);
 
-    DeleteLListData ( &fulllist );
-    DeleteLListData ( &filteredlist );
-    
+    DeleteDequeData ( &fulllist );
 	fulllist.Empty ();
 	filteredlist.Empty ();
+	searchindex.Empty ();
 
     for ( int i = 0; i < newfulllist->Size (); ++i ) {
 
@@ -555,6 +558,11 @@ void LinksScreenInterface::SetFullList ( LList <char *> *newfulllist )
         UplinkStrncpy ( copydata, newfulllist->GetData (i), copydatasize );
         fulllist.PutData ( copydata );
 
+		// Expired links have no name to match
+
+		VLocation *vl = game->GetWorld ()->GetVLocation ( copydata );
+		searchindex.AddItem ( vl ? vl->computer : (char *) "" );
+
     }
 	
 	ApplyFilter ( NULL );
@@ -564,19 +572,22 @@ void LinksScreenInterface::SetFullList ( LList <char *> *newfulllist )
 void LinksScreenInterface::SetFullList ()
 {
 
-	DeleteLListData ( &fulllist );
-    fulllist.Empty ();
+	// filteredlist points into fulllist, which is about to be replaced
+
+	LList <char *> newfulllist;
 
     for ( int i = 0; i < filteredlist.Size (); ++i ) {
 
 		size_t copydatasize = SIZE_VLOCATION_IP;
         char *copydata = new char [copydatasize];
         UplinkStrncpy ( copydata, filteredlist.GetData (i), copydatasize );
-		fulllist.PutData ( copydata );
+		newfulllist.PutData ( copydata );
 
     }
 
-	ApplyFilter ( NULL );
+	SetFullList ( &newfulllist );
+
+	DeleteLListData ( &newfulllist );
 
 }
 
@@ -585,53 +596,24 @@ void LinksScreenInterface::ApplyFilter ( char *filter )
 
 	//
 	// Do the filtering
+	// The search index narrows its last results when the filter just got longer
 	//
 
-    DeleteLListData ( &filteredlist );
-    filteredlist.Empty ();
-
-	if ( filter ) {
-
-		char *lowercasefilter = LowerCaseString ( filter );
-
-		for ( int i = 0; i < fulllist.Size (); ++i ) {
-
-			VLocation *vl = game->GetWorld ()->GetVLocation ( fulllist.GetData (i) );
-
-			if ( !vl ) { 
-				UplinkAbortArgs ( "Cannot find location for ip %s", fulllist.GetData (i) );
-			}
-
-			char *computername = vl->computer;
-			char *lowercasename = LowerCaseString ( computername );
-
-            if ( strstr ( lowercasename, lowercasefilter ) != NULL) {
-
-				size_t datacopysize = SIZE_VLOCATION_IP;
-                char *datacopy = new char [datacopysize];
-                UplinkStrncpy ( datacopy, fulllist.GetData (i), datacopysize );
-				filteredlist.PutData ( datacopy );
-
-            }
-
-			delete [] lowercasename;
-
-		}
-
-		delete [] lowercasefilter;
-
-	}
-	else {
+	if ( filter && filter [0] == '\x0' ) filter = NULL;
 
-        for ( int i = 0; i < fulllist.Size (); ++i ) {
+	searchindex.Filter ( filter );
 
-			size_t datacopysize = SIZE_VLOCATION_IP;
-            char *datacopy = new char [datacopysize];
-            UplinkStrncpy ( datacopy, fulllist.GetData (i), datacopysize );		     
-            filteredlist.PutData ( datacopy );
+	filteredlist.Empty ();
+	for ( int i = 0; i < searchindex.NumResults (); ++i )
+		filteredlist.PutData ( fulllist.GetData ( searchindex.GetResult (i) ) );
 
-        }
+	if ( lastfilter ) delete [] lastfilter;
+	lastfilter = NULL;
 
+	if ( filter ) {
+		size_t lastfiltersize = strlen ( filter ) + 1;
+		lastfilter = new char [lastfiltersize];
+		UplinkStrncpy ( lastfilter, filter, lastfiltersize );
 	}
 
 	baseoffset = 0;
@@ -678,7 +660,7 @@ void LinksScreenInterface::ApplyFilter ( char *filter )
 int LinksScreenInterface::NumLinksOnScreen ()
 {
 
-    int screenheight = app->GetOptions()->GetOptionValue( "graphics_screenheight" );
+    int screenheight = app->GetOptions()->GetOptionValue ( OPTION_SCREENHEIGHT );
     int availablePixels = screenheight - 120 - 145;
     return availablePixels/15;
 
@@ -934,6 +916,20 @@ bool LinksScreenInterface::ReturnKeyPressed ()
 void LinksScreenInterface::Update ()
 {
 
+	//
+	// Filter as the player types
+
+	Button *filterbutton = EclGetButton ( "linksscreen_filtertext" );
+
+	if ( filterbutton ) {
+
+		char *filter = filterbutton->caption;
+		bool changed = lastfilter ? strcmp ( filter, lastfilter ) != 0 : filter [0] != '\x0';
+
+		if ( changed ) ApplyFilter ( filter );
+
+	}
+
 }
 
 LinksScreen *LinksScreenInterface::GetComputerScreen ()
@@ -6,6 +6,7 @@
 
 // ============================================================================
 
+#include "interface/searchindex.h"
 #include "interface/remoteinterface/remoteinterfacescreen.h"
 
 class ComputerScreen;
@@ -21,8 +22,11 @@ protected:
 
 	static int baseoffset;
 
-	LList <char *> fulllist;
-	LList <char *> filteredlist;
+	Deque <char *> fulllist;
+	Deque <char *> filteredlist;								// Points into fulllist
+
+	SearchIndex searchindex;									// Computer names, indexed on fulllist
+	char *lastfilter;											// As last applied, NULL for none
 
 	static Image *ilink_tif;
 	static Image *ilink_h_tif;
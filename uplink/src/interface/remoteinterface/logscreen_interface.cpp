@@ -197,7 +197,7 @@ void LogScreenInterface::LogDraw ( Button *button, bool highlighted, bool clicke
 
 	UplinkAssert ( button );
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 	
@@ -17,6 +17,8 @@
 #include "app/miscutils.h"
 #include "app/opengl_interface.h"
 
+#include "options/options.h"
+
 #include "game/game.h"
 
 #include "interface/interface.h"
@@ -33,7 +35,7 @@
 void MenuScreenInterface::DrawMenuOption ( Button *button, bool highlighted, bool clicked )
 {
 
-    SetColour ( "MenuText" );
+    SetColour ( COLOUR_MENUTEXT );
     GciDrawText ( button->x, button->y + 20, button->caption, HELVETICA_18 );
 
 }
@@ -41,7 +43,7 @@ void MenuScreenInterface::DrawMenuOption ( Button *button, bool highlighted, boo
 void MenuScreenInterface::DrawMenuOptionDimmed ( Button *button, bool highlighted, bool clicked )
 {
 
-	SetColour ( "DimmedText" );
+	SetColour ( COLOUR_DIMMEDTEXT );
 	GciDrawText ( button->x, button->y + 20, button->caption, HELVETICA_18 );
 
 }
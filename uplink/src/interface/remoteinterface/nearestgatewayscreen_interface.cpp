@@ -151,8 +151,8 @@ void NearestGatewayScreenInterface::Create ( ComputerScreen *newcs )
 
 		// Work out the size/ratios of the map
 
-		int screenw = app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" );
-	    int screenh = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+	    int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 		int x1 = 23;
 		int y1 = 50;
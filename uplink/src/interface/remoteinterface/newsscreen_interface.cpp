@@ -39,7 +39,7 @@
 
 
 int NewsScreenInterface::baseoffset = 0;
-int NewsScreenInterface::currentselect = -1;
+News *NewsScreenInterface::currentselect = NULL;
 int NewsScreenInterface::previousnummessages = 0;
 
 
@@ -54,18 +54,20 @@ void NewsScreenInterface::ClickNewsButton ( Button *button )
 
 	index += baseoffset;
 
-	// Dirty the old button
-
-	char oldname [128];
-	UplinkSnprintf ( oldname, sizeof ( oldname ), "news_story %d", currentselect - baseoffset );
-	EclDirtyButton ( oldname );
+	// Dirty the old button, wherever it has moved to
 
 	CompanyUplink *cu = (CompanyUplink *) game->GetWorld ()->GetCompany ( "Uplink" );
 	UplinkAssert ( cu );
 
+	if ( currentselect ) {
+		char oldname [128];
+		UplinkSnprintf ( oldname, sizeof ( oldname ), "news_story %d", cu->news.FindData ( currentselect ) - baseoffset );
+		EclDirtyButton ( oldname );
+	}
+
 	if ( cu->GetNews (index) ) {
 
-		currentselect = index;
+		currentselect = cu->GetNews (index);
         
 	    // Reset the offset so the player can read it from line 1
         ScrollBox *scrollBox = ScrollBox::GetScrollBox( "news_details" );
@@ -111,17 +113,17 @@ void NewsScreenInterface::DrawNewsButton ( Button *button, bool highlighted, boo
 
 	if ( news ) {
 
-		int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+		int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 		glEnable ( GL_SCISSOR_TEST );
 
-		if ( index == currentselect ) {
+		if ( news == currentselect ) {
 
 			glBegin ( GL_QUADS );
-				SetColour ( "PanelHighlightA" );		glVertex2i ( button->x, button->y );
-				SetColour ( "PanelHighlightB" );        glVertex2i ( button->x + button->width, button->y );
-				SetColour ( "PanelHighlightA" );        glVertex2i ( button->x + button->width, button->y + button->height );
-				SetColour ( "PanelHighlightB" );        glVertex2i ( button->x, button->y + button->height );
+				SetColour ( COLOUR_PANELHIGHLIGHTA );		glVertex2i ( button->x, button->y );
+				SetColour ( COLOUR_PANELHIGHLIGHTB );        glVertex2i ( button->x + button->width, button->y );
+				SetColour ( COLOUR_PANELHIGHLIGHTA );        glVertex2i ( button->x + button->width, button->y + button->height );
+				SetColour ( COLOUR_PANELHIGHLIGHTB );        glVertex2i ( button->x, button->y + button->height );
 			glEnd ();
 
 		}
@@ -130,20 +132,20 @@ void NewsScreenInterface::DrawNewsButton ( Button *button, bool highlighted, boo
 			if ( index % 2 == 0 ) {
 
 				glBegin ( GL_QUADS );
-					SetColour ( "DarkPanelA" );     glVertex2i ( button->x, button->y + button->height );
-					SetColour ( "DarkPanelB" );     glVertex2i ( button->x, button->y );
-					SetColour ( "DarkPanelA" );     glVertex2i ( button->x + button->width, button->y );
-					SetColour ( "DarkPanelB" );     glVertex2i ( button->x + button->width, button->y + button->height );
+					SetColour ( COLOUR_DARKPANELA );     glVertex2i ( button->x, button->y + button->height );
+					SetColour ( COLOUR_DARKPANELB );     glVertex2i ( button->x, button->y );
+					SetColour ( COLOUR_DARKPANELA );     glVertex2i ( button->x + button->width, button->y );
+					SetColour ( COLOUR_DARKPANELB );     glVertex2i ( button->x + button->width, button->y + button->height );
 				glEnd ();
 
 			}
 			else {
 
 				glBegin ( GL_QUADS );
-					SetColour ( "DarkPanelB" );     glVertex2i ( button->x, button->y + button->height );
-					SetColour ( "DarkPanelA" );     glVertex2i ( button->x, button->y );
-					SetColour ( "DarkPanelB" );     glVertex2i ( button->x + button->width, button->y );
-					SetColour ( "DarkPanelA" );     glVertex2i ( button->x + button->width, button->y + button->height );
+					SetColour ( COLOUR_DARKPANELB );     glVertex2i ( button->x, button->y + button->height );
+					SetColour ( COLOUR_DARKPANELA );     glVertex2i ( button->x, button->y );
+					SetColour ( COLOUR_DARKPANELB );     glVertex2i ( button->x + button->width, button->y );
+					SetColour ( COLOUR_DARKPANELA );     glVertex2i ( button->x + button->width, button->y + button->height );
 				glEnd ();
 
 			}
@@ -152,7 +154,7 @@ void NewsScreenInterface::DrawNewsButton ( Button *button, bool highlighted, boo
 
 		if ( highlighted ) {
 
-			SetColour ( "PanelHighlightBorder" );
+			SetColour ( COLOUR_PANELHIGHLIGHTBORDER );
 			border_draw ( button );
 
 		}
@@ -180,11 +182,11 @@ void NewsScreenInterface::DrawNewsButton ( Button *button, bool highlighted, boo
 
         // Draw the text items
 
-		SetColour ( "DefaultText" );
+		SetColour ( COLOUR_DEFAULTTEXT );
 		GciDrawText ( button->x + 110, button->y + 10, subject );
 		GciDrawText ( button->x + 5, button->y + 10, date );
 
-        SetColour ( "DimmedText" );
+        SetColour ( COLOUR_DIMMEDTEXT );
         GciDrawText ( button->x + 110, button->y + 25, details );
 
 		glDisable ( GL_SCISSOR_TEST );
@@ -198,7 +200,7 @@ void NewsScreenInterface::DrawDetails ( Button *button, bool highlighted, bool c
 
 	UplinkAssert (button);
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -213,13 +215,13 @@ void NewsScreenInterface::DrawDetails ( Button *button, bool highlighted, bool c
 	// Draw the button
 
 	glBegin ( GL_QUADS );
-		SetColour ( "PanelBackgroundA" );       glVertex2i ( button->x, button->y + button->height );
-		SetColour ( "PanelBackgroundB" );       glVertex2i ( button->x, button->y );
-		SetColour ( "PanelBackgroundA" );       glVertex2i ( button->x + button->width, button->y );
-		SetColour ( "PanelBackgroundB" );       glVertex2i ( button->x + button->width, button->y + button->height );
+		SetColour ( COLOUR_PANELBACKGROUNDA );       glVertex2i ( button->x, button->y + button->height );
+		SetColour ( COLOUR_PANELBACKGROUNDB );       glVertex2i ( button->x, button->y );
+		SetColour ( COLOUR_PANELBACKGROUNDA );       glVertex2i ( button->x + button->width, button->y );
+		SetColour ( COLOUR_PANELBACKGROUNDB );       glVertex2i ( button->x + button->width, button->y + button->height );
 	glEnd ();
 
-	SetColour ( "PanelBorder" );
+	SetColour ( COLOUR_PANELBORDER );
 	border_draw ( button );
 
 
@@ -227,7 +229,7 @@ void NewsScreenInterface::DrawDetails ( Button *button, bool highlighted, bool c
 
 	int maxnumlines = (button->height - 10 ) / 15;
 
-	SetColour ( "DefaultText" );
+	SetColour ( COLOUR_DEFAULTTEXT );
 
 	LList <char *> *wrappedtext = wordwraptext ( button->caption, button->width );
 
@@ -354,7 +356,7 @@ void NewsScreenInterface::Create ( ComputerScreen *newcs )
         ScrollBox::CreateScrollBox( "news_scroll", itemWidth + 21, 50, 15, numRows * 40, cu->news.Size(), numRows, 0, ScrollChange );
 
 		baseoffset = 0;
-		currentselect = -1;
+		currentselect = NULL;
 
 	}
 
@@ -14,6 +14,7 @@
 
 class ComputerScreen;
 class GenericScreen;
+class News;
 
 // ============================================================================
 
@@ -24,7 +25,7 @@ class NewsScreenInterface : public RemoteInterfaceScreen
 protected:
 
 	static int baseoffset;
-	static int currentselect;
+	static News *currentselect;					// Stays put as stories arrive - check it is still there before use
 	static int previousnummessages;
 
 protected:
@@ -19,6 +19,8 @@
 #include "app/miscutils.h"
 #include "app/opengl_interface.h"
 
+#include "options/options.h"
+
 #include "game/game.h"
 
 #include "interface/interface.h"
@@ -104,7 +106,7 @@ void PasswordScreenInterface::CodeButtonDraw ( Button *button, bool highlighted,
 
 	// Draw a background colour
 
-	SetColour ( "PasswordBoxBackground" );
+	SetColour ( COLOUR_PASSWORDBOXBACKGROUND );
 	
 	glBegin ( GL_QUADS );
 
@@ -117,7 +119,7 @@ void PasswordScreenInterface::CodeButtonDraw ( Button *button, bool highlighted,
 
 	// Print the text
 
-    SetColour ( "DefaultText" );
+    SetColour ( COLOUR_DEFAULTTEXT );
 	
 	char *caption = new char [strlen(button->caption) + 1];
 	for ( size_t i = 0; i < strlen(button->caption); ++i )
@@ -12,6 +12,8 @@
 #include "app/miscutils.h"
 #include "app/opengl_interface.h"
 
+#include "options/options.h"
+
 #include "game/game.h"
 #include "game/scriptlibrary.h"
 #include "game/data/data.h"
@@ -46,7 +48,7 @@ void RadioTransmitterScreenInterface::BackgroundDraw ( Button *button, bool high
 		glVertex2i ( button->x + button->width, button->y + button->height );
 	glEnd ();
 
-	SetColour ( "PanelBorder" );
+	SetColour ( COLOUR_PANELBORDER );
 	border_draw ( button );
 
 }
@@ -55,7 +57,7 @@ void RadioTransmitterScreenInterface::FrequencyDraw ( Button *button, bool highl
 {
 
     textbutton_draw ( button, highlighted, clicked );
-    SetColour ( "PanelBorder" );
+    SetColour ( COLOUR_PANELBORDER );
     border_draw ( button );
 
     char frequency[64];
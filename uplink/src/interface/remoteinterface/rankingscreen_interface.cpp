@@ -14,6 +14,8 @@
 #include "app/miscutils.h"
 #include "app/opengl_interface.h"
 
+#include "options/options.h"
+
 #include "game/game.h"
 
 #include "world/world.h"
@@ -47,7 +49,7 @@ void RankingScreenInterface::ActiveAgentDraw ( Button *button, bool highlighted,
 		
 	clear_draw ( button->x, button->y, button->width, button->height );
 
-	SetColour ( "DefaultText" );
+	SetColour ( COLOUR_DEFAULTTEXT );
 
 	int xpos = button->x + 10;
 	int	ypos = button->y + 10;
@@ -60,16 +62,16 @@ void RankingScreenInterface::PlayerDraw ( Button *button, bool highlighted, bool
 {
 		
 	glBegin ( GL_QUADS );
-		SetColour ( "PanelBackgroundA" );   glVertex2i ( button->x - 1, button->y );
-		SetColour ( "PanelBackgroundB" );   glVertex2i ( button->x + button->width, button->y );
-		SetColour ( "PanelBackgroundA" );   glVertex2i ( button->x + button->width, button->y + button->height );
-		SetColour ( "PanelBackgroundB" );   glVertex2i ( button->x, button->y + button->height );
+		SetColour ( COLOUR_PANELBACKGROUNDA );   glVertex2i ( button->x - 1, button->y );
+		SetColour ( COLOUR_PANELBACKGROUNDB );   glVertex2i ( button->x + button->width, button->y );
+		SetColour ( COLOUR_PANELBACKGROUNDA );   glVertex2i ( button->x + button->width, button->y + button->height );
+		SetColour ( COLOUR_PANELBACKGROUNDB );   glVertex2i ( button->x, button->y + button->height );
 	glEnd ();
 
-	SetColour ( "PanelBorder" );
+	SetColour ( COLOUR_PANELBORDER );
 	border_draw ( button );
 
-	SetColour ( "DefaultText" );
+	SetColour ( COLOUR_DEFAULTTEXT );
 
 	int xpos = button->x + 10;
 	int	ypos = button->y + 10;
@@ -83,7 +85,7 @@ void RankingScreenInterface::NonActiveAgentDraw ( Button *button, bool highlight
 
 	clear_draw ( button->x, button->y, button->width, button->height );
 
-	SetColour ( "DimmedText" );
+	SetColour ( COLOUR_DIMMEDTEXT );
 
 	int xpos = button->x + 10;
 	int	ypos = button->y + 10;
@@ -38,12 +38,12 @@ RemoteInterfaceScreen::~RemoteInterfaceScreen()
 void RemoteInterfaceScreen::DrawMainTitle ( Button *button, bool highlighted, bool clicked )
 {
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
 
-    SetColour ( "MenuText" );
+    SetColour ( COLOUR_MENUTEXT );
     int ypos = (button->y + button->height / 2) + 5;
 	GciDrawText ( button->x, ypos, button->caption, HELVETICA_18 );
 
@@ -55,12 +55,12 @@ void RemoteInterfaceScreen::DrawMainTitle ( Button *button, bool highlighted, bo
 void RemoteInterfaceScreen::DrawSubTitle ( Button *button, bool highlighted, bool clicked )
 {
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
 	
-	SetColour ( "DefaultText" );
+	SetColour ( COLOUR_DEFAULTTEXT );
 	int ypos = (button->y + button->height / 2) + 5;
 	GciDrawText ( button->x, ypos, button->caption, HELVETICA_12 );
 
@@ -103,25 +103,25 @@ void SWSalesScreenInterface::DrawSWButton ( Button *button, bool highlighted, bo
 		if ( index == currentselect ) {
 
 			glBegin ( GL_QUADS );
-				SetColour ( "PanelHighlightA" );		glVertex2i ( button->x, button->y );
-				SetColour ( "PanelHighlightB" );		glVertex2i ( button->x + button->width, button->y );
-				SetColour ( "PanelHighlightA" );		glVertex2i ( button->x + button->width, button->y + button->height );
-				SetColour ( "PanelHighlightB" );		glVertex2i ( button->x, button->y + button->height );
+				SetColour ( COLOUR_PANELHIGHLIGHTA );		glVertex2i ( button->x, button->y );
+				SetColour ( COLOUR_PANELHIGHLIGHTB );		glVertex2i ( button->x + button->width, button->y );
+				SetColour ( COLOUR_PANELHIGHLIGHTA );		glVertex2i ( button->x + button->width, button->y + button->height );
+				SetColour ( COLOUR_PANELHIGHLIGHTB );		glVertex2i ( button->x, button->y + button->height );
 			glEnd ();
 
 		}
 
 		if ( highlighted || index == currentselect ) {
 
-			SetColour ( "PanelBorder" );
+			SetColour ( COLOUR_PANELBORDER );
 			border_draw ( button );
 
 		}
 
 		bool hasmoney = ( game->GetWorld ()->GetPlayer ()->GetBalance () >= sv->cost );
 
-		if ( hasmoney ) 	SetColour ( "DefaultText" );
-		else				SetColour ( "DimmedText" );
+		if ( hasmoney ) 	SetColour ( COLOUR_DEFAULTTEXT );
+		else				SetColour ( COLOUR_DIMMEDTEXT );
 
 		char name [SIZE_SALE_TITLE];
 		char version [8];
@@ -149,13 +149,13 @@ void SWSalesScreenInterface::DrawDetails ( Button *button, bool highlighted, boo
 {
 
 	glBegin ( GL_QUADS );
-		SetColour ( "PanelBackgroundA" );       glVertex2i ( button->x, button->y + button->height );
-		SetColour ( "PanelBackgroundB" );       glVertex2i ( button->x, button->y );
-		SetColour ( "PanelBackgroundA" );       glVertex2i ( button->x + button->width, button->y );
-		SetColour ( "PanelBackgroundB" );       glVertex2i ( button->x + button->width, button->y + button->height );
+		SetColour ( COLOUR_PANELBACKGROUNDA );       glVertex2i ( button->x, button->y + button->height );
+		SetColour ( COLOUR_PANELBACKGROUNDB );       glVertex2i ( button->x, button->y );
+		SetColour ( COLOUR_PANELBACKGROUNDA );       glVertex2i ( button->x + button->width, button->y );
+		SetColour ( COLOUR_PANELBACKGROUNDB );       glVertex2i ( button->x + button->width, button->y + button->height );
 	glEnd ();
 
-	SetColour ( "PanelBorder" );
+	SetColour ( COLOUR_PANELBORDER );
 	border_draw ( button );
 
 	text_draw ( button, highlighted, clicked );
@@ -424,7 +424,7 @@ void SWSalesScreenInterface::ScrollChange ( char *scrollname, int newValue )
 
 int SWSalesScreenInterface::NumItemsOnScreen ()
 {
-    int screenheight = app->GetOptions()->GetOptionValue( "graphics_screenheight" );
+    int screenheight = app->GetOptions()->GetOptionValue ( OPTION_SCREENHEIGHT );
     int availablePixels = screenheight - 200 - 45;
     return availablePixels/20;
 }
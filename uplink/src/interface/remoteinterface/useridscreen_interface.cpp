@@ -212,13 +212,13 @@ void UserIDScreenInterface::UserIDButtonDraw ( Button *button, bool highlighted,
 
 	UplinkAssert ( button );
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );
 	glEnable ( GL_SCISSOR_TEST );
 
 	// Draw a background colour
 
-	SetColour ( "PasswordBoxBackground" );
+	SetColour ( COLOUR_PASSWORDBOXBACKGROUND );
 
 	glBegin ( GL_QUADS );
 
@@ -231,7 +231,7 @@ void UserIDScreenInterface::UserIDButtonDraw ( Button *button, bool highlighted,
 
 	// Draw the text
 
-	SetColour ( "DefaultText" );
+	SetColour ( COLOUR_DEFAULTTEXT );
 
 	text_draw ( button, highlighted, clicked );
 
@@ -248,13 +248,13 @@ void UserIDScreenInterface::CodeButtonDraw ( Button *button, bool highlighted, b
 
 	UplinkAssert (button);
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );
 	glEnable ( GL_SCISSOR_TEST );
 
 	// Draw a background colour
 
-    SetColour ( "PasswordBoxBackground" );
+    SetColour ( COLOUR_PASSWORDBOXBACKGROUND );
 
 	glBegin ( GL_QUADS );
 
@@ -267,7 +267,7 @@ void UserIDScreenInterface::CodeButtonDraw ( Button *button, bool highlighted, b
 
 	// Print the text
 
-    SetColour ( "DefaultText" );
+    SetColour ( COLOUR_DEFAULTTEXT );
 
 	char *caption = new char [strlen(button->caption) + 1];
 	for ( size_t i = 0; i < strlen(button->caption); ++i )
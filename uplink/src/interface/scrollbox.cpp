@@ -17,6 +17,8 @@
 #include "app/opengl_interface.h"
 #include "app/opengl.h"
 
+#include "options/options.h"
+
 #include "interface/scrollbox.h"
 
 #include "mmgr.h"
@@ -95,10 +97,10 @@ void ScrollBox::DrawScrollBar ( Button *button, bool highlighted, bool clicked )
     // Draw the background
 
 	glBegin ( GL_QUADS );		
-		SetColour ( "PanelBackgroundA" );       glVertex2i ( button->x, button->y + button->height );
-		SetColour ( "PanelBackgroundB" );       glVertex2i ( button->x, button->y );
-		SetColour ( "PanelBackgroundA" );       glVertex2i ( button->x + button->width, button->y );
-		SetColour ( "PanelBackgroundB" );       glVertex2i ( button->x + button->width, button->y + button->height );
+		SetColour ( COLOUR_PANELBACKGROUNDA );       glVertex2i ( button->x, button->y + button->height );
+		SetColour ( COLOUR_PANELBACKGROUNDB );       glVertex2i ( button->x, button->y );
+		SetColour ( COLOUR_PANELBACKGROUNDA );       glVertex2i ( button->x + button->width, button->y );
+		SetColour ( COLOUR_PANELBACKGROUNDB );       glVertex2i ( button->x + button->width, button->y + button->height );
 	glEnd ();
 
     //
@@ -118,10 +120,10 @@ void ScrollBox::DrawScrollBar ( Button *button, bool highlighted, bool clicked )
         if ( h > button->height ) h = button->height;
 
 	    glBegin ( GL_QUADS );
-		    SetColour ( "ButtonNormalA" );          glVertex2i ( x, y + h );
-		    SetColour ( "ButtonNormalB" );          glVertex2i ( x, y );
-		    SetColour ( "ButtonNormalA" );          glVertex2i ( x + w, y );
-            SetColour ( "ButtonNormalB" );          glVertex2i ( x + w, y + h );
+		    SetColour ( COLOUR_BUTTONNORMALA );          glVertex2i ( x, y + h );
+		    SetColour ( COLOUR_BUTTONNORMALB );          glVertex2i ( x, y );
+		    SetColour ( COLOUR_BUTTONNORMALA );          glVertex2i ( x + w, y );
+            SetColour ( COLOUR_BUTTONNORMALB );          glVertex2i ( x + w, y + h );
 	    glEnd ();
 
     }
@@ -129,7 +131,7 @@ void ScrollBox::DrawScrollBar ( Button *button, bool highlighted, bool clicked )
     //
     // Draw the border
 
-	SetColour ( "PanelBorder" );
+	SetColour ( COLOUR_PANELBORDER );
 	border_draw ( button );
     
 }
@@ -0,0 +1,258 @@
+
+#include <string.h>
+
+#include "app/globals.h"
+#include "app/miscutils.h"
+
+#include "interface/searchindex.h"
+
+#include "mmgr.h"
+
+
+// Trigrams are folded to 5 bits a character, so the posting lists can be
+// a flat table - anything that folds together is told apart by the final strstr
+
+#define TRIGRAM_BITS    5
+#define NUM_TRIGRAMS    ( 1 << ( TRIGRAM_BITS * 3 ) )
+
+static int FoldCharacter ( char c )
+{
+
+	if ( c >= 'a' && c <= 'z' ) return c - 'a' + 1;
+	if ( c >= '0' && c <= '9' ) return 27 + ( c - '0' ) % 4;
+	if ( c == ' ' )				return 31;
+	return 0;
+
+}
+
+static int TrigramCode ( char *p )
+{
+
+	return ( FoldCharacter ( p [0] ) << ( TRIGRAM_BITS * 2 ) ) |
+		   ( FoldCharacter ( p [1] ) << TRIGRAM_BITS ) |
+		   FoldCharacter ( p [2] );
+
+}
+
+SearchIndex::SearchIndex ()
+{
+
+	postingstart = postings = NULL;
+	indexdirty = false;
+
+	lastfilter = NULL;
+	results = NULL;
+	numresults = 0;
+
+}
+
+SearchIndex::~SearchIndex ()
+{
+
+	Empty ();
+
+}
+
+int SearchIndex::AddItem ( char *key )
+{
+
+	UplinkAssert ( key );
+
+	keys.PutData ( LowerCaseString ( key ) );
+	indexdirty = true;
+
+	// Forget the last results - they don't cover the new item
+
+	if ( lastfilter ) {
+		delete [] lastfilter;
+		lastfilter = NULL;
+	}
+
+	delete [] results;
+	results = NULL;
+	numresults = 0;
+
+	return keys.Size () - 1;
+
+}
+
+void SearchIndex::Empty ()
+{
+
+	for ( int i = 0; i < keys.Size (); ++i )
+		delete [] keys.GetData (i);
+	keys.Empty ();
+
+	delete [] postingstart;
+	delete [] postings;
+	postingstart = postings = NULL;
+	indexdirty = false;
+
+	if ( lastfilter ) delete [] lastfilter;
+	lastfilter = NULL;
+
+	delete [] results;
+	results = NULL;
+	numresults = 0;
+
+}
+
+void SearchIndex::BuildTrigrams ()
+{
+
+	delete [] postingstart;
+	delete [] postings;
+	postingstart = postings = NULL;
+	indexdirty = false;
+
+	//
+	// Count the items containing each trigram, once per item
+
+	postingstart = new int [NUM_TRIGRAMS + 1];
+	int *lastitem = new int [NUM_TRIGRAMS];
+	for ( int t = 0; t <= NUM_TRIGRAMS; ++t ) postingstart [t] = 0;
+	for ( int t = 0; t < NUM_TRIGRAMS; ++t ) lastitem [t] = -1;
+
+	for ( int i = 0; i < keys.Size (); ++i ) {
+		for ( char *p = keys.GetData (i); p [0] && p [1] && p [2]; ++p ) {
+			int t = TrigramCode ( p );
+			if ( lastitem [t] == i ) continue;
+			lastitem [t] = i;
+			++postingstart [t + 1];
+		}
+	}
+
+	for ( int t = 0; t < NUM_TRIGRAMS; ++t ) {
+		postingstart [t + 1] += postingstart [t];
+		lastitem [t] = -1;
+	}
+
+	//
+	// Fill in item order, so every posting list is sorted
+
+	int *next = new int [NUM_TRIGRAMS];
+	for ( int t = 0; t < NUM_TRIGRAMS; ++t ) next [t] = postingstart [t];
+
+	postings = new int [postingstart [NUM_TRIGRAMS] > 0 ? postingstart [NUM_TRIGRAMS] : 1];
+
+	for ( int i = 0; i < keys.Size (); ++i ) {
+		for ( char *p = keys.GetData (i); p [0] && p [1] && p [2]; ++p ) {
+			int t = TrigramCode ( p );
+			if ( lastitem [t] == i ) continue;
+			lastitem [t] = i;
+			postings [next [t]++] = i;
+		}
+	}
+
+	delete [] next;
+	delete [] lastitem;
+
+}
+
+void SearchIndex::Filter ( char *filter )
+{
+
+	if ( indexdirty || !postingstart ) BuildTrigrams ();
+
+	char *newfilter = ( filter && filter [0] ) ? LowerCaseString ( filter ) : NULL;
+
+	//
+	// Work out which items could match
+
+	int *candidates = NULL;
+	int numcandidates = 0;
+	bool ownscandidates = false;
+
+	if ( !newfilter ) {
+
+		delete [] results;
+		results = new int [keys.Size () > 0 ? keys.Size () : 1];
+		numresults = keys.Size ();
+		for ( int i = 0; i < numresults; ++i )
+			results [i] = i;
+
+		if ( lastfilter ) delete [] lastfilter;
+		lastfilter = NULL;
+		return;
+
+	}
+	else if ( lastfilter && results && strstr ( newfilter, lastfilter ) ) {
+
+		// Anything matching the new filter matched the last one
+
+		candidates = results;
+		numcandidates = numresults;
+
+	}
+	else if ( strlen ( newfilter ) >= 3 ) {
+
+		// Only items containing the filter's rarest trigram
+
+		int best = -1;
+		for ( char *p = newfilter; p [0] && p [1] && p [2]; ++p ) {
+			int t = TrigramCode ( p );
+			if ( best == -1 || postingstart [t + 1] - postingstart [t] < postingstart [best + 1] - postingstart [best] )
+				best = t;
+		}
+
+		candidates = &postings [postingstart [best]];
+		numcandidates = postingstart [best + 1] - postingstart [best];
+
+	}
+	else {
+
+		// Too short for a trigram - check everything
+
+		candidates = new int [keys.Size () > 0 ? keys.Size () : 1];
+		numcandidates = keys.Size ();
+		for ( int i = 0; i < numcandidates; ++i )
+			candidates [i] = i;
+		ownscandidates = true;
+
+	}
+
+	//
+	// Check the candidates
+	// Narrowing can reuse the results array, since matches never overtake candidates
+
+	int *newresults = ( candidates == results ) ? results : new int [numcandidates > 0 ? numcandidates : 1];
+	int numnewresults = 0;
+
+	for ( int i = 0; i < numcandidates; ++i ) {
+		int item = candidates [i];
+		if ( strstr ( keys.GetData (item), newfilter ) )
+			newresults [numnewresults++] = item;
+	}
+
+	if ( ownscandidates ) delete [] candidates;
+	if ( newresults != results ) delete [] results;
+
+	results = newresults;
+	numresults = numnewresults;
+
+	if ( lastfilter ) delete [] lastfilter;
+	lastfilter = newfilter;
+
+}
+
+int SearchIndex::NumItems ()
+{
+
+	return keys.Size ();
+
+}
+
+int SearchIndex::NumResults ()
+{
+
+	return numresults;
+
+}
+
+int SearchIndex::GetResult ( int index )
+{
+
+	UplinkAssert ( index >= 0 && index < numresults );
+	return results [index];
+
+}
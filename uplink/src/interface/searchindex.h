@@ -0,0 +1,54 @@
+
+/*
+    Search index
+
+	Substring search over a fixed set of items, eg the links screen filter.
+	Each item's key is lowercased once when it is added, and a trigram
+	posting list finds the candidates for a new filter.  A filter that
+	extends the last one only rechecks the last results, so typing a
+	filter narrows it a keystroke at a time
+
+  */
+
+
+#ifndef _included_searchindex_h
+#define _included_searchindex_h
+
+#include "tosser.h"
+
+
+class SearchIndex
+{
+
+protected:
+
+	Deque <char *> keys;						// Lowercased, indexed on item
+
+	int *postingstart;							// Items containing trigram t are
+	int *postings;								// postings [postingstart [t]] to postings [postingstart [t+1] - 1]
+	bool indexdirty;
+
+	char *lastfilter;							// Lowercased, NULL for everything
+	int *results;								// Matching items, in the order added
+	int numresults;
+
+	void BuildTrigrams ();
+
+public:
+
+	SearchIndex ();
+	~SearchIndex ();
+
+	int  AddItem ( char *key );					// Returns the item number, in order added
+	void Empty ();
+
+	void Filter ( char *filter );				// Case insensitive substring, NULL or "" for everything
+
+	int NumItems ();
+	int NumResults ();
+	int GetResult ( int index );				// Item number of the index'th match
+
+};
+
+
+#endif
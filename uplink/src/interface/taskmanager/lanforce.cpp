@@ -46,6 +46,32 @@ LanForce::~LanForce()
 {
 }
 
+// Links the player knows about, at either end
+
+static bool KnownLink ( LanComputerLink *link )
+{
+
+	return link->visible != LANLINKVISIBLE_NONE;
+
+}
+
+// Locks are forced across the LAN, so the lock must be linked to the
+// system the player is on through links they know of
+
+static bool IsForceable ( LanComputer *comp, int systemIndex )
+{
+
+	LList <int> reachable;
+	comp->GetReachableSystems ( LanMonitor::currentSystem, &reachable, KnownLink );
+
+	for ( int i = 0; i < reachable.Size(); ++i )
+		if ( reachable.GetData(i) == systemIndex )
+			return true;
+
+	return false;
+
+}
+
 void LanForce::BorderDraw ( Button *button, bool highlighted, bool clicked )
 {
 
@@ -157,7 +183,7 @@ void LanForce::SetTarget ( UplinkObject *uo, char *uos, int uoi )
 			LanComputerSystem *system = comp->systems.GetData( uoi );
             LanInterfaceObject *lio = LanInterface::GetLanInterfaceObject( system->TYPE );
 		
-            if ( system->TYPE == LANSYSTEM_LOCK ) {
+            if ( system->TYPE == LANSYSTEM_LOCK && IsForceable ( comp, uoi ) ) {
 
 			    Button *button = EclGetButton ( uos );
 			    UplinkAssert ( button );
@@ -288,58 +288,64 @@ void LanProbe::Tick ( int n )
 			    // Every link with a port number <= this has been scanned
 			    int portDone = (int) ( LAN_LINKPORTRANGE * ( (float) progress / (float) TICKSREQUIRED_SCANLANLINKS ) );
 
-			    for ( int i = 0; i < comp->links.Size(); ++i ) {
-				    if ( comp->links.ValidIndex( i ) ) {
+			    // Links from this system, then links to it
 
-					    LanComputerLink *link = comp->links.GetData( i );
-					    UplinkAssert (link);
-	    
-					    if ( link->visible < LANLINKVISIBLE_AWARE &&
-						     link->port <= portDone ) {
-   
-						    if ( link->from == systemIndex ) {
+			    LanComputerEdge *edges = comp->GetOutEdges( systemIndex );
+			    for ( int i = 0; i < comp->NumOutEdges( systemIndex ); ++i ) {
 
-    					    	SgPlaySound ( RsArchiveFileOpen ( "sounds/done.wav" ), "sounds/done.wav" );
+				    LanComputerLink *link = comp->links.GetData( edges[i].link );
+				    UplinkAssert (link);
 
-                                if ( version >= link->security ) {
-								    link->IncreaseVisibility( LANLINKVISIBLE_AWARE );
+				    if ( link->visible < LANLINKVISIBLE_AWARE && edges[i].port <= portDone ) {
 
-							        if ( comp->systems.ValidIndex( link->to ) ) {
-								        LanComputerSystem *target = comp->systems.GetData( link->to );
-								        UplinkAssert (target);
-								        target->IncreaseVisibility( LANSYSTEMVISIBLE_AWARE );
-							        }
+					    SgPlaySound ( RsArchiveFileOpen ( "sounds/done.wav" ), "sounds/done.wav" );
 
-                                }
-							    else
-                                    link->IncreaseVisibility( LANLINKVISIBLE_FROMAWARE );
+                        if ( version >= edges[i].security ) {
+						    link->IncreaseVisibility( LANLINKVISIBLE_AWARE );
 
+					        if ( comp->systems.ValidIndex( edges[i].system ) ) {
+						        LanComputerSystem *target = comp->systems.GetData( edges[i].system );
+						        UplinkAssert (target);
+						        target->IncreaseVisibility( LANSYSTEMVISIBLE_AWARE );
+					        }
 
-						    }
-						    else if ( link->to == systemIndex ) {
+                        }
+					    else
+                            link->IncreaseVisibility( LANLINKVISIBLE_FROMAWARE );
 
-    					    	SgPlaySound ( RsArchiveFileOpen ( "sounds/done.wav" ), "sounds/done.wav" );
+				    }
+
+			    }
+
+			    edges = comp->GetInEdges( systemIndex );
+			    for ( int i = 0; i < comp->NumInEdges( systemIndex ); ++i ) {
+
+				    // A link back to this system was dealt with above
+				    if ( edges[i].system == systemIndex ) continue;
+
+				    LanComputerLink *link = comp->links.GetData( edges[i].link );
+				    UplinkAssert (link);
 
-                                if ( version >= link->security ) {
-								    link->IncreaseVisibility( LANLINKVISIBLE_AWARE );
+				    if ( link->visible < LANLINKVISIBLE_AWARE && edges[i].port <= portDone ) {
 
-							        if ( comp->systems.ValidIndex( link->from ) ) {
-								        LanComputerSystem *target = comp->systems.GetData( link->from );
-								        UplinkAssert (target);
-								        target->IncreaseVisibility( LANSYSTEMVISIBLE_AWARE );
-							        }
+					    SgPlaySound ( RsArchiveFileOpen ( "sounds/done.wav" ), "sounds/done.wav" );
 
-                                }
-							    else
-								    link->IncreaseVisibility( LANLINKVISIBLE_TOAWARE );
+                        if ( version >= edges[i].security ) {
+						    link->IncreaseVisibility( LANLINKVISIBLE_AWARE );
 
-						    }
+					        if ( comp->systems.ValidIndex( edges[i].system ) ) {
+						        LanComputerSystem *target = comp->systems.GetData( edges[i].system );
+						        UplinkAssert (target);
+						        target->IncreaseVisibility( LANSYSTEMVISIBLE_AWARE );
+					        }
 
-					    }						
+                        }
+					    else
+						    link->IncreaseVisibility( LANLINKVISIBLE_TOAWARE );
 
 				    }
 
-                }
+			    }
 
 			}
 
@@ -478,6 +478,8 @@ void LogDeleter::Tick ( int n )
 
 					}
 
+					source->LogChanged ( sourceindex );
+
 					// Dirty the log-screen buttons (hack!)
 					for ( int i = 0; i < 15; ++i ) {
 
@@ -537,6 +539,8 @@ void LogDeleter::Tick ( int n )
 
 							}
 
+							source->LogChanged ( currentreplaceindex );
+
 							// Dirty the log-screen buttons (hack!)
 							for ( int i = 0; i < 15; ++i ) {
 
@@ -457,6 +457,8 @@ void LogModifier::Tick ( int n )
 						source->internallogs.PutData ( internalcopy, sourceindex );
 					}
 
+					source->LogChanged ( sourceindex );
+
 					status = LOGMODIFIER_STATUS_FINISHED;
 
 				}
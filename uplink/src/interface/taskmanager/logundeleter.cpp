@@ -310,6 +310,7 @@ void LogUnDeleter::Tick ( int n )
 					// Un-delete the log	
 					//source->logs.PutData ( source->internallogs.GetData (sourceindex), sourceindex );
 					source->logs.GetData ( sourceindex )->SetProperties ( source->internallogs.GetData (sourceindex) );
+					source->LogChanged ( sourceindex );
 
 					// Finished 
 					status = LOGUNDELETER_FINISHED;
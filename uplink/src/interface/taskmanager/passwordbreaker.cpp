@@ -204,6 +204,7 @@ void PasswordBreaker::SetTarget ( UplinkObject *uo, char *uos, int uoi )
 	char buttonname [64];
 	UplinkSnprintf ( buttonname, sizeof ( buttonname ), "passwordbreaker %d", pid );
 	EclGetButton ( buttonname )->width = length * 26;
+	EclDirtyButton ( buttonname );
 
 	char closename [64];
 	UplinkSnprintf ( closename, sizeof ( closename ), "passwordbreaker_close %d", pid );
@@ -124,8 +124,8 @@ void Revelation::Tick ( int n )
 		    game->GetInterface ()->GetRemoteInterface ()->RunNewLocation ();
 		    game->GetInterface ()->GetRemoteInterface ()->RunScreen ( 0 );		
 
-            EclReset ( app->GetOptions ()->GetOptionValue ("graphics_screenwidth"),
-			           app->GetOptions ()->GetOptionValue ("graphics_screenheight") );
+            EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+			           app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
 
         }
 
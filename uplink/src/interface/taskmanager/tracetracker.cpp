@@ -91,7 +91,7 @@ void TraceTracker::TraceDraw ( Button *button, bool highlighted, bool clicked )
 	// Draw the button
     //
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 	
@@ -365,8 +365,8 @@ void TraceTracker::CreateInterface ()
         button_assignbitmaps ( audioname, "software/audioon.tif", "software/audioon_h.tif", "software/audioon_c.tif" );
         EclRegisterButtonCallbacks ( audioname, AudioDraw, AudioClick, button_click, button_highlight );
         
-        int screenW = app->GetOptions ()->GetOptionValue( "graphics_screenwidth" );
-        int screenH = app->GetOptions ()->GetOptionValue( "graphics_screenheight" );
+        int screenW = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+        int screenH = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 		MoveTo ( screenW - 115, screenH - 15, 500 );
 
@@ -81,8 +81,8 @@ void ConnectionLostInterface::Update ()
 
 				// Exit button
 
-				int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-				int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+				int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+				int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 				EclRegisterButton ( screenw - 40, screenh - 40, 32, 32, "", "Return to Main Menu", "connectionlost_mainmenu" );
 				EclRegisterButtonCallback ( "connectionlost_mainmenu", ReturnToMainMenuClick );
@@ -41,8 +41,8 @@ void FirstTimeLoadingInterface::Create ()
 
 		}
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 		EclRegisterButton ( screenw - 370, screenh - 30, 370, 20, "", "", "firsttimeloading_text" );
 		EclRegisterButtonCallbacks ( "firsttimeloading_text", textbutton_draw, NULL, NULL, NULL );
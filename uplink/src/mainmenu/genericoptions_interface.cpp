@@ -167,8 +167,8 @@ void GenericOptionsInterface::SetOptionTYPE ( char *newtype )
 	// Create Title
 	//
 
-	int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-	int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+	int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+	int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 	char title [64];
 	UplinkSnprintf ( title, sizeof ( title ), "%s options", optionTYPE );
@@ -238,8 +238,8 @@ void GenericOptionsInterface::Create ()
 
 		MainMenuScreen::Create ();
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 		// Close button
 
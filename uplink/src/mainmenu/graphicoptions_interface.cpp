@@ -167,27 +167,9 @@ bool GraphicOptionsInterface::ChangeOptionValue ( char *option, int newvalue )
 	// Deal with specific options
 	//
 
-	if ( strcmp ( option, "graphics_buttonanimations" ) == 0 ) {
+	// Button animations are switched by listeners on the options - see opengl.cpp
 
-    	app->GetOptions ()->SetOptionValue ( option, newvalue );
-
-		if ( newvalue == 0 ) EclDisableAnimations ();
-		else				 EclEnableAnimations ();
-
-        return false;
-
-	}
-	else if ( strcmp ( option, "graphics_fasterbuttonanimations" ) == 0 ) {
-
-    	app->GetOptions ()->SetOptionValue ( option, newvalue );
-
-		if ( newvalue == 0 ) EclDisableFasterAnimations ();
-		else                 EclEnableFasterAnimations ();
-
-        return false;
-
-	}
-	else if ( strcmp ( option, "graphics_fullscreen" ) == 0 ||
+	if ( strcmp ( option, "graphics_fullscreen" ) == 0 ||
          strcmp ( option, "graphics_screendepth" ) == 0 ||
          strcmp ( option, "graphics_screenrefresh" ) == 0 ||
          strcmp ( option, "graphics_safemode" ) == 0 || 
@@ -261,33 +243,33 @@ void GraphicOptionsInterface::ScreenOptionDraw ( Button *button, bool highlighte
     if ( highlighted || clicked || currentValue ) {
 
 	    glBegin ( GL_QUADS );		
-		    SetColour ( "PanelHighlightA" );	glVertex2i ( button->x, button->y + button->height );
-		    SetColour ( "PanelHighlightB" );	glVertex2i ( button->x, button->y );
-		    SetColour ( "PanelHighlightA" );	glVertex2i ( button->x + button->width, button->y );
-		    SetColour ( "PanelHighlightB" );	glVertex2i ( button->x + button->width, button->y + button->height );
+		    SetColour ( COLOUR_PANELHIGHLIGHTA );	glVertex2i ( button->x, button->y + button->height );
+		    SetColour ( COLOUR_PANELHIGHLIGHTB );	glVertex2i ( button->x, button->y );
+		    SetColour ( COLOUR_PANELHIGHLIGHTA );	glVertex2i ( button->x + button->width, button->y );
+		    SetColour ( COLOUR_PANELHIGHLIGHTB );	glVertex2i ( button->x + button->width, button->y + button->height );
 	    glEnd ();
 
     }
     else {
 
 	    glBegin ( GL_QUADS );		
-		    SetColour ( "PanelBackgroundA" );   glVertex2i ( button->x, button->y + button->height );
-		    SetColour ( "PanelBackgroundB" );   glVertex2i ( button->x, button->y );
-		    SetColour ( "PanelBackgroundA" );   glVertex2i ( button->x + button->width, button->y );
-		    SetColour ( "PanelBackgroundB" );   glVertex2i ( button->x + button->width, button->y + button->height );
+		    SetColour ( COLOUR_PANELBACKGROUNDA );   glVertex2i ( button->x, button->y + button->height );
+		    SetColour ( COLOUR_PANELBACKGROUNDB );   glVertex2i ( button->x, button->y );
+		    SetColour ( COLOUR_PANELBACKGROUNDA );   glVertex2i ( button->x + button->width, button->y );
+		    SetColour ( COLOUR_PANELBACKGROUNDB );   glVertex2i ( button->x + button->width, button->y + button->height );
 	    glEnd ();
 
     }
 
     if ( clicked || currentValue ) {
 
-        SetColour ( "PanelHighlightBorder" );
+        SetColour ( COLOUR_PANELHIGHLIGHTBORDER );
         border_draw ( button );
 
     }
     else {
 
-	    SetColour ( "PanelBorder" );
+	    SetColour ( COLOUR_PANELBORDER );
 	    border_draw ( button );
 
     }
@@ -295,7 +277,7 @@ void GraphicOptionsInterface::ScreenOptionDraw ( Button *button, bool highlighte
 	int xpos = (button->x + button->width  / 2) - ( GciTextWidth ( button->caption ) / 2 );
 	int ypos = (button->y + button->height / 2) + 2;
 
-    SetColour ( "DefaultText" );
+    SetColour ( COLOUR_DEFAULTTEXT );
     GciDrawText ( xpos, ypos, button->caption );
 
 }
@@ -333,8 +315,8 @@ void GraphicOptionsInterface::ScreenOptionClick ( Button *button )
 
     screenSettingsChanged = true;
 
-    int screenW = app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" );
-    int screenH = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+    int screenW = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+    int screenH = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
     int startY = screenH - 170;
     EclDirtyRectangle ( 0, startY, screenW, screenH - startY );
 
@@ -362,8 +344,8 @@ void GraphicOptionsInterface::SetOptionTYPE ( char *newtype )
 	// Create Title
 	//
 
-	int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-	int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+	int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+	int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 	char title [64];
 	UplinkSnprintf ( title, sizeof ( title ), "%s options", optionTYPE );
@@ -433,8 +415,8 @@ void GraphicOptionsInterface::Create ()
 
 		MainMenuScreen::Create ();
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 		//
 		// Close button
@@ -516,8 +498,8 @@ void GraphicOptionsInterface::Create ()
         EclRegisterButtonCallbacks ( "graphic 3 100 0", ScreenOptionDraw, ScreenOptionClick, button_click, button_highlight );
 
 
-        newScreenWidth = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-        newScreenHeight = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+        newScreenWidth = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+        newScreenHeight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
         newColourDepth = app->GetOptions ()->GetOptionValue ("graphics_screendepth");
         newRefresh = app->GetOptions ()->GetOptionValue ("graphics_screenrefresh" );
         screenSettingsChanged = false;
@@ -55,8 +55,8 @@ void LoadingInterface::Create ()
 
             */
 
-		int screenw = app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" );
-		int screenh = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 		
 		// Decide which graphic to load up
         char *filename = app->GetOptions ()->ThemeFilename ( "loading/filenames.txt" );
@@ -217,7 +217,7 @@ void LoginInterface::ExitGameClick ( Button *button )
 void LoginInterface::LargeTextBoxDraw ( Button *button, bool highlighted, bool clicked )
 {
 
-	SetColour ( "TitleText" );
+	SetColour ( COLOUR_TITLETEXT );
 	int ypos = (button->y + button->height / 2) + 5;
 
 	GciDrawText ( button->x, ypos, button->caption, HELVETICA_18 );
@@ -229,13 +229,13 @@ void LoginInterface::UserIDButtonDraw ( Button *button, bool highlighted, bool c
 
 	UplinkAssert ( button );
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
 	// Draw a background colour
 
-	SetColour ( "PasswordBoxBackground" );
+	SetColour ( COLOUR_PASSWORDBOXBACKGROUND );
 	
 	glBegin ( GL_QUADS );
 
@@ -248,7 +248,7 @@ void LoginInterface::UserIDButtonDraw ( Button *button, bool highlighted, bool c
 
 	// Draw the text
 
-	SetColour ( "DefaultText" );
+	SetColour ( COLOUR_DEFAULTTEXT );
 
 	text_draw ( button, highlighted, clicked );
 
@@ -265,13 +265,13 @@ void LoginInterface::CodeButtonDraw ( Button *button, bool highlighted, bool cli
 
 	UplinkAssert (button);
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
 	// Draw a background colour
 
-	SetColour ( "PasswordBoxBackground" );
+	SetColour ( COLOUR_PASSWORDBOXBACKGROUND );
 	
 	glBegin ( GL_QUADS );
 
@@ -284,7 +284,7 @@ void LoginInterface::CodeButtonDraw ( Button *button, bool highlighted, bool cli
 
 	// Print the text
 
-	SetColour ( "DefaultText" );
+	SetColour ( COLOUR_DEFAULTTEXT );
 
 	char *caption = new char [strlen(button->caption) + 1];
 	for ( size_t i = 0; i < strlen(button->caption); ++i )
@@ -317,8 +317,8 @@ void LoginInterface::CommsClick ( Button *button )
 
 	UplinkAssert ( app->GetNetwork ()->STATUS == NETWORK_CLIENT );
 
-    EclReset ( app->GetOptions ()->GetOptionValue ("graphics_screenwidth"),
-			   app->GetOptions ()->GetOptionValue ("graphics_screenheight") );
+    EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+			   app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
 
 	app->GetNetwork ()->GetClient ()->SetClientType ( CLIENT_COMMS );
 	
@@ -329,8 +329,8 @@ void LoginInterface::StatusClick	( Button *button )
 
 	UplinkAssert ( app->GetNetwork ()->STATUS == NETWORK_CLIENT );
 
-    EclReset ( app->GetOptions ()->GetOptionValue ("graphics_screenwidth"),
-			   app->GetOptions ()->GetOptionValue ("graphics_screenheight") );
+    EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+			   app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
 
 	app->GetNetwork ()->GetClient ()->SetClientType ( CLIENT_STATUS );
 
@@ -360,8 +360,8 @@ void LoginInterface::Create ()
 
 		MainMenuScreen::Create ();
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 		if ( app->GetNetwork ()->STATUS == NETWORK_CLIENT ) {
 
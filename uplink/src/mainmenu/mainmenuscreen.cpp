@@ -36,8 +36,8 @@ void MainMenuScreen::Create ()
 	
 	// Background picture
 
-	int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-	int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+	int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+	int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 	RegisterButton ( SX(320) - 170, 75, 425, 60, "", "mainmenu_background" );
 	button_assignbitmap ( "mainmenu_background", "mainmenu/uplinklogo.tif" );		
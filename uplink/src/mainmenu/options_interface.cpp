@@ -84,8 +84,8 @@ void OptionsInterface::Create ()
 
 		MainMenuScreen::Create ();
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 		EclRegisterButton ( -832, screenh - 50, 32, 32, "", "Edit GAME options", "gameoptions" );
 		EclRegisterButton ( -672, screenh - 50, 32, 32, "", "Edit GRAPHICS options", "graphicsoptions" );
@@ -106,8 +106,8 @@ void RevelationWonInterface::Update ()
 
 				// Exit button
 
-				int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-				int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+				int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+				int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 				EclRegisterButton ( screenw - 40, screenh - 40, 32, 32, "", "Return to Main Menu", "revelationwon_mainmenu" );
 				EclRegisterButtonCallback ( "revelationwon_mainmenu", ReturnToMainMenuClick );
@@ -44,8 +44,8 @@ void ThemeInterface::ApplyClick ( Button *button )
         app->GetOptions ()->SetThemeName ( newThemeName );   
     }
 
-    EclReset ( app->GetOptions ()->GetOptionValue( "graphics_screenwidth" ),
-               app->GetOptions ()->GetOptionValue( "graphics_screenheight" ) );
+    EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+               app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
 
     app->GetMainMenu ()->RunScreen ( MAINMENU_THEME );
 
@@ -56,8 +56,8 @@ void ThemeInterface::DefaultClick ( Button *button )
 
     app->GetOptions ()->SetThemeName ( "graphics" );
 
-    EclReset ( app->GetOptions ()->GetOptionValue( "graphics_screenwidth" ),
-               app->GetOptions ()->GetOptionValue( "graphics_screenheight" ) );
+    EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+               app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
     
     app->GetMainMenu ()->RunScreen ( MAINMENU_THEME );
     currentSelect = -1;
@@ -123,33 +123,33 @@ void ThemeInterface::ThemeNameDraw ( Button *button, bool highlighted, bool clic
     if ( highlighted || clicked || index == currentSelect ) {
 
 	    glBegin ( GL_QUADS );		
-		    SetColour ( "PanelHighlightA" );	glVertex2i ( button->x, button->y + button->height );
-		    SetColour ( "PanelHighlightB" );	glVertex2i ( button->x, button->y );
-		    SetColour ( "PanelHighlightA" );	glVertex2i ( button->x + button->width, button->y );
-		    SetColour ( "PanelHighlightB" );	glVertex2i ( button->x + button->width, button->y + button->height );
+		    SetColour ( COLOUR_PANELHIGHLIGHTA );	glVertex2i ( button->x, button->y + button->height );
+		    SetColour ( COLOUR_PANELHIGHLIGHTB );	glVertex2i ( button->x, button->y );
+		    SetColour ( COLOUR_PANELHIGHLIGHTA );	glVertex2i ( button->x + button->width, button->y );
+		    SetColour ( COLOUR_PANELHIGHLIGHTB );	glVertex2i ( button->x + button->width, button->y + button->height );
 	    glEnd ();
 
     }
     else {
 
 	    glBegin ( GL_QUADS );		
-		    SetColour ( "PanelBackgroundA" );   glVertex2i ( button->x, button->y + button->height );
-		    SetColour ( "PanelBackgroundB" );   glVertex2i ( button->x, button->y );
-		    SetColour ( "PanelBackgroundA" );   glVertex2i ( button->x + button->width, button->y );
-		    SetColour ( "PanelBackgroundB" );   glVertex2i ( button->x + button->width, button->y + button->height );
+		    SetColour ( COLOUR_PANELBACKGROUNDA );   glVertex2i ( button->x, button->y + button->height );
+		    SetColour ( COLOUR_PANELBACKGROUNDB );   glVertex2i ( button->x, button->y );
+		    SetColour ( COLOUR_PANELBACKGROUNDA );   glVertex2i ( button->x + button->width, button->y );
+		    SetColour ( COLOUR_PANELBACKGROUNDB );   glVertex2i ( button->x + button->width, button->y + button->height );
 	    glEnd ();
 
     }
 
     if ( clicked || index == currentSelect ) {
 
-        SetColour ( "PanelHighlightBorder" );
+        SetColour ( COLOUR_PANELHIGHLIGHTBORDER );
         border_draw ( button );
 
     }
     else {
 
-	    SetColour ( "PanelBorder" );
+	    SetColour ( COLOUR_PANELBORDER );
 	    border_draw ( button );
 
     }
@@ -157,7 +157,7 @@ void ThemeInterface::ThemeNameDraw ( Button *button, bool highlighted, bool clic
 	int xpos = (button->x + button->width  / 2) - ( GciTextWidth ( button->caption ) / 2 );
 	int ypos = (button->y + button->height / 2) + 2;
 
-    SetColour ( "DefaultText" );
+    SetColour ( COLOUR_DEFAULTTEXT );
     GciDrawText ( xpos, ypos, button->caption );
 
 }
@@ -193,8 +193,8 @@ void ThemeInterface::Create ()
 
 		MainMenuScreen::Create ();
 
-		int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-		int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
         DArray <char *> *themes = ListAvailableThemes ();
         int numThemes = themes->NumUsed();
@@ -94,7 +94,7 @@ void ClientCommsInterface::LargeMapDraw ( Button *button, bool highlighted, bool
 
 	imagebutton_drawtextured ( button, highlighted, clicked );
 
-    int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+    int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
     glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
     glEnable ( GL_SCISSOR_TEST );
 
@@ -233,8 +233,8 @@ void ClientCommsInterface::Create ()
 {
     if ( !IsVisible () ) {
 	
-	int screenw = app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" );
-	int screenh = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+	int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 	// Create a close button
 
@@ -250,7 +250,7 @@ void ClientCommsInterface::Create ()
 	// Create the background bitmap
 	if ( layout )
 		delete layout;
-	layout = new WorldMapLayout( MapRectangle( 20, 50, fullsizeX, fullsizeY ) );
+	layout = new WorldMapLayout( MapRectangle( 20, 50, fullsizeX, fullsizeY ), app->GetOptions ()->GetOptionValue ( "graphics_layoutthreads" ) );
 	
 	EclRegisterButton ( 20, 50, fullsizeX, fullsizeY, "", "", "comms_largemap" );												
 	
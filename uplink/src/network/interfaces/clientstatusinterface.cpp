@@ -67,7 +67,7 @@ void ClientStatusInterface::BackgroundDraw ( Button *button, bool highlighted, b
 void ClientStatusInterface::GatewayPanelDraw ( Button *button, bool highlighted, bool clicked )
 {
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -98,7 +98,7 @@ void ClientStatusInterface::GatewayPanelDraw ( Button *button, bool highlighted,
 void ClientStatusInterface::PersonalPanelDraw ( Button *button, bool highlighted, bool clicked )
 {
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -129,7 +129,7 @@ void ClientStatusInterface::PersonalPanelDraw ( Button *button, bool highlighted
 void ClientStatusInterface::WorldPanelDraw ( Button *button, bool highlighted, bool clicked )
 {
 
-	int screenheight = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+	int screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 	glScissor ( button->x, screenheight - (button->y + button->height), button->width, button->height );	
 	glEnable ( GL_SCISSOR_TEST );
 
@@ -250,8 +250,8 @@ void ClientStatusInterface::Create ()
 
 	if ( !IsVisible () ) {
 
-		int screenw = app->GetOptions ()->GetOptionValue ( "graphics_screenwidth" );
-		int screenh = app->GetOptions ()->GetOptionValue ( "graphics_screenheight" );
+		int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+		int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 		// Create a close button
 
@@ -330,8 +330,8 @@ void NetworkClient::Update ()
 	switch ( result ) {
 
 	    case TCP4U_SOCKETCLOSED:
-        EclReset ( app->GetOptions ()->GetOptionValue ("graphics_screenwidth"),
-			       app->GetOptions ()->GetOptionValue ("graphics_screenheight") );
+        EclReset ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ),
+			       app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) );
 		socket = -1;
 		app->GetNetwork ()->SetStatus ( NETWORK_NONE );
 		app->GetMainMenu ()->RunScreen ( MAINMENU_NETWORKOPTIONS );
@@ -30,7 +30,22 @@ static ColourOption getColourDefault ( 0.0, 0.0, 0.0 );
 
 Options::Options()
 {
+
     UplinkStrncpy ( themeName, "graphics", sizeof ( themeName ) );
+
+	// Hand out the fixed colour handles (see options.h)
+
+	static char *fixedColours [] = { "Background", "DefaultText", "DimmedText", "TitleText", "MenuText", "TextBorder",
+									 "PanelBackgroundA", "PanelBackgroundB", "PanelBorder",
+									 "PanelHighlightA", "PanelHighlightB", "PanelHighlightBorder",
+									 "DarkPanelA", "DarkPanelB",
+									 "ButtonNormalA", "ButtonNormalB", "ButtonHighlightedA", "ButtonHighlightedB",
+									 "ButtonClickedA", "ButtonClickedB", "PasswordBoxBackground" };
+
+	for ( int i = 0; i < (int) ( sizeof ( fixedColours ) / sizeof ( fixedColours [0] ) ); ++i )
+		if ( GetColourHandle ( fixedColours [i] ) != i )
+			UplinkAbort ( "Fixed colour handles are out of order" );
+
 }
 
 Options::~Options()
@@ -91,6 +106,49 @@ bool Options::IsOptionEqualTo ( char *name, int value )
 
 }
 
+int Options::GetOptionHandle ( char *name )
+{
+
+	Option *option = GetOption ( name );
+
+	if ( !option ) {
+		char msg [256];
+		UplinkSnprintf ( msg, sizeof ( msg ), "Option %s not found", name );
+		UplinkAbort(msg);
+	}
+
+	if ( option->handle == -1 )
+		option->handle = handles.PutData ( option );
+
+	return option->handle;
+
+}
+
+int Options::GetOptionValue ( int handle )
+{
+
+	UplinkAssert ( handles.ValidIndex (handle) );
+	return handles.GetData (handle)->value;
+
+}
+
+bool Options::IsOptionEqualTo ( int handle, int value )
+{
+
+	return GetOptionValue ( handle ) == value;
+
+}
+
+void Options::AddOptionListener ( char *name, OptionListener listener )
+{
+
+	Option *option = GetOption ( name );
+	UplinkAssert ( option );
+
+	option->listeners.PutData ( listener );
+
+}
+
 void Options::SetOptionValue ( char *name, int newvalue )
 {
 
@@ -173,6 +231,7 @@ void Options::CreateDefaultOptions ()
 	// Game
 
 	if ( !GetOption ( "game_debugstart" ) )				SetOptionValue ( "game_debugstart", 1, "z", true, false );
+	if ( !GetOption ( "game_heapsample" ) )				SetOptionValue ( "game_heapsample", 0, "Sample 1 in N allocations for a heap profile (0 for off).", false, false );
 
 #ifndef TESTGAME
 	if ( !GetOption ( "game_firsttime" ) ) {
@@ -201,6 +260,7 @@ void Options::CreateDefaultOptions ()
     currentVersion *= 100;
 
     if ( !GetOption ( "game_version" ) )                SetOptionValue ( "game_version", (int) currentVersion, "z", false, false );
+	if ( !GetOption ( "game_updatethreads" ) )			SetOptionValue ( "game_updatethreads", 0, "Threads used to update computers and people (0 to update them on the main thread).", false, false );
 
 	// Graphics
 
@@ -214,6 +274,9 @@ void Options::CreateDefaultOptions ()
 	if ( !GetOption ( "graphics_softwaremouse" ) )		SetOptionValue ( "graphics_softwaremouse", 0, "Render a software mouse.  Use to correct mouse problems.", true, true );
 	if ( !GetOption ( "graphics_fasterbuttonanimations" ) )	SetOptionValue ( "graphics_fasterbuttonanimations", 0, "Increase the speed of button animations.", true, true );
 	if ( !GetOption ( "graphics_defaultworldmap" ) )	SetOptionValue ( "graphics_defaultworldmap", 1, "Create agents with the default world map.", true, true );
+	if ( !GetOption ( "graphics_showframestats" ) )		SetOptionValue ( "graphics_showframestats", 0, "Show frame time and draw counts.", true, false );
+	if ( !GetOption ( "graphics_framerate" ) )			SetOptionValue ( "graphics_framerate", 60, "Maximum frames per second (0 for no limit).", false, false );
+	if ( !GetOption ( "graphics_layoutthreads" ) )		SetOptionValue ( "graphics_layoutthreads", 0, "Threads used to lay out world map labels (0 for one per core).", false, false );
 
 	Option *optionSoftwareRendering = GetOption ( "graphics_softwarerendering" );
 	if ( !optionSoftwareRendering ) {
@@ -250,6 +313,16 @@ void Options::CreateDefaultOptions ()
     app->GetOptions ()->GetOption ( "graphics_screendepth" )->SetVisible ( false );
     app->GetOptions ()->GetOption ( "graphics_screenrefresh" )->SetVisible ( false );
 
+	// Hand out the fixed handles (see options.h)
+
+	if ( GetOptionHandle ( "graphics_screenwidth" ) != OPTION_SCREENWIDTH ||
+		 GetOptionHandle ( "graphics_screenheight" ) != OPTION_SCREENHEIGHT ||
+		 GetOptionHandle ( "graphics_safemode" ) != OPTION_SAFEMODE ||
+		 GetOptionHandle ( "graphics_showframestats" ) != OPTION_SHOWFRAMESTATS ||
+		 GetOptionHandle ( "graphics_framerate" ) != OPTION_FRAMERATE ||
+		 GetOptionHandle ( "graphics_softwaremouse" ) != OPTION_SOFTWAREMOUSE )
+		UplinkAbort ( "Fixed option handles are out of order" );
+
 }
 
 void Options::SetThemeName ( char *newThemeName )
@@ -292,13 +365,16 @@ void Options::SetThemeName ( char *newThemeName )
     		std::istrstream thisLine ( lineBuffer );
             thisLine >> colourName >> ws >> r >> g >> b >> ws;
 
+            // Updated in place, so the palette keeps pointing at it
+
             BTree <ColourOption *> *exists = colours.LookupTree( colourName );
             if ( !exists ) {
                 colours.PutData( colourName, new ColourOption ( r, g, b ) );
             }
             else {
-                delete exists->data;
-                exists->data = new ColourOption ( r, g, b );
+                exists->data->r = r;
+                exists->data->g = g;
+                exists->data->b = b;
             }
 
         }
@@ -344,6 +420,34 @@ ColourOption *Options::GetColour ( char *colourName )
 
 }
 
+int Options::GetColourHandle ( char *colourName )
+{
+
+    //
+    // Colours the theme hasn't set yet start out black
+
+    ColourOption *colour = colours.GetData ( colourName );
+
+    if ( !colour ) {
+        colour = new ColourOption ( 0.0f, 0.0f, 0.0f );
+        colours.PutData ( colourName, colour );
+    }
+
+    if ( colour->handle == -1 )
+        colour->handle = palette.PutData ( colour );
+
+    return colour->handle;
+
+}
+
+ColourOption *Options::GetColour ( int handle )
+{
+
+    UplinkAssert ( palette.ValidIndex (handle) );
+    return palette.GetData (handle);
+
+}
+
 char *Options::ThemeFilename ( char *filename )
 {
 
@@ -566,6 +670,7 @@ Option::Option()
 	yesorno = false;
 	visible = true;
 	value = 0;
+	handle = -1;
 
 }
 
@@ -607,8 +712,13 @@ void Option::SetVisible ( bool newvisible )
 void Option::SetValue ( int newvalue )
 {
 
+	if ( newvalue == value ) return;
+
 	value = newvalue;
 
+	for ( int i = 0; i < listeners.Size (); ++i )
+		(*listeners.GetData (i)) ( this );
+
 }
 
 bool Option::Load ( FILE *file )
@@ -24,12 +24,55 @@ class OptionChange;
 class ColourOption;
 
 
+typedef void (*OptionListener) ( Option *option );
+
+
+// Fixed handles for the options read every frame.
+// Handed out in this order by CreateDefaultOptions - any other option
+// gets the next free handle from GetOptionHandle
+
+#define OPTION_SCREENWIDTH          0
+#define OPTION_SCREENHEIGHT         1
+#define OPTION_SAFEMODE             2
+#define OPTION_SHOWFRAMESTATS       3
+#define OPTION_FRAMERATE            4
+#define OPTION_SOFTWAREMOUSE        5
+
+
+// Fixed handles for the theme colours the interface draws with.
+// Registered in this order by the constructor, so they are valid
+// before any theme is loaded - SetThemeName fills them in
+
+#define COLOUR_BACKGROUND               0
+#define COLOUR_DEFAULTTEXT              1
+#define COLOUR_DIMMEDTEXT               2
+#define COLOUR_TITLETEXT                3
+#define COLOUR_MENUTEXT                 4
+#define COLOUR_TEXTBORDER               5
+#define COLOUR_PANELBACKGROUNDA         6
+#define COLOUR_PANELBACKGROUNDB         7
+#define COLOUR_PANELBORDER              8
+#define COLOUR_PANELHIGHLIGHTA          9
+#define COLOUR_PANELHIGHLIGHTB          10
+#define COLOUR_PANELHIGHLIGHTBORDER     11
+#define COLOUR_DARKPANELA               12
+#define COLOUR_DARKPANELB               13
+#define COLOUR_BUTTONNORMALA            14
+#define COLOUR_BUTTONNORMALB            15
+#define COLOUR_BUTTONHIGHLIGHTEDA       16
+#define COLOUR_BUTTONHIGHLIGHTEDB       17
+#define COLOUR_BUTTONCLICKEDA           18
+#define COLOUR_BUTTONCLICKEDB           19
+#define COLOUR_PASSWORDBOXBACKGROUND    20
+
+
 class Options : public UplinkObject  
 {
 
 protected:
 
 	BTree <Option *> options;
+	DArray <Option *> handles;														// Indexed on handle
     LList <OptionChange *> shutdownChanges;
 
     char themeName[128];
@@ -37,6 +80,7 @@ protected:
     char themeTitle[128];
     char themeDescription[1024];
     BTree <ColourOption *> colours;
+    DArray <ColourOption *> palette;                                                // Indexed on colour handle
 
 public:
 
@@ -54,6 +98,12 @@ public:
 	void	SetOptionValue ( char *name, int newvalue, char *tooltip, 
 							 bool yesorno = false, bool visible = true );			// Creates new if neccisary
 
+	int		GetOptionHandle ( char *name );											// Resolve a name once - asserts existence
+	int		GetOptionValue  ( int handle );											// No lookup - use in anything run every frame
+	bool	IsOptionEqualTo ( int handle, int value );
+
+	void	AddOptionListener ( char *name, OptionListener listener );				// Called whenever the value changes
+
 	LList <Option *> *GetAllOptions ( char *searchstring, bool returnhidden );		// String can be NULL - will return ALL
 
     void SetThemeName ( char *newThemeName );
@@ -62,6 +112,8 @@ public:
     char *GetThemeDescription ();
     
     ColourOption *GetColour     ( char *colourName );                                   // Always safe - returns BLACK if not found
+    int           GetColourHandle ( char *colourName );                                 // Resolve a name once - stays valid across themes
+    ColourOption *GetColour     ( int handle );                                         // No lookup - use in anything run every frame
 
     char *ThemeFilename ( char *filename );
 
@@ -97,6 +149,9 @@ public:
 	bool visible;										// Is this a hidden option
 	int value;
 
+	int handle;											// -1 until one is asked for
+	LList <OptionListener> listeners;
+
 public:
 
 	Option();
@@ -106,7 +161,7 @@ public:
 	void SetTooltip ( char *newtooltip );
 	void SetYesOrNo	( bool newyesorno );
 	void SetVisible ( bool newvisible );
-	void SetValue   ( int newvalue );
+	void SetValue   ( int newvalue );					// Tells the listeners if it has changed
 
 
 	// Common functions
@@ -136,12 +191,14 @@ class ColourOption
 public:
 
     ColourOption ( float _r, float _g, float _b )
-        : r ( _r ), g ( _g ), b ( _b ) {}
+        : r ( _r ), g ( _g ), b ( _b ), handle ( -1 ) {}
 
     float r;
     float g;
     float b;
 
+    int handle;                                         // -1 until one is asked for
+
 };
 
 #endif 
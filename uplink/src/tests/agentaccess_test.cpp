@@ -0,0 +1,374 @@
+// -*- tab-width:4 c-file-style:"cc-mode" -*-
+
+/*
+
+  Agent access test
+
+	Gives agents access codes - right, wrong and out of date - for the
+	accounts on a generated world's computers, then asks HasAccount about
+	them again and again while passwords change, under the game's own
+	ChangeSecurityCodes and by hand, security levels change, passwords are
+	deleted, accounts are added and new codes given. Checks every answer,
+	cached or not, against walking the codes and searching the records
+	the way HasAccount used to. Times a look up both ways over 5,000 agents
+
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app/app.h"
+#include "app/globals.h"
+
+#include "game/game.h"
+
+#include "world/world.h"
+#include "world/agent.h"
+#include "world/vlocation.h"
+#include "world/computer/computer.h"
+#include "world/computer/recordbank.h"
+#include "world/generator/worldgenerator.h"
+
+#include "tests/testworld.h"
+
+#include "mmgr.h"
+
+
+#define WORLDSEED       1
+
+#define NUMAGENTS       50
+#define NUMTARGETS      12                          // Computers each agent has codes for
+#define NUMSTEPS        40000
+
+#define BIGAGENTS       5000
+#define BIGTARGETS      20
+#define BIGWARMPASSES   10
+
+
+// Passwords handed out and changed to, so codes go bad and come good again
+
+static char *PASSWORDS [] = { "rosebud", "guest", "swordfish", "joshua", NULL };
+#define NUMPASSWORDS    4
+
+
+// Agent keeps its HasAccount results protected
+
+class TestAgent : public Agent
+{
+
+public:
+
+	bool Cached ( char *ip )			{ return accesscache.GetData ( ip ) != NULL; }
+
+};
+
+
+// The old look up - every code held for the ip, each searched for in the records
+
+static int ScanHasAccount ( Agent *agent, char *ip )
+{
+
+	VLocation *vl = game->GetWorld ()->GetVLocation ( ip );
+	Computer *comp = vl ? vl->GetComputer () : NULL;
+	if ( !comp ) return -1;
+
+	int securityLevel = -1;
+
+	for ( BTree <char *> *treeCode = agent->codes.LookupTree ( ip ); treeCode;
+		  treeCode = treeCode->Left () ? treeCode->Left ()->LookupTree ( ip ) : NULL ) {
+
+		char username [256];
+		char password [256];
+		if ( !treeCode->data ||
+			 !Agent::ParseAccessCode ( treeCode->data, username, sizeof ( username ), password, sizeof ( password ) ) )
+			continue;
+
+		Record *rec = comp->recordbank.GetRecordFromNamePassword ( username, password );
+		char *securitytext = rec ? rec->GetField ( RECORDBANK_SECURITY ) : NULL;
+
+		if ( securitytext ) {
+			int security = -1;
+			sscanf ( securitytext, "%d", &security );
+			if ( security != -1 && ( securityLevel == -1 || security < securityLevel ) )
+				securityLevel = security;
+		}
+
+	}
+
+	return securityLevel;
+
+}
+
+static int Random ( int range )
+{
+
+	return rand () % range;
+
+}
+
+
+static DArray <Computer *> *targets = NULL;					// Computers with accounts to have codes for
+
+
+static void FindTargets ()
+{
+
+	DArray <Computer *> *computers = game->GetWorld ()->computers.ConvertToDArray ();
+	targets = new DArray <Computer *> ();
+
+	for ( int i = 0; i < computers->Size (); ++i ) {
+		if ( !computers->ValidIndex (i) ) continue;
+
+		Computer *comp = computers->GetData (i);
+		if ( !game->GetWorld ()->GetVLocation ( comp->ip ) ) continue;
+
+		for ( int r = 0; r < comp->recordbank.records.Size (); ++r ) {
+			Record *rec = comp->recordbank.records.GetData (r);
+			if ( rec->GetField ( RECORDBANK_NAME ) && rec->GetField ( RECORDBANK_PASSWORD ) ) {
+				targets->PutData ( comp );
+				break;
+			}
+		}
+	}
+
+	delete computers;
+
+}
+
+static Record *RandomAccount ( Computer *comp )
+{
+
+	for ( int tries = 0; tries < 20; ++tries ) {
+		Record *rec = comp->recordbank.records.GetData ( Random ( comp->recordbank.records.Size () ) );
+		if ( rec->GetField ( RECORDBANK_NAME ) ) return rec;
+	}
+
+	return NULL;
+
+}
+
+// A code for an account on the computer - its real password, one of the
+// shared ones, or just a password with no name
+
+static void GiveRandomCode ( Agent *agent, Computer *comp )
+{
+
+	Record *rec = RandomAccount ( comp );
+	if ( !rec ) return;
+
+	char *password = rec->GetField ( RECORDBANK_PASSWORD );
+	if ( !password || Random (3) == 0 ) password = PASSWORDS [Random ( NUMPASSWORDS )];
+
+	char code [128];
+	if ( Random (8) == 0 )	Computer::GenerateAccessCode ( password, code, sizeof ( code ) );
+	else					Computer::GenerateAccessCode ( rec->GetField ( RECORDBANK_NAME ), password, code, sizeof ( code ) );
+
+	agent->GiveCode ( comp->ip, code );
+
+}
+
+// ChangeSecurityCodes expects these to keep their passwords
+
+static bool IsSystemAccount ( Record *rec )
+{
+
+	char *name = rec->GetField ( RECORDBANK_NAME );
+	return strcmp ( name, RECORDBANK_ADMIN ) == 0 ||
+		   strcmp ( name, RECORDBANK_READWRITE ) == 0 ||
+		   strcmp ( name, RECORDBANK_READONLY ) == 0;
+
+}
+
+// Changes one computer's records one of the ways the game can
+
+static void ChangeRecords ( Computer *comp )
+{
+
+	Record *rec = RandomAccount ( comp );
+	int action = Random (10);
+
+	if ( action < 5 && rec ) {
+		if ( rec->GetField ( RECORDBANK_PASSWORD ) )	rec->ChangeField ( RECORDBANK_PASSWORD, PASSWORDS [Random ( NUMPASSWORDS )] );
+		else											rec->AddField ( RECORDBANK_PASSWORD, PASSWORDS [Random ( NUMPASSWORDS )] );
+	}
+
+	else if ( action < 6 )
+		comp->ChangeSecurityCodes ();
+
+	else if ( action < 8 && rec && rec->GetField ( RECORDBANK_SECURITY ) )
+		rec->ChangeField ( RECORDBANK_SECURITY, Random (5) );
+
+	else if ( action < 9 && rec && rec->GetField ( RECORDBANK_PASSWORD ) && !IsSystemAccount ( rec ) )
+		rec->DeleteField ( RECORDBANK_PASSWORD );
+
+	else {
+		static int numaccounts = 0;
+		char name [64];
+		UplinkSnprintf ( name, sizeof ( name ), "account%d", ++numaccounts );
+		Record *newrec = new Record ();
+		newrec->AddField ( RECORDBANK_NAME, name );
+		newrec->AddField ( RECORDBANK_PASSWORD, PASSWORDS [Random ( NUMPASSWORDS )] );
+		newrec->AddField ( RECORDBANK_SECURITY, Random (5) );
+		comp->recordbank.AddRecord ( newrec );
+	}
+
+}
+
+static void CheckAccess ()
+{
+
+	TestCreateWorld ( WORLDSEED );
+	WorldGenerator::GenerateAll ();
+	FindTargets ();
+
+	TestAgent *agents [NUMAGENTS];
+	Computer *agenttargets [NUMAGENTS][NUMTARGETS];
+	int lastanswer [NUMAGENTS][NUMTARGETS];
+
+	for ( int a = 0; a < NUMAGENTS; ++a ) {
+		agents [a] = new TestAgent ();
+		for ( int t = 0; t < NUMTARGETS; ++t ) {
+			agenttargets [a][t] = targets->GetData ( Random ( targets->Size () ) );
+			lastanswer [a][t] = -2;
+			for ( int c = Random (3); c >= 0; --c )
+				GiveRandomCode ( agents [a], agenttargets [a][t] );
+		}
+	}
+
+	int numchecks = 0, numhits = 0, numchanged = 0, numfound = 0;
+
+	for ( int step = 0; step < NUMSTEPS; ++step ) {
+
+		int a = Random ( NUMAGENTS );
+		int t = Random ( NUMTARGETS );
+		Computer *comp = agenttargets [a][t];
+		int action = Random (100);
+
+		if ( action < 80 ) {
+
+			bool cached = agents [a]->Cached ( comp->ip );
+			int security = agents [a]->HasAccount ( comp->ip );
+			int expected = ScanHasAccount ( agents [a], comp->ip );
+
+			if ( TEST_CHECK ( security == expected ) ) ++numchecks;
+
+			// A cached answer the records have since changed
+
+			if ( cached && lastanswer [a][t] == expected ) ++numhits;
+			if ( cached && lastanswer [a][t] != expected ) ++numchanged;
+			if ( expected != -1 ) ++numfound;
+
+			lastanswer [a][t] = expected;
+
+		}
+		else if ( action < 95 )
+			ChangeRecords ( comp );
+
+		else
+			GiveRandomCode ( agents [a], comp );
+
+	}
+
+	// Worth checking only if answers were reused, and records changed under them
+
+	TEST_CHECK ( numhits > 0 );
+	TEST_CHECK ( numchanged > 0 );
+	TEST_CHECK ( numfound > 0 && numfound < numchecks );
+
+	printf ( "%d look ups matched the scan : %d with access, %d from unchanged records, %d after their records changed\n",
+			 numchecks, numfound, numhits, numchanged );
+
+	for ( int a = 0; a < NUMAGENTS; ++a )
+		delete agents [a];
+
+	delete targets;
+	targets = NULL;
+
+}
+
+// 5,000 agents with codes for a screenful of computers each, looked up
+// the way the world map does - cold, again and again, and after a
+// password change on every computer
+
+static void TimeAgents ()
+{
+
+	TestCreateWorld ( WORLDSEED );
+	WorldGenerator::GenerateAll ();
+	FindTargets ();
+
+	Agent **agents = new Agent * [BIGAGENTS];
+	Computer **agenttargets = new Computer * [BIGAGENTS * BIGTARGETS];
+	int *answers = new int [BIGAGENTS * BIGTARGETS];
+
+	for ( int a = 0; a < BIGAGENTS; ++a ) {
+		agents [a] = new Agent ();
+		for ( int t = 0; t < BIGTARGETS; ++t ) {
+			Computer *comp = targets->GetData ( Random ( targets->Size () ) );
+			agenttargets [a * BIGTARGETS + t] = comp;
+			for ( int c = Random (3); c >= 0; --c )
+				GiveRandomCode ( agents [a], comp );
+		}
+	}
+
+	int numlookups = BIGAGENTS * BIGTARGETS;
+
+	TestTime start = TestNow ();
+	for ( int i = 0; i < numlookups; ++i )
+		answers [i] = agents [i / BIGTARGETS]->HasAccount ( agenttargets [i]->ip );
+	double coldms = TestMilliseconds ( start );
+
+	int mismatched = 0;
+	start = TestNow ();
+	for ( int pass = 0; pass < BIGWARMPASSES; ++pass )
+		for ( int i = 0; i < numlookups; ++i )
+			if ( agents [i / BIGTARGETS]->HasAccount ( agenttargets [i]->ip ) != answers [i] ) ++mismatched;
+	double warmms = TestMilliseconds ( start ) / BIGWARMPASSES;
+
+	TEST_CHECK ( mismatched == 0 );
+
+	start = TestNow ();
+	for ( int i = 0; i < numlookups; ++i )
+		if ( ScanHasAccount ( agents [i / BIGTARGETS], agenttargets [i]->ip ) != answers [i] ) ++mismatched;
+	double scanms = TestMilliseconds ( start );
+
+	TEST_CHECK ( mismatched == 0 );
+
+	for ( int i = 0; i < targets->Size (); ++i )
+		ChangeRecords ( targets->GetData (i) );
+
+	start = TestNow ();
+	for ( int i = 0; i < numlookups; ++i )
+		if ( agents [i / BIGTARGETS]->HasAccount ( agenttargets [i]->ip ) != ScanHasAccount ( agents [i / BIGTARGETS], agenttargets [i]->ip ) )
+			++mismatched;
+	double changedms = TestMilliseconds ( start );
+
+	TEST_CHECK ( mismatched == 0 );
+
+	printf ( "%d agents, %d computers each, %d computers with accounts\n", BIGAGENTS, BIGTARGETS, targets->Size () );
+	printf ( "All look ups : cold %.1fms, cached %.1fms, records scanned %.1fms, checked after a change everywhere %.1fms\n",
+			 coldms, warmms, scanms, changedms );
+
+	for ( int a = 0; a < BIGAGENTS; ++a )
+		delete agents [a];
+
+	delete [] agents;
+	delete [] agenttargets;
+	delete [] answers;
+	delete targets;
+	targets = NULL;
+
+}
+
+int main ()
+{
+
+	TestInitialise ();
+
+	CheckAccess ();
+	TimeAgents ();
+
+	return TestFinish ();
+
+}
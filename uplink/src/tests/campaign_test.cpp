@@ -0,0 +1,313 @@
+// -*- tab-width:4 c-file-style:"cc-mode" -*-
+
+/*
+
+  Campaign test
+
+	Plays a generated world forward for a month of game time - computers
+	making their own logs and files, connections bouncing through them,
+	and banks emptied and formatted as tracks are covered - saving and
+	reloading it half way through. Checks every wiped bank hands its arena
+	back at once, and that nothing is left in the arenas once every bank
+	is wiped. Counts the heap allocations the pools and arenas saved, and
+	reports the resident memory along the way
+
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app/app.h"
+#include "app/globals.h"
+
+#include "options/options.h"
+
+#include "game/game.h"
+
+#include "world/world.h"
+#include "world/vlocation.h"
+#include "world/computer/computer.h"
+#include "world/computer/logbank.h"
+#include "world/computer/databank.h"
+#include "world/generator/worldgenerator.h"
+
+#include "tests/testworld.h"
+
+#include "mmalloc.h"
+#include "mmgr.h"
+
+
+#define WORLDSEED       1
+#define NUMDAYS         30
+#define FRAMESPERDAY    96                          // An update every quarter of an hour of game time
+#define FRAMESECONDS    ( 24 * 60 * 60 / FRAMESPERDAY )
+
+#define HACKFRAMES      3                           // Updates between connections
+#define NUMBOUNCES      4                           // Computers each connection passes through
+#define WIPESPERDAY     3                           // Banks emptied and formatted each day
+
+
+// Logs and files made by the pools and arenas
+
+struct PooledCounts
+{
+
+	unsigned long long frompools;					// The class pools
+	unsigned long long fromarenas;					// Every bank's own arena
+
+};
+
+
+static DArray <Computer *> *computers = NULL;
+
+
+static int Random ( int range )
+{
+
+	return rand () % range;
+
+}
+
+// VmRSS or VmHWM from /proc, in kilobytes - 0 where there is no /proc
+
+static long ReadMemory ( const char *field )
+{
+
+	FILE *file = fopen ( "/proc/self/status", "r" );
+	if ( !file ) return 0;
+
+	char line [256];
+	long kilobytes = 0;
+	size_t length = strlen ( field );
+
+	while ( fgets ( line, sizeof ( line ), file ) )
+		if ( strncmp ( line, field, length ) == 0 ) {
+			sscanf ( line + length, " %ld", &kilobytes );
+			break;
+		}
+
+	fclose ( file );
+	return kilobytes;
+
+}
+
+static void FindComputers ()
+{
+
+	delete computers;
+	computers = new DArray <Computer *> ();
+
+	DArray <Computer *> *all = game->GetWorld ()->computers.ConvertToDArray ();
+
+	for ( int i = 0; i < all->Size (); ++i )
+		if ( all->ValidIndex (i) )
+			computers->PutData ( all->GetData (i) );
+
+	delete all;
+
+}
+
+static void CountPooled ( PooledCounts *counts )
+{
+
+	counts->frompools = AccessLog::pool.NumAllocations () + Data::pool.NumAllocations ();
+	counts->fromarenas = 0;
+
+	for ( int i = 0; i < computers->Size (); ++i ) {
+		Computer *comp = computers->GetData (i);
+		counts->fromarenas += comp->logbank.arena.NumAllocations () + comp->databank.arena.NumAllocations ();
+	}
+
+}
+
+static size_t ArenaBytes ()
+{
+
+	size_t bytes = 0;
+
+	for ( int i = 0; i < computers->Size (); ++i ) {
+		Computer *comp = computers->GetData (i);
+		bytes += comp->logbank.arena.BytesReserved () + comp->databank.arena.BytesReserved ();
+	}
+
+	return bytes;
+
+}
+
+// The logs Connection::Connect leaves on each computer it bounces through
+
+static void Hack ()
+{
+
+	char *ips [NUMBOUNCES + 1];
+	ips [0] = (char *) "LOCAL";
+
+	for ( int i = 1; i <= NUMBOUNCES; ++i )
+		ips [i] = computers->GetData ( Random ( computers->Size () ) )->ip;
+
+	for ( int i = 1; i <= NUMBOUNCES; ++i ) {
+
+		Computer *comp = game->GetWorld ()->GetVLocation ( ips [i] )->GetComputer ();
+		AccessLog *log = new AccessLog ();
+
+		if ( i == NUMBOUNCES ) {
+			log->SetProperties ( &(game->GetWorld ()->date), ips [i-1], "PLAYER",
+								 LOG_NOTSUSPICIOUS, LOG_TYPE_CONNECTIONOPENED );
+		}
+		else {
+			log->SetProperties ( &(game->GetWorld ()->date), ips [i-1], "PLAYER",
+								 LOG_NOTSUSPICIOUS, i == 1 ? LOG_TYPE_BOUNCEBEGIN : LOG_TYPE_BOUNCE );
+			log->SetData1 ( ips [i+1] );
+		}
+
+		comp->logbank.AddLog ( log );
+
+	}
+
+}
+
+// Returns true if the bank's arenas were released
+
+static bool Wipe ( Computer *comp )
+{
+
+	comp->logbank.Empty ();
+	comp->databank.Format ();
+
+	return comp->logbank.arena.NumSlabs () == 0 && comp->logbank.arena.NumLive () == 0 &&
+		   comp->databank.arena.NumSlabs () == 0 && comp->databank.arena.NumLive () == 0;
+
+}
+
+// Saves the world and loads it into a new one, so every log and file
+// on every computer is loaded into that computer's arenas
+
+static bool Reload ()
+{
+
+	FILE *file = tmpfile ();
+	UplinkAssert ( file );
+
+	game->GetWorld ()->Save ( file );
+	rewind ( file );
+
+	delete computers;
+	computers = NULL;
+
+	World *world = TestCreateWorld ( WORLDSEED );
+	bool loaded = world->Load ( file );
+	fclose ( file );
+
+	world->date.DeActivate ();
+	FindComputers ();
+	return loaded;
+
+}
+
+static void RunCampaign ()
+{
+
+	TestCreateWorld ( WORLDSEED );
+	WorldGenerator::GenerateAll ();
+	game->GetWorld ()->date.DeActivate ();
+	app->GetOptions ()->SetOptionValue ( "game_updatethreads", 0 );
+	FindComputers ();
+
+	long startrss = ReadMemory ( "VmRSS:" );
+
+	MmStats startheap;
+	MmGetStats ( &startheap );
+
+	PooledCounts startpooled, beforereload, afterreload, endpooled;
+	CountPooled ( &startpooled );
+
+	int numwipes = 0, numreleased = 0;
+	size_t peakarenabytes = 0;
+	bool loaded = false;
+
+	for ( int day = 0; day < NUMDAYS; ++day ) {
+
+		if ( day == NUMDAYS / 2 ) {
+			CountPooled ( &beforereload );
+			loaded = Reload ();
+			CountPooled ( &afterreload );
+		}
+
+		for ( int frame = 0; frame < FRAMESPERDAY; ++frame ) {
+
+			game->GetWorld ()->date.AdvanceSecond ( FRAMESECONDS );
+			game->GetWorld ()->Update ();
+
+			if ( frame % HACKFRAMES == 0 )
+				Hack ();
+
+		}
+
+		size_t arenabytes = ArenaBytes ();
+		if ( arenabytes > peakarenabytes ) peakarenabytes = arenabytes;
+
+		for ( int w = 0; w < WIPESPERDAY; ++w ) {
+			++numwipes;
+			if ( Wipe ( computers->GetData ( Random ( computers->Size () ) ) ) ) ++numreleased;
+		}
+
+	}
+
+	MmStats endheap;
+	MmGetStats ( &endheap );
+	CountPooled ( &endpooled );
+
+	long peakrss = ReadMemory ( "VmHWM:" );
+	long endrss = ReadMemory ( "VmRSS:" );
+
+	// Everything loaded went into the arenas, so they held something
+
+	TEST_CHECK ( loaded );
+	TEST_CHECK ( afterreload.fromarenas > 0 );
+	TEST_CHECK ( numreleased == numwipes );
+
+	unsigned long long heap = endheap.allocations - startheap.allocations;
+	unsigned long long frompools = ( beforereload.frompools - startpooled.frompools ) + ( endpooled.frompools - afterreload.frompools );
+	unsigned long long fromarenas = ( beforereload.fromarenas - startpooled.fromarenas ) + endpooled.fromarenas;
+
+	TEST_CHECK ( frompools + fromarenas > 0 );
+
+	printf ( "%d days, %d computers, %d banks wiped : %llu logs and files from the class pools, %llu from arenas, "
+			 "%llu other heap allocations - %llu without the pools\n",
+			 NUMDAYS, computers->Size (), numwipes, frompools, fromarenas, heap, heap + frompools + fromarenas );
+
+	// Wipe the rest - every arena goes back, the class pools keep their slabs
+
+	size_t arenabytes = ArenaBytes ();
+	int numlast = 0;
+
+	for ( int i = 0; i < computers->Size (); ++i )
+		if ( Wipe ( computers->GetData (i) ) ) ++numlast;
+
+	TEST_CHECK ( numlast == computers->Size () );
+	TEST_CHECK ( ArenaBytes () == 0 );
+
+	printf ( "Arenas held %lukb at the most, %lukb at the end and none once every bank was wiped; "
+			 "class pools keep %lukb\n",
+			 (unsigned long) ( peakarenabytes / 1024 ), (unsigned long) ( arenabytes / 1024 ),
+			 (unsigned long) ( ( AccessLog::pool.BytesReserved () + Data::pool.BytesReserved () ) / 1024 ) );
+
+	printf ( "Resident memory : %ldkb generated, %ldkb at the most, %ldkb at the end, %ldkb wiped\n",
+			 startrss, peakrss, endrss, ReadMemory ( "VmRSS:" ) );
+
+	delete computers;
+	computers = NULL;
+
+}
+
+int main ()
+{
+
+	TestInitialise ();
+
+	RunCampaign ();
+
+	return TestFinish ();
+
+}
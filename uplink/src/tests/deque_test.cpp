@@ -0,0 +1,313 @@
+// -*- tab-width:4 c-file-style:"cc-mode" -*-
+
+/*
+
+  Deque test
+
+	Pushes and pops at both ends of a tosser Deque, through its growth
+	from empty and with its items wrapped round the end of the ring,
+	and inserts and removes in the middle on either side. Checks every
+	item after every change against a std::deque doing the same, then
+	runs the same checks on a long randomized mix of changes
+
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <deque>
+
+#include "tosser.h"
+
+#include "tests/testworld.h"
+
+#include "mmgr.h"
+
+
+#define NUMRANDOM       200000
+#define RANDOMLIMIT     300                         // Keeps the random run wrapping round a small ring
+
+
+// Deque keeps its ring protected
+
+class TestDeque : public Deque <int>
+{
+
+public:
+
+	int Capacity ()			{ return capacity; }
+	int Start ()			{ return start; }
+
+	bool Wrapped ()			{ return capacity > 0 && start + numitems > capacity; }
+
+};
+
+
+static bool Same ( TestDeque *deque, std::deque <int> *expected )
+{
+
+	if ( deque->Size () != (int) expected->size () ) return false;
+
+	for ( int i = 0; i < deque->Size (); ++i )
+		if ( !deque->ValidIndex (i) || deque->GetData (i) != (*expected) [i] || (*deque) [i] != (*expected) [i] )
+			return false;
+
+	return !deque->ValidIndex ( -1 ) && !deque->ValidIndex ( deque->Size () ) &&
+		   deque->GetData ( -1 ) == 0 && deque->GetData ( deque->Size () ) == 0;
+
+}
+
+static int Random ( int range )
+{
+
+	return rand () % range;
+
+}
+
+// Both ends, from empty, through growth - the capacity doubles from 16
+// and keeps the items in order
+
+static void CheckEnds ()
+{
+
+	TestDeque deque;
+	std::deque <int> expected;
+
+	TEST_CHECK ( deque.Size () == 0 && deque.Capacity () == 0 );
+	TEST_CHECK ( Same ( &deque, &expected ) );
+
+	bool allsame = true;
+	int lastcapacity = 0;
+	int numgrowths = 0;
+
+	for ( int i = 0; i < 1000; ++i ) {
+
+		if ( i % 3 == 0 )	{ deque.PutDataAtStart ( i );	expected.push_front ( i ); }
+		else if ( i % 3 == 1 )	{ deque.PutDataAtEnd ( i );		expected.push_back ( i ); }
+		else				{ deque.PutData ( i );			expected.push_back ( i ); }
+
+		if ( deque.Capacity () != lastcapacity ) {
+			TEST_CHECK ( deque.Capacity () == ( lastcapacity ? lastcapacity * 2 : 16 ) );
+			lastcapacity = deque.Capacity ();
+			++numgrowths;
+		}
+
+		if ( !Same ( &deque, &expected ) ) allsame = false;
+
+	}
+
+	TEST_CHECK ( numgrowths == 7 );								// 16 up to 1024
+
+	// Pop from both ends until empty
+
+	while ( deque.Size () > 0 ) {
+
+		if ( deque.Size () % 2 )	{ deque.RemoveData ( 0 );					expected.pop_front (); }
+		else						{ deque.RemoveData ( deque.Size () - 1 );	expected.pop_back (); }
+
+		if ( !Same ( &deque, &expected ) ) allsame = false;
+
+	}
+
+	TEST_CHECK ( allsame );
+	TEST_CHECK ( deque.Capacity () == 1024 );					// Removing never shrinks the ring
+
+	// Out of range removes change nothing
+
+	deque.PutData ( 7 );
+	deque.RemoveData ( -1 );
+	deque.RemoveData ( 1 );
+	TEST_CHECK ( deque.Size () == 1 && deque.GetData (0) == 7 );
+
+	deque.Empty ();
+	TEST_CHECK ( deque.Size () == 0 && deque.Capacity () == 0 );
+
+}
+
+// Items wrapped round the end of the ring - as a queue, adding at one
+// end and removing from the other, then growing while wrapped
+
+static void CheckWraparound ()
+{
+
+	TestDeque deque;
+	std::deque <int> expected;
+	bool allsame = true;
+	int numwrapped = 0;
+
+	for ( int i = 0; i < 12; ++i ) {
+		deque.PutDataAtEnd ( i );
+		expected.push_back ( i );
+	}
+
+	// Twenty times round a ring of 16
+
+	for ( int i = 12; i < 12 + 16 * 20; ++i ) {
+
+		deque.PutDataAtEnd ( i );
+		expected.push_back ( i );
+		deque.RemoveData ( 0 );
+		expected.pop_front ();
+
+		if ( deque.Wrapped () ) ++numwrapped;
+		if ( !Same ( &deque, &expected ) ) allsame = false;
+
+	}
+
+	TEST_CHECK ( deque.Capacity () == 16 );
+	TEST_CHECK ( numwrapped > 0 );
+
+	// The other way round
+
+	for ( int i = 0; i < 16 * 20; ++i ) {
+
+		deque.PutDataAtStart ( -i );
+		expected.push_front ( -i );
+		deque.RemoveData ( deque.Size () - 1 );
+		expected.pop_back ();
+
+		if ( !Same ( &deque, &expected ) ) allsame = false;
+
+	}
+
+	TEST_CHECK ( deque.Capacity () == 16 );
+
+	// Fill the ring while it is wrapped, then grow it
+
+	while ( !deque.Wrapped () ) {
+		deque.PutDataAtEnd ( 1000 );
+		expected.push_back ( 1000 );
+		deque.RemoveData ( 0 );
+		expected.pop_front ();
+	}
+
+	for ( int i = 0; deque.Size () < 16; ++i ) {
+		deque.PutDataAtEnd ( 2000 + i );
+		expected.push_back ( 2000 + i );
+	}
+
+	TEST_CHECK ( deque.Wrapped () && deque.Capacity () == 16 );
+
+	deque.PutDataAtStart ( 3000 );
+	expected.push_front ( 3000 );
+
+	// Growing unwrapped the items, so the new first item is in the last slot
+
+	TEST_CHECK ( deque.Capacity () == 32 && deque.Start () == 31 );
+	if ( !Same ( &deque, &expected ) ) allsame = false;
+
+	TEST_CHECK ( allsame );
+
+}
+
+// Inserts and removes in the middle, on the shorter side either way,
+// and finding items
+
+static void CheckMiddle ()
+{
+
+	TestDeque deque;
+	std::deque <int> expected;
+	bool allsame = true;
+
+	for ( int i = 0; i < 20; ++i ) {
+		deque.PutData ( i * 10 );
+		expected.push_back ( i * 10 );
+	}
+
+	for ( int i = 0; i < 200; ++i ) {
+
+		int index = Random ( deque.Size () + 3 ) - 1;			// Out of range adds at an end
+
+		deque.PutDataAtIndex ( 5000 + i, index );
+		if ( index <= 0 )							expected.push_front ( 5000 + i );
+		else if ( index >= (int) expected.size () )	expected.push_back ( 5000 + i );
+		else										expected.insert ( expected.begin () + index, 5000 + i );
+
+		if ( !Same ( &deque, &expected ) ) allsame = false;
+
+		if ( i % 3 == 0 ) {
+			index = Random ( deque.Size () );
+			deque.RemoveData ( index );
+			expected.erase ( expected.begin () + index );
+			if ( !Same ( &deque, &expected ) ) allsame = false;
+		}
+
+	}
+
+	TEST_CHECK ( allsame );
+
+	TEST_CHECK ( deque.FindData ( 5000 + 199 ) != -1 );
+	TEST_CHECK ( deque.GetData ( deque.FindData ( 5000 + 199 ) ) == 5000 + 199 );
+	TEST_CHECK ( deque.FindData ( -12345 ) == -1 );
+
+}
+
+// A long run of every kind of change, kept small so it wraps and grows often
+
+static void CheckRandom ()
+{
+
+	TestDeque deque;
+	std::deque <int> expected;
+	int numfailed = 0;
+	int numwrapped = 0;
+
+	for ( int step = 0; step < NUMRANDOM; ++step ) {
+
+		int action = Random ( deque.Size () > RANDOMLIMIT ? 6 : 10 );
+		int index = deque.Size () ? Random ( deque.Size () ) : 0;
+
+		switch ( action ) {
+
+			case 0:		deque.RemoveData ( 0 );		if ( expected.size () ) expected.pop_front ();		break;
+			case 1:		deque.RemoveData ( deque.Size () - 1 );	if ( expected.size () ) expected.pop_back ();	break;
+			case 2:
+			case 3:
+				if ( expected.size () ) {
+					deque.RemoveData ( index );
+					expected.erase ( expected.begin () + index );
+				}
+				break;
+			case 4:
+				if ( Random (200) == 0 ) {
+					deque.Empty ();
+					expected.clear ();
+				}
+				break;
+			case 5:
+			case 6:		deque.PutDataAtStart ( step );	expected.push_front ( step );		break;
+			case 7:		deque.PutDataAtEnd ( step );	expected.push_back ( step );		break;
+			default:
+				deque.PutDataAtIndex ( step, index );
+				expected.insert ( expected.begin () + index, step );
+				break;
+
+		}
+
+		if ( deque.Wrapped () ) ++numwrapped;
+		if ( !Same ( &deque, &expected ) ) ++numfailed;
+
+	}
+
+	TEST_CHECK ( numfailed == 0 );
+	TEST_CHECK ( numwrapped > 0 );
+
+	printf ( "%d random changes matched std::deque, %d of them with the ring wrapped\n", NUMRANDOM, numwrapped );
+
+}
+
+int main ()
+{
+
+	TestInitialise ();
+
+	CheckEnds ();
+	CheckWraparound ();
+	CheckMiddle ();
+	CheckRandom ();
+
+	return TestFinish ();
+
+}
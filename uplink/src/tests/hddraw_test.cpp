@@ -0,0 +1,243 @@
+// -*- tab-width:4 c-file-style:"cc-mode" -*-
+
+/*
+
+  HD draw test
+
+	Draws the HD main menu and top bar layouts into a memory bitmap, as
+	they are drawn every frame, and times them against frames that parse
+	every colour and walk every parent chain again, as Draw did before
+	the tree cached them. Checks both ways make the same draw calls, that
+	moving the top bar moves everything in it, and that the cached frames
+	are the faster
+
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "app/app.h"
+#include "app/globals.h"
+
+#include "hd_ui/hd_allegro5.h"
+#include "hd_ui/hd_atlas.h"
+#include "hd_ui/hd_layout_parser.h"
+
+#include "tests/testworld.h"
+
+#include "mmgr.h"
+
+using namespace HDUI;
+
+
+#define HD_DIR          "../mod/uplinkHD"                   // Relative to uplink/src, where "make test" runs
+#define HD_MAINMENU     HD_DIR "/layouts/MainMenu/MainMenu.xml"
+#define HD_TOPBAR       HD_DIR "/layouts/HUD/TopBar.xml"
+
+#define DRAWSCALE       16                                  // Drawn at 1/16 size, so the software rasteriser
+#define NUMFRAMES       2000                                // doesn't drown out the work done in the tree
+#define NUMPASSES       5
+
+
+// LoadLayout reports every layout it loads
+
+static int savedstdout = -1;
+
+static void Quiet ( bool quiet )
+{
+
+	fflush ( stdout );
+
+	if ( quiet ) {
+		savedstdout = dup ( STDOUT_FILENO );
+		int devnull = open ( "/dev/null", O_WRONLY );
+		dup2 ( devnull, STDOUT_FILENO );
+		close ( devnull );
+	}
+	else if ( savedstdout != -1 ) {
+		dup2 ( savedstdout, STDOUT_FILENO );
+		close ( savedstdout );
+		savedstdout = -1;
+	}
+
+}
+
+// A memory bitmap to draw into - there is no display here
+
+static ALLEGRO_BITMAP *CreateTarget ()
+{
+
+	if ( !al_init () || !al_init_primitives_addon () || !al_init_image_addon () )
+		return NULL;
+
+	al_set_new_bitmap_flags ( ALLEGRO_MEMORY_BITMAP );
+
+	ALLEGRO_BITMAP *target = al_create_bitmap ( 1920 / DRAWSCALE, 1080 / DRAWSCALE );
+	if ( target ) al_set_target_bitmap ( target );
+
+	Allegro5System::SetBaseResolution ( 1920 * DRAWSCALE, 1080 * DRAWSCALE );
+	return target;
+
+}
+
+static std::unique_ptr <UIObject> Load ( const char *path )
+{
+
+	LayoutParser parser;
+	parser.SetAssetBasePath ( HD_DIR "/graphics" );
+
+	Quiet ( true );
+	std::unique_ptr <UIObject> layout = parser.LoadLayout ( path );
+	Quiet ( false );
+
+	return layout;
+
+}
+
+static int CountObjects ( UIObject *object )
+{
+
+	int count = 1;
+	for ( size_t i = 0; i < object->children.size (); ++i )
+		count += CountObjects ( object->children [i].get () );
+
+	return count;
+
+}
+
+// Throws away every cached colour and position, so the next Draw
+// resolves them all again - what every frame did before the cache
+
+static void Uncache ( UIObject *object )
+{
+
+	object->InvalidateStyle ();
+	object->InvalidateTransform ();
+
+	for ( size_t i = 0; i < object->children.size (); ++i )
+		Uncache ( object->children [i].get () );
+
+}
+
+// Draws a frame, returning the draw calls made
+
+static int DrawFrame ( UIObject *mainmenu, UIObject *topbar, bool cached )
+{
+
+	if ( !cached ) {
+		Uncache ( mainmenu );
+		Uncache ( topbar );
+	}
+
+	Allegro5System::ResetDrawCalls ();
+
+	mainmenu->Draw ();
+	topbar->Draw ();
+	Allegro5System::EndFrame ();
+
+	return Allegro5System::GetDrawCalls ();
+
+}
+
+static double TimeFrames ( UIObject *mainmenu, UIObject *topbar, bool cached )
+{
+
+	TestTime start = TestNow ();
+	for ( int frame = 0; frame < NUMFRAMES; ++frame )
+		DrawFrame ( mainmenu, topbar, cached );
+
+	return TestMilliseconds ( start ) / NUMFRAMES;
+
+}
+
+// Moving the top bar moves everything in it
+
+static bool CheckMove ( UIObject *topbar )
+{
+
+	if ( topbar->children.empty () ) return false;
+
+	UIObject *child = topbar->children [0].get ();
+	float childx = child->GetAbsoluteX ();
+	float childy = child->GetAbsoluteY ();
+
+	topbar->SetPosition ( topbar->x + 10.0f, topbar->y + 20.0f );
+	bool moved = child->GetAbsoluteX () == childx + 10.0f && child->GetAbsoluteY () == childy + 20.0f;
+	topbar->SetPosition ( topbar->x - 10.0f, topbar->y - 20.0f );
+
+	return moved && child->GetAbsoluteX () == childx && child->GetAbsoluteY () == childy;
+
+}
+
+static void TimeDraws ()
+{
+
+	ALLEGRO_BITMAP *target = CreateTarget ();
+	TEST_CHECK ( target );
+	if ( !target ) return;
+
+	Quiet ( true );
+	AtlasManager::GetInstance ().SetBasePath ( HD_DIR "/graphics/" );
+	bool atlas = AtlasManager::GetInstance ().LoadAtlas ( "uplinkHD_atlas_00.xml" );
+	Quiet ( false );
+
+	std::unique_ptr <UIObject> mainmenu = Load ( HD_MAINMENU );
+	std::unique_ptr <UIObject> topbar = Load ( HD_TOPBAR );
+
+	TEST_CHECK ( mainmenu && topbar );
+	if ( !mainmenu || !topbar ) return;
+
+	// Both ways draw the same thing
+
+	int cachedcalls = DrawFrame ( mainmenu.get (), topbar.get (), true );
+	int uncachedcalls = DrawFrame ( mainmenu.get (), topbar.get (), false );
+
+	TEST_CHECK ( cachedcalls > 0 );
+	TEST_CHECK ( cachedcalls == uncachedcalls );
+	TEST_CHECK ( CheckMove ( topbar.get () ) );
+
+	// Alternating passes, keeping the best of each, so a busy machine
+	// slows both the same
+
+	double cachedms = 0.0, uncachedms = 0.0;
+
+	for ( int pass = 0; pass < NUMPASSES; ++pass ) {
+
+		double ms = TimeFrames ( mainmenu.get (), topbar.get (), true );
+		if ( pass == 0 || ms < cachedms ) cachedms = ms;
+
+		ms = TimeFrames ( mainmenu.get (), topbar.get (), false );
+		if ( pass == 0 || ms < uncachedms ) uncachedms = ms;
+
+	}
+
+	TEST_CHECK ( cachedms < uncachedms );
+
+	printf ( "Main menu and top bar, %d objects, %d draw calls%s : cached %.4fms a frame, resolved every frame %.4fms\n",
+			 CountObjects ( mainmenu.get () ) + CountObjects ( topbar.get () ), cachedcalls,
+			 atlas ? "" : " (no atlas)", cachedms, uncachedms );
+
+	mainmenu.reset ();
+	topbar.reset ();
+	AtlasManager::GetInstance ().ClearAll ();
+
+	al_set_target_bitmap ( NULL );
+	al_destroy_bitmap ( target );
+
+}
+
+int main ()
+{
+
+	TestInitialise ();
+
+	TimeDraws ();
+
+	return TestFinish ();
+
+}
@@ -0,0 +1,284 @@
+// -*- tab-width:4 c-file-style:"cc-mode" -*-
+
+/*
+
+  HD layout test
+
+	Loads every HD UI layout the way LayoutManager does, from the data
+	directory "make layouts" compiles into, and checks each one came from
+	its mapped compiled file and builds the same tree as its XML. Checks
+	the compiled atlas is current, that a layout edited after compiling
+	falls back to its XML, and times loading every layout both ways
+
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include <tinyxml2.h>
+
+#include "app/app.h"
+#include "app/globals.h"
+
+#include "hd_ui/hd_layout_binary.h"
+#include "hd_ui/hd_layout_parser.h"
+
+#include "tests/testworld.h"
+
+#include "mmgr.h"
+
+using namespace HDUI;
+
+
+#define HD_DIR          "../mod/uplinkHD"                   // Relative to uplink/src, where "make test" runs
+#define HD_ATLAS        HD_DIR "/graphics/uplinkHD_atlas_00.xml"
+
+#define NUMPASSES       20
+
+
+static void FindLayouts ( const std::string &directory, std::vector <std::string> *layouts )
+{
+
+	DIR *dir = opendir ( directory.c_str () );
+	if ( !dir ) return;
+
+	while ( struct dirent *entry = readdir ( dir ) ) {
+
+		if ( entry->d_name [0] == '.' ) continue;
+
+		std::string path = directory + "/" + entry->d_name;
+		size_t length = path.size ();
+
+		if ( length > 4 && path.compare ( length - 4, 4, ".xml" ) == 0 )
+			layouts->push_back ( path );
+		else
+			FindLayouts ( path, layouts );
+
+	}
+
+	closedir ( dir );
+
+}
+
+static std::string ReadFile ( const std::string &path )
+{
+
+	std::string text;
+	FILE *file = fopen ( path.c_str (), "rb" );
+	if ( !file ) return text;
+
+	char buffer [4096];
+	size_t read;
+	while ( ( read = fread ( buffer, 1, sizeof ( buffer ), file ) ) > 0 )
+		text.append ( buffer, read );
+
+	fclose ( file );
+	return text;
+
+}
+
+// LoadLayout reports every layout it loads
+
+static int savedstdout = -1;
+
+static void Quiet ( bool quiet )
+{
+
+	fflush ( stdout );
+
+	if ( quiet ) {
+		savedstdout = dup ( STDOUT_FILENO );
+		int devnull = open ( "/dev/null", O_WRONLY );
+		dup2 ( devnull, STDOUT_FILENO );
+		close ( devnull );
+	}
+	else if ( savedstdout != -1 ) {
+		dup2 ( savedstdout, STDOUT_FILENO );
+		close ( savedstdout );
+		savedstdout = -1;
+	}
+
+}
+
+static bool SameTree ( UIObject *a, UIObject *b )
+{
+
+	if ( !a || !b ) return a == b;
+
+	if ( strcmp ( a->GetTypeName (), b->GetTypeName () ) != 0 ||
+		 a->name != b->name ||
+		 a->x != b->x || a->y != b->y || a->w != b->w || a->h != b->h ||
+		 a->alpha != b->alpha ||
+		 a->scalingType != b->scalingType || a->arrangeType != b->arrangeType ||
+		 a->arrangePadding != b->arrangePadding ||
+		 a->children.size () != b->children.size () )
+		return false;
+
+	if ( UIGradient *ga = dynamic_cast <UIGradient *> ( a ) ) {
+		UIGradient *gb = (UIGradient *) b;
+		if ( ga->subtype != gb->subtype || ga->stops.size () != gb->stops.size () ) return false;
+		for ( size_t i = 0; i < ga->stops.size (); ++i )
+			if ( ga->stops [i].location != gb->stops [i].location ||
+				 ga->stops [i].fillColor != gb->stops [i].fillColor )
+				return false;
+	}
+	else if ( UIRectangle *ra = dynamic_cast <UIRectangle *> ( a ) ) {
+		UIRectangle *rb = (UIRectangle *) b;
+		if ( ra->subtype != rb->subtype || ra->fillColor != rb->fillColor || ra->fillAlpha != rb->fillAlpha ||
+			 ra->strokeColor != rb->strokeColor || ra->strokeWidth != rb->strokeWidth )
+			return false;
+	}
+	else if ( UILine *la = dynamic_cast <UILine *> ( a ) ) {
+		UILine *lb = (UILine *) b;
+		if ( la->x1 != lb->x1 || la->y1 != lb->y1 || la->x2 != lb->x2 || la->y2 != lb->y2 ||
+			 la->strokeColor != lb->strokeColor || la->strokeWidth != lb->strokeWidth )
+			return false;
+	}
+	else if ( UITextPoint *ta = dynamic_cast <UITextPoint *> ( a ) ) {
+		UITextPoint *tb = (UITextPoint *) b;
+		if ( ta->text != tb->text || ta->font != tb->font || ta->fontSize != tb->fontSize ||
+			 ta->fillColor != tb->fillColor || ta->align != tb->align )
+			return false;
+	}
+	else if ( UIImage *ia = dynamic_cast <UIImage *> ( a ) ) {
+		if ( ia->file != ( (UIImage *) b )->file ) return false;
+	}
+
+	for ( size_t i = 0; i < a->children.size (); ++i )
+		if ( !SameTree ( a->children [i].get (), b->children [i].get () ) )
+			return false;
+
+	return true;
+
+}
+
+// Every shipped layout, loaded the way LayoutManager loads it
+
+static void CheckLayouts ( std::vector <std::string> *layouts )
+{
+
+	int numcompiled = 0, numsame = 0;
+
+	for ( size_t i = 0; i < layouts->size (); ++i ) {
+
+		const std::string &path = (*layouts) [i];
+
+		LayoutParser parser;
+		Quiet ( true );
+		std::unique_ptr <UIObject> loaded = parser.LoadLayout ( path );
+		Quiet ( false );
+
+		if ( parser.LoadedCompiled () ) ++numcompiled;
+		else printf ( "Not loaded from its compiled file : %s\n", path.c_str () );
+
+		LayoutParser xmlparser;
+		std::unique_ptr <UIObject> parsed = xmlparser.ParseLayout ( ReadFile ( path ) );
+
+		if ( loaded && SameTree ( loaded.get (), parsed.get () ) ) ++numsame;
+		else printf ( "Compiled and XML layouts differ : %s\n", path.c_str () );
+
+	}
+
+	TEST_CHECK ( layouts->size () > 0 );
+	TEST_CHECK ( numcompiled == (int) layouts->size () );
+	TEST_CHECK ( numsame == (int) layouts->size () );
+
+	printf ( "%d layouts in %s : %d loaded from their compiled files, %d the same as their XML\n",
+			 (int) layouts->size (), HD_DIR, numcompiled, numsame );
+
+	BinaryImage atlas;
+	std::string atlaspath = CompiledPath ( HD_ATLAS, ATLAS_BINARY_EXT );
+	TEST_CHECK ( atlas.Map ( atlaspath ) && atlas.IsAtlas () && !atlas.IsStaleFor ( HD_ATLAS ) );
+
+}
+
+// A layout edited since it was compiled is loaded from its XML
+
+static void CheckStale ( const std::string &source )
+{
+
+	std::string path = std::string ( TestPath () ) + "stale.xml";
+	std::string text = ReadFile ( source );
+	TEST_CHECK ( TestWriteFile ( (char *) "stale.xml", text.c_str () ) );
+
+	tinyxml2::XMLDocument doc;
+	std::vector <char> bytes;
+	TEST_CHECK ( doc.LoadFile ( path.c_str () ) == tinyxml2::XML_SUCCESS );
+	TEST_CHECK ( CompileLayout ( doc, std::vector <const BinaryImage *> (), bytes ) && StampSource ( bytes, path ) );
+
+	FILE *file = fopen ( CompiledPath ( path, LAYOUT_BINARY_EXT ).c_str (), "wb" );
+	TEST_CHECK ( file && fwrite ( bytes.data (), 1, bytes.size (), file ) == bytes.size () );
+	if ( file ) fclose ( file );
+
+	Quiet ( true );
+
+	LayoutParser current;
+	std::unique_ptr <UIObject> fromcompiled = current.LoadLayout ( path );
+
+	text += "\n<!-- Edited -->\n";
+	TestWriteFile ( (char *) "stale.xml", text.c_str () );
+
+	LayoutParser stale;
+	std::unique_ptr <UIObject> fromxml = stale.LoadLayout ( path );
+
+	Quiet ( false );
+
+	TEST_CHECK ( current.LoadedCompiled () );
+	TEST_CHECK ( !stale.LoadedCompiled () );
+	TEST_CHECK ( SameTree ( fromcompiled.get (), fromxml.get () ) );
+
+}
+
+static void TimeLoads ( std::vector <std::string> *layouts )
+{
+
+	Quiet ( true );
+
+	TestTime start = TestNow ();
+	for ( int pass = 0; pass < NUMPASSES; ++pass )
+		for ( size_t i = 0; i < layouts->size (); ++i ) {
+			LayoutParser parser;
+			parser.LoadLayout ( (*layouts) [i] );
+		}
+	double compiledms = TestMilliseconds ( start ) / NUMPASSES;
+
+	// What the fallback does - parse, compile in memory, build
+
+	start = TestNow ();
+	for ( int pass = 0; pass < NUMPASSES; ++pass )
+		for ( size_t i = 0; i < layouts->size (); ++i ) {
+			LayoutParser parser;
+			parser.ParseLayout ( ReadFile ( (*layouts) [i] ) );
+		}
+	double xmlms = TestMilliseconds ( start ) / NUMPASSES;
+
+	Quiet ( false );
+
+	TEST_CHECK ( compiledms < xmlms );
+
+	printf ( "Every layout : compiled %.2fms, XML %.2fms\n", compiledms, xmlms );
+
+}
+
+int main ()
+{
+
+	TestInitialise ();
+
+	std::vector <std::string> layouts;
+	FindLayouts ( HD_DIR "/layouts", &layouts );
+
+	CheckLayouts ( &layouts );
+	if ( layouts.size () > 0 ) CheckStale ( layouts [0] );
+	TimeLoads ( &layouts );
+
+	return TestFinish ();
+
+}
@@ -0,0 +1,278 @@
+// -*- tab-width:4 c-file-style:"cc-mode" -*-
+
+/*
+
+  LAN draw test
+
+	Draws the LAN view background for a large, fully known LAN with a long
+	connection through it, offscreen. Checks the cached link geometry draws
+	the same pixels as geometry rebuilt that frame, and that the connection
+	turns red up to the sys admin. Times a frame both ways
+
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <GL/gl.h>
+
+#include "eclipse.h"
+
+#include "app/app.h"
+#include "app/globals.h"
+
+#include "options/options.h"
+
+#include "game/game.h"
+
+#include "interface/interface.h"
+#include "interface/localinterface/localinterface.h"
+#include "interface/localinterface/lan_interface.h"
+
+#include "world/world.h"
+#include "world/player.h"
+#include "world/vlocation.h"
+#include "world/company/company.h"
+#include "world/computer/lancomputer.h"
+#include "world/computer/lanmonitor.h"
+#include "world/generator/worldgenerator.h"
+
+#include "tests/testworld.h"
+
+#include "mmgr.h"
+
+
+#define WORLDSEED       1
+
+#define GRIDWIDTH       32                              // Hubs, 48x20 each
+#define GRIDHEIGHT      32
+#define GRIDSPACEX      64
+#define GRIDSPACEY      40
+
+#define CACHEDFRAMES    200
+#define REBUILTFRAMES   50
+
+
+// LanInterface keeps its draw functions protected, and they look for
+// the LAN screen through the game's interface
+
+class TestLanInterface : public LanInterface
+{
+
+public:
+
+	static void DrawBackground ( Button *background )	{ LanBackgroundDraw ( background, false, false ); }
+
+};
+
+class TestLocalInterface : public LocalInterface
+{
+
+public:
+
+	void SetScreen ( LocalInterfaceScreen *newscreen )	{ screen = newscreen; currentscreencode = SCREEN_LAN; }
+
+};
+
+class TestInterface : public Interface
+{
+
+public:
+
+	void SetLocalInterface ( LocalInterface *newli )	{ delete li; li = newli; }
+
+};
+
+
+static int screenwidth = 0;
+static int screenheight = 0;
+
+
+static int GridSystem ( int x, int y )
+{
+
+	return y * GRIDWIDTH + x;
+
+}
+
+// A grid of hubs linked across and down, every system and link known
+
+static LanComputer *CreateGridLAN ()
+{
+
+	VLocation *vl = WorldGenerator::GenerateLocation ();
+
+	LanComputer *comp = new LanComputer ();
+	comp->SetTYPE ( COMPUTER_TYPE_LAN );
+	comp->SetName ( "Grid Local Area Network" );
+	comp->SetCompanyName ( WorldGenerator::GetRandomCompany ()->name );
+	comp->SetIP ( vl->ip );
+	game->GetWorld ()->CreateComputer ( comp );
+
+	for ( int y = 0; y < GRIDHEIGHT; ++y )
+		for ( int x = 0; x < GRIDWIDTH; ++x )
+			comp->AddLanSystem ( x == 0 && y == 0 ? LANSYSTEM_ROUTER : LANSYSTEM_HUB,
+								 20 + x * GRIDSPACEX, 20 + y * GRIDSPACEY );
+
+	for ( int y = 0; y < GRIDHEIGHT; ++y )
+		for ( int x = 0; x < GRIDWIDTH; ++x ) {
+			if ( x + 1 < GRIDWIDTH )
+				comp->AddLanLink ( GridSystem ( x, y ), 1.0f, 0.5f, GridSystem ( x + 1, y ), 0.0f, 0.5f );
+			if ( y + 1 < GRIDHEIGHT )
+				comp->AddLanLink ( GridSystem ( x, y ), 0.5f, 1.0f, GridSystem ( x, y + 1 ), 0.5f, 0.0f );
+		}
+
+	for ( int i = 0; i < comp->systems.Size (); ++i )
+		comp->systems.GetData (i)->visible = LANSYSTEMVISIBLE_TYPE;
+	for ( int i = 0; i < comp->links.Size (); ++i )
+		comp->links.GetData (i)->IncreaseVisibility ( LANLINKVISIBLE_AWARE );
+
+	return comp;
+
+}
+
+// Across the top row then down the far side, as far as the screen shows
+
+static void CreateConnection ()
+{
+
+	LanMonitor::ResetAll ();
+
+	for ( int x = 0; x < GRIDWIDTH; ++x )
+		LanMonitor::connection.PutDataAtEnd ( GridSystem ( x, 0 ) );
+	for ( int y = 1; y < GRIDHEIGHT; ++y )
+		LanMonitor::connection.PutDataAtEnd ( GridSystem ( GRIDWIDTH - 1, y ) );
+
+	LanMonitor::currentSystem = GridSystem ( GRIDWIDTH - 1, GRIDHEIGHT - 1 );
+
+}
+
+static void DrawFrame ( Button *background, bool rebuild )
+{
+
+	if ( rebuild ) ++LanComputerLink::changes;
+
+	glClear ( GL_COLOR_BUFFER_BIT );
+	TestLanInterface::DrawBackground ( background );
+	glFinish ();
+
+}
+
+static unsigned char *ReadFrame ()
+{
+
+	unsigned char *pixels = new unsigned char [screenwidth * screenheight * 3];
+	glPixelStorei ( GL_PACK_ALIGNMENT, 1 );
+	glReadPixels ( 0, 0, screenwidth, screenheight, GL_RGB, GL_UNSIGNED_BYTE, pixels );
+	return pixels;
+
+}
+
+static int CountPixels ( unsigned char *pixels, int r, int g, int b )
+{
+
+	int count = 0;
+	for ( int i = 0; i < screenwidth * screenheight; ++i )
+		if ( pixels [i * 3] == r && pixels [i * 3 + 1] == g && pixels [i * 3 + 2] == b )
+			++count;
+
+	return count;
+
+}
+
+static double TimeFrames ( Button *background, int frames, bool rebuild )
+{
+
+	TestTime start = TestNow ();
+	for ( int i = 0; i < frames; ++i )
+		DrawFrame ( background, rebuild );
+
+	return TestMilliseconds ( start ) / frames;
+
+}
+
+int main ()
+{
+
+	TestInitialise ();
+
+	screenwidth = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+	screenheight = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
+
+	glViewport ( 0, 0, screenwidth, screenheight );
+	glMatrixMode ( GL_PROJECTION );
+	glLoadIdentity ();
+	glOrtho ( 0.0, screenwidth, screenheight, 0.0, -1.0, 1.0 );
+	glMatrixMode ( GL_MODELVIEW );
+	glLoadIdentity ();
+	glTranslatef ( 0.375f, 0.375f, 0.0f );
+	glClearColor ( 0.0f, 0.0f, 0.0f, 1.0f );
+
+	TestCreateWorld ( WORLDSEED );
+	WorldGenerator::GenerateAll ();
+
+	LanComputer *comp = CreateGridLAN ();
+	game->GetWorld ()->GetPlayer ()->SetRemoteHost ( comp->ip );
+	CreateConnection ();
+
+	TestLocalInterface *localinterface = new TestLocalInterface ();
+	localinterface->SetScreen ( new TestLanInterface () );
+	TestInterface *testinterface = new TestInterface ();
+	testinterface->SetLocalInterface ( localinterface );
+	TestSetInterface ( testinterface );
+
+	Button background ( 0, 0, screenwidth, screenheight, "", "lan_background" );
+
+	//
+	// Cached and rebuilt geometry draw the same, with the whole connection white
+
+	DrawFrame ( &background, true );
+	unsigned char *rebuilt = ReadFrame ();
+	DrawFrame ( &background, false );
+	unsigned char *cached = ReadFrame ();
+
+	TEST_CHECK ( memcmp ( rebuilt, cached, screenwidth * screenheight * 3 ) == 0 );
+	TEST_CHECK ( CountPixels ( cached, 255, 255, 255 ) > 0 );
+	TEST_CHECK ( CountPixels ( cached, 255, 0, 0 ) == 0 );
+
+	int whitepixels = CountPixels ( cached, 255, 255, 255 );
+
+	delete [] rebuilt;
+	delete [] cached;
+
+	//
+	// With the sys admin at the far end, the connection is red all the way
+
+	LanMonitor::sysAdminCurrentSystem = LanMonitor::connection.GetData ( LanMonitor::connection.Size () - 1 );
+
+	DrawFrame ( &background, false );
+	cached = ReadFrame ();
+	DrawFrame ( &background, true );
+	rebuilt = ReadFrame ();
+
+	TEST_CHECK ( memcmp ( rebuilt, cached, screenwidth * screenheight * 3 ) == 0 );
+	TEST_CHECK ( CountPixels ( cached, 255, 0, 0 ) > 0 );
+	TEST_CHECK ( CountPixels ( cached, 255, 255, 255 ) < whitepixels );
+
+	delete [] rebuilt;
+	delete [] cached;
+
+	//
+	// Frame times
+
+	LanMonitor::sysAdminCurrentSystem = LanMonitor::connection.GetData ( GRIDWIDTH );
+
+	double cachedms = TimeFrames ( &background, CACHEDFRAMES, false );
+	double rebuiltms = TimeFrames ( &background, REBUILTFRAMES, true );
+
+	printf ( "%s\n", (char *) glGetString ( GL_RENDERER ) );
+	printf ( "%d systems, %d links, %d in the connection\n",
+			 comp->systems.Size (), comp->links.Size (), LanMonitor::connection.Size () );
+	printf ( "LAN background frame : cached geometry %.2fms, rebuilt each frame %.2fms\n", cachedms, rebuiltms );
+
+	LanMonitor::ResetAll ();
+
+	return TestFinish ();
+
+}
@@ -0,0 +1,392 @@
+// -*- tab-width:4 c-file-style:"cc-mode" -*-
+
+/*
+
+  LAN path test
+
+	Generates LANs at every difficulty and checks each system can be reached
+	from the router, a modem or a radio receiver, that every shortest path
+	walks real links and is as short as a search that scans every link, and
+	that reachable systems come out nearest first. Checks half known links
+	aren't followed and connections still extend a link at a time. Times
+	the indexed search against the scan on a 10,000 system LAN
+
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app/app.h"
+#include "app/globals.h"
+
+#include "game/game.h"
+
+#include "world/world.h"
+#include "world/company/company.h"
+#include "world/computer/lancomputer.h"
+#include "world/computer/lanmonitor.h"
+#include "world/generator/worldgenerator.h"
+#include "world/generator/langenerator.h"
+
+#include "tests/testworld.h"
+
+#include "mmgr.h"
+
+
+#define WORLDSEED       1
+#define LANSPERLEVEL    10
+
+#define BIGSYSTEMS      10000
+#define BIGEXTRALINKS   5000
+#define BIGQUERIES      1000
+#define BIGSCANQUERIES  10
+
+
+// LanMonitor keeps the LAN it extends through protected
+
+class TestLanMonitor : public LanMonitor
+{
+
+public:
+
+	static void Begin ( LanComputer *comp, int router )
+	{
+		ResetAll ();
+		lanComputer = comp;
+		currentlyActive = true;
+		connection.PutDataAtStart ( router );
+		currentSystem = router;
+	}
+
+	static void End ()
+	{
+		ResetAll ();
+		lanComputer = NULL;
+		currentlyActive = false;
+	}
+
+};
+
+
+// The old search - fewest links from one system to another, scanning
+// every link for each system taken off the queue. -1 if there's no way
+
+static int ScanDistance ( LanComputer *comp, int from, int to )
+{
+
+	int numsystems = comp->systems.Size ();
+	int *distance = new int [numsystems];
+	int *queue = new int [numsystems];
+	for ( int i = 0; i < numsystems; ++i ) distance [i] = -1;
+
+	int head = 0, tail = 0;
+	distance [from] = 0;
+	queue [tail++] = from;
+
+	while ( head < tail && distance [to] == -1 ) {
+
+		int current = queue [head++];
+
+		for ( int i = 0; i < comp->links.Size (); ++i ) {
+			if ( !comp->links.ValidIndex (i) ) continue;
+			LanComputerLink *link = comp->links.GetData (i);
+
+			int next = link->from == current ? link->to :
+					   link->to == current ? link->from : -1;
+
+			if ( next != -1 && comp->systems.ValidIndex ( next ) && distance [next] == -1 ) {
+				distance [next] = distance [current] + 1;
+				queue [tail++] = next;
+			}
+		}
+
+	}
+
+	int result = distance [to];
+	delete [] distance;
+	delete [] queue;
+	return result;
+
+}
+
+static bool Linked ( LanComputer *comp, int a, int b )
+{
+
+	for ( int i = 0; i < comp->links.Size (); ++i )
+		if ( comp->links.ValidIndex (i) ) {
+			LanComputerLink *link = comp->links.GetData (i);
+			if ( ( link->from == a && link->to == b ) || ( link->from == b && link->to == a ) )
+				return true;
+		}
+
+	return false;
+
+}
+
+// A path from GetShortestPath starts and ends in the right place,
+// walks along links, and is no longer than the scan finds
+
+static bool CheckPath ( LanComputer *comp, int from, int to, LList <int> *path )
+{
+
+	bool valid = path->Size () > 0 &&
+				 path->GetData (0) == from &&
+				 path->GetData ( path->Size () - 1 ) == to &&
+				 path->Size () - 1 == ScanDistance ( comp, from, to );
+
+	for ( int i = 1; valid && i < path->Size (); ++i )
+		valid = Linked ( comp, path->GetData ( i - 1 ), path->GetData (i) );
+
+	return valid;
+
+}
+
+static int FindSystem ( LanComputer *comp, int TYPE )
+{
+
+	for ( int i = 0; i < comp->systems.Size (); ++i )
+		if ( comp->systems.ValidIndex (i) && comp->systems.GetData (i)->TYPE == TYPE )
+			return i;
+
+	return -1;
+
+}
+
+// Links the player knows both ends of
+
+static bool AwareLink ( LanComputerLink *link )
+{
+
+	return link->visible == LANLINKVISIBLE_AWARE;
+
+}
+
+// Reachable systems come out nearest first - every system the scan can
+// reach, each no further than the one after it
+
+static bool CheckReachable ( LanComputer *comp, int from, LList <int> *reachable )
+{
+
+	int numreachable = 0;
+	for ( int i = 0; i < comp->systems.Size (); ++i )
+		if ( comp->systems.ValidIndex (i) && ScanDistance ( comp, from, i ) != -1 )
+			++numreachable;
+
+	bool valid = reachable->Size () == numreachable && reachable->GetData (0) == from;
+
+	for ( int i = 1; valid && i < reachable->Size (); ++i )
+		valid = ScanDistance ( comp, from, reachable->GetData ( i - 1 ) ) <= ScanDistance ( comp, from, reachable->GetData (i) );
+
+	return valid;
+
+}
+
+// Where the player can come into a LAN - the router, or by dialling a modem or tuning a receiver
+
+static bool IsEntry ( LanComputerSystem *system )
+{
+
+	return system->TYPE == LANSYSTEM_ROUTER ||
+		   system->TYPE == LANSYSTEM_MODEM ||
+		   system->TYPE == LANSYSTEM_RADIORECEIVER;
+
+}
+
+// Every system the generator places is connected by links to a way in
+
+static void CheckGeneratedLANs ()
+{
+
+	int numpaths = 0;
+
+	for ( int level = 0; level <= 4; ++level ) {
+		for ( int n = 0; n < LANSPERLEVEL; ++n ) {
+
+			TestCreateWorld ( WORLDSEED );
+			WorldGenerator::GenerateAll ();
+			srand ( level * 100 + n );
+
+			char *companyname = WorldGenerator::GetRandomCompany ()->name;
+			LanComputer *comp = (LanComputer *) LanGenerator::GenerateLAN ( companyname, level );
+			if ( !TEST_CHECK ( comp != NULL ) ) continue;
+
+			int router = FindSystem ( comp, LANSYSTEM_ROUTER );
+			if ( !TEST_CHECK ( router != -1 ) ) continue;
+
+			if ( level <= 1 )
+				TEST_CHECK ( FindSystem ( comp, LANSYSTEM_MAINSERVER ) != -1 );
+
+			LList <int> reachable;
+			comp->GetReachableSystems ( router, &reachable );
+			TEST_CHECK ( CheckReachable ( comp, router, &reachable ) );
+
+			for ( int i = 0; i < comp->systems.Size (); ++i ) {
+				if ( !comp->systems.ValidIndex (i) ) continue;
+
+				bool found = false;
+
+				for ( int entry = 0; !found && entry < comp->systems.Size (); ++entry ) {
+					if ( !comp->systems.ValidIndex ( entry ) || !IsEntry ( comp->systems.GetData ( entry ) ) ) continue;
+
+					LList <int> path;
+					found = comp->GetShortestPath ( entry, i, &path );
+					if ( found && TEST_CHECK ( CheckPath ( comp, entry, i, &path ) ) )
+						++numpaths;
+				}
+
+				TEST_CHECK ( found );
+			}
+
+		}
+	}
+
+	printf ( "%d shortest paths from a way in checked over %d generated LANs\n", numpaths, 5 * LANSPERLEVEL );
+
+}
+
+// router 0 - hub 1 - lock 2 - terminal 3, with a longer way round 1 - hub 4 - hub 5 - 3,
+// and a switch 6 linked to nothing
+
+static void CheckSmallLAN ()
+{
+
+	TestCreateWorld ( WORLDSEED );
+
+	LanComputer *comp = new LanComputer ();
+	comp->AddLanSystem ( LANSYSTEM_ROUTER, 0, 0 );
+	comp->AddLanSystem ( LANSYSTEM_HUB, 100, 0 );
+	int lock = comp->AddLanSystem ( LANSYSTEM_LOCK, 200, 0 );
+	int terminal = comp->AddLanSystem ( LANSYSTEM_TERMINAL, 300, 0 );
+	comp->AddLanSystem ( LANSYSTEM_HUB, 100, 100 );
+	comp->AddLanSystem ( LANSYSTEM_HUB, 200, 100 );
+	int island = comp->AddLanSystem ( LANSYSTEM_SWITCH, 300, 100 );
+
+	comp->AddLanLink ( 0, 1.0f, 0.5f, 1, 0.0f, 0.5f );
+	comp->AddLanLink ( 1, 1.0f, 0.5f, 2, 0.0f, 0.5f );
+	comp->AddLanLink ( 2, 1.0f, 0.5f, 3, 0.0f, 0.5f );
+	comp->AddLanLink ( 1, 0.5f, 1.0f, 4, 0.5f, 0.0f );
+	comp->AddLanLink ( 4, 1.0f, 0.5f, 5, 0.0f, 0.5f );
+	comp->AddLanLink ( 3, 0.5f, 1.0f, 5, 0.5f, 0.0f );
+
+	for ( int i = 0; i < comp->systems.Size (); ++i )
+		comp->systems.GetData (i)->visible = LANSYSTEMVISIBLE_TYPE;
+	for ( int i = 0; i < comp->links.Size (); ++i )
+		comp->links.GetData (i)->visible = LANLINKVISIBLE_AWARE;
+
+	// Everything but the island, nearest first, following links backwards too
+
+	LList <int> reachable;
+	comp->GetReachableSystems ( terminal, &reachable );
+	TEST_CHECK ( CheckReachable ( comp, terminal, &reachable ) && reachable.Size () == 6 );
+
+	reachable.Empty ();
+	comp->GetReachableSystems ( island, &reachable );
+	TEST_CHECK ( reachable.Size () == 1 && reachable.GetData (0) == island );
+
+	// Links the player only half knows aren't followed
+
+	comp->links.GetData (2)->visible = LANLINKVISIBLE_FROMAWARE;
+	comp->links.GetData (5)->visible = LANLINKVISIBLE_TOAWARE;
+
+	reachable.Empty ();
+	comp->GetReachableSystems ( 0, &reachable, AwareLink );
+	TEST_CHECK ( reachable.Size () == 5 );
+	for ( int i = 0; i < reachable.Size (); ++i )
+		TEST_CHECK ( reachable.GetData (i) != terminal );
+
+	LList <int> path;
+	TEST_CHECK ( !comp->GetShortestPath ( 0, terminal, &path, AwareLink ) && path.Size () == 0 );
+
+	// Connections still extend one link at a time, to a linked system the
+	// player can get into
+
+	comp->links.GetData (2)->visible = LANLINKVISIBLE_AWARE;
+	comp->links.GetData (5)->visible = LANLINKVISIBLE_AWARE;
+	comp->systems.GetData ( lock )->data1 = 1;
+
+	TestLanMonitor::Begin ( comp, 0 );
+
+	LanMonitor::ExtendConnection ( terminal );
+	TEST_CHECK ( LanMonitor::connection.Size () == 1 );
+
+	LanMonitor::ExtendConnection ( 1 );
+	LanMonitor::ExtendConnection ( lock );
+	TEST_CHECK ( LanMonitor::connection.Size () == 2 && LanMonitor::IsInConnection ( 1 ) );
+
+	comp->systems.GetData ( lock )->data1 = 0;
+	LanMonitor::ExtendConnection ( lock );
+	LanMonitor::ExtendConnection ( terminal );
+	TEST_CHECK ( LanMonitor::connection.Size () == 4 && LanMonitor::connection.GetData (3) == terminal );
+
+	TestLanMonitor::End ();
+	delete comp;
+
+}
+
+// A random spanning tree with extra links across it
+
+static void TimeBigLAN ()
+{
+
+	srand ( WORLDSEED );
+
+	LanComputer *comp = new LanComputer ();
+
+	for ( int i = 0; i < BIGSYSTEMS; ++i )
+		comp->AddLanSystem ( LANSYSTEM_HUB, rand () % 1000, rand () % 1000 );
+
+	for ( int i = 1; i < BIGSYSTEMS; ++i )
+		comp->AddLanLink ( rand () % i, 0.5f, 0.5f, i, 0.5f, 0.5f );
+
+	for ( int i = 0; i < BIGEXTRALINKS; ++i )
+		comp->AddLanLink ( rand () % BIGSYSTEMS, 0.5f, 0.5f, rand () % BIGSYSTEMS, 0.5f, 0.5f );
+
+	TestTime start = TestNow ();
+	comp->NumOutEdges ( 0 );							// Builds the index
+	double indexms = TestMilliseconds ( start );
+
+	int from [BIGQUERIES], to [BIGQUERIES], length [BIGQUERIES];
+	for ( int i = 0; i < BIGQUERIES; ++i ) {
+		from [i] = rand () % BIGSYSTEMS;
+		to [i] = rand () % BIGSYSTEMS;
+	}
+
+	start = TestNow ();
+
+	for ( int i = 0; i < BIGQUERIES; ++i ) {
+		LList <int> path;
+		length [i] = comp->GetShortestPath ( from [i], to [i], &path ) ? path.Size () - 1 : -1;
+	}
+
+	double indexedms = TestMilliseconds ( start );
+
+	start = TestNow ();
+
+	int matched = 0;
+	for ( int i = 0; i < BIGSCANQUERIES; ++i )
+		if ( TEST_CHECK ( ScanDistance ( comp, from [i], to [i] ) == length [i] ) )
+			++matched;
+
+	double scanms = TestMilliseconds ( start );
+
+	printf ( "%d systems, %d links : index built in %.2fms\n", BIGSYSTEMS, comp->links.Size (), indexms );
+	printf ( "Shortest path : indexed %.1fus each (x%d), link scan %.1fus each (x%d, %d agree)\n",
+			 indexedms * 1000.0 / BIGQUERIES, BIGQUERIES, scanms * 1000.0 / BIGSCANQUERIES, BIGSCANQUERIES, matched );
+
+	delete comp;
+
+}
+
+int main ()
+{
+
+	TestInitialise ();
+
+	CheckGeneratedLANs ();
+	CheckSmallLAN ();
+	TimeBigLAN ();
+
+	return TestFinish ();
+
+}
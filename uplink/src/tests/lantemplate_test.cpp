@@ -0,0 +1,270 @@
+// -*- tab-width:4 c-file-style:"cc-mode" -*-
+
+/*
+
+  LAN template test
+
+	Loads the same LANs once from their text files and once from packed
+	templates, in worlds generated from the same seed, and checks the
+	saved LanComputers match byte for byte. Times the full LoadLAN both
+	ways, and checks a template is only used while its text is unchanged
+
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app/app.h"
+#include "app/globals.h"
+#include "app/miscutils.h"
+
+#include "game/game.h"
+
+#include "world/world.h"
+#include "world/computer/lancomputer.h"
+#include "world/generator/worldgenerator.h"
+#include "world/generator/langenerator.h"
+#include "world/generator/lantemplate.h"
+
+#include "tests/testworld.h"
+
+#include "mmgr.h"
+
+
+#define NUMLANS         50
+#define WORLDSEED       1
+#define LANSEED         2
+
+
+// uplink/bin/data/lans/sample.txt, with the name and IP made unique per copy
+
+static const char *SAMPLELAN =
+	"NAME        %s Local Area Network %d\n"
+	"COMPANY     %s Company %d\n"
+	"IP          127.432.543.%d\n"
+	"XPOS        73\n"
+	"YPOS        73\n"
+	"\n"
+	"; NUM   SYSTEMTYPE      XPOS    YPOS    SECUR   DATA1   DATA2   DATA3   DATAX\n"
+	"0       ROUTER          7       340     1       -1      -1      -1\n"
+	"1       HUB             87      211     1       -1      -1      -1\n"
+	"2       TERMINAL        147     371     1       -1      -1      -1\n"
+	"3       AUTHENTICATION  144     304     3       4       -1      -1\n"
+	"4       LOCK            230     370     2       1       -1      -1\n"
+	"5       TERMINAL        447     320     1       -1      -1      -1\n"
+	"6       AUTHENTICATION  388     304     3       14      -1      -1\n"
+	"7       HUB             440     213     1       -1      -1      -1\n"
+	"8       MODEM           398     23      1       -1      -1      -1      07764-588892\n"
+	"9       LOCK            323     24      2       1       -1      -1\n"
+	"10      AUTHENTICATION  388     77      3       9       -1      -1\n"
+	"11      TERMINAL        92      79      1       -1      -1      -1\n"
+	"12      AUTHENTICATION  149     77      3       13      -1      -1\n"
+	"13      LOCK            202     143     2       1       -1      -1\n"
+	"14      LOCK            331     202     2       1       -1      -1\n"
+	"15      MAINSERVER      241     231     3       -1      -1      -1\n"
+	".\n"
+	"\n"
+	"; LINK  FROM    FROMX   FROMY   TO  TOX     TOY     SECUR\n"
+	"LINK    0       0.5     0.0     1   0.0     0.5     1\n"
+	"LINK    1       0.5     1.0     2   0.0     0.5     1\n"
+	"LINK    2       0.5     0.0     3   0.5     1.0     1\n"
+	"LINK    2       1.0     0.5     4   0.0     0.5     1\n"
+	"LINK    4       1.0     0.5     5   0.5     1.0     1\n"
+	"LINK    5       0.0     0.5     6   1.0     0.5     1\n"
+	"LINK    5       0.5     0.0     7   0.5     1.0     1\n"
+	"LINK    7       0.5     0.0     8   1.0     0.5     1\n"
+	"LINK    8       0.0     0.5     9   1.0     0.5     1\n"
+	"LINK    8       0.5     1.0     10  0.5     0.0     1\n"
+	"LINK    9       0.0     0.5     11  0.5     0.0     1\n"
+	"LINK    11      1.0     0.5     12  0.0     0.5     1\n"
+	"LINK    11      0.5     1.0     1   0.5     0.0     1\n"
+	"LINK    1       1.0     0.5     13  0.0     0.5     1\n"
+	"LINK    13      1.0     0.5     14  0.5     0.0     1\n"
+	"LINK    7       0.0     0.5     14  1.0     0.5     1\n"
+	"LINK    14      0.5     1.0     15  1.0     0.5     1\n"
+	".\n"
+	"\n"
+	"VALIDSUBNET     8       2\n"
+	"VALIDSUBNET     15      11\n"
+	".\n"
+	"\n"
+	"DATA    2       Some specially placed text\n"
+	"DATA    11      A little bit more placed text\n"
+	".\n";
+
+
+static void SampleLAN ( char *result, size_t resultsize, const char *name, int index )
+{
+
+	UplinkSnprintf ( result, resultsize, SAMPLELAN, name, index, name, index, index );
+
+}
+
+// Writes the text and, if packedname is given, a template packed from that text instead.
+// The template is stamped with the text file as written, so LoadLAN takes it as current
+
+static bool WriteLAN ( char *filename, const char *name, int index, const char *packedname )
+{
+
+	char text [4096];
+	SampleLAN ( text, sizeof ( text ), name, index );
+	if ( !TestWriteFile ( filename, text ) ) return false;
+	if ( !packedname ) return true;
+
+	SampleLAN ( text, sizeof ( text ), packedname, index );
+
+	int size = 0;
+	char *compiled = LanTemplate::Compile ( text, (int) strlen ( text ), &size );
+	if ( !compiled ) return false;
+
+	char textpath [256];
+	char templatepath [256];
+	UplinkSnprintf ( textpath, sizeof ( textpath ), "%s%s", TestPath (), filename );
+	LanTemplate::TemplateFilename ( textpath, templatepath, sizeof ( templatepath ) );
+
+	bool success = LanTemplate::Stamp ( compiled, textpath );
+
+	FILE *file = fopen ( templatepath, "wb" );
+	success = success && file && fwrite ( compiled, 1, size, file ) == (size_t) size;
+	if ( file ) success = ( fclose ( file ) == 0 ) && success;
+
+	delete [] compiled;
+	return success;
+
+}
+
+// The saved form of a computer, in new [] memory
+
+static char *SaveBytes ( UplinkObject *object, int *size )
+{
+
+	FILE *file = tmpfile ();
+	UplinkAssert ( file );
+
+	object->Save ( file );
+	*size = (int) ftell ( file );
+	rewind ( file );
+
+	char *bytes = new char [*size];
+	bool success = fread ( bytes, 1, *size, file ) == (size_t) *size;
+	fclose ( file );
+
+	UplinkAssert ( success );
+	return bytes;
+
+}
+
+// Loads prefix0 to prefixN in a fresh world, returns the time and each saved LAN
+
+static double LoadAll ( const char *prefix, char **saved, int *savedsize )
+{
+
+	TestCreateWorld ( WORLDSEED );
+	WorldGenerator::GenerateAll ();
+	srand ( LANSEED );
+
+	LanComputer *comps [NUMLANS];
+
+	TestTime start = TestNow ();
+
+	for ( int i = 0; i < NUMLANS; ++i ) {
+		char filename [256];
+		UplinkSnprintf ( filename, sizeof ( filename ), "data/testlans/%s%d.txt", prefix, i );
+		comps [i] = (LanComputer *) LanGenerator::LoadLAN ( filename );
+	}
+
+	double milliseconds = TestMilliseconds ( start );
+
+	for ( int i = 0; i < NUMLANS; ++i ) {
+
+		saved [i] = NULL;
+		savedsize [i] = 0;
+
+		if ( TEST_CHECK ( comps [i] != NULL ) ) {
+			TEST_CHECK ( comps [i]->systems.NumUsed () == 16 );
+			TEST_CHECK ( comps [i]->links.NumUsed () == 17 );
+			saved [i] = SaveBytes ( comps [i], &savedsize [i] );
+		}
+
+	}
+
+	return milliseconds;
+
+}
+
+static char *LoadedName ( char *filename )
+{
+
+	Computer *comp = LanGenerator::LoadLAN ( filename );
+	return comp ? comp->name : (char *) "";
+
+}
+
+int main ()
+{
+
+	TestInitialise ();
+
+	// Outside data/lans/, which world generation loads everything from
+
+	char directory [256];
+	UplinkSnprintf ( directory, sizeof ( directory ), "%sdata/testlans", TestPath () );
+	MakeDirectory ( directory );
+
+	//
+	// The same LANs as text only, and as text with a current template
+
+	for ( int i = 0; i < NUMLANS; ++i ) {
+
+		char filename [256];
+		UplinkSnprintf ( filename, sizeof ( filename ), "data/testlans/text%d.txt", i );
+		TEST_CHECK ( WriteLAN ( filename, "Sample", i, NULL ) );
+
+		UplinkSnprintf ( filename, sizeof ( filename ), "data/testlans/packed%d.txt", i );
+		TEST_CHECK ( WriteLAN ( filename, "Sample", i, "Sample" ) );
+
+	}
+
+	char *textsaved [NUMLANS], *packedsaved [NUMLANS];
+	int textsize [NUMLANS], packedsize [NUMLANS];
+
+	double textms = LoadAll ( "text", textsaved, textsize );
+	double packedms = LoadAll ( "packed", packedsaved, packedsize );
+
+	int identical = 0;
+
+	for ( int i = 0; i < NUMLANS; ++i ) {
+
+		if ( textsaved [i] && packedsaved [i] &&
+			 TEST_CHECK ( textsize [i] == packedsize [i] ) &&
+			 TEST_CHECK ( memcmp ( textsaved [i], packedsaved [i], textsize [i] ) == 0 ) )
+			++identical;
+
+		delete [] textsaved [i];
+		delete [] packedsaved [i];
+
+	}
+
+	printf ( "%d of %d LANs identical from text and template\n", identical, NUMLANS );
+	printf ( "LoadLAN x%d : text %.2fms (%.1fus each), template %.2fms (%.1fus each)\n",
+			 NUMLANS, textms, textms * 1000.0 / NUMLANS, packedms, packedms * 1000.0 / NUMLANS );
+
+	//
+	// A template stamped with its text is used, and is ignored once the text changes
+
+	TestCreateWorld ( WORLDSEED );
+	WorldGenerator::GenerateAll ();
+
+	TEST_CHECK ( WriteLAN ( "data/testlans/current.txt", "Text", NUMLANS, "Packed" ) );
+	TEST_CHECK ( strncmp ( LoadedName ( "data/testlans/current.txt" ), "Packed", 6 ) == 0 );
+
+	TEST_CHECK ( WriteLAN ( "data/testlans/stale.txt", "Text", NUMLANS + 1, "Packed" ) );
+	char edited [4096];
+	SampleLAN ( edited, sizeof ( edited ), "Edited text", NUMLANS + 1 );
+	TEST_CHECK ( TestWriteFile ( "data/testlans/stale.txt", edited ) );
+	TEST_CHECK ( strncmp ( LoadedName ( "data/testlans/stale.txt" ), "Edited text", 11 ) == 0 );
+
+	return TestFinish ();
+
+}
@@ -0,0 +1,636 @@
+// -*- tab-width:4 c-file-style:"cc-mode" -*-
+
+/*
+
+  Log bank test
+
+	Plays the same seeded run on a generated world twice - bounce chains
+	laid across its computers, then traces at random ratings mixed with
+	every way the game changes logs : deleting them at each log deleter
+	version, overwriting, modifying, undeleting, covering up, deleting
+	the lot from the console, expiring old logs and adding new ones.
+	Traces once through the bounce index and once scanning every log
+	the way TraceLog used to, and checks both runs find the same
+	sources, restore the same logs and mark the same security breaches.
+	Times a trace both ways on a bank of 100,000 logs
+
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app/app.h"
+#include "app/globals.h"
+
+#include "game/game.h"
+#include "game/data/data.h"
+
+#include "world/world.h"
+#include "world/vlocation.h"
+#include "world/company/company.h"
+#include "world/computer/computer.h"
+#include "world/computer/logbank.h"
+#include "world/generator/worldgenerator.h"
+
+#include "tests/testworld.h"
+
+#include "mmgr.h"
+
+
+#define WORLDSEED       1
+#define NUMRUNS         8
+
+#define NUMCOMPUTERS    24
+#define NUMCHAINS       300
+#define NUMNOISE        3000
+#define NUMSTEPS        3000
+#define MAXHOPS         6
+#define LOGSPREAD       60 * 24 * 60            // Minutes the logs are spread over, past the time logs expire
+
+#define BIGLOGS         100000
+#define BIGTARGETS      100
+#define BIGQUERIES      1000
+#define BIGSCANQUERIES  20
+
+
+// The old trace - every log in the bank looked at in turn
+
+static char *ScanTraceLog ( LogBank *bank, char *to_ip, char *logbank_ip, Date *date, int uplinkrating, LList <char *> *visited )
+{
+
+	for ( int v = 0; v + 1 < visited->Size (); v += 2 )
+		if ( strcmp ( visited->GetData (v), to_ip ) == 0 &&
+			 strcmp ( visited->GetData (v + 1), logbank_ip ) == 0 )
+			return NULL;
+
+	visited->PutData ( to_ip );
+	visited->PutData ( logbank_ip );
+
+	Computer *comp_local = game->GetWorld ()->GetVLocation ( logbank_ip )->GetComputer ();
+	Company *company_local = game->GetWorld ()->GetCompany ( comp_local->companyname );
+
+	Date upperdate;
+	Date lowerdate;
+
+	upperdate.SetDate ( date );
+	lowerdate.SetDate ( date );
+
+	upperdate.AdvanceSecond ( 10 );
+	lowerdate.AdvanceSecond ( -10 );
+
+	for ( int i = 0; i < bank->logs.Size (); ++i ) {
+
+		if ( bank->logs.ValidIndex (i) ) {
+
+			AccessLog *al = bank->logs.GetData (i);
+
+			if ( ( ( al->TYPE == LOG_TYPE_DELETED && uplinkrating >= MINREQUIREDRATING_UNDELETELOGLEVEL1 ) ||
+				   ( al->TYPE != LOG_TYPE_DELETED && bank->LogModified (i) && uplinkrating >= MINREQUIREDRATING_UNDELETELOGLEVEL3 ) ) &&
+				 bank->internallogs.ValidIndex (i) && bank->internallogs.GetData (i) )
+				al = bank->RecoverLog (i);
+
+			if ( al->date.After ( &lowerdate ) &&
+				 al->date.Before ( &upperdate ) ) {
+
+				if ( al->TYPE == LOG_TYPE_BOUNCEBEGIN &&
+					 al->data1 && strcmp ( al->data1, to_ip ) == 0 )
+					return logbank_ip;
+
+				if ( al->TYPE == LOG_TYPE_BOUNCE &&
+					 al->data1 && strcmp ( al->data1, to_ip ) == 0 ) {
+
+					VLocation *vl = game->GetWorld ()->GetVLocation ( al->fromip );
+					Computer *comp = vl ? vl->GetComputer () : NULL;
+
+					if ( comp ) {
+
+						bool isbank = comp_local->TYPE == COMPUTER_TYPE_PUBLICBANKSERVER;
+						bool isgov  = company_local->TYPE == COMPANYTYPE_GOVERNMENT;
+
+						if ( (!isbank || uplinkrating >= MINREQUIREDRATING_HACKBANKSERVER) &&
+							 (!isgov  || uplinkrating >= MINREQUIREDRATING_HACKGOVERNMENTCOMPUTER) )
+							return ScanTraceLog ( &comp->logbank, logbank_ip, comp->ip, date, uplinkrating, visited );
+
+					}
+
+				}
+
+			}
+
+		}
+
+	}
+
+	if ( comp_local->TYPE == COMPUTER_TYPE_PERSONALCOMPUTER )
+		return logbank_ip;
+
+	return NULL;
+
+}
+
+static char *Trace ( Computer *comp, char *to_ip, Date *date, int uplinkrating, bool useindex )
+{
+
+	if ( useindex )
+		return comp->logbank.TraceLog ( to_ip, comp->ip, date, uplinkrating );
+
+	LList <char *> visited;
+	return ScanTraceLog ( &comp->logbank, to_ip, comp->ip, date, uplinkrating, &visited );
+
+}
+
+static int Random ( unsigned int *state, int range )
+{
+
+	*state = *state * 1103515245 + 12345;
+	return (int) ( ( *state >> 8 ) % (unsigned int) range );
+
+}
+
+
+// One run of the scenario - what it traced, and what it left behind
+
+struct RunResult
+{
+
+	char traces [NUMSTEPS][SIZE_VLOCATION_IP];
+	int numtraces;
+	int numfound;
+	bool breached [NUMCOMPUTERS];
+	char *saved;
+	long savedsize;
+
+};
+
+struct Chain
+{
+
+	Computer *hops [MAXHOPS + 1];
+	int numhops;
+	Date date;
+
+};
+
+
+static Computer *computers [NUMCOMPUTERS];
+static Chain chains [NUMCHAINS * 2];
+static int numchains = 0;
+
+
+static void ChooseComputers ( unsigned int *random )
+{
+
+	DArray <Computer *> *all = game->GetWorld ()->computers.ConvertToDArray ();
+	int numchosen = 0;
+
+	while ( numchosen < NUMCOMPUTERS ) {
+
+		Computer *comp = all->GetData ( Random ( random, all->Size () ) );
+		bool chosen = false;
+		for ( int i = 0; i < numchosen; ++i )
+			if ( computers [i] == comp ) chosen = true;
+
+		if ( !chosen && game->GetWorld ()->GetVLocation ( comp->ip ) &&
+			 game->GetWorld ()->GetCompany ( comp->companyname ) )
+			computers [numchosen++] = comp;
+
+	}
+
+	delete all;
+
+	// Some of them at the ends of trails, where a trace gets someone
+
+	for ( int i = 0; i < NUMCOMPUTERS; i += 4 )
+		computers [i]->SetTYPE ( COMPUTER_TYPE_PERSONALCOMPUTER );
+
+}
+
+static AccessLog *NewLog ( Date *date, char *fromip, int TYPE, char *data1 )
+{
+
+	AccessLog *al = new AccessLog ();
+	al->SetProperties ( date, fromip, "Someone", LOG_SUSPICIOUS, TYPE );
+	if ( data1 ) al->SetData1 ( data1 );
+	return al;
+
+}
+
+// A bounced connection from hops [0] to hops [numhops - 1], with each
+// hop's log a few seconds either side of the connection
+
+static void AddChain ( Date *around, unsigned int *random )
+{
+
+	Chain *chain = &chains [numchains++];
+	chain->numhops = 2 + Random ( random, MAXHOPS - 1 );
+
+	for ( int h = 0; h < chain->numhops; ++h ) {
+		bool used;
+		do {
+			chain->hops [h] = computers [Random ( random, NUMCOMPUTERS )];
+			used = false;
+			for ( int p = 0; p < h; ++p )
+				if ( chain->hops [p] == chain->hops [h] ) used = true;
+		} while ( used );
+	}
+
+	chain->date.SetDate ( around );
+	chain->date.AdvanceMinute ( -Random ( random, LOGSPREAD ) );
+	chain->date.AdvanceSecond ( Random ( random, 60 ) );
+
+	for ( int h = 0; h + 1 < chain->numhops; ++h ) {
+
+		Date logdate;
+		logdate.SetDate ( &chain->date );
+		logdate.AdvanceSecond ( Random ( random, 25 ) - 12 );
+
+		Computer *comp = chain->hops [h];
+		char *nextip = chain->hops [h + 1]->ip;
+
+		if ( h == 0 )	comp->logbank.AddLog ( NewLog ( &logdate, comp->ip, LOG_TYPE_BOUNCEBEGIN, nextip ) );
+		else			comp->logbank.AddLog ( NewLog ( &logdate, chain->hops [h - 1]->ip, LOG_TYPE_BOUNCE, nextip ) );
+
+	}
+
+}
+
+static void AddNoise ( Date *around, unsigned int *random )
+{
+
+	Computer *comp = computers [Random ( random, NUMCOMPUTERS )];
+	Computer *other = computers [Random ( random, NUMCOMPUTERS )];
+
+	Date logdate;
+	logdate.SetDate ( around );
+	logdate.AdvanceMinute ( -Random ( random, LOGSPREAD ) );
+
+	int TYPE = Random ( random, 4 );
+
+	if ( TYPE == 0 )		comp->logbank.AddLog ( NewLog ( &logdate, other->ip, LOG_TYPE_BOUNCE, computers [Random ( random, NUMCOMPUTERS )]->ip ) );
+	else if ( TYPE == 1 )	comp->logbank.AddLog ( NewLog ( &logdate, other->ip, LOG_TYPE_CONNECTIONOPENED, NULL ) );
+	else if ( TYPE == 2 )	comp->logbank.AddLog ( NewLog ( &logdate, other->ip, LOG_TYPE_TEXT, "Accessed File" ) );
+	else					comp->logbank.AddLog ( NewLog ( &logdate, other->ip, LOG_TYPE_BOUNCEBEGIN, computers [Random ( random, NUMCOMPUTERS )]->ip ) );
+
+}
+
+static int RandomLog ( LogBank *bank, unsigned int *random )
+{
+
+	if ( bank->logs.Size () == 0 ) return -1;
+	int index = Random ( random, bank->logs.Size () );
+	return bank->logs.ValidIndex ( index ) ? index : -1;
+
+}
+
+// A deleted marker in place of the log, as log deleters 1 and 2, and an agent covering up
+
+static void DeleteLog ( LogBank *bank, int index )
+{
+
+	Date logdate;
+	logdate.SetDate ( &bank->logs.GetData (index)->date );
+
+	delete bank->logs.GetData (index);
+	bank->logs.RemoveData (index);
+
+	AccessLog *al = new AccessLog ();
+	al->SetProperties ( &logdate, "Unknown", " ", LOG_NOTSUSPICIOUS, LOG_TYPE_DELETED );
+	bank->logs.PutData ( al, index );
+
+	bank->LogChanged ( index );
+
+}
+
+// Another log copied over it at the same date, as log deleter 3
+
+static void OverwriteLog ( LogBank *bank, int index, int copyindex )
+{
+
+	Date logdate;
+	logdate.SetDate ( &bank->logs.GetData (index)->date );
+
+	AccessLog *al = new AccessLog ();
+	al->SetProperties ( bank->logs.GetData ( copyindex ) );
+	al->date.SetDate ( &logdate );
+	al->SetSuspicious ( LOG_NOTSUSPICIOUS );
+
+	delete bank->logs.GetData (index);
+	bank->logs.RemoveData (index);
+	bank->logs.PutData ( al, index );
+
+	bank->LogChanged ( index );
+
+}
+
+// Removed, and every log after it shifted up one, as log deleter 4
+
+static void RemoveLog ( LogBank *bank, int index )
+{
+
+	delete bank->logs.GetData (index);
+	bank->logs.RemoveData (index);
+	bank->LogChanged ( index );
+
+	for ( int i = index; i < bank->logs.Size () - 1; ++i ) {
+
+		if ( bank->logs.ValidIndex ( i + 1 ) ) {
+
+			bank->logs.PutData ( bank->logs.GetData ( i + 1 ), i );
+			bank->logs.RemoveData ( i + 1 );
+
+			if ( bank->internallogs.ValidIndex ( i + 1 ) ) {
+				bank->internallogs.PutData ( bank->internallogs.GetData ( i + 1 ), i );
+				bank->internallogs.RemoveData ( i + 1 );
+			}
+
+			bank->LogChanged ( i );
+
+		}
+
+	}
+
+	bank->logs.SetSize ( bank->logs.Size () - 1 );
+	bank->internallogs.SetSize ( bank->logs.Size () );
+
+}
+
+// Changed, and the change copied to the internal log, as the log modifier
+
+static void ModifyLog ( LogBank *bank, int index, int TYPE, char *fromip, char *data1 )
+{
+
+	AccessLog *log = bank->logs.GetData (index);
+	log->SetTYPE ( TYPE );
+	log->SetFromIP ( fromip );
+	log->SetData1 ( data1 );
+
+	if ( bank->internallogs.ValidIndex (index) )
+		bank->internallogs.GetData (index)->SetProperties ( log );
+	else {
+		AccessLog *internalcopy = new AccessLog ();
+		internalcopy->SetProperties ( log );
+		bank->internallogs.PutData ( internalcopy, index );
+	}
+
+	bank->LogChanged ( index );
+
+}
+
+// Put back from the internal log, as the log undeleter
+
+static void UnDeleteLog ( LogBank *bank, int index )
+{
+
+	if ( !bank->internallogs.ValidIndex (index) ) return;
+
+	bank->logs.GetData (index)->SetProperties ( bank->internallogs.GetData (index) );
+	bank->LogChanged ( index );
+
+}
+
+// Every log replaced with a deleted marker, as the console's DELETEALL
+
+static void DeleteAllLogs ( LogBank *bank )
+{
+
+	for ( int i = 0; i < bank->logs.Size (); ++i ) {
+
+		if ( bank->logs.ValidIndex (i) ) {
+
+			delete bank->logs.GetData (i);
+			bank->logs.RemoveData (i);
+
+			AccessLog *al = new AccessLog ();
+			al->SetProperties ( &game->GetWorld ()->date, "Unknown", " ", LOG_NOTSUSPICIOUS, LOG_TYPE_DELETED );
+			bank->logs.PutData ( al, i );
+
+		}
+
+	}
+
+	bank->InvalidateIndex ();
+
+}
+
+static void SaveLogBanks ( RunResult *result )
+{
+
+	FILE *file = tmpfile ();
+	UplinkAssert ( file );
+
+	for ( int i = 0; i < NUMCOMPUTERS; ++i )
+		computers [i]->logbank.Save ( file );
+
+	result->savedsize = ftell ( file );
+	result->saved = new char [result->savedsize + 1];
+	rewind ( file );
+	result->savedsize = (long) fread ( result->saved, 1, result->savedsize, file );
+	fclose ( file );
+
+}
+
+static void Run ( unsigned int seed, bool useindex, RunResult *result )
+{
+
+	TestCreateWorld ( WORLDSEED );
+	WorldGenerator::GenerateAll ();
+
+	unsigned int random = seed;
+	Date *now = &game->GetWorld ()->date;
+
+	ChooseComputers ( &random );
+	numchains = 0;
+
+	for ( int i = 0; i < NUMCHAINS; ++i )
+		AddChain ( now, &random );
+	for ( int i = 0; i < NUMNOISE; ++i )
+		AddNoise ( now, &random );
+
+	result->numtraces = 0;
+	result->numfound = 0;
+
+	for ( int step = 0; step < NUMSTEPS; ++step ) {
+
+		int action = Random ( &random, 100 );
+		LogBank *bank = &computers [Random ( &random, NUMCOMPUTERS )]->logbank;
+		int index = RandomLog ( bank, &random );
+
+		if ( action < 40 ) {
+
+			// Trace a connection from its target, near the time it was made
+
+			Chain *chain = &chains [Random ( &random, numchains )];
+			Date date;
+			date.SetDate ( &chain->date );
+			date.AdvanceSecond ( Random ( &random, 7 ) - 3 );
+			int uplinkrating = Random ( &random, 17 );
+
+			char *found = Trace ( chain->hops [chain->numhops - 2], chain->hops [chain->numhops - 1]->ip,
+								  &date, uplinkrating, useindex );
+
+			UplinkStrncpy ( result->traces [result->numtraces], found ? found : "", SIZE_VLOCATION_IP );
+			++result->numtraces;
+			if ( found ) ++result->numfound;
+
+		}
+		else if ( index == -1 )		continue;
+		else if ( action < 55 )		DeleteLog ( bank, index );
+		else if ( action < 63 ) {
+			int copyindex = RandomLog ( bank, &random );
+			if ( copyindex != -1 ) OverwriteLog ( bank, index, copyindex );
+		}
+		else if ( action < 68 )		RemoveLog ( bank, index );
+		else if ( action < 78 )		ModifyLog ( bank, index, Random ( &random, 2 ) ? LOG_TYPE_BOUNCE : LOG_TYPE_TEXT,
+												computers [Random ( &random, NUMCOMPUTERS )]->ip,
+												computers [Random ( &random, NUMCOMPUTERS )]->ip );
+		else if ( action < 86 )		UnDeleteLog ( bank, index );
+		else if ( action < 87 )		DeleteAllLogs ( bank );
+		else if ( action < 90 ) {
+			now->AdvanceHour ( 12 );
+			computers [Random ( &random, NUMCOMPUTERS )]->ManageOldLogs ();
+		}
+		else if ( numchains < NUMCHAINS * 2 )
+			AddChain ( now, &random );
+
+	}
+
+	for ( int i = 0; i < NUMCOMPUTERS; ++i )
+		result->breached [i] = game->GetWorld ()->securitybreaches.GetData ( computers [i]->name ) != NULL;
+
+	SaveLogBanks ( result );
+
+}
+
+static bool SameRuns ( RunResult *a, RunResult *b )
+{
+
+	if ( a->numtraces != b->numtraces || a->savedsize != b->savedsize ) return false;
+
+	for ( int i = 0; i < a->numtraces; ++i )
+		if ( strcmp ( a->traces [i], b->traces [i] ) != 0 ) return false;
+
+	for ( int i = 0; i < NUMCOMPUTERS; ++i )
+		if ( a->breached [i] != b->breached [i] ) return false;
+
+	return memcmp ( a->saved, b->saved, a->savedsize ) == 0;
+
+}
+
+static void CheckRuns ()
+{
+
+	RunResult *indexed = new RunResult;
+	RunResult *scanned = new RunResult;
+
+	int numtraces = 0, numfound = 0, numbreached = 0;
+
+	for ( unsigned int seed = 1; seed <= NUMRUNS; ++seed ) {
+
+		Run ( seed, true, indexed );
+		Run ( seed, false, scanned );
+
+		TEST_CHECK ( SameRuns ( indexed, scanned ) );
+
+		numtraces += indexed->numtraces;
+		numfound += indexed->numfound;
+		for ( int i = 0; i < NUMCOMPUTERS; ++i )
+			if ( indexed->breached [i] ) ++numbreached;
+
+		delete [] indexed->saved;
+		delete [] scanned->saved;
+
+	}
+
+	// The runs are only worth comparing if traces find people and restore logs
+
+	TEST_CHECK ( numfound > 0 && numfound < numtraces );
+	TEST_CHECK ( numbreached > 0 );
+
+	printf ( "%d runs : %d traces matched the scan, %d found a source, %d computers breached\n",
+			 NUMRUNS, numtraces, numfound, numbreached );
+
+	delete indexed;
+	delete scanned;
+
+}
+
+// One bank of logs a few seconds apart, a tenth of them bounces to a
+// hundred targets, each bounced on from a personal computer
+
+static void TimeBigBank ()
+{
+
+	TestCreateWorld ( WORLDSEED );
+	WorldGenerator::GenerateAll ();
+
+	unsigned int random = WORLDSEED;
+	ChooseComputers ( &random );
+
+	Computer *comp = computers [1];
+	Computer *source = computers [0];							// A personal computer, so every trace ends there
+
+	Date logdate;
+	logdate.SetDate ( &game->GetWorld ()->date );
+
+	int numbounces = 0;
+	int *bounceindex = new int [BIGLOGS];
+
+	for ( int i = 0; i < BIGLOGS; ++i ) {
+
+		logdate.AdvanceSecond ( 1 + Random ( &random, 5 ) );
+
+		if ( Random ( &random, 10 ) == 0 ) {
+			char target [SIZE_VLOCATION_IP];
+			UplinkSnprintf ( target, sizeof ( target ), "%d.%d.%d.%d", 200, 1, 1, Random ( &random, BIGTARGETS ) );
+			bounceindex [numbounces++] = comp->logbank.logs.Size ();
+			comp->logbank.AddLog ( NewLog ( &logdate, source->ip, LOG_TYPE_BOUNCE, target ) );
+		}
+		else
+			comp->logbank.AddLog ( NewLog ( &logdate, computers [3]->ip, LOG_TYPE_TEXT, "Accessed File" ) );
+
+	}
+
+	TestTime start = TestNow ();
+	comp->logbank.TraceLog ( "0.0.0.0", comp->ip, &logdate, 0 );			// Builds the index
+	double buildms = TestMilliseconds ( start );
+
+	int query [BIGQUERIES];
+	char *found [BIGQUERIES];
+	for ( int i = 0; i < BIGQUERIES; ++i )
+		query [i] = bounceindex [Random ( &random, numbounces )];
+
+	start = TestNow ();
+	for ( int i = 0; i < BIGQUERIES; ++i ) {
+		AccessLog *al = comp->logbank.logs.GetData ( query [i] );
+		found [i] = comp->logbank.TraceLog ( al->data1, comp->ip, &al->date, 0 );
+	}
+	double indexms = TestMilliseconds ( start );
+
+	int matched = 0;
+	start = TestNow ();
+	for ( int i = 0; i < BIGSCANQUERIES; ++i ) {
+		AccessLog *al = comp->logbank.logs.GetData ( query [i] );
+		if ( TEST_CHECK ( Trace ( comp, al->data1, &al->date, 0, false ) == found [i] ) ) ++matched;
+	}
+	double scanms = TestMilliseconds ( start );
+
+	printf ( "%d logs, %d bounces : index built in %.2fms\n", comp->logbank.logs.Size (), numbounces, buildms );
+	printf ( "Trace : indexed %.1fus each (x%d), log scan %.1fus each (x%d, %d agree)\n",
+			 indexms * 1000.0 / BIGQUERIES, BIGQUERIES, scanms * 1000.0 / BIGSCANQUERIES, BIGSCANQUERIES, matched );
+
+	delete [] bounceindex;
+
+}
+
+int main ()
+{
+
+	TestInitialise ();
+
+	CheckRuns ();
+	TimeBigBank ();
+
+	return TestFinish ();
+
+}
@@ -0,0 +1,217 @@
+// -*- tab-width:4 c-file-style:"cc-mode" -*-
+
+/*
+
+  Search index test
+
+	Indexes 50,000 made up computer names and types filters into it a
+	keystroke at a time, backing off and starting again. Checks every
+	result list against lowercasing each name and using strstr, the way
+	the links screen used to filter, and times a keystroke both ways
+
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app/app.h"
+#include "app/globals.h"
+#include "app/miscutils.h"
+
+#include "interface/searchindex.h"
+
+#include "tests/testworld.h"
+
+#include "mmgr.h"
+
+
+#define NUMITEMS        50000
+#define NUMRANDOM       200
+
+
+static const char *FIRSTWORDS [] = { "Alpha", "Border", "Crest", "Delta", "Eastern", "First", "Global", "High",
+									 "International", "Joint", "Kingdom", "Lunar", "Metro", "North", "Orbital", "Pacific" };
+
+static const char *SECONDWORDS [] = { "Systems", "Holdings", "Networks", "Bank", "Labs", "Group", "Trading", "Media",
+									  "Software", "Research", "Insurance", "Security" };
+
+static const char *THIRDWORDS [] = { "Internal Services Machine", "Public Access Server", "File Server",
+									 "Local Area Network", "Mainframe", "Central Mainframe", "Access Terminal" };
+
+#define NUMWORDS(words)     ( (int) ( sizeof(words) / sizeof(words [0]) ) )
+
+
+// Typed a keystroke at a time - words, part words, numbers, other
+// characters, the same text in other cases, and things nothing matches
+
+static const char *TYPED [] = {
+	"international bank", "GLOBAL", "Mainframe", "ank s", "server 1", "4 ", "n-", "zzz",
+	"labs public access", "metro media local", "Crest Security 49", "  ", "e", "xq", NULL
+};
+
+
+static char names [NUMITEMS][128];
+static int *expected = NULL;
+
+
+// The first length characters of text
+
+static void Prefix ( char *result, const char *text, int length )
+{
+
+	memcpy ( result, text, length );
+	result [length] = '\0';
+
+}
+
+// The old links screen filter
+
+static int ScanFilter ( const char *filter, int *matches )
+{
+
+	int nummatches = 0;
+
+	if ( !filter || !filter [0] ) {
+		for ( int i = 0; i < NUMITEMS; ++i ) matches [nummatches++] = i;
+		return nummatches;
+	}
+
+	char *lowercasefilter = LowerCaseString ( filter );
+
+	for ( int i = 0; i < NUMITEMS; ++i ) {
+		char *lowercasename = LowerCaseString ( names [i] );
+		if ( strstr ( lowercasename, lowercasefilter ) ) matches [nummatches++] = i;
+		delete [] lowercasename;
+	}
+
+	delete [] lowercasefilter;
+	return nummatches;
+
+}
+
+static bool SameResults ( SearchIndex *index, char *filter )
+{
+
+	int numexpected = ScanFilter ( filter, expected );
+	if ( index->NumResults () != numexpected ) return false;
+
+	for ( int i = 0; i < numexpected; ++i )
+		if ( index->GetResult (i) != expected [i] ) return false;
+
+	return true;
+
+}
+
+// Types text into the filter, then deletes it again, checking each step
+
+static int TypeAndCheck ( SearchIndex *index, const char *text )
+{
+
+	char filter [128];
+	int length = (int) strlen ( text );
+	int numchecked = 0;
+
+	for ( int i = 0; i <= length; ++i ) {
+		Prefix ( filter, text, i );
+		index->Filter ( filter );
+		if ( TEST_CHECK ( SameResults ( index, filter ) ) ) ++numchecked;
+	}
+
+	for ( int i = length - 1; i >= 0; --i ) {
+		Prefix ( filter, text, i );
+		index->Filter ( filter );
+		if ( TEST_CHECK ( SameResults ( index, filter ) ) ) ++numchecked;
+	}
+
+	return numchecked;
+
+}
+
+int main ()
+{
+
+	TestInitialise ();
+
+	srand ( 1 );
+
+	for ( int i = 0; i < NUMITEMS; ++i )
+		UplinkSnprintf ( names [i], sizeof ( names [i] ), "%s %s %s %d",
+						 FIRSTWORDS [rand () % NUMWORDS ( FIRSTWORDS )],
+						 SECONDWORDS [rand () % NUMWORDS ( SECONDWORDS )],
+						 THIRDWORDS [rand () % NUMWORDS ( THIRDWORDS )],
+						 rand () % 1000 );
+
+	expected = new int [NUMITEMS];
+
+	SearchIndex index;
+
+	TestTime start = TestNow ();
+	for ( int i = 0; i < NUMITEMS; ++i )
+		index.AddItem ( names [i] );
+	index.Filter ( "abc" );								// Builds the trigrams
+	double buildms = TestMilliseconds ( start );
+
+	//
+	// Typed filters, and random slices of the names
+
+	int numchecked = 0;
+
+	for ( int i = 0; TYPED [i]; ++i )
+		numchecked += TypeAndCheck ( &index, TYPED [i] );
+
+	for ( int i = 0; i < NUMRANDOM; ++i ) {
+		char slice [128];
+		char *name = names [rand () % NUMITEMS];
+		int length = (int) strlen ( name );
+		int from = rand () % length;
+		Prefix ( slice, name + from, 1 + rand () % ( length - from ) );
+		index.Filter ( slice );
+		if ( TEST_CHECK ( SameResults ( &index, slice ) ) ) ++numchecked;
+	}
+
+	// Items added after a filter are found by the next one
+
+	index.Filter ( "unique" );
+	TEST_CHECK ( index.NumResults () == 0 );
+	int added = index.AddItem ( "A Unique Name" );
+	index.Filter ( "unique" );
+	TEST_CHECK ( index.NumResults () == 1 && index.GetResult (0) == added );
+
+	printf ( "%d filters matched the scan over %d names\n", numchecked, NUMITEMS );
+
+	//
+	// A keystroke at a time, both ways
+
+	index.Empty ();
+	for ( int i = 0; i < NUMITEMS; ++i )
+		index.AddItem ( names [i] );
+	index.Filter ( NULL );
+
+	const char *typed = "international bank";
+	int numkeys = (int) strlen ( typed );
+	char filter [128];
+
+	start = TestNow ();
+	for ( int i = 1; i <= numkeys; ++i ) {
+		Prefix ( filter, typed, i );
+		index.Filter ( filter );
+	}
+	double indexms = TestMilliseconds ( start );
+
+	start = TestNow ();
+	for ( int i = 1; i <= numkeys; ++i ) {
+		Prefix ( filter, typed, i );
+		ScanFilter ( filter, expected );
+	}
+	double scanms = TestMilliseconds ( start );
+
+	printf ( "Index of %d names built in %.2fms\n", NUMITEMS, buildms );
+	printf ( "Typing \"%s\" : index %.3fms a keystroke, lowercase and strstr %.3fms a keystroke\n",
+			 typed, indexms / numkeys, scanms / numkeys );
+
+	delete [] expected;
+
+	return TestFinish ();
+
+}
@@ -0,0 +1,447 @@
+// -*- tab-width:4 c-file-style:"cc-mode" -*-
+
+/*
+
+  Security breach test
+
+	Makes, blames, deletes, restores and undeletes suspicious logs on a
+	generated world's computers the ways the game does, sweeping for
+	security breaches every so often, and checks every computer with
+	something for the sweep is marked for it as soon as its logs change.
+	Plays the same run with the old sweep of every computer and checks
+	both leave every log the same. Times a sweep both ways over 5,000
+	computers
+
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app/app.h"
+#include "app/globals.h"
+
+#include "game/game.h"
+#include "game/data/data.h"
+
+#include "world/world.h"
+#include "world/person.h"
+#include "world/computer/computer.h"
+#include "world/computer/logbank.h"
+#include "world/generator/worldgenerator.h"
+#include "world/scheduler/notificationevent.h"
+
+#include "tests/testworld.h"
+
+#include "mmgr.h"
+
+
+#define WORLDSEED       1
+#define NUMSTEPS        4000
+#define SWEEPSTEPS      200                         // Log changes between sweeps
+
+#define BIGCOMPUTERS    5000
+#define BIGLOGS         20                          // Ordinary logs on each computer
+#define BIGBREACHED     10                          // Computers with a suspicious log
+#define BIGSWEEPS       3                           // Noticed, then investigated, then nothing left
+
+
+// Every computer's logs, once a run is over
+
+struct LogsState
+{
+
+	char *saved;
+	long savedsize;
+
+};
+
+
+static unsigned int randomstate = WORLDSEED;		// Apart from rand (), which the sweeps' consequences use
+static DArray <Computer *> *computers = NULL;
+static DArray <Person *> *hackers = NULL;			// Anyone but the player, to blame logs on
+
+
+static int Random ( int range )
+{
+
+	randomstate = randomstate * 1103515245 + 12345;
+	return (int) ( ( randomstate >> 8 ) % (unsigned int) range );
+
+}
+
+static void FindComputers ()
+{
+
+	delete computers;
+	computers = new DArray <Computer *> ();
+
+	DArray <Computer *> *all = game->GetWorld ()->computers.ConvertToDArray ();
+	for ( int i = 0; i < all->Size (); ++i )
+		if ( all->ValidIndex (i) )
+			computers->PutData ( all->GetData (i) );
+	delete all;
+
+	delete hackers;
+	hackers = new DArray <Person *> ();
+
+	DArray <Person *> *people = game->GetWorld ()->people.ConvertToDArray ();
+	for ( int i = 0; i < people->Size (); ++i )
+		if ( people->ValidIndex (i) && strcmp ( people->GetData (i)->name, "PLAYER" ) != 0 )
+			hackers->PutData ( people->GetData (i) );
+	delete people;
+
+}
+
+static void SaveLogs ( LogsState *state )
+{
+
+	FILE *file = tmpfile ();
+	UplinkAssert ( file );
+
+	for ( int i = 0; i < computers->Size (); ++i )
+		computers->GetData (i)->logbank.Save ( file );
+
+	state->savedsize = ftell ( file );
+	state->saved = new char [state->savedsize + 1];
+	rewind ( file );
+	state->savedsize = (long) fread ( state->saved, 1, state->savedsize, file );
+	fclose ( file );
+
+}
+
+// Generated computers can share a name, so this one is looked for among them
+
+static bool Marked ( Computer *comp )
+{
+
+	for ( BTree <Computer *> *tree = game->GetWorld ()->securitybreaches.LookupTree ( comp->name ); tree;
+		  tree = tree->Left () ? tree->Left ()->LookupTree ( comp->name ) : NULL )
+		if ( tree->data == comp ) return true;
+
+	return false;
+
+}
+
+// Every computer the sweep has something to do for is marked - and if
+// exactly, no other computer is
+
+static bool CheckMarked ( bool exactly )
+{
+
+	for ( int i = 0; i < computers->Size (); ++i ) {
+
+		Computer *comp = computers->GetData (i);
+		bool breached = comp->HasSecurityBreaches ();
+
+		if ( breached && !Marked ( comp ) ) return false;
+		if ( exactly && !breached && Marked ( comp ) ) return false;
+
+	}
+
+	return true;
+
+}
+
+static int RandomLog ( LogBank *bank )
+{
+
+	if ( bank->logs.Size () == 0 ) return -1;
+	int index = Random ( bank->logs.Size () );
+	return bank->logs.ValidIndex ( index ) ? index : -1;
+
+}
+
+// A connection to the computer, closed before a trace could finish -
+// as Connection::Disconnect, with no connection opened log to blame
+
+static void SuspiciousLog ( Computer *comp )
+{
+
+	Person *hacker = hackers->GetData ( Random ( hackers->Size () ) );
+	Computer *from = computers->GetData ( Random ( computers->Size () ) );
+
+	AccessLog *al = new AccessLog ();
+	al->SetProperties ( &game->GetWorld ()->date, from->ip, hacker->name, LOG_SUSPICIOUS, LOG_TYPE_CONNECTIONCLOSED );
+	comp->logbank.AddLog ( al );
+
+}
+
+static void OrdinaryLog ( Computer *comp )
+{
+
+	Person *hacker = hackers->GetData ( Random ( hackers->Size () ) );
+	Computer *from = computers->GetData ( Random ( computers->Size () ) );
+
+	AccessLog *al = new AccessLog ();
+	al->SetProperties ( &game->GetWorld ()->date, from->ip, hacker->name, LOG_NOTSUSPICIOUS, LOG_TYPE_CONNECTIONOPENED );
+	comp->logbank.AddLog ( al );
+
+}
+
+// Connection::Disconnect finding the connection opened log to blame
+
+static void BlameLog ( Computer *comp, int index )
+{
+
+	if ( !game->GetWorld ()->GetPerson ( comp->logbank.logs.GetData (index)->fromname ) ) return;
+
+	comp->logbank.logs.GetData (index)->SetSuspicious ( LOG_SUSPICIOUS );
+	if ( comp->logbank.internallogs.ValidIndex (index) )
+		comp->logbank.internallogs.GetData (index)->SetSuspicious ( LOG_SUSPICIOUS );
+
+	comp->logbank.LogChanged ( index );
+
+}
+
+// A deleted marker in place of the log, as the log deleters
+
+static void DeleteLog ( Computer *comp, int index )
+{
+
+	LogBank *bank = &comp->logbank;
+
+	Date logdate;
+	logdate.SetDate ( &bank->logs.GetData (index)->date );
+
+	delete bank->logs.GetData (index);
+	bank->logs.RemoveData (index);
+
+	AccessLog *al = new AccessLog ();
+	al->SetProperties ( &logdate, "Unknown", " ", LOG_NOTSUSPICIOUS, LOG_TYPE_DELETED );
+	bank->logs.PutData ( al, index );
+
+	bank->LogChanged ( index );
+
+}
+
+// Put back from the internal log, as the log undeleter
+
+static void UnDeleteLog ( Computer *comp, int index )
+{
+
+	if ( !comp->logbank.internallogs.ValidIndex (index) ) return;
+
+	comp->logbank.logs.GetData (index)->SetProperties ( comp->logbank.internallogs.GetData (index) );
+	comp->logbank.LogChanged ( index );
+
+}
+
+// NotificationEvent::CheckForSecurityBreaches as it was before computers
+// were marked - every computer, every time
+
+static void OldSweep ()
+{
+
+	DArray <Computer *> *d_computers = game->GetWorld ()->computers.ConvertToDArray ();
+
+	for ( int i = 0; i < d_computers->Size (); ++i )
+		if ( d_computers->ValidIndex (i) )
+			d_computers->GetData (i)->CheckForSecurityBreaches ();
+
+	delete d_computers;
+
+	Date duedate;
+	duedate.SetDate ( &game->GetWorld ()->date );
+	duedate.AdvanceMinute ( FREQUENCY_CHECKFORSECURITYBREACHES );
+
+	NotificationEvent *event = new NotificationEvent ();
+	event->SetTYPE ( NOTIFICATIONEVENT_TYPE_CHECKFORSECURITYBREACHES );
+	event->SetRunDate ( &duedate );
+	game->GetWorld ()->scheduler.ScheduleEvent ( event );
+
+}
+
+static void Sweep ( bool old )
+{
+
+	game->GetWorld ()->date.AdvanceMinute ( FREQUENCY_CHECKFORSECURITYBREACHES );
+
+	if ( old ) {
+		OldSweep ();
+		return;
+	}
+
+	NotificationEvent event;
+	event.SetTYPE ( NOTIFICATIONEVENT_TYPE_CHECKFORSECURITYBREACHES );
+	event.SetRunDate ( &game->GetWorld ()->date );
+	event.Run ();
+
+}
+
+static void CreateWorld ()
+{
+
+	TestCreateWorld ( WORLDSEED );
+	WorldGenerator::GenerateAll ();
+	game->GetWorld ()->date.DeActivate ();
+	FindComputers ();
+
+	randomstate = WORLDSEED;
+
+	// Anything already there is marked as World::Load would - Computer::Update
+	// marks the rest, but these tests never run it
+
+	for ( int i = 0; i < computers->Size (); ++i )
+		if ( computers->GetData (i)->HasSecurityBreaches () )
+			game->GetWorld ()->MarkSecurityBreach ( computers->GetData (i) );
+
+}
+
+// One run, sweeping the marked computers or, if old, every computer.
+// Returns how many computers the sweeps were given, between them
+
+static int RunSteps ( bool old, LogsState *state )
+{
+
+	CreateWorld ();
+
+	bool allmarked = CheckMarked ( false );
+	bool exactlymarked = true;
+	int numswept = 0, numrestored = 0;
+
+	for ( int step = 0; step < NUMSTEPS; ++step ) {
+
+		Computer *comp = computers->GetData ( Random ( computers->Size () ) );
+		int index = RandomLog ( &comp->logbank );
+		int action = Random (100);
+
+		if ( action < 20 )					SuspiciousLog ( comp );
+		else if ( action < 40 )				OrdinaryLog ( comp );
+		else if ( index == -1 )				continue;
+		else if ( action < 55 )				BlameLog ( comp, index );
+		else if ( action < 75 )				DeleteLog ( comp, index );
+		else if ( action < 90 ) {
+
+			// Traced by an agent, who can recover anything
+
+			if ( comp->logbank.LogModified ( index ) ) {
+				comp->logbank.RecoverLog ( index );
+				++numrestored;
+			}
+
+		}
+		else								UnDeleteLog ( comp, index );
+
+		if ( !CheckMarked ( false ) ) allmarked = false;
+
+		if ( step % SWEEPSTEPS == SWEEPSTEPS - 1 ) {
+
+			numswept += game->GetWorld ()->securitybreaches.Size ();
+			Sweep ( old );
+
+			// What is left after a sweep is exactly what the next has to do
+
+			if ( !old && !CheckMarked ( true ) ) exactlymarked = false;
+
+		}
+
+	}
+
+	TEST_CHECK ( allmarked );
+	TEST_CHECK ( exactlymarked );
+	TEST_CHECK ( numrestored > 0 );
+
+	SaveLogs ( state );
+	return numswept;
+
+}
+
+static void CheckRuns ()
+{
+
+	LogsState marked, old;
+
+	int numswept = RunSteps ( false, &marked );
+	RunSteps ( true, &old );
+
+	TEST_CHECK ( numswept > 0 );
+	TEST_CHECK ( marked.savedsize == old.savedsize && memcmp ( marked.saved, old.saved, marked.savedsize ) == 0 );
+
+	printf ( "%d log changes, %d sweeps : %d computers swept against %d, the same logs as sweeping them all\n",
+			 NUMSTEPS, NUMSTEPS / SWEEPSTEPS, numswept, ( NUMSTEPS / SWEEPSTEPS ) * computers->Size () );
+
+	delete [] marked.saved;
+	delete [] old.saved;
+
+}
+
+static void AddComputers ( int numcomputers )
+{
+
+	for ( int i = 0; i < numcomputers; ++i ) {
+
+		char name [64];
+		char ip [SIZE_VLOCATION_IP];
+		UplinkSnprintf ( name, sizeof ( name ), "Test Computer %d", i );
+		UplinkSnprintf ( ip, sizeof ( ip ), "200.%d.%d.%d", i / 65536, ( i / 256 ) % 256, i % 256 );
+		game->GetWorld ()->CreateVLocation ( ip, i % 500, ( i / 500 ) % 300 );
+
+		Computer *comp = new Computer ();
+		comp->SetTYPE ( COMPUTER_TYPE_PUBLICACCESSSERVER );
+		comp->SetName ( name );
+		comp->SetCompanyName ( WorldGenerator::GetRandomCompany ()->name );
+		comp->SetIP ( ip );
+		game->GetWorld ()->CreateComputer ( comp );
+
+	}
+
+}
+
+// Every computer with ordinary logs and a few with a suspicious one,
+// swept until there is nothing left to do
+
+static double TimeSweeps ( bool old, int *numcomputers )
+{
+
+	CreateWorld ();
+	AddComputers ( BIGCOMPUTERS );
+	FindComputers ();
+
+	for ( int i = 0; i < computers->Size (); ++i )
+		for ( int l = 0; l < BIGLOGS; ++l )
+			OrdinaryLog ( computers->GetData (i) );
+
+	for ( int i = 0; i < BIGBREACHED; ++i )
+		SuspiciousLog ( computers->GetData ( Random ( computers->Size () ) ) );
+
+	TestTime start = TestNow ();
+	for ( int s = 0; s < BIGSWEEPS; ++s )
+		Sweep ( old );
+	double milliseconds = TestMilliseconds ( start ) / BIGSWEEPS;
+
+	TEST_CHECK ( old || game->GetWorld ()->securitybreaches.Size () == 0 );
+
+	*numcomputers = computers->Size ();
+	return milliseconds;
+
+}
+
+static void TimeBigWorld ()
+{
+
+	int numcomputers = 0;
+	double markedms = TimeSweeps ( false, &numcomputers );
+	double oldms = TimeSweeps ( true, &numcomputers );
+
+	TEST_CHECK ( markedms < oldms );
+
+	printf ( "%d computers, %d logs each, %d breached : a sweep of the marked computers %.3fms, of every computer %.3fms\n",
+			 numcomputers, BIGLOGS, BIGBREACHED, markedms, oldms );
+
+}
+
+int main ()
+{
+
+	TestInitialise ();
+
+	CheckRuns ();
+	TimeBigWorld ();
+
+	delete computers;
+	delete hackers;
+
+	return TestFinish ();
+
+}
@@ -0,0 +1,226 @@
+// -*- tab-width:4 c-file-style:"cc-mode" -*-
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include "redshirt.h"
+
+#include "app/app.h"
+#include "app/globals.h"
+#include "app/miscutils.h"
+
+#include "options/options.h"
+
+#include "game/game.h"
+
+#include "world/world.h"
+
+#include "tests/testworld.h"
+
+#include "mmgr.h"
+
+
+// Game keeps its world protected - this lets the tests swap it
+
+class TestGame : public Game
+{
+
+public:
+
+	void SetWorld ( World *newworld )	{ world = newworld; }
+	void SetInterface ( Interface *newinterface )	{ ui = newinterface; }
+	World *CurrentWorld ()				{ return world; }			// GetWorld asserts there is one
+
+};
+
+
+static TestGame *testgame = NULL;
+static char testpath [256] = "";
+static int numchecks = 0;
+static int numfailed = 0;
+
+
+// Stand-in data files - only what World and the name generator read
+
+static const char *TESTDATA [][2] = {
+
+	{ "data/wordlist.txt",		"rosebud\nsecret\npassword\nmango\nwhisky\nfalcon\nlibrary\nsilver\norbit\ncobalt\n" },
+	{ "data/gatewaydefs.txt",	"; The starting gateway only\nGATEWAYS 1\n"
+								"Gateway ALPHA       \n0 2 4 1 1 1 100 100\nStarting gateway\n"
+								"CPUS\n10 10\n20 10\nMEMORY\n10 20\n20 20\n30 20\n40 20\nSECURITY\n10 30\nMODEM 50 50\nPOWER 60 60\n" },
+	{ "data/fornames.txt",		"Alan\nBeth\nCarl\nDana\nEvan\nFaye\nGary\nHelen\nIan\nJune\nKarl\nLena\n\n" },
+	{ "data/surnames.txt",		"Archer\nBaker\nCarter\nDriver\nEaston\nFisher\nGrant\nHarper\nIngram\nJoyce\nKeller\nLawson\n"
+								"Mason\nNewton\nOwens\nPrice\nQuinn\nRyder\nSawyer\nTurner\nUpton\nVance\nWalker\nYoung\n\n" },
+	{ "data/agentaliases.txt",	"Blackjack\nCipher\nDrift\nEcho\nFlux\nGhost\nHex\nIon\nJinx\nKilo\nLynx\nMoth\n\n" },
+	{ "data/companya.txt",		"Alpha\nBorder\nCrest\nDelta\nEastern\nFirst\nGlobal\nHigh\n\n" },
+	{ "data/companyb.txt",		"Systems\nHoldings\nNetworks\nBank\nLabs\nGroup\nTrading\nMedia\n\n" },
+
+	{ NULL, NULL }
+
+};
+
+
+// The world generator scales its map mask with gluScaleImage, which needs a current context
+
+static bool CreateOffscreenContext ()
+{
+
+	PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+		(PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress ( "eglGetPlatformDisplayEXT" );
+
+	EGLDisplay display = getPlatformDisplay ?
+						 getPlatformDisplay ( EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL ) :
+						 eglGetDisplay ( EGL_DEFAULT_DISPLAY );
+
+	if ( display == EGL_NO_DISPLAY || !eglInitialize ( display, NULL, NULL ) ) return false;
+	if ( !eglBindAPI ( EGL_OPENGL_API ) ) return false;
+
+	EGLint configattribs [] = { EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+								EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_NONE };
+	EGLConfig config;
+	EGLint numconfigs = 0;
+	if ( !eglChooseConfig ( display, configattribs, &config, 1, &numconfigs ) || numconfigs < 1 ) return false;
+
+	EGLint surfaceattribs [] = { EGL_WIDTH, 1024, EGL_HEIGHT, 768, EGL_NONE };
+	EGLSurface surface = eglCreatePbufferSurface ( display, config, surfaceattribs );
+	EGLContext context = eglCreateContext ( display, config, EGL_NO_CONTEXT, NULL );
+	if ( surface == EGL_NO_SURFACE || context == EGL_NO_CONTEXT ) return false;
+
+	return eglMakeCurrent ( display, surface, surface, context ) == EGL_TRUE;
+
+}
+
+void TestInitialise ()
+{
+
+	setvbuf ( stdout, NULL, _IONBF, 0 );
+
+	if ( !CreateOffscreenContext () ) {
+		printf ( "Failed to create an offscreen GL context\n" );
+		exit ( 1 );
+	}
+
+	//
+	// Scratch app path with the stand-in data
+
+	strcpy ( testpath, "/tmp/uplinktest-XXXXXX" );
+	if ( !mkdtemp ( testpath ) ) {
+		printf ( "Failed to make a scratch directory\n" );
+		exit ( 1 );
+	}
+	strcat ( testpath, "/" );
+
+	char datapath [256];
+	UplinkSnprintf ( datapath, sizeof ( datapath ), "%sdata", testpath );
+	MakeDirectory ( datapath );
+	UplinkSnprintf ( datapath, sizeof ( datapath ), "%sdata/lans", testpath );
+	MakeDirectory ( datapath );
+
+	for ( int i = 0; TESTDATA [i][0]; ++i )
+		if ( !TestWriteFile ( (char *) TESTDATA [i][0], TESTDATA [i][1] ) ) {
+			printf ( "Failed to write %s%s\n", testpath, TESTDATA [i][0] );
+			exit ( 1 );
+		}
+
+	app = new App ();
+	app->Set ( testpath, "test", "TEST", "today", "Uplink tests" );
+	RsInitialise ( app->path );
+
+	app->options = new Options ();
+	app->options->CreateDefaultOptions ();
+
+	testgame = new TestGame ();
+	game = testgame;
+
+}
+
+int TestFinish ()
+{
+
+	printf ( "%d checks, %d failed\n", numchecks, numfailed );
+	printf ( numfailed ? "FAILED\n" : "PASSED\n" );
+	return numfailed ? 1 : 0;
+
+}
+
+World *TestCreateWorld ( unsigned int seed )
+{
+
+	UplinkAssert ( testgame );
+
+	if ( testgame->CurrentWorld () ) {
+		World *oldworld = testgame->CurrentWorld ();
+		testgame->SetWorld ( NULL );
+		delete oldworld;
+	}
+
+	srand ( seed );
+
+	World *world = new World ();
+	testgame->SetWorld ( world );
+	return world;
+
+}
+
+void TestSetInterface ( Interface *newinterface )
+{
+
+	UplinkAssert ( testgame );
+	testgame->SetInterface ( newinterface );
+
+}
+
+char *TestPath ()
+{
+
+	return testpath;
+
+}
+
+bool TestWriteFile ( char *filename, const char *text )
+{
+
+	char fullfilename [256];
+	UplinkSnprintf ( fullfilename, sizeof ( fullfilename ), "%s%s", testpath, filename );
+
+	FILE *file = fopen ( fullfilename, "wb" );
+	if ( !file ) return false;
+
+	size_t length = strlen ( text );
+	bool success = fwrite ( text, 1, length, file ) == length;
+	return ( fclose ( file ) == 0 ) && success;
+
+}
+
+bool TestCheck ( bool condition, const char *text, const char *file, int line )
+{
+
+	++numchecks;
+
+	if ( !condition ) {
+		++numfailed;
+		printf ( "%s(%d) : check failed : %s\n", file, line, text );
+	}
+
+	return condition;
+
+}
+
+TestTime TestNow ()
+{
+
+	return std::chrono::steady_clock::now ();
+
+}
+
+double TestMilliseconds ( TestTime start )
+{
+
+	std::chrono::duration <double, std::milli> elapsed = std::chrono::steady_clock::now () - start;
+	return elapsed.count ();
+
+}
@@ -0,0 +1,46 @@
+
+/*
+
+  Test world
+
+	Shared set up for the standalone checks and benchmarks in tests/.
+	Builds just enough of the game to generate worlds without a window :
+	an offscreen GL context (the world generator scales its map mask
+	through GLU), default options, and a scratch app path holding small
+	stand-in data files in place of the shipped archives
+
+	Each test is its own program, linked against the game objects
+	less uplink.cpp - see "make test"
+
+  */
+
+#ifndef _included_testworld_h
+#define _included_testworld_h
+
+#include <chrono>
+
+class World;
+class Interface;
+
+
+#define TEST_CHECK(condition)	TestCheck ( (condition), #condition, __FILE__, __LINE__ )
+
+
+void   TestInitialise ();								// Call once, first thing in main
+int    TestFinish ();									// Prints PASSED / FAILED, returns the exit code
+
+World *TestCreateWorld ( unsigned int seed );			// Replaces game's world with an empty one, and seeds rand ()
+void   TestSetInterface ( Interface *newinterface );	// For code that looks up the current screen
+
+char  *TestPath ();										// Scratch app path, with a trailing slash
+bool   TestWriteFile ( char *filename, const char *text );	// Relative to TestPath
+
+bool   TestCheck ( bool condition, const char *text, const char *file, int line );
+
+typedef std::chrono::steady_clock::time_point TestTime;
+
+TestTime TestNow ();
+double   TestMilliseconds ( TestTime start );			// Since start
+
+
+#endif
@@ -0,0 +1,261 @@
+// -*- tab-width:4 c-file-style:"cc-mode" -*-
+
+/*
+
+  World map cost test
+
+	Lays out seeded sets of labels with WorldMapLayout, which scores a
+	label from a summed area table of the fixed features plus a flat
+	charge for every pixel it shares with another label. Lays out the
+	same labels with the per pixel shade screen it replaced, on the same
+	annealing schedule, and scores both layouts the old way. Checks the
+	new scoring costs no more than WORLDMAPCOST_MAXWORSE on that metric,
+	and times both
+
+  */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app/app.h"
+#include "app/globals.h"
+
+#include "interface/localinterface/worldmap/rectangle.h"
+#include "interface/localinterface/worldmap/worldmap_layout.h"
+
+#include "tests/testworld.h"
+
+#include "mmgr.h"
+
+
+#define NUMSEEDS                3
+#define WORLDMAPCOST_MAXWORSE   0.05                // Of the old layouts' cost, summed over the seeds
+
+#define MAPX                    20
+#define MAPY                    50
+#define MAPWIDTH                595
+#define MAPHEIGHT               315
+
+
+// The old objective - how many things cover each pixel, with a pixel
+// under n things costing 2 + 3 + ... + n
+
+class ShadeScreen
+{
+
+public:
+
+	int *counts;
+	long long cost;
+
+	ShadeScreen ()				{ counts = new int [MAPWIDTH * MAPHEIGHT]; memset ( counts, 0, MAPWIDTH * MAPHEIGHT * sizeof(int) ); cost = 0; }
+	~ShadeScreen ()				{ delete [] counts; }
+
+	void Add ( const MapRectangle &rect, int change );
+
+};
+
+void ShadeScreen::Add ( const MapRectangle &rect, int change )
+{
+
+	MapRectangle r = MapRectangle ( MAPX, MAPY, MAPWIDTH, MAPHEIGHT ).intersection ( rect );
+	if ( r.isNull () ) return;
+
+	for ( int y = r.y1; y <= r.y2 (); ++y ) {
+		int *line = counts + ( y - MAPY ) * MAPWIDTH - MAPX;
+		for ( int x = r.x1; x <= r.x2 (); ++x ) {
+			if ( change > 0 ) {
+				if ( ++line [x] != 1 ) cost += line [x];
+			}
+			else {
+				if ( line [x] != 1 ) cost -= line [x];
+				--line [x];
+			}
+		}
+	}
+
+}
+
+static void AddFeatures ( ShadeScreen *shade, WorldMapLayout *layout )
+{
+
+	LList <WorldMapInterfaceObject *> &locations = layout->GetLocations ();
+
+	for ( int i = 0; i < locations.Size (); ++i ) {
+		MapRectangle r = locations.GetData (i)->GetExtent ();
+		shade->Add ( r, 1 );
+		shade->Add ( MapRectangle ( r.x1 - r.width, r.y1 - r.height, r.width * 3, r.height * 3 ), 1 );
+	}
+
+}
+
+// The layout's labels where they are now, scored the old way
+
+static long long OldCost ( WorldMapLayout *layout )
+{
+
+	ShadeScreen shade;
+	AddFeatures ( &shade, layout );
+
+	LList <WorldMapInterfaceLabel *> &labels = layout->GetLabels ();
+	for ( int i = 0; i < labels.Size (); ++i )
+		shade.Add ( labels.GetData (i)->GetExtent (), 1 );
+
+	return shade.cost;
+
+}
+
+static int Random ( unsigned int *state, int range )
+{
+
+	*state = *state * 1103515245 + 12345;
+	return (int) ( ( *state >> 8 ) % (unsigned int) range );
+
+}
+
+static float RandomUniform ( unsigned int *state )
+{
+
+	*state = *state * 1103515245 + 12345;
+	return (float) ( *state >> 8 ) / (float) 0xFFFFFF;
+
+}
+
+static int RandomPosition ( WorldMapInterfaceLabel *label, unsigned int *state )
+{
+
+	if ( label->NumPossibleLabelPositions () == 0 ) return label->GetLabelPosition ();
+	return label->GetPossibleLabelPosition ( Random ( state, label->NumPossibleLabelPositions () ) );
+
+}
+
+// The layout as it was before the summed area table - the same schedule,
+// moving labels on the shade screen. Leaves the labels where it ends
+
+static void OldLayout ( WorldMapLayout *layout, unsigned int seed )
+{
+
+	LList <WorldMapInterfaceLabel *> &labels = layout->GetLabels ();
+	int n = labels.Size ();
+	unsigned int random = seed;
+
+	ShadeScreen shade;
+	AddFeatures ( &shade, layout );
+
+	for ( int i = 0; i < n; ++i ) {
+		labels.GetData (i)->SetLabelPosition ( RandomPosition ( labels.GetData (i), &random ) );
+		shade.Add ( labels.GetData (i)->GetExtent (), 1 );
+	}
+
+	float E = (float) shade.cost;
+	float T = 10.0f / log ( 3.0f );
+	int iteration = 0, moveNumber = 0, numGoodMoves = 0;
+	bool complete = ( n == 0 );
+
+	while ( !complete ) {
+
+		for ( int i = 0; E > 0 && i < 20; ++i ) {
+
+			WorldMapInterfaceLabel *l = labels.GetData ( Random ( &random, n ) );
+			int origPos = l->GetLabelPosition ();
+
+			shade.Add ( l->GetExtent (), -1 );
+			l->SetLabelPosition ( RandomPosition ( l, &random ) );
+			shade.Add ( l->GetExtent (), 1 );
+
+			float deltaE = shade.cost - E;
+
+			if ( deltaE < 0 )
+				numGoodMoves++;
+			else {
+				float expX = -deltaE / T;
+				if ( expX < -700.0f ) expX = -700.0f;
+
+				if ( RandomUniform ( &random ) <= 1.0 - exp ( expX ) ) {
+					shade.Add ( l->GetExtent (), -1 );
+					l->SetLabelPosition ( origPos );
+					shade.Add ( l->GetExtent (), 1 );
+					deltaE = 0;
+				}
+			}
+
+			E += deltaE;
+
+		}
+
+		moveNumber += 20;
+
+		if ( numGoodMoves >= 5 * n || moveNumber >= 10 * n ) {
+
+			if ( E <= 0 || numGoodMoves <= 0 || iteration > 20 )
+				complete = true;
+
+			iteration++;
+			moveNumber = 0;
+			numGoodMoves = 0;
+			T -= T / 10.0f;
+
+		}
+
+	}
+
+}
+
+static void AddLocations ( WorldMapLayout *layout, int numlocations, unsigned int seed )
+{
+
+	srand ( seed );
+
+	for ( int i = 0; i < numlocations; ++i ) {
+		char name [32];
+		UplinkSnprintf ( name, sizeof ( name ), "%.*s %d", 1 + rand () % 12, "Computer System", i );
+		int x = MAPX + rand () % MAPWIDTH;
+		int y = MAPY + rand () % MAPHEIGHT;
+		layout->AddLocation ( x, y, name );
+	}
+
+}
+
+int main ()
+{
+
+	TestInitialise ();
+
+	int sizes [] = { 50, 200, 1000 };
+
+	for ( int s = 0; s < 3; ++s ) {
+
+		long long newcost = 0, oldcost = 0;
+		double newms = 0.0, oldms = 0.0;
+
+		for ( unsigned int seed = 1; seed <= NUMSEEDS; ++seed ) {
+
+			WorldMapLayout layout ( MapRectangle ( MAPX, MAPY, MAPWIDTH, MAPHEIGHT ), 1, seed );
+			AddLocations ( &layout, sizes [s], seed );
+
+			TestTime start = TestNow ();
+			layout.FullLayoutLabels ();
+			newms += TestMilliseconds ( start );
+			newcost += OldCost ( &layout );
+
+			start = TestNow ();
+			OldLayout ( &layout, seed );
+			oldms += TestMilliseconds ( start );
+			oldcost += OldCost ( &layout );
+
+		}
+
+		double worse = oldcost > 0 ? (double) ( newcost - oldcost ) / oldcost : 0.0;
+
+		printf ( "%4d labels x%d : summed area %7.1fms cost %9lld, shade screen %7.1fms cost %9lld, %+.1f%%\n",
+				 sizes [s], NUMSEEDS, newms / NUMSEEDS, newcost, oldms / NUMSEEDS, oldcost, worse * 100.0 );
+
+		TEST_CHECK ( worse <= WORLDMAPCOST_MAXWORSE );
+
+	}
+
+	return TestFinish ();
+
+}
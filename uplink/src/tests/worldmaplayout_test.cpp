@@ -0,0 +1,173 @@
+// -*- tab-width:4 c-file-style:"cc-mode" -*-
+
+/*
+
+  World map layout test
+
+	Lays out the same seeded set of labels again and again - with one,
+	two and four threads, on a fresh layout and on one that is reused,
+	after a restart part way through, and with another thread keeping
+	a core busy - and checks a given seed and thread count always put
+	every label in the same place
+
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <thread>
+
+#include "app/app.h"
+#include "app/globals.h"
+
+#include "interface/localinterface/worldmap/rectangle.h"
+#include "interface/localinterface/worldmap/worldmap_layout.h"
+
+#include "tests/testworld.h"
+
+#include "mmgr.h"
+
+
+#define NUMLOCATIONS    300
+#define LOCATIONSEED    7
+#define LAYOUTSEED      WORLDMAPLAYOUT_SEED
+
+#define MAPX            20                          // As the client's full size map
+#define MAPY            50
+#define MAPWIDTH        595
+#define MAPHEIGHT       315
+
+
+static int locationx [NUMLOCATIONS];
+static int locationy [NUMLOCATIONS];
+static char locationname [NUMLOCATIONS][32];
+
+
+static void CreateLocations ()
+{
+
+	srand ( LOCATIONSEED );
+
+	for ( int i = 0; i < NUMLOCATIONS; ++i ) {
+		locationx [i] = MAPX + rand () % MAPWIDTH;
+		locationy [i] = MAPY + rand () % MAPHEIGHT;
+		UplinkSnprintf ( locationname [i], sizeof ( locationname [i] ), "%.*s %d",
+						 1 + rand () % 12, "Computer System", i );
+	}
+
+}
+
+static void AddLocations ( WorldMapLayout *layout, int first, int last )
+{
+
+	for ( int i = first; i < last; ++i )
+		layout->AddLocation ( locationx [i], locationy [i], locationname [i] );
+
+}
+
+static void GetPositions ( WorldMapLayout *layout, int *positions )
+{
+
+	LList <WorldMapInterfaceLabel *> &labels = layout->GetLabels ();
+	for ( int i = 0; i < labels.Size (); ++i )
+		positions [i] = labels.GetData (i)->GetLabelPosition ();
+
+}
+
+static bool SamePositions ( int *a, int *b )
+{
+
+	return memcmp ( a, b, NUMLOCATIONS * sizeof(int) ) == 0;
+
+}
+
+// A fresh layout of every location, timed
+
+static double LayOut ( int numthreads, unsigned int seed, int *positions )
+{
+
+	WorldMapLayout layout ( MapRectangle ( MAPX, MAPY, MAPWIDTH, MAPHEIGHT ), numthreads, seed );
+	AddLocations ( &layout, 0, NUMLOCATIONS );
+
+	TestTime start = TestNow ();
+	layout.FullLayoutLabels ();
+	double milliseconds = TestMilliseconds ( start );
+
+	TEST_CHECK ( layout.IsLayoutComplete () );
+	GetPositions ( &layout, positions );
+	return milliseconds;
+
+}
+
+static std::atomic <bool> spinning;
+
+static void Spin ()
+{
+
+	volatile unsigned int work = 0;
+	while ( spinning ) ++work;
+
+}
+
+int main ()
+{
+
+	TestInitialise ();
+
+	CreateLocations ();
+
+	int threadcounts [] = { 1, 2, 4 };
+
+	for ( int t = 0; t < 3; ++t ) {
+
+		int numthreads = threadcounts [t];
+		int first [NUMLOCATIONS], again [NUMLOCATIONS], positions [NUMLOCATIONS];
+
+		double milliseconds = LayOut ( numthreads, LAYOUTSEED, first );
+		LayOut ( numthreads, LAYOUTSEED, again );
+		TEST_CHECK ( SamePositions ( first, again ) );
+
+		//
+		// One layout reused, so its worker threads are too
+
+		WorldMapLayout layout ( MapRectangle ( MAPX, MAPY, MAPWIDTH, MAPHEIGHT ), numthreads, LAYOUTSEED );
+
+		for ( int run = 0; run < 2; ++run ) {
+			layout.Reset ();
+			AddLocations ( &layout, 0, NUMLOCATIONS );
+			layout.FullLayoutLabels ();
+			GetPositions ( &layout, positions );
+			TEST_CHECK ( SamePositions ( first, positions ) );
+		}
+
+		//
+		// Restarted by a location added while the workers run
+
+		layout.Reset ();
+		AddLocations ( &layout, 0, NUMLOCATIONS - 1 );
+		layout.PartialLayoutLabels ();
+		AddLocations ( &layout, NUMLOCATIONS - 1, NUMLOCATIONS );
+		layout.FullLayoutLabels ();
+		GetPositions ( &layout, positions );
+		TEST_CHECK ( SamePositions ( first, positions ) );
+
+		//
+		// With another thread competing for the processor
+
+		spinning = true;
+		std::thread spinner ( Spin );
+		double busymilliseconds = LayOut ( numthreads, LAYOUTSEED, positions );
+		spinning = false;
+		spinner.join ();
+		TEST_CHECK ( SamePositions ( first, positions ) );
+
+		printf ( "%d labels on %d thread%s : %.1fms, %.1fms with a busy core\n",
+				 NUMLOCATIONS, numthreads, numthreads == 1 ? "" : "s", milliseconds, busymilliseconds );
+
+	}
+
+	return TestFinish ();
+
+}
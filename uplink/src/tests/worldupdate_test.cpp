@@ -0,0 +1,346 @@
+// -*- tab-width:4 c-file-style:"cc-mode" -*-
+
+/*
+
+  World update test
+
+	Runs the same generated world forward on one, two, four and seven
+	worker threads - with computers shut down, with Revelation ready to
+	spread, and with people reading their mail - and checks every run
+	saves exactly the same world and leaves the main random numbers in
+	the same place. Checks that with no threads World::Update is still
+	the plain UpdateBTree of every object. Times an update each way with
+	20,000 computers
+
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app/app.h"
+#include "app/globals.h"
+#include "app/serialise.h"
+
+#include "options/options.h"
+
+#include "game/game.h"
+#include "game/data/data.h"
+
+#include "world/world.h"
+#include "world/vlocation.h"
+#include "world/message.h"
+#include "world/person.h"
+#include "world/company/company.h"
+#include "world/computer/computer.h"
+#include "world/generator/worldgenerator.h"
+
+#include "tests/testworld.h"
+
+#include "mmgr.h"
+
+
+#define WORLDSEED       1
+#define NUMFRAMES       300
+#define FRAMESECONDS    120                         // Game time between updates
+
+#define NUMINFECTED     2                           // Revelation doubles every three minutes, and
+#define INFECTEDFRAMES  4                           // at REVELATION_RELEASEUNCONTROLLED it's game over
+
+#define BIGCOMPUTERS    20000
+#define BIGFRAMES       20
+
+
+static int THREADCOUNTS [] = { 1, 2, 4, 7 };
+#define NUMTHREADCOUNTS 4
+
+
+struct WorldState
+{
+
+	char *saved;
+	long savedsize;
+	int nextrandom;									// rand () once the run is over
+
+};
+
+
+static void SaveWorld ( WorldState *state )
+{
+
+	FILE *file = tmpfile ();
+	UplinkAssert ( file );
+
+	game->GetWorld ()->Save ( file );
+
+	state->savedsize = ftell ( file );
+	state->saved = new char [state->savedsize + 1];
+	rewind ( file );
+	state->savedsize = (long) fread ( state->saved, 1, state->savedsize, file );
+	fclose ( file );
+
+	state->nextrandom = rand ();
+
+}
+
+static bool SameState ( WorldState *a, WorldState *b )
+{
+
+	return a->savedsize == b->savedsize &&
+		   a->nextrandom == b->nextrandom &&
+		   memcmp ( a->saved, b->saved, a->savedsize ) == 0;
+
+}
+
+static void RunFrames ( int numframes )
+{
+
+	World *world = game->GetWorld ();
+
+	for ( int i = 0; i < numframes; ++i ) {
+		world->date.AdvanceSecond ( FRAMESECONDS );
+		world->Update ();
+	}
+
+}
+
+// World::Update as it was before the update threads - every frame is
+// more than the two seconds apart it waits for
+
+static void RunBaselineFrames ( int numframes )
+{
+
+	World *world = game->GetWorld ();
+
+	for ( int i = 0; i < numframes; ++i ) {
+
+		world->date.AdvanceSecond ( FRAMESECONDS );
+
+		UpdateBTree ( (BTree <UplinkObject *> *) &world->locations );
+		UpdateBTree ( (BTree <UplinkObject *> *) &world->companies );
+		UpdateBTree ( (BTree <UplinkObject *> *) &world->computers );
+		UpdateBTree ( (BTree <UplinkObject *> *) &world->people    );
+
+		world->scheduler.Update ();
+		world->plotgenerator.Update ();
+
+	}
+
+}
+
+// Shuts down some computers, leaves Revelation ready to spread from
+// a couple of others, and sends some people mail
+
+static void StirWorld ()
+{
+
+	World *world = game->GetWorld ();
+
+	DArray <Computer *> *computers = world->computers.ConvertToDArray ();
+	int numinfected = 0;
+
+	for ( int i = 0; i < computers->Size (); ++i ) {
+		if ( !computers->ValidIndex (i) ) continue;
+
+		Computer *comp = computers->GetData (i);
+
+		if ( i % 17 == 0 )
+			comp->SetIsRunning ( false );
+
+		else if ( i % 7 == 0 && numinfected < NUMINFECTED &&
+				  ( comp->TYPE & ( COMPUTER_TYPE_INTERNALSERVICESMACHINE | COMPUTER_TYPE_CENTRALMAINFRAME ) ) ) {
+			comp->InfectWithRevelation ( 2.0f );
+			comp->infectiondate.AdvanceMinute ( -TIME_REVELATIONREPRODUCE );
+			++numinfected;
+		}
+	}
+
+	delete computers;
+
+	DArray <Person *> *people = world->people.ConvertToDArray ();
+
+	for ( int i = 0; i < people->Size (); ++i ) {
+		if ( !people->ValidIndex (i) || i % 3 != 0 ) continue;
+
+		Person *person = people->GetData (i);
+		if ( strcmp ( person->name, "PLAYER" ) == 0 ) continue;
+
+		for ( int m = 0; m <= i % 4; ++m ) {
+			Message *msg = new Message ();
+			msg->SetTo ( person->name );
+			msg->SetFrom ( "internal@Uplink.net" );
+			msg->SetSubject ( "Newsletter" );
+			msg->SetBody ( "Nothing to report" );
+			person->GiveMessage ( msg );
+		}
+	}
+
+	delete people;
+
+}
+
+static void CreateWorld ( int numthreads )
+{
+
+	TestCreateWorld ( WORLDSEED );
+	WorldGenerator::GenerateAll ();
+	game->GetWorld ()->date.DeActivate ();
+
+	app->GetOptions ()->SetOptionValue ( "game_updatethreads", numthreads );
+
+}
+
+// How many computers have Revelation, and cleans them up if asked
+
+static int CountInfected ( bool disinfect )
+{
+
+	DArray <Computer *> *computers = game->GetWorld ()->computers.ConvertToDArray ();
+
+	int numinfected = 0;
+	for ( int i = 0; i < computers->Size (); ++i )
+		if ( computers->ValidIndex (i) && computers->GetData (i)->isinfected_revelation > 0.0 ) {
+			++numinfected;
+			if ( disinfect ) computers->GetData (i)->DisinfectRevelation ();
+		}
+
+	delete computers;
+	return numinfected;
+
+}
+
+// One run of the stirred world, on numthreads threads or, if baseline,
+// through the old World::Update. Returns how far Revelation spread
+
+static int RunStirred ( int numthreads, bool baseline, WorldState *state )
+{
+
+	CreateWorld ( numthreads );
+	StirWorld ();
+
+	if ( baseline ) RunBaselineFrames ( INFECTEDFRAMES );
+	else			RunFrames ( INFECTEDFRAMES );
+
+	int numinfected = CountInfected ( true );
+
+	if ( baseline ) RunBaselineFrames ( NUMFRAMES - INFECTEDFRAMES );
+	else			RunFrames ( NUMFRAMES - INFECTEDFRAMES );
+
+	SaveWorld ( state );
+	return numinfected;
+
+}
+
+static void CheckRuns ()
+{
+
+	WorldState states [NUMTHREADCOUNTS];
+	int numinfected = 0;
+
+	for ( int t = 0; t < NUMTHREADCOUNTS; ++t ) {
+
+		numinfected = RunStirred ( THREADCOUNTS [t], false, &states [t] );
+
+		if ( t > 0 )
+			TEST_CHECK ( SameState ( &states [0], &states [t] ) );
+
+	}
+
+	// Revelation spread, so objects reached each other during the updates
+
+	TEST_CHECK ( numinfected > NUMINFECTED );
+
+	printf ( "%d updates, Revelation spread from %d computers to %d : the same world on 1, 2, 4 and 7 threads\n",
+			 NUMFRAMES, NUMINFECTED, numinfected );
+
+	// No threads is the update there always was, random numbers and all
+
+	WorldState serial, baseline;
+	int serialinfected = RunStirred ( 0, false, &serial );
+	int baselineinfected = RunStirred ( 0, true, &baseline );
+
+	TEST_CHECK ( SameState ( &serial, &baseline ) );
+	TEST_CHECK ( serialinfected == baselineinfected && serialinfected > NUMINFECTED );
+
+	printf ( "%d updates on the main thread : the same world as the old update, Revelation spread to %d\n",
+			 NUMFRAMES, serialinfected );
+
+	for ( int t = 0; t < NUMTHREADCOUNTS; ++t )
+		delete [] states [t].saved;
+
+	delete [] serial.saved;
+	delete [] baseline.saved;
+
+}
+
+static void AddComputers ( int numcomputers )
+{
+
+	for ( int i = 0; i < numcomputers; ++i ) {
+
+		char name [64];
+		char ip [SIZE_VLOCATION_IP];
+		UplinkSnprintf ( name, sizeof ( name ), "Test Computer %d", i );
+		UplinkSnprintf ( ip, sizeof ( ip ), "200.%d.%d.%d", i / 65536, ( i / 256 ) % 256, i % 256 );
+		game->GetWorld ()->CreateVLocation ( ip, i % 500, ( i / 500 ) % 300 );
+
+		Computer *comp = new Computer ();
+		comp->SetTYPE ( COMPUTER_TYPE_PUBLICACCESSSERVER );
+		comp->SetName ( name );
+		comp->SetCompanyName ( WorldGenerator::GetRandomCompany ()->name );
+		comp->SetIP ( ip );
+		game->GetWorld ()->CreateComputer ( comp );
+
+	}
+
+}
+
+static void TimeUpdates ()
+{
+
+	WorldState states [NUMTHREADCOUNTS];
+	double milliseconds [NUMTHREADCOUNTS];
+
+	CreateWorld ( 0 );
+	AddComputers ( BIGCOMPUTERS );
+
+	TestTime start = TestNow ();
+	RunFrames ( BIGFRAMES );
+	double serialms = TestMilliseconds ( start ) / BIGFRAMES;
+
+	for ( int t = 0; t < NUMTHREADCOUNTS; ++t ) {
+
+		CreateWorld ( THREADCOUNTS [t] );
+		AddComputers ( BIGCOMPUTERS );
+
+		start = TestNow ();
+		RunFrames ( BIGFRAMES );
+		milliseconds [t] = TestMilliseconds ( start ) / BIGFRAMES;
+
+		SaveWorld ( &states [t] );
+		if ( t > 0 )
+			TEST_CHECK ( SameState ( &states [0], &states [t] ) );
+
+	}
+
+	printf ( "%d computers, update on the main thread %.2fms", game->GetWorld ()->computers.Size (), serialms );
+	for ( int t = 0; t < NUMTHREADCOUNTS; ++t )
+		printf ( ", %d thread%s %.2fms", THREADCOUNTS [t], THREADCOUNTS [t] == 1 ? "" : "s", milliseconds [t] );
+	printf ( "\n" );
+
+	for ( int t = 0; t < NUMTHREADCOUNTS; ++t )
+		delete [] states [t].saved;
+
+}
+
+int main ()
+{
+
+	TestInitialise ();
+
+	CheckRuns ();
+	TimeUpdates ();
+
+	return TestFinish ();
+
+}
@@ -23,6 +23,10 @@
 #include "stdafx.h"
 
 #include <time.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <fcntl.h>
@@ -51,6 +55,7 @@
 #include "gucci.h"
 #include "redshirt.h"
 #include "bungle.h"
+#include "mmalloc.h"
 
 #include "app/app.h"
 #include "app/globals.h"
@@ -106,6 +111,26 @@ bool Cleanup_Steam ();
 bool VerifyLegitAndCodeCardCheck();
 #endif
 
+// ============================================================================
+// Startup timeline
+// Each startup task records when it ran and on which thread (0 is the main 
+// thread), and the timeline is written to startup.log once the game is up
+
+struct StartupEvent
+{
+	char name [32];
+	int thread;
+	double start;
+	double finish;
+};
+
+static double startuptime = 0.0;
+static std::mutex startupmutex;
+static std::vector <StartupEvent> startupevents;
+
+static double StartupTrace ( const char *name, int thread, double start );		// Returns the finish time
+static void WriteStartupTimeline ();
+
 // ============================================================================
 // Static variables
 
@@ -394,6 +419,9 @@ void RunUplink ( int argc, char **argv )
 			return;
 		}
 
+		startuptime = EclGetAccurateTime ();
+		double phase = startuptime;
+
 			
 		// Initialise each of the modules
 
@@ -403,6 +431,7 @@ void RunUplink ( int argc, char **argv )
 		Init_App      ( br_find_exe(NULL) );
 #endif
 		Init_Options  ( argc, argv );
+		phase = StartupTrace ( "Init_App / Init_Options", 0, phase );
 
 		printf ( "DEBUG: After Init_Options, before VerifyLegit check\n" );
 		fflush(stdout);
@@ -424,22 +453,33 @@ void RunUplink ( int argc, char **argv )
 		app->askCodeCard = false;
 #endif
 
+		phase = EclGetAccurateTime ();
+
 		if( !Load_Data() ) {
 			if (file_stdout) { fprintf(file_stdout, "DEBUG: Load_Data FAILED\n"); fflush(file_stdout); }
 			Cleanup_Uplink ();
 			return;
 		}
+		phase = StartupTrace ( "Load_Data", 0, phase );
 		if (file_stdout) { fprintf(file_stdout, "DEBUG: Load_Data OK, starting Init_Game\n"); fflush(file_stdout); }
 
 		Init_Game     ();
+		phase = StartupTrace ( "Init_Game", 0, phase );
 		if (file_stdout) { fprintf(file_stdout, "DEBUG: Init_Game OK, starting Init_Graphics\n"); fflush(file_stdout); }
 		Init_Graphics ();
+		phase = StartupTrace ( "Init_Graphics", 0, phase );
 		if (file_stdout) { fprintf(file_stdout, "DEBUG: Init_Graphics OK, starting Init_OpenGL\n"); fflush(file_stdout); }
 		Init_OpenGL   ( argc, argv );
+		phase = StartupTrace ( "Init_OpenGL", 0, phase );
 		if (file_stdout) { fprintf(file_stdout, "DEBUG: Init_OpenGL OK\n"); fflush(file_stdout); }
 		Init_Fonts	  ();
+		phase = StartupTrace ( "Init_Fonts", 0, phase );
 		Init_Sound    ();
+		phase = StartupTrace ( "Init_Sound", 0, phase );
 		Init_Music    ();
+		phase = StartupTrace ( "Init_Music", 0, phase );
+
+		WriteStartupTimeline ();
 
 		// Run everything
 
@@ -996,18 +1036,65 @@ void Init_Options ( int argc, char **argv )
 
 	printf ( "\n" );
 	
-    SetWindowScaleFactor ( app->GetOptions ()->GetOptionValue("graphics_screenwidth") / 640.0f,
-                           app->GetOptions ()->GetOptionValue("graphics_screenheight") / 480.0f );
+    SetWindowScaleFactor ( app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH ) / 640.0f,
+                           app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT ) / 480.0f );
 
 	if ( app->GetOptions ()->IsOptionEqualTo ( "game_debugstart", 1 ) ) 	
 		printf ( "=====DEBUGGING INFORMATION ENABLED=====\n" );
 
+	// Heap profiling can also be switched on and off with F11
+
+	if ( app->GetOptions ()->GetOptionValue ( "game_heapsample" ) > 0 )
+		MmSetSampling ( app->GetOptions ()->GetOptionValue ( "game_heapsample" ) );
+
+}
+
+static double StartupTrace ( const char *name, int thread, double start )
+{
+
+	double finish = EclGetAccurateTime ();
+
+	StartupEvent event;
+	UplinkStrncpy ( event.name, name, sizeof ( event.name ) );
+	event.thread = thread;
+	event.start = start - startuptime;
+	event.finish = finish - startuptime;
+
+	startupmutex.lock ();
+	startupevents.push_back ( event );
+	startupmutex.unlock ();
+
+	return finish;
+
+}
+
+static void WriteStartupTimeline ()
+{
+
+	char filename [256];
+	UplinkSnprintf ( filename, sizeof ( filename ), "%sstartup.log", app->userpath );
+
+	FILE *file = fopen ( filename, "wt" );
+	if ( !file ) return;
+
+	fprintf ( file, "%-24s %6s %10s %10s %10s\n", "Task", "Thread", "Start", "Finish", "Time (ms)" );
+
+	startupmutex.lock ();
+	for ( size_t i = 0; i < startupevents.size (); ++i ) {
+		StartupEvent *event = &startupevents [i];
+		fprintf ( file, "%-24s %6d %10.1f %10.1f %10.1f\n", event->name, event->thread, 
+				  event->start, event->finish, event->finish - event->start );
+	}
+	startupmutex.unlock ();
+
+	fclose ( file );
+
 }
 
-static bool TestRsLoadArchive ( char *filename )
+static bool TestRsAddArchive ( char *filename, BglArchive *archive )
 {
 
-	if ( !RsLoadArchive ( filename ) ) {
+	if ( !RsAddArchive ( filename, archive ) ) {
 		printf ( "\nAn error occured in Uplink\n" );
 		printf ( "Files integrity is not verified\n" );
 		printf ( "Failed loading '%s'\n", filename );
@@ -1036,6 +1123,28 @@ static bool TestRsLoadArchive ( char *filename )
 
 }
 
+#define NUM_ARCHIVES 9
+
+static char *archivenames [NUM_ARCHIVES] = { "data.dat", "graphics.dat", "loading.dat", "sounds.dat", "music.dat",
+											 "fonts.dat", "patch.dat", "patch2.dat", "patch3.dat" };
+static BglArchive *mappedarchives [NUM_ARCHIVES];
+static std::atomic <int> nextarchive;
+
+static void Load_DataWorker ( int thread )
+{
+
+	int index;
+
+	while ( ( index = nextarchive++ ) < NUM_ARCHIVES ) {
+
+		double start = EclGetAccurateTime ();
+		mappedarchives [index] = RsMapArchive ( archivenames [index] );
+		StartupTrace ( archivenames [index], thread, start );
+
+	}
+
+}
+
 bool Load_Data ()
 {
 
@@ -1045,15 +1154,36 @@ bool Load_Data ()
 
 	if ( debugging ) printf ( "Loading application data\n" );
 
-	if ( !TestRsLoadArchive ( "data.dat" ) ) return false;
-	if ( !TestRsLoadArchive ( "graphics.dat" ) ) return false;
-    if ( !TestRsLoadArchive ( "loading.dat" ) ) return false;
-	if ( !TestRsLoadArchive ( "sounds.dat" ) ) return false;
-	if ( !TestRsLoadArchive ( "music.dat" ) ) return false;
-	if ( !TestRsLoadArchive ( "fonts.dat" ) ) return false;
-    if ( !TestRsLoadArchive ( "patch.dat" ) ) return false;
-    if ( !TestRsLoadArchive ( "patch2.dat" ) ) return false;
-    if ( !TestRsLoadArchive ( "patch3.dat" ) ) return false;
+	//
+	// Map the archives on worker threads
+	//
+
+	int numthreads = (int) std::thread::hardware_concurrency ();
+	if ( numthreads < 1 ) numthreads = 1;
+	if ( numthreads > NUM_ARCHIVES ) numthreads = NUM_ARCHIVES;
+
+	nextarchive = 0;
+
+	std::vector <std::thread> workers;
+	for ( int t = 0; t < numthreads; ++t )
+		workers.push_back ( std::thread ( Load_DataWorker, t + 1 ) );
+
+	for ( int t = 0; t < numthreads; ++t )
+		workers [t].join ();
+
+	//
+	// Add them in order - earlier archives take priority.
+	// Each is added or reported on its own result, so everything mapped is
+	// added (and so freed at cleanup) even after a failure
+	//
+
+	bool success = true;
+
+	for ( int i = 0; i < NUM_ARCHIVES; ++i ) 
+		if ( !TestRsAddArchive ( archivenames [i], mappedarchives [i] ) )
+			success = false;
+
+	if ( !success ) return false;
 
 #ifdef _DEBUG
 	//DArray<char *> *fnames = RsListArchive("","");
@@ -55,6 +55,17 @@
 
 
 
+// A resolved HasAccount, valid while the computer's records are unchanged
+
+struct AgentAccess
+{
+
+	Computer *computer;
+	int generation;							// computer->recordbank.generation
+	int security;
+
+};
+
 Agent::Agent() : Person ()
 {
 }
@@ -66,6 +77,12 @@ Agent::~Agent()
 	DeleteBTreeData ( &codes );
 	DeleteLListData ( (LList <UplinkObject *> *) &missions );
 
+	DArray <AgentAccess *> *access = accesscache.ConvertToDArray ();
+	for ( int i = 0; i < access->Size (); ++i )
+		if ( access->ValidIndex (i) )
+			delete access->GetData (i);
+	delete access;
+
 }
 
 void Agent::SetHandle ( char *newhandle )
@@ -222,9 +239,40 @@ void Agent::GiveLink ( char *newip )
 
 }
 
+void Agent::ForgetAccess ( char *ip )
+{
+
+	AgentAccess *access = accesscache.GetData ( ip );
+	if ( access ) {
+		accesscache.RemoveData ( ip );
+		delete access;
+	}
+
+}
+
 int Agent::HasAccount  ( char *ip )
 {
 
+	if ( !codes.LookupTree ( ip ) )
+		return -1;
+
+	// Lookup the computer
+
+	VLocation *vl = game->GetWorld ()->GetVLocation ( ip );
+	if ( !vl )
+		return -1;
+
+	Computer *comp = vl->GetComputer ();
+	if ( !comp )
+		return -1;
+
+	// Each code below costs a search of the records, so reuse the last answer
+	// until the records change or we are given a new code for this ip
+
+	AgentAccess *access = accesscache.GetData ( ip );
+	if ( access && access->computer == comp && access->generation == comp->recordbank.generation )
+		return access->security;
+
 	int securityLevel = -1;
 	bool firstime = true;
 
@@ -256,16 +304,6 @@ int Agent::HasAccount  ( char *ip )
 			if ( !ParseAccessCode ( code, username, sizeof ( username ), password, sizeof ( password ) ) )
 				continue;
 
-			// Lookup the computer
-
-			VLocation *vl = game->GetWorld ()->GetVLocation ( ip );
-			if ( !vl )
-				continue;
-
-			Computer *comp = vl->GetComputer ();
-			if ( !comp )
-				continue;
-
 			// Lookup the account we have compromised
 
 			Record *rec = comp->recordbank.GetRecordFromNamePassword ( username, password );
@@ -291,6 +329,15 @@ int Agent::HasAccount  ( char *ip )
 
 	} while ( treeCode );
 
+	if ( !access ) {
+		access = new AgentAccess ();
+		accesscache.PutData ( ip, access );
+	}
+
+	access->computer = comp;
+	access->generation = comp->recordbank.generation;
+	access->security = securityLevel;
+
     return securityLevel;
 
 }
@@ -352,6 +399,8 @@ void Agent::GiveMessage ( Message *message )
 void Agent::GiveCode ( char *newip, char *newcode )
 {
 
+	ForgetAccess ( newip );
+
     // Do we already have this code?
     //
 
@@ -670,18 +719,7 @@ void Agent::AttemptMission_TraceUser ()
 			if ( al->TYPE == LOG_TYPE_DELETED &&
 				 rating.uplinkrating >= MINREQUIREDRATING_UNDELETELOGLEVEL1 ) {
 
-				if ( comp->logbank.internallogs.ValidIndex (il) ) {
-
-					AccessLog *recovered = comp->logbank.internallogs.GetData (il);
-					if ( recovered ) {
-						AccessLog *internalcopy = new AccessLog ();
-						internalcopy->SetProperties ( recovered );
-						comp->logbank.logs.PutData ( internalcopy, il );
-						delete al;
-						al = internalcopy;
-					}
-
-				}
+				al = comp->logbank.RecoverLog ( il );
 
 			}
 			else if ( al->TYPE != LOG_TYPE_DELETED &&
@@ -691,14 +729,7 @@ void Agent::AttemptMission_TraceUser ()
 
 				// Log was overwritten or modified
 
-				AccessLog *recovered = comp->logbank.internallogs.GetData (il);
-				if ( recovered ) {
-					AccessLog *internalcopy = new AccessLog ();
-					internalcopy->SetProperties ( recovered );
-					comp->logbank.logs.PutData ( internalcopy, il );
-					delete al;
-					al = internalcopy;
-				}
+				al = comp->logbank.RecoverLog ( il );
 
 			}
 
@@ -963,6 +994,8 @@ void Agent::EstablishConnection ( char *ip )
 
 				}
 
+				comp->logbank.LogChanged ( il );
+
 			}
 
 		}
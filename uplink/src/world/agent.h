@@ -20,6 +20,7 @@
 
 class Message;
 class Mission;
+struct AgentAccess;
 
 #define SIZE_AGENT_HANDLE		64
 
@@ -38,6 +39,12 @@ public:
 
 	char handle [SIZE_AGENT_HANDLE];
 
+protected:
+
+	BTree <AgentAccess *> accesscache;		// HasAccount results, indexed on ip
+
+	void ForgetAccess ( char *ip );
+
 public:
 
 	Agent ();
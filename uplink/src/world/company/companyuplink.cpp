@@ -31,10 +31,10 @@ CompanyUplink::CompanyUplink() : Company ()
 CompanyUplink::~CompanyUplink()
 {
 
-	DeleteLListData ( (LList <UplinkObject *> *) &missions );
-	DeleteLListData ( (LList <UplinkObject *> *) &sw_sales );
-	DeleteLListData ( (LList <UplinkObject *> *) &hw_sales );
-	DeleteLListData ( (LList <UplinkObject *> *) &news     );
+	DeleteDequeData ( (Deque <UplinkObject *> *) &missions );
+	DeleteDequeData ( (Deque <UplinkObject *> *) &sw_sales );
+	DeleteDequeData ( (Deque <UplinkObject *> *) &hw_sales );
+	DeleteDequeData ( (Deque <UplinkObject *> *) &news     );
 
 }
 
@@ -46,17 +46,21 @@ void CompanyUplink::CreateMission ( Mission *mission )
 	if ( mission->createdate.GetYear () == 1000 )
 		mission->SetCreateDate ( &(game->GetWorld ()->date) );
 
-	// Insert the mission in date order
+	// Insert the mission in date order, after any others created at the same time.
+	// Binary search for the first older mission
 
-	for ( int i = 0; i < missions.Size (); ++i ) {
-		if ( mission->createdate.After ( &(missions.GetData (i)->createdate) ) ) {
-			missions.PutDataAtIndex ( mission, i );
-			return;
-		}
+	int low = 0;
+	int high = missions.Size ();
+
+	while ( low < high ) {
+		int mid = ( low + high ) / 2;
+		if ( mission->createdate.After ( &(missions.GetData (mid)->createdate) ) )
+			high = mid;
+		else
+			low = mid + 1;
 	}
 
-	// If we get here, put the mission at the end of the list
-	missions.PutDataAtEnd ( mission );
+	missions.PutDataAtIndex ( mission, low );
 	
 }
 
@@ -71,20 +75,7 @@ void CompanyUplink::CreateMission ( char *employer, int payment, char *descripti
 	mission->SetDetails ( details );
 	mission->SetFullDetails ( fulldetails );
 	
-	if ( mission->createdate.GetYear () == 1000 )
-		mission->SetCreateDate ( &(game->GetWorld ()->date) );
-
-	// Insert the mission in date order
-
-	for ( int i = 0; i < missions.Size (); ++i ) {
-		if ( mission->createdate.Before ( &(missions.GetData (i)->createdate) ) ) {
-			missions.PutDataAtIndex ( mission, i );
-			return;
-		}
-	}
-
-	// If we get here, put the mission at the end of the list
-	missions.PutDataAtEnd ( mission );
+	CreateMission ( mission );
 		
 }
 
@@ -155,10 +146,10 @@ bool CompanyUplink::Load ( FILE *file )
 
 	if ( !Company::Load ( file ) ) return false;
 
-	if ( !LoadLList ( (LList <UplinkObject *> *) &missions,  file ) ) return false;
-	if ( !LoadLList ( (LList <UplinkObject *> *) &hw_sales,  file ) ) return false;
-	if ( !LoadLList ( (LList <UplinkObject *> *) &sw_sales,  file ) ) return false;
-	if ( !LoadLList ( (LList <UplinkObject *> *) &news,	   file ) ) return false;
+	if ( !LoadDeque ( (Deque <UplinkObject *> *) &missions,  file ) ) return false;
+	if ( !LoadDeque ( (Deque <UplinkObject *> *) &hw_sales,  file ) ) return false;
+	if ( !LoadDeque ( (Deque <UplinkObject *> *) &sw_sales,  file ) ) return false;
+	if ( !LoadDeque ( (Deque <UplinkObject *> *) &news,	   file ) ) return false;
 
 	LoadID_END ( file );
 
@@ -173,10 +164,10 @@ void CompanyUplink::Save  ( FILE *file )
 
 	Company::Save ( file );
 
-	SaveLList ( (LList <UplinkObject *> *) &missions,  file );
-	SaveLList ( (LList <UplinkObject *> *) &hw_sales,  file );
-	SaveLList ( (LList <UplinkObject *> *) &sw_sales,  file );
-	SaveLList ( (LList <UplinkObject *> *) &news,	   file );
+	SaveDeque ( (Deque <UplinkObject *> *) &missions,  file );
+	SaveDeque ( (Deque <UplinkObject *> *) &hw_sales,  file );
+	SaveDeque ( (Deque <UplinkObject *> *) &sw_sales,  file );
+	SaveDeque ( (Deque <UplinkObject *> *) &news,	   file );
 
 	SaveID_END ( file );
 
@@ -187,10 +178,10 @@ void CompanyUplink::Print ()
 
 	Company::Print ();
 
-	PrintLList ( (LList <UplinkObject *> *) &missions  );
-	PrintLList ( (LList <UplinkObject *> *) &hw_sales  );
-	PrintLList ( (LList <UplinkObject *> *) &sw_sales  );
-	PrintLList ( (LList <UplinkObject *> *) &news	   );
+	PrintDeque ( (Deque <UplinkObject *> *) &missions  );
+	PrintDeque ( (Deque <UplinkObject *> *) &hw_sales  );
+	PrintDeque ( (Deque <UplinkObject *> *) &sw_sales  );
+	PrintDeque ( (Deque <UplinkObject *> *) &news	   );
 
 }
 
@@ -26,10 +26,12 @@ class CompanyUplink : public Company
 
 public:
 
-	LList <Mission *> missions;
-	LList <Sale *>	  hw_sales;				// Hardware
-	LList <Sale *>	  sw_sales;				// Software
-	LList <News *>	  news;
+	// Boards are kept newest first, in deques so any index is quick to read
+
+	Deque <Mission *> missions;
+	Deque <Sale *>	  hw_sales;				// Hardware
+	Deque <Sale *>	  sw_sales;				// Software
+	Deque <News *>	  news;
 
 public:
 
@@ -11,6 +11,7 @@
 
 #include "world/world.h"
 #include "world/vlocation.h"
+#include "world/worldpartition.h"
 #include "world/player.h"
 #include "world/company/mission.h"
 #include "world/computer/computer.h"
@@ -54,6 +55,8 @@ Computer::Computer()
 	isrunning = true;
 	isinfected_revelation = 0.0;
 
+	logbank.SetComputer ( this );
+
 }
 
 Computer::~Computer()
@@ -318,6 +321,28 @@ void Computer::CheckForSecurityBreaches ()
 
 }
 
+bool Computer::HasSecurityBreaches ()
+{
+
+	if ( !isrunning || databank.formatted || security.IsAnythingDisabled () )
+		return true;
+
+	for ( int i = 0; i < logbank.logs.Size (); ++i ) {
+		if ( logbank.logs.ValidIndex (i) ) {
+
+			AccessLog *al = logbank.logs.GetData (i);
+
+			if ( al->SUSPICIOUS == LOG_SUSPICIOUS ||
+				 al->SUSPICIOUS == LOG_SUSPICIOUSANDNOTICED )
+				return true;
+
+		}
+	}
+
+	return false;
+
+}
+
 bool Computer::ChangeSecurityCodes ()
 {
 
@@ -424,6 +449,7 @@ void Computer::ManageOldLogs ()
 	//
 
 	int nextlog = 0;
+	bool moved = false;
 
 	for ( int il = 0; il < logbank.logs.Size (); ++il ) {
 
@@ -451,6 +477,7 @@ void Computer::ManageOldLogs ()
 					++nextlog;
 
 					found = true;
+					moved = true;
 					break;
 
 				}
@@ -473,6 +500,8 @@ void Computer::ManageOldLogs ()
 
 	}
 
+	if ( moved ) logbank.InvalidateIndex ();
+
 }
 
 void Computer::AddToRecentHacks ( int n )
@@ -618,6 +647,14 @@ void Computer::Print ()
 void Computer::Update ()
 {
 
+	//
+	// Suspicious logs are marked as they are made, but these
+	// are cheap enough to pick up here
+	//
+
+	if ( !isrunning || databank.formatted || security.IsAnythingDisabled () )
+		game->GetWorld ()->MarkSecurityBreach ( this );
+
 	if ( !isrunning ) return;
 
     if ( isinfected_revelation > 1.0 ) {
@@ -666,6 +703,13 @@ void Computer::Update ()
 
     }
 
+	UpdateActivity ();
+
+}
+
+void Computer::UpdateActivity ()
+{
+
 	//
 	// Generate some new files
 	//
@@ -673,7 +717,11 @@ void Computer::Update ()
 	if ( databank.NumDataFiles () > 0 && 
 		 NumberGenerator::RandomNumber ( 1000 ) == 0 ) {
 
-		Data *data = new Data ();
+		Data *data;
+		{
+			PoolArena <Data> inarena ( &databank.arena );
+			data = new Data ();
+		}
 		data->SetTitle ( NameGenerator::GenerateDataName ( "companyname", DATATYPE_DATA ) );
 		data->SetDetails ( DATATYPE_DATA, NumberGenerator::RandomNumber ( 10 ) + 1, 0, 0 );
 		if ( !databank.PutData ( data ) )
@@ -687,7 +735,11 @@ void Computer::Update ()
 
 	if ( NumberGenerator::RandomNumber ( 1000 ) == 0 ) {
 
-		AccessLog *al = new AccessLog ();
+		AccessLog *al;
+		{
+			PoolArena <AccessLog> inarena ( &logbank.arena );
+			al = new AccessLog ();
+		}
 		al->SetProperties ( &(game->GetWorld ()->date), WorldGenerator::GetRandomLocation ()->ip, " " );
 		al->SetData1 ( "Accessed File" );
 		logbank.AddLog (al);
@@ -696,6 +748,28 @@ void Computer::Update ()
 
 }
 
+void Computer::UpdatePartition ( WorldPartition *partition )
+{
+
+	UplinkAssert (partition);
+
+	// Revelation spreads to other computers and can disconnect the player,
+	// so an infected computer runs its whole Update on the main thread
+
+	if ( isrunning && isinfected_revelation > 1.0 ) {
+		partition->AddCommand ( WORLDCOMMAND_UPDATE, this );
+		return;
+	}
+
+	if ( !isrunning || databank.formatted || security.IsAnythingDisabled () )
+		partition->AddCommand ( WORLDCOMMAND_SECURITYBREACH, this );
+
+	if ( !isrunning ) return;
+
+	UpdateActivity ();
+
+}
+
 void Computer::GenerateAccessCode( char *code, char *result, size_t resultsize )
 {
     UplinkSnprintf( result, resultsize, "%s:'%s'", "CODE", code );
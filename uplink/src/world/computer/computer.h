@@ -59,6 +59,7 @@
 
 
 class ComputerScreen;
+class WorldPartition;
 
 // ============================================================================
 
@@ -120,6 +121,7 @@ public:
 
 
 	void CheckForSecurityBreaches ();				// Call me frequently
+	bool HasSecurityBreaches ();					// Anything for CheckForSecurityBreaches to act on?
 	void ManageOldLogs ();							// Call me frequently
     bool ChangeSecurityCodes ();                    // Changes passwords, returns true if changes made
 
@@ -131,6 +133,9 @@ public:
     static void GenerateAccessCode( char *name, char *code, char *result, size_t resultsize );
     static void GenerateAccessCode( int accNo, char *code, char *result, size_t resultsize );
 
+	void UpdateActivity ();							// New files and logs, from Update
+	void UpdatePartition ( WorldPartition *partition );		// Update from a worker thread
+
 	// Common functions
 
 	bool Load  ( FILE *file );
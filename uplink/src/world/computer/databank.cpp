@@ -17,7 +17,7 @@
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
-DataBank::DataBank()
+DataBank::DataBank() : arena ( DATABANK_ARENASLAB )
 {
 	
 	formatted = false;
@@ -28,6 +28,8 @@ DataBank::~DataBank()
 {
 
     DeleteDArrayData ( (DArray <UplinkObject *> *) &data );
+
+	arena.Release ();
     
 }
 
@@ -308,6 +310,8 @@ void DataBank::Format ()
 	memory.Empty ();
     memory.SetSize ( oldmemsize );
 
+	arena.Release ();
+
 	formatted = true;
 
 }
@@ -352,7 +356,12 @@ bool DataBank::Load ( FILE *file )
 	
 	LoadID ( file );
 
-	if ( !LoadDArray ( (DArray <UplinkObject *> *) &data, file ) ) return false;
+	// Every file loaded here belongs to this bank alone
+
+	{
+		PoolArena <Data> inarena ( &arena );
+		if ( !LoadDArray ( (DArray <UplinkObject *> *) &data, file ) ) return false;
+	}
 	if ( !LoadDArray ( &memory, file ) ) return false;
 
 	if ( !FileReadData ( &formatted, sizeof(formatted), 1, file ) ) return false;
@@ -412,6 +421,8 @@ void DataBank::Update ()
 // Data class =================================================================
 
 
+POOL_DEFINE ( Data, 512 )
+
 Data::Data ()
 {
 
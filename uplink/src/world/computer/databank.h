@@ -17,6 +17,9 @@
 class Data;
 
 
+#define DATABANK_ARENASLAB		8					// Files per slab of a bank's arena
+
+
 
 class DataBank : public UplinkObject  
 {
@@ -30,6 +33,8 @@ public:
 
 	bool formatted;							// Set if databank was recently wiped
 
+	Pool <Data> arena;						// Files made for this bank alone, released by Format
+
 public:
 
 	DataBank();
@@ -117,6 +122,10 @@ public:
 	Data ( Data *copyme );
 	~Data ();
 
+	// Every file on every computer - these come from a pool
+
+	POOL_MEMBERS ( Data )
+
 	void SetTitle ( char *newtitle );
 	void SetDetails ( int newTYPE, int newsize, 
 					  int newencrypted = 0, int newcompressed = 0, 
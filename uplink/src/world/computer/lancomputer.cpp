@@ -1,4 +1,5 @@
 
+#include "app/globals.h"
 #include "app/uplinkobject.h"
 #include "app/serialise.h"
 
@@ -13,6 +14,12 @@
 
 LanComputer::LanComputer () : Computer ()
 {
+
+    outStart = inStart = NULL;
+    outEdges = inEdges = NULL;
+    indexedSystems = indexedLinks = 0;
+    indexDirty = true;
+
 }
 
 LanComputer::~LanComputer ()
@@ -20,12 +27,18 @@ LanComputer::~LanComputer ()
 
     DeleteDArrayData ( (DArray <UplinkObject *> *) &systems );
     DeleteDArrayData ( (DArray <UplinkObject *> *) &links );
+
+    delete [] outStart;
+    delete [] inStart;
+    delete [] outEdges;
+    delete [] inEdges;
     
 }
 
 int LanComputer::AddLanSystem ( LanComputerSystem *system )
 {
 
+    indexDirty = true;
     return systems.PutData ( system );
 
 }
@@ -59,10 +72,225 @@ int LanComputer::AddLanLink ( int from, float fromX, float fromY,
     link->toY = toY;
 	link->port = NumberGenerator::RandomNumber ( LAN_LINKPORTRANGE );
 	link->security = security;
+
+    indexDirty = true;
     return links.PutData ( link );
 
 }
 
+void LanComputer::InvalidateIndex ()
+{
+
+    indexDirty = true;
+
+}
+
+void LanComputer::UpdateIndex ()
+{
+
+    //
+    // Anything that replaces the arrays wholesale also changes their size
+
+    if ( !indexDirty && indexedSystems == systems.Size () && indexedLinks == links.Size () )
+        return;
+
+    delete [] outStart;
+    delete [] inStart;
+    delete [] outEdges;
+    delete [] inEdges;
+
+    indexedSystems = systems.Size ();
+    indexedLinks = links.Size ();
+    indexDirty = false;
+
+    outStart = new int [indexedSystems + 1];
+    inStart = new int [indexedSystems + 1];
+    for ( int i = 0; i <= indexedSystems; ++i )
+        outStart [i] = inStart [i] = 0;
+
+    //
+    // Count the edges at each system, then turn the counts into offsets
+
+    int numEdges = 0;
+
+    for ( int i = 0; i < indexedLinks; ++i ) {
+        if ( !links.ValidIndex ( i ) ) continue;
+        LanComputerLink *link = links.GetData ( i );
+        if ( link->from < 0 || link->from >= indexedSystems ||
+             link->to < 0 || link->to >= indexedSystems ) continue;
+        ++outStart [link->from + 1];
+        ++inStart [link->to + 1];
+        ++numEdges;
+    }
+
+    for ( int i = 0; i < indexedSystems; ++i ) {
+        outStart [i + 1] += outStart [i];
+        inStart [i + 1] += inStart [i];
+    }
+
+    outEdges = new LanComputerEdge [numEdges > 0 ? numEdges : 1];
+    inEdges = new LanComputerEdge [numEdges > 0 ? numEdges : 1];
+
+    //
+    // Fill in link order, using the next offsets as cursors
+
+    int *outNext = new int [indexedSystems + 1];
+    int *inNext = new int [indexedSystems + 1];
+    for ( int i = 0; i <= indexedSystems; ++i ) {
+        outNext [i] = outStart [i];
+        inNext [i] = inStart [i];
+    }
+
+    for ( int i = 0; i < indexedLinks; ++i ) {
+        if ( !links.ValidIndex ( i ) ) continue;
+        LanComputerLink *link = links.GetData ( i );
+        if ( link->from < 0 || link->from >= indexedSystems ||
+             link->to < 0 || link->to >= indexedSystems ) continue;
+
+        LanComputerEdge *out = &outEdges [outNext [link->from]++];
+        out->system = link->to;
+        out->link = i;
+        out->security = link->security;
+        out->port = link->port;
+
+        LanComputerEdge *in = &inEdges [inNext [link->to]++];
+        in->system = link->from;
+        in->link = i;
+        in->security = link->security;
+        in->port = link->port;
+    }
+
+    delete [] outNext;
+    delete [] inNext;
+
+}
+
+int LanComputer::NumOutEdges ( int system )
+{
+
+    UpdateIndex ();
+    if ( system < 0 || system >= indexedSystems ) return 0;
+    return outStart [system + 1] - outStart [system];
+
+}
+
+int LanComputer::NumInEdges ( int system )
+{
+
+    UpdateIndex ();
+    if ( system < 0 || system >= indexedSystems ) return 0;
+    return inStart [system + 1] - inStart [system];
+
+}
+
+LanComputerEdge *LanComputer::GetOutEdges ( int system )
+{
+
+    UpdateIndex ();
+    if ( system < 0 || system >= indexedSystems ) return NULL;
+    return &outEdges [outStart [system]];
+
+}
+
+LanComputerEdge *LanComputer::GetInEdges ( int system )
+{
+
+    UpdateIndex ();
+    if ( system < 0 || system >= indexedSystems ) return NULL;
+    return &inEdges [inStart [system]];
+
+}
+
+static int SearchLan ( LanComputer *lan, int from, int to, int *queue, int *parent, LanLinkFilter filter )
+{
+
+    //
+    // Breadth first from "from", stopping early if "to" is reached
+    // Fills queue in visiting order, parent [s] is -1 for unvisited systems
+    // Returns the number of systems visited
+
+    int numSystems = lan->systems.Size ();
+    for ( int i = 0; i < numSystems; ++i )
+        parent [i] = -1;
+
+    if ( from < 0 || from >= numSystems || !lan->systems.ValidIndex ( from ) ) return 0;
+
+    int head = 0;
+    int tail = 0;
+    queue [tail++] = from;
+    parent [from] = from;
+
+    while ( head < tail ) {
+
+        int current = queue [head++];
+        if ( current == to ) break;
+
+        for ( int direction = 0; direction < 2; ++direction ) {
+
+            int numEdges = direction == 0 ? lan->NumOutEdges ( current ) : lan->NumInEdges ( current );
+            LanComputerEdge *edges = direction == 0 ? lan->GetOutEdges ( current ) : lan->GetInEdges ( current );
+
+            for ( int i = 0; i < numEdges; ++i ) {
+                int next = edges [i].system;
+                if ( parent [next] != -1 || !lan->systems.ValidIndex ( next ) ) continue;
+                if ( filter && !filter ( lan->links.GetData ( edges [i].link ) ) ) continue;
+                parent [next] = current;
+                queue [tail++] = next;
+            }
+
+        }
+
+    }
+
+    return tail;
+
+}
+
+void LanComputer::GetReachableSystems ( int from, LList <int> *result, LanLinkFilter filter )
+{
+
+    UplinkAssert ( result );
+
+    int numSystems = systems.Size ();
+    int *queue = new int [numSystems > 0 ? numSystems : 1];
+    int *parent = new int [numSystems > 0 ? numSystems : 1];
+
+    int numVisited = SearchLan ( this, from, -1, queue, parent, filter );
+    for ( int i = 0; i < numVisited; ++i )
+        result->PutData ( queue [i] );
+
+    delete [] queue;
+    delete [] parent;
+
+}
+
+bool LanComputer::GetShortestPath ( int from, int to, LList <int> *path, LanLinkFilter filter )
+{
+
+    UplinkAssert ( path );
+
+    int numSystems = systems.Size ();
+    if ( to < 0 || to >= numSystems ) return false;
+
+    int *queue = new int [numSystems > 0 ? numSystems : 1];
+    int *parent = new int [numSystems > 0 ? numSystems : 1];
+
+    SearchLan ( this, from, to, queue, parent, filter );
+    bool found = parent [to] != -1;
+
+    if ( found ) {
+        for ( int current = to; current != from; current = parent [current] )
+            path->PutDataAtStart ( current );
+        path->PutDataAtStart ( from );
+    }
+
+    delete [] queue;
+    delete [] parent;
+
+    return found;
+
+}
+
 bool LanComputer::Load  ( FILE *file )
 {
 
@@ -73,6 +301,8 @@ bool LanComputer::Load  ( FILE *file )
     if ( !LoadDArray ( (DArray <UplinkObject *> *) &systems, file ) ) return false;
     if ( !LoadDArray ( (DArray <UplinkObject *> *) &links, file ) ) return false;
 
+    indexDirty = true;
+
     LoadID_END ( file );
 
 	return true;
@@ -229,9 +459,13 @@ int LanComputerSystem::GetOBJECTID ()
 // ============================================================================
 
 
+int LanComputerLink::changes = 0;
+
 LanComputerLink::LanComputerLink ()
 {
 
+    ++changes;
+
     visible = LANLINKVISIBLE_NONE;
     from = -1;
     to = -1;
@@ -248,8 +482,10 @@ LanComputerLink::~LanComputerLink ()
 void LanComputerLink::IncreaseVisibility( int newValue )
 {
 
-    if ( newValue > visible )
+    if ( newValue > visible ) {
         visible = newValue;
+        ++changes;
+    }
 
 }
 
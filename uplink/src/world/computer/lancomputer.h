@@ -19,6 +19,21 @@ class LanComputerSystem;
 class LanComputerLink;
 
 
+// One end of a link, as seen from a system in the adjacency index
+
+struct LanComputerEdge
+{
+
+    int system;                                     // The system at the other end
+    int link;                                       // Index into links
+    int security;
+    int port;
+
+};
+
+typedef bool (*LanLinkFilter) ( LanComputerLink *link );
+
+
 // ============================================================================
 
 
@@ -31,6 +46,22 @@ public:
     DArray <LanComputerSystem *> systems;
     DArray <LanComputerLink *> links;
 
+protected:
+
+    // Adjacency index over links, in compressed rows
+    // The out edges of system s are outEdges [outStart[s]] to outEdges [outStart[s+1] - 1]
+
+    int *outStart;
+    int *inStart;
+    LanComputerEdge *outEdges;
+    LanComputerEdge *inEdges;
+
+    int indexedSystems;
+    int indexedLinks;
+    bool indexDirty;
+
+    void UpdateIndex ();
+
 public:
 
     LanComputer ();
@@ -41,6 +72,18 @@ public:
     int AddLanLink ( int from, float fromX, float fromY, 
                      int to, float toX, float toY, int security = 1 );
 
+    void InvalidateIndex ();                                    // Call after changing systems or links directly
+
+    int NumOutEdges ( int system );                             // Links from this system, in link order
+    int NumInEdges ( int system );                              // Links to this system, in link order
+    LanComputerEdge *GetOutEdges ( int system );                // Valid until systems or links change
+    LanComputerEdge *GetInEdges ( int system );
+
+    // Queries following links in either direction, through links the filter accepts (all if NULL)
+
+    void GetReachableSystems ( int from, LList <int> *result, LanLinkFilter filter = NULL );       // Breadth first order
+    bool GetShortestPath ( int from, int to, LList <int> *path, LanLinkFilter filter = NULL );      // Fewest links, from and to included
+
 	// Common functions
 
 	bool Load  ( FILE *file );
@@ -150,6 +193,8 @@ public:
     float toX;
     float toY;
 
+    static int changes;                             // Bumped when any link is created or becomes more visible
+
 public:
 
     LanComputerLink ();
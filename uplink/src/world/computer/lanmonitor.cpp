@@ -170,31 +170,35 @@ void LanMonitor::ExtendConnection ( int newNode )
 		return;
 
 	int linkHead = connection.GetData(linkHeadIndex);
-	
-	for ( int i = 0; i < lanComputer->links.Size(); ++i ) {
-		if ( lanComputer->links.ValidIndex(i) ) {
-		
-			LanComputerLink *link = lanComputer->links.GetData(i);
-			UplinkAssert(link);
-
-			if ( ( (link->from == linkHead && link->to == newNode) ||
-                   (link->to == linkHead && link->from == newNode) ) &&
-			 	 link->visible == LANLINKVISIBLE_AWARE ) {
 
-				if ( lanComputer->systems.ValidIndex ( newNode ) ) {
-					connection.PutDataAtEnd( newNode );
-					lanComputer->systems.GetData( newNode )->IncreaseVisibility( LANSYSTEMVISIBLE_TYPE );
-				}
+	bool linked = false;
 
-				break;
+	LanComputerEdge *edges = lanComputer->GetOutEdges ( linkHead );
+	for ( int i = 0; !linked && i < lanComputer->NumOutEdges ( linkHead ); ++i )
+		linked = edges[i].system == newNode &&
+				 lanComputer->links.GetData ( edges[i].link )->visible == LANLINKVISIBLE_AWARE;
 
-			}
+	edges = lanComputer->GetInEdges ( linkHead );
+	for ( int i = 0; !linked && i < lanComputer->NumInEdges ( linkHead ); ++i )
+		linked = edges[i].system == newNode &&
+				 lanComputer->links.GetData ( edges[i].link )->visible == LANLINKVISIBLE_AWARE;
 
-		}
+	if ( linked && lanComputer->systems.ValidIndex ( newNode ) ) {
+		connection.PutDataAtEnd( newNode );
+		lanComputer->systems.GetData( newNode )->IncreaseVisibility( LANSYSTEMVISIBLE_TYPE );
 	}
 
 }
 
+// Links the sysadmin follows - both ends on the player's connection
+
+static bool ConnectionLink ( LanComputerLink *link )
+{
+
+	return LanMonitor::IsInConnection ( link->from ) && LanMonitor::IsInConnection ( link->to );
+
+}
+
 void LanMonitor::ForceExtendConnection ( int newNode )
 {
 
@@ -277,24 +281,17 @@ bool LanMonitor::IsAccessable ( int newNode )
     if ( newNode != currentSystem ) {
 
         bool knownLinks = false;
-        for ( int i = 0; i < lanComputer->links.Size(); ++i ) {
-            if ( lanComputer->links.ValidIndex(i) ) {
-                LanComputerLink *link = lanComputer->links.GetData(i);
-                UplinkAssert (link);
-                
-                if ( (link->to == newNode && link->visible == LANLINKVISIBLE_TOAWARE) ||
-                     (link->from == newNode && link->visible == LANLINKVISIBLE_FROMAWARE) ) {
-                     knownLinks = true;
-                     break;
-                }
-            
-                if ( (link->to == newNode || link->from == newNode) &&
-                    link->visible == LANLINKVISIBLE_AWARE ) {
-                    knownLinks = true;
-                    break;
-                }
 
-            }
+        LanComputerEdge *edges = lanComputer->GetInEdges ( newNode );
+        for ( int i = 0; !knownLinks && i < lanComputer->NumInEdges ( newNode ); ++i ) {
+            int visible = lanComputer->links.GetData ( edges[i].link )->visible;
+            knownLinks = visible == LANLINKVISIBLE_TOAWARE || visible == LANLINKVISIBLE_AWARE;
+        }
+
+        edges = lanComputer->GetOutEdges ( newNode );
+        for ( int i = 0; !knownLinks && i < lanComputer->NumOutEdges ( newNode ); ++i ) {
+            int visible = lanComputer->links.GetData ( edges[i].link )->visible;
+            knownLinks = visible == LANLINKVISIBLE_FROMAWARE || visible == LANLINKVISIBLE_AWARE;
         }
 
         if ( !knownLinks ) return false;
@@ -424,15 +421,19 @@ void LanMonitor::Update ()
             else {
 
                 if ( EclGetAccurateTime() >= sysAdminTimer ) {
-                    int nodeIndex = GetNodeIndex( sysAdminCurrentSystem );
-                    if ( nodeIndex == -1 ) 
+
+                    //
+                    // One system closer along the player's connection,
+                    // cutting across any link between two systems on it
+
+                    LList <int> path;
+                    if ( !IsInConnection ( sysAdminCurrentSystem ) ||
+                         !lanComputer->GetShortestPath ( sysAdminCurrentSystem, currentSystem, &path, ConnectionLink ) ||
+                         path.Size() < 2 )
                         sysAdminState = SYSADMIN_CURIOUS;
-                    else {
-                        if ( connection.ValidIndex(nodeIndex+1) )
-                            sysAdminCurrentSystem = connection.GetData(nodeIndex+1);
-                        else
-                            sysAdminState = SYSADMIN_CURIOUS;
-                    }
+                    else
+                        sysAdminCurrentSystem = path.GetData(1);
+
                     int timeToDiscover = (int) NumberGenerator::RandomNormalNumber( 10, 5 );
                     sysAdminTimer = (int) ( EclGetAccurateTime() + timeToDiscover * 1000 );
                 }
@@ -20,8 +20,12 @@
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
-LogBank::LogBank ()
+LogBank::LogBank () : arena ( LOGBANK_ARENASLAB )
 {
+
+	indexvalid = false;
+	computer = NULL;
+
 }
 
 LogBank::~LogBank ()
@@ -30,6 +34,166 @@ LogBank::~LogBank ()
     DeleteDArrayData ( (DArray <UplinkObject *> *) &logs );
     DeleteDArrayData ( (DArray <UplinkObject *> *) &internallogs );
 
+	EmptyIndex ();
+
+	arena.Release ();
+
+}
+
+static bool PackDate ( Date *date, long long *packed )
+{
+
+	// Orders the same as Date::Before/After, as long as each field is in range
+
+	int year = date->GetYear ();
+	int month = date->GetMonth ();
+	int day = date->GetDay ();
+	int hour = date->GetHour ();
+	int minute = date->GetMinute ();
+	int second = date->GetSecond ();
+
+	if ( year < 0 || year >= 16384 || month < 0 || month >= 16 || day < 0 || day >= 32 ||
+		 hour < 0 || hour >= 32 || minute < 0 || minute >= 64 || second < 0 || second >= 64 )
+		return false;
+
+	*packed = ( ( ( ( (long long) year * 16 + month ) * 32 + day ) * 32 + hour ) * 64 + minute ) * 64 + second;
+	return true;
+
+}
+
+static int LowerBound ( Deque <long long> *entries, long long key )
+{
+
+	int low = 0;
+	int high = entries->Size ();
+
+	while ( low < high ) {
+		int mid = ( low + high ) / 2;
+		if ( entries->GetData (mid) < key )	low = mid + 1;
+		else								high = mid;
+	}
+
+	return low;
+
+}
+
+static int CompareIndex ( const void *a, const void *b )
+{
+
+	return *(const int *) a - *(const int *) b;
+
+}
+
+void LogBank::IndexLog ( AccessLog *log, int index )
+{
+
+	if ( !log || !log->data1 ) return;
+	if ( log->TYPE != LOG_TYPE_BOUNCE && log->TYPE != LOG_TYPE_BOUNCEBEGIN ) return;
+
+	long long packed;
+	if ( index < 0 || index >= ( 1 << LOGBANK_INDEXBITS ) || !PackDate ( &log->date, &packed ) ) {
+		uncheckedlogs.PutData ( index );
+		return;
+	}
+
+	Deque <long long> *entries = bounces.GetData ( log->data1 );
+	if ( !entries ) {
+		entries = new Deque <long long> ();
+		bounces.PutData ( log->data1, entries );
+	}
+
+	// Logs are mostly added in date order, so this is usually the end
+
+	long long key = ( packed << LOGBANK_INDEXBITS ) | index;
+	int position = LowerBound ( entries, key );
+	if ( position < entries->Size () && entries->GetData (position) == key ) return;
+	entries->PutDataAtIndex ( key, position );
+
+}
+
+void LogBank::RebuildIndex ()
+{
+
+	EmptyIndex ();
+
+	for ( int i = 0; i < logs.Size (); ++i ) {
+		if ( logs.ValidIndex (i) ) {
+
+			AccessLog *al = logs.GetData (i);
+			IndexLog ( al, i );
+
+			if ( al->TYPE == LOG_TYPE_DELETED || LogModified (i) )
+				uncheckedlogs.PutData ( i );
+
+		}
+	}
+
+	for ( int i = 0; i < internallogs.Size (); ++i )
+		if ( internallogs.ValidIndex (i) )
+			IndexLog ( internallogs.GetData (i), i );
+
+	indexvalid = true;
+
+}
+
+void LogBank::EmptyIndex ()
+{
+
+	DArray <Deque <long long> *> *entries = bounces.ConvertToDArray ();
+	for ( int i = 0; i < entries->Size (); ++i )
+		if ( entries->ValidIndex (i) )
+			delete entries->GetData (i);
+	delete entries;
+
+	bounces.Empty ();
+	uncheckedlogs.Empty ();
+	indexvalid = false;
+
+}
+
+void LogBank::SetComputer ( Computer *newcomputer )
+{
+
+	computer = newcomputer;
+
+}
+
+void LogBank::MarkBreach ( AccessLog *log )
+{
+
+	// Logs are only made suspicious on the main thread - the update
+	// threads' activity logs never are
+
+	if ( computer && log &&
+		 ( log->SUSPICIOUS == LOG_SUSPICIOUS || log->SUSPICIOUS == LOG_SUSPICIOUSANDNOTICED ) )
+		game->GetWorld ()->MarkSecurityBreach ( computer );
+
+}
+
+void LogBank::LogChanged ( int index )
+{
+
+	if ( logs.ValidIndex (index) ) MarkBreach ( logs.GetData (index) );
+
+	if ( !indexvalid ) return;
+
+	if ( logs.ValidIndex (index) )			IndexLog ( logs.GetData (index), index );
+	if ( internallogs.ValidIndex (index) )	IndexLog ( internallogs.GetData (index), index );
+
+	uncheckedlogs.PutData ( index );
+
+	// Past this point a rebuild is cheaper than checking them all on every trace
+
+	if ( uncheckedlogs.Size () > logs.Size () + 64 )
+		indexvalid = false;
+
+}
+
+void LogBank::InvalidateIndex ()
+{
+
+	indexvalid = false;
+
 }
 
 void LogBank::AddLog ( AccessLog *log, int index )
@@ -46,12 +210,46 @@ void LogBank::AddLog ( AccessLog *log, int index )
 
 	// Add the log into the internal structure
 
-	AccessLog *internalcopy = new AccessLog ();
+	AccessLog *internalcopy;
+	{
+		PoolArena <AccessLog> inarena ( &arena );
+		internalcopy = new AccessLog ();
+	}
 	internalcopy->SetProperties ( log );
 
 	internallogs.SetSize ( logs.Size () );
 	internallogs.PutData ( internalcopy, index );
 
+	if ( indexvalid ) IndexLog ( log, index );
+
+	MarkBreach ( log );
+
+}
+
+AccessLog *LogBank::RecoverLog ( int index )
+{
+
+	if ( !logs.ValidIndex (index) ) return NULL;
+
+	AccessLog *log = logs.GetData (index);
+	AccessLog *recovered = internallogs.ValidIndex (index) ? internallogs.GetData (index) : NULL;
+	if ( !recovered ) return log;
+
+	// The original is in the bounce index already, from internallogs
+
+	AccessLog *internalcopy;
+	{
+		PoolArena <AccessLog> inarena ( &arena );
+		internalcopy = new AccessLog ();
+	}
+	internalcopy->SetProperties ( recovered );
+	logs.PutData ( internalcopy, index );
+	delete log;
+
+	MarkBreach ( internalcopy );
+
+	return internalcopy;
+
 }
 
 bool LogBank::LogModified ( int index )
@@ -76,12 +274,31 @@ bool LogBank::LogModified ( int index )
 }
 
 char *LogBank::TraceLog ( char *to_ip, char *logbank_ip, Date *date, int uplinkrating )
+{
+
+	LList <char *> visited;
+	return TraceLog ( to_ip, logbank_ip, date, uplinkrating, &visited );
+
+}
+
+char *LogBank::TraceLog ( char *to_ip, char *logbank_ip, Date *date, int uplinkrating, LList <char *> *visited )
 {
 
 	UplinkAssert ( to_ip );
 	UplinkAssert ( logbank_ip );
 	UplinkAssert ( date );
 
+	// Bounce logs can form a loop - the same hop would give the same answer,
+	// so stop rather than going round forever (visited holds to_ip, logbank_ip pairs)
+
+	for ( int v = 0; v + 1 < visited->Size (); v += 2 )
+		if ( strcmp ( visited->GetData (v), to_ip ) == 0 &&
+			 strcmp ( visited->GetData (v + 1), logbank_ip ) == 0 )
+			return NULL;
+
+	visited->PutData ( to_ip );
+	visited->PutData ( logbank_ip );
+
 	//
 	// Get some information regarding the local machine
 	//
@@ -93,11 +310,66 @@ char *LogBank::TraceLog ( char *to_ip, char *logbank_ip, Date *date, int uplinkr
 	Company *company_local = game->GetWorld ()->GetCompany ( comp_local->companyname );
 	UplinkAssert (company_local);
 
+	// Only look at logs within a few seconds of the connection date
+	// (Otherwise it could be from anywhere)
+
+	Date upperdate;
+	Date lowerdate;
+
+	upperdate.SetDate ( date );
+	lowerdate.SetDate ( date );
+
+	upperdate.AdvanceSecond ( 10 );
+	lowerdate.AdvanceSecond ( -10 );
+
+	// Candidates are the indexed bounces to to_ip inside that window, plus any
+	// log this trace could restore, in index order - every other log is skipped
+	// by the checks below anyway
+
+	if ( !indexvalid ) RebuildIndex ();
+
+	long long lowerpacked, upperpacked;
+	bool indexed = PackDate ( &lowerdate, &lowerpacked ) && PackDate ( &upperdate, &upperpacked );
+
+	int numcandidates = 0;
+	int *candidates = NULL;
+
+	if ( indexed ) {
+
+		Deque <long long> *entries = bounces.GetData ( to_ip );
+		int first = 0, last = 0;
+		if ( entries ) {
+			first = LowerBound ( entries, ( lowerpacked + 1 ) << LOGBANK_INDEXBITS );
+			last  = LowerBound ( entries, upperpacked << LOGBANK_INDEXBITS );
+		}
+
+		candidates = new int [ ( last - first ) + uncheckedlogs.Size () + 1 ];
+
+		for ( int e = first; e < last; ++e )
+			candidates [numcandidates++] = (int) ( entries->GetData (e) & ( ( 1 << LOGBANK_INDEXBITS ) - 1 ) );
+		for ( int u = 0; u < uncheckedlogs.Size (); ++u )
+			candidates [numcandidates++] = uncheckedlogs.GetData (u);
+
+		qsort ( candidates, numcandidates, sizeof(int), CompareIndex );
+
+	}
+	else {
+
+		candidates = new int [ logs.Size () + 1 ];
+		for ( int i = 0; i < logs.Size (); ++i )
+			candidates [numcandidates++] = i;
+
+	}
+
 	// Try to find a log that showed a user bouncing from this machine
 	// to to_ip.
 	// Then recurse into that source log.
 
-	for ( int i = 0; i < logs.Size (); ++i ) {
+	for ( int c = 0; c < numcandidates; ++c ) {
+
+		int i = candidates [c];
+		if ( c > 0 && i == candidates [c - 1] ) continue;
+
 		if ( logs.ValidIndex (i) ) {
 
 			AccessLog *al = logs.GetData (i);
@@ -107,18 +379,7 @@ char *LogBank::TraceLog ( char *to_ip, char *logbank_ip, Date *date, int uplinkr
 			if ( al->TYPE == LOG_TYPE_DELETED &&
 			     uplinkrating >= MINREQUIREDRATING_UNDELETELOGLEVEL1 ) {
 
-				if ( internallogs.ValidIndex (i) ) {
-
-					AccessLog *recovered = internallogs.GetData (i);
-					if ( recovered ) {
-						AccessLog *internalcopy = new AccessLog ();
-						internalcopy->SetProperties ( recovered );
-						logs.PutData ( internalcopy, i );
-						delete al;
-						al = internalcopy;
-					}
-
-				}
+				al = RecoverLog (i);
 
 			}
 			else if ( al->TYPE != LOG_TYPE_DELETED &&
@@ -127,33 +388,10 @@ char *LogBank::TraceLog ( char *to_ip, char *logbank_ip, Date *date, int uplinkr
 
 				// This one isn't deleted but overwritten, however the origional still exists
 
-				if ( internallogs.ValidIndex (i) ) {
-
-					AccessLog *recovered = internallogs.GetData (i);
-					if ( recovered ) {
-						AccessLog *internalcopy = new AccessLog ();
-						internalcopy->SetProperties ( recovered );
-						logs.PutData ( internalcopy, i );
-						delete al;
-						al = internalcopy;
-					}
-
-				}
+				al = RecoverLog (i);
 
 			}
 
-			// Only look at the log if it is within a few seconds of the connection date
-			// (Otherwise it could be from anywhere)
-
-			Date upperdate;
-			Date lowerdate;
-
-			upperdate.SetDate ( date );
-			lowerdate.SetDate ( date );
-
-			upperdate.AdvanceSecond ( 10 );
-			lowerdate.AdvanceSecond ( -10 );
-
 			if ( al->date.After ( &lowerdate ) &&
 				 al->date.Before ( &upperdate ) ) {
 
@@ -164,6 +402,7 @@ char *LogBank::TraceLog ( char *to_ip, char *logbank_ip, Date *date, int uplinkr
 
 					// This computer is the origin of the bounced call
 					// And is therefore the solution to this trace
+					delete [] candidates;
 					return logbank_ip;
 
 				}
@@ -182,8 +421,10 @@ char *LogBank::TraceLog ( char *to_ip, char *logbank_ip, Date *date, int uplinkr
 							bool isgov  = company_local->TYPE == COMPANYTYPE_GOVERNMENT;
 
 							if ( (!isbank || (isbank && uplinkrating >= MINREQUIREDRATING_HACKBANKSERVER)) &&
-								 (!isgov  || (isgov  && uplinkrating >= MINREQUIREDRATING_HACKGOVERNMENTCOMPUTER )) )
-								return comp->logbank.TraceLog ( logbank_ip, comp->ip, date, uplinkrating );
+								 (!isgov  || (isgov  && uplinkrating >= MINREQUIREDRATING_HACKGOVERNMENTCOMPUTER )) ) {
+								delete [] candidates;
+								return comp->logbank.TraceLog ( logbank_ip, comp->ip, date, uplinkrating, visited );
+							}
 
 						}
 
@@ -194,8 +435,11 @@ char *LogBank::TraceLog ( char *to_ip, char *logbank_ip, Date *date, int uplinkr
 			}
 
 		}
+
 	}
 
+	delete [] candidates;
+
 	//
 	// That log doesn't exist, or it can't be traced further
 	// (this is the end of the trail).
@@ -219,6 +463,10 @@ void LogBank::Empty ()
     logs.Empty ();
     internallogs.Empty ();
 
+	EmptyIndex ();
+
+	arena.Release ();
+
 }
 
 bool LogBank::Load ( FILE *file )
@@ -226,6 +474,12 @@ bool LogBank::Load ( FILE *file )
 
 	LoadID ( file );
 
+	InvalidateIndex ();
+
+	// Every log loaded here belongs to this bank alone
+
+	PoolArena <AccessLog> inarena ( &arena );
+
 	int size;
 	if ( !FileReadData ( &size, sizeof(size), 1, file ) ) return false;
 
@@ -388,6 +642,8 @@ int LogBank::GetOBJECTID ()
 
 
 
+POOL_DEFINE ( AccessLog, 1024 )
+
 AccessLog::AccessLog()
 {
 
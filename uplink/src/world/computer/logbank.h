@@ -18,6 +18,10 @@
 #include "world/person.h"
 
 class AccessLog;
+class Computer;
+
+#define LOGBANK_INDEXBITS		18							// MAX_ITEMS_DATA_STRUCTURE fits
+#define LOGBANK_ARENASLAB		16							// Logs per slab of a bank's arena
 	
 // ============================================================================
 
@@ -30,11 +34,34 @@ public:
 	DArray <AccessLog *> logs;
 	DArray <AccessLog *> internallogs;						// Never delete from here
 
+	Pool <AccessLog> arena;									// Logs made for this bank alone, released by Empty
+
+protected:
+
+	// Bounce logs by target IP (data1), as sorted ( packed date << LOGBANK_INDEXBITS | index ).
+	// Covers logs and internallogs and may hold stale entries - TraceLog rechecks every hit.
+	// Deleted and modified logs can be restored by a trace, so are always checked
+
+	BTree <Deque <long long> *> bounces;
+	Deque <int> uncheckedlogs;
+	bool indexvalid;
+
+	Computer *computer;										// Marked for the breach sweep by suspicious logs - NULL for account logs
+
+	void MarkBreach ( AccessLog *log );						// If the log is one for CheckForSecurityBreaches
+	void IndexLog ( AccessLog *log, int index );
+	void RebuildIndex ();
+	void EmptyIndex ();
+
+	char *TraceLog ( char *to_ip, char *logbank_ip, Date *date, int uplinkrating, LList <char *> *visited );
+
 public:
 
 	LogBank ();
 	~LogBank ();
 
+	void SetComputer ( Computer *newcomputer );
+
 	void AddLog ( AccessLog *log, int index = -1 );			// Adds to both
 
 	bool LogModified ( int index );							// Is the log in internallogs different to that in logs?
@@ -42,6 +69,11 @@ public:
 	char *TraceLog ( char *to_ip, char *logbank_ip, Date *date, int uplinkrating );		
 															// ie source->logbank_ip->to_ip; lookup source and return (recursive)
 
+	AccessLog *RecoverLog ( int index );					// Puts back the original of the log at index, from internallogs
+
+	void LogChanged ( int index );							// Call after changing logs/internallogs at index directly
+	void InvalidateIndex ();								// Call after moving logs between indices
+
     void Empty ();
 
 	// Common functions
@@ -109,6 +141,10 @@ public:
 	AccessLog();
 	virtual ~AccessLog();
 
+	// Logs are created and thrown away constantly, so come from a pool
+
+	POOL_MEMBERS ( AccessLog )
+
 	void SetProperties ( Date *newdate, char *newfromip, char *newfromname,
 						 int newSUSPICIOUS = LOG_NOTSUSPICIOUS,
 						 int newTYPE = LOG_TYPE_TEXT );
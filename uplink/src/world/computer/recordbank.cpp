@@ -2,6 +2,8 @@
 //
 //////////////////////////////////////////////////////////////////////
 
+#include <atomic>
+
 #include "gucci.h"
 
 #include "app/app.h"
@@ -14,9 +16,13 @@
 #include "mmgr.h"
 
 
+static std::atomic <int> lastgeneration ( 0 );			// Banks change on the world update threads
+
 RecordBank::RecordBank ()
 {
 
+	generation = ++lastgeneration;
+
 }
 
 
@@ -33,6 +39,9 @@ void RecordBank::AddRecord ( Record *newrecord )
 	UplinkAssert (newrecord);
 	records.PutData ( newrecord );
 
+	newrecord->bank = this;
+	RecordChanged ();
+
 }
 
 void RecordBank::AddRecordSorted ( Record *newrecord, char *sortfield )
@@ -63,6 +72,16 @@ void RecordBank::AddRecordSorted ( Record *newrecord, char *sortfield )
 			
 	if ( !inserted ) records.PutDataAtEnd ( newrecord );
 
+	newrecord->bank = this;
+	RecordChanged ();
+
+}
+
+void RecordBank::RecordChanged ()
+{
+
+	generation = ++lastgeneration;
+
 }
 
 char * RecordBank::MakeSafeField( char * fieldval )
@@ -302,6 +321,12 @@ bool RecordBank::Load ( FILE *file )
 
 	if ( !LoadLList ( (LList <UplinkObject *> *) &records, file ) ) return false;
 
+	for ( int i = 0; i < records.Size (); ++i )
+		if ( records.GetData (i) )
+			records.GetData (i)->bank = this;
+
+	RecordChanged ();
+
 	LoadID_END ( file );
 
 	return true;
@@ -348,9 +373,13 @@ int RecordBank::GetOBJECTID ()
 
 //////////////////////////////////////////////////////////////////////
 
+POOL_DEFINE ( Record, 1024 )
+
 Record::Record()
 {
 
+	bank = NULL;
+
 }
 
 Record::~Record()
@@ -367,6 +396,8 @@ void Record::AddField ( char *name, char *value )
 	UplinkSafeStrcpy ( newvalue, value );
 	fields.PutData ( name, newvalue );
 
+	if ( bank ) bank->RecordChanged ();
+
 }
 
 void Record::AddField ( char *name, int value )
@@ -377,6 +408,8 @@ void Record::AddField ( char *name, int value )
 	UplinkSnprintf ( newvalue, newvaluesize, "%d", value );
 	fields.PutData ( name, newvalue );
 
+	if ( bank ) bank->RecordChanged ();
+
 }
 
 void Record::ChangeField ( char *name, char *newvalue )
@@ -391,6 +424,8 @@ void Record::ChangeField ( char *name, char *newvalue )
 		tree->data = new char [tree__datasize];
 		UplinkStrncpy ( tree->data, newvalue, tree__datasize );
 
+		if ( bank ) bank->RecordChanged ();
+
 	}
 	else {
 
@@ -413,6 +448,8 @@ void Record::ChangeField ( char *name, int newvalue )
 		tree->data = new char [tree__datasize];
 		UplinkSnprintf ( tree->data, tree__datasize, "%d", newvalue );
 
+		if ( bank ) bank->RecordChanged ();
+
 	}
 	else {
 
@@ -448,6 +485,8 @@ void Record::DeleteField ( char *name )
 
 	fields.RemoveData ( name );
 
+	if ( bank ) bank->RecordChanged ();
+
 }
 
 int RecordBank::FindNextRecordIndexNameNotSystemAccount ( int curindex )
@@ -45,11 +45,15 @@ public:
 
 	LList <Record *> records;
 
+	int generation;											// Changes whenever a record is added or changed,
+															// never repeats across banks
 public:
 
 	RecordBank ();
 	~RecordBank ();
 
+	void RecordChanged ();
+
 	// Data access functions
 
 	void AddRecord ( Record *newrecord );
@@ -98,12 +102,17 @@ class Record : public UplinkObject
 public:
 
 	BTree <char *> fields;
+	RecordBank *bank;										// The bank holding this record, if any
 
 public:
 
 	Record();
 	virtual ~Record();
 
+	// Record banks hold thousands of these, so they come from a pool
+
+	POOL_MEMBERS ( Record )
+
 	void AddField    ( char *name, char *value );
 	void AddField    ( char *name, int value );
 	
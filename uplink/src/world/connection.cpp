@@ -328,6 +328,8 @@ void Connection::Disconnect ()
 					if ( comp->logbank.internallogs.ValidIndex (i) )
 						comp->logbank.internallogs.GetData (i)->SetSuspicious ( LOG_SUSPICIOUS );
 
+					comp->logbank.LogChanged (i);
+
 					// Add in the connection closed log, not suspicious
 					comp->logbank.AddLog ( log1 );
 
@@ -16,6 +16,7 @@
 #include "world/world.h"
 #include "world/generator/worldgenerator.h"
 #include "world/generator/langenerator.h"
+#include "world/generator/lantemplate.h"
 #include "world/generator/namegenerator.h"
 #include "world/generator/numbergenerator.h"
 
@@ -47,47 +48,63 @@ void LanGenerator::Initialise ()
 
 Computer  *LanGenerator::LoadLAN ( char *filename )
 {
-	idos2unixstream thefile(RsArchiveFileOpen ( filename) );
 
-	if ( thefile.eof() ) {
+	//
+	// Use the compiled template beside the text file if there is one,
+	// otherwise compile the text now
+
+	char templatename [256];
+	LanTemplate::TemplateFilename ( filename, templatename, sizeof ( templatename ) );
+
+	int size = 0;
+	char *data = RsArchiveFileData ( templatename, &size );
+	char *compiled = NULL;
 
-		thefile.close ();
-		RsArchiveFileClose ( filename );
-		return NULL;
+	char textpath [256];
+	UplinkSnprintf ( textpath, sizeof ( textpath ), "%s%s", app->path, filename );
 
+	if ( data && !LanTemplate::IsValid ( data, size ) ) {
+		printf ( "LanGenerator::LoadLAN WARNING: Ignoring invalid template %s\n", templatename );
+		data = NULL;
+	}
+	else if ( data && LanTemplate::IsStaleFor ( data, textpath ) ) {
+		printf ( "LanGenerator::LoadLAN WARNING: Template %s is out of date, using the text\n", templatename );
+		data = NULL;
 	}
 
-	//
-	// Load the header information
+	if ( !data ) {
 
-	char computerName[SIZE_COMPUTER_NAME];
-	char companyName[SIZE_COMPANY_NAME];
-	char ip [SIZE_VLOCATION_IP];
-	int x, y;
+		char *text = RsArchiveFileData ( filename, &size );
+		if ( text ) compiled = LanTemplate::Compile ( text, size, &size );
+		if ( !compiled ) return NULL;
+		data = compiled;
 
-	char buffer [256];
+	}
 
-    thefile >> buffer >> ws;
-    thefile.getline( computerName, SIZE_COMPUTER_NAME );
+	Computer *comp = LoadLAN ( (LanTemplateHeader *) data, filename );
 
-	thefile >> buffer >> ws;
-    thefile.getline( companyName, SIZE_COMPANY_NAME );
+	if ( compiled ) delete [] compiled;
 
-    thefile >> buffer >> ws;
-    thefile.getline( ip, SIZE_VLOCATION_IP );
+	return comp;
 
-	thefile.getline( buffer, 256 );
-	sscanf ( buffer, "XPOS %d", &x );
+}
 
-	thefile.getline( buffer, 256 );
-	sscanf ( buffer, "YPOS %d", &y );
+Computer  *LanGenerator::LoadLAN ( LanTemplateHeader *lan, char *filename )
+{
+
+	//
+	// Load the header information
+
+	char *computerName = LanTemplate::String ( lan, lan->computername );
+	char *companyName = LanTemplate::String ( lan, lan->companyname );
+	char *ip = LanTemplate::String ( lan, lan->ip );
+	int x = lan->x;
+	int y = lan->y;
 
     printf ( "Loading LAN from %s...", filename );
 
     if ( game->GetWorld ()->GetVLocation (ip) ) {
         printf ( "[Already Loaded]\n", filename );
-		thefile.close ();
-		RsArchiveFileClose ( filename );
         return NULL;
     }
 
@@ -96,8 +113,6 @@ Computer  *LanGenerator::LoadLAN ( char *filename )
 
 	if ( !game->GetWorld()->VerifyVLocation( ip, x, y ) ) {
 		printf ( "LanGenerator::LoadLAN WARNING: Location is invalid, ip(%s), x(%d), y(%d).(%s)\n", (ip)?ip:"NULL", x, y, filename );
-		thefile.close ();
-		RsArchiveFileClose ( filename );
         return NULL;
 	}
 
@@ -134,60 +149,56 @@ Computer  *LanGenerator::LoadLAN ( char *filename )
 	//
 	// Load each LAN system
 
-	while ( thefile )
+	LanTemplateSystem *systems = LanTemplate::Systems ( lan );
+
+	for ( int is = 0; is < lan->numsystems; ++is )
 	{
 
-		char fullLine [256];
-		thefile.getline( fullLine, 256 );
-
-		if ( fullLine[0] == '.' )       break;
-        if ( strlen(fullLine) < 2 )     continue;
-		if ( fullLine[0] == ';' )       continue;
-
-		char systemName[128];
-		int index, x, y, security, data1, data2, data3;
-		bool haveModemPhoneNumber = true;
-        char dataX[256];
-		std::istrstream thisLine ( fullLine );
-		thisLine >> index >> systemName >> x >> y >> security >> data1 >> data2 >> data3 >> ws;
-        if ( strstr(systemName, "MODEM") ) {
-            thisLine.getline(dataX, 256);
-            if ( strlen(dataX) < 3 ) {
-				haveModemPhoneNumber = false;
-                printf ( "LanGenerator::LoadLAN WARNING: Modem found without phone number.(%s)\n", filename );
-            }
-        }
+		LanTemplateSystem *thisSystem = &systems [is];
+		char *systemName = LanTemplate::String ( lan, thisSystem->name );
+		char *dataX = LanTemplate::String ( lan, thisSystem->phonenumber );
+		int x = thisSystem->x;
+		int y = thisSystem->y;
+		int security = thisSystem->security;
 
 		int indexUsed = -1;
 
-		if		( strstr(systemName, "ROUTER") )			indexUsed = GenerateRouter              (comp, cluster, x, y, security);
-		else if ( strstr(systemName, "HUB") )				indexUsed = GenerateHUB                 (comp, cluster, x, y, security);
-		else if ( strstr(systemName, "TERMINAL") )			indexUsed = GenerateTerminal            (comp, cluster, x, y, security);
-		else if ( strstr(systemName, "MAINSERVER") )		indexUsed = GenerateMainServer          (comp, cluster, x, y, security);
-		else if ( strstr(systemName, "AUTHENTICATION") )	indexUsed = GenerateAuthentication      (comp, cluster, x, y, security);
-		else if ( strstr(systemName, "LOCK") )				indexUsed = GenerateLock                (comp, cluster, x, y, security);
-        else if ( strstr(systemName, "ISOLATIONBRIDGE") )   indexUsed = GenerateIsolationBridge     (comp, cluster, x, y, security);
-        else if ( strstr(systemName, "SESSIONKEYSERVER") )  indexUsed = GenerateSessionKeyServer    (comp, cluster, x, y, security);
-        else if ( strstr(systemName, "RADIOTRANSMITTER") )  indexUsed = GenerateRadioTransmitter    (comp, cluster, x, y, security);
-        else if ( strstr(systemName, "RADIORECEIVER") )     indexUsed = GenerateRadioReceiver       (comp, cluster, x, y, security);
-        else if ( strstr(systemName, "FAXPRINTER") )        indexUsed = GenerateFaxPrinter          (comp, cluster, x, y, security);
-		else if ( strstr(systemName, "MODEM" ) ) {
-			if ( haveModemPhoneNumber )
-															indexUsed = GenerateModem               (comp, cluster, x, y, security, dataX, sizeof ( dataX ) );
-			else
-															indexUsed = GenerateModem               (comp, cluster, x, y, security);
-		}
-        else if ( strstr(systemName, "LOGSERVER" ) )        indexUsed = GenerateLogServer           (comp, cluster, x, y, security);
+		switch ( thisSystem->TYPE ) {
+
+			case LANSYSTEM_ROUTER:				indexUsed = GenerateRouter              (comp, cluster, x, y, security);		break;
+			case LANSYSTEM_HUB:					indexUsed = GenerateHUB                 (comp, cluster, x, y, security);		break;
+			case LANSYSTEM_TERMINAL:			indexUsed = GenerateTerminal            (comp, cluster, x, y, security);		break;
+			case LANSYSTEM_MAINSERVER:			indexUsed = GenerateMainServer          (comp, cluster, x, y, security);		break;
+			case LANSYSTEM_AUTHENTICATION:		indexUsed = GenerateAuthentication      (comp, cluster, x, y, security);		break;
+			case LANSYSTEM_LOCK:				indexUsed = GenerateLock                (comp, cluster, x, y, security);		break;
+			case LANSYSTEM_ISOLATIONBRIDGE:		indexUsed = GenerateIsolationBridge     (comp, cluster, x, y, security);		break;
+			case LANSYSTEM_SESSIONKEYSERVER:	indexUsed = GenerateSessionKeyServer    (comp, cluster, x, y, security);		break;
+			case LANSYSTEM_RADIOTRANSMITTER:	indexUsed = GenerateRadioTransmitter    (comp, cluster, x, y, security);		break;
+			case LANSYSTEM_RADIORECEIVER:		indexUsed = GenerateRadioReceiver       (comp, cluster, x, y, security);		break;
+			case LANSYSTEM_FAXPRINTER:			indexUsed = GenerateFaxPrinter          (comp, cluster, x, y, security);		break;
+			case LANSYSTEM_LOGSERVER:			indexUsed = GenerateLogServer           (comp, cluster, x, y, security);		break;
+
+			case LANSYSTEM_MODEM:
+				if ( dataX )
+												indexUsed = GenerateModem               (comp, cluster, x, y, security, dataX, strlen ( dataX ) + 1 );
+				else {
+					printf ( "LanGenerator::LoadLAN WARNING: Modem found without phone number.(%s)\n", filename );
+												indexUsed = GenerateModem               (comp, cluster, x, y, security);
+				}
+				break;
 
-		else
-			printf ( "LanGenerator::LoadLAN WARNING: Unrecognised System TYPE %s.(%s)\n", systemName, filename );
+			default:
+				printf ( "LanGenerator::LoadLAN WARNING: Unrecognised System TYPE %s.(%s)\n", systemName, filename );
+				break;
+
+		}
 
 		if ( indexUsed != -1 ) {
 			UplinkAssert ( cluster->systems.ValidIndex ( indexUsed ) );
 			LanComputerSystem *system = cluster->systems.GetData(indexUsed);
-			system->data1 = data1;
-			system->data2 = data2;
-			system->data3 = data3;
+			system->data1 = thisSystem->data1;
+			system->data2 = thisSystem->data2;
+			system->data3 = thisSystem->data3;
 		}
 
 	}
@@ -195,32 +206,19 @@ Computer  *LanGenerator::LoadLAN ( char *filename )
 	//
 	// Load all links
 
-	while ( thefile )
-	{
-
-		//LanComputerLink *link = new LanComputerLink();
+	LanTemplateLink *links = LanTemplate::Links ( lan );
 
-		char fullLine [256];
-		thefile.getline( fullLine, 256 );
-
-		if ( fullLine[0] == '.' )       break;
-        if ( strlen(fullLine) < 2 )     continue;
-		if ( fullLine[0] == ';' )       continue;
-
-		char linkName [256];
-		int from, to, security;
-		float fromX, fromY, toX, toY;
+	for ( int il = 0; il < lan->numlinks; ++il )
+	{
 
-		std::istrstream thisLine ( fullLine );
-		thisLine >> linkName >> from >> fromX >> fromY >> to >> toX >> toY >> security >> ws;
-		linkName[ sizeof(linkName) - 1 ] = '\0';
+		LanTemplateLink *link = &links [il];
 
-		if ( !cluster->VerifyLanLink ( from, fromX, fromY, to, toX, toY, security ) ) {
+		if ( !cluster->VerifyLanLink ( link->from, link->fromX, link->fromY, link->to, link->toX, link->toY, link->security ) ) {
             printf ( "LanGenerator::LoadLAN WARNING: Invalid link, linkName(%s), from(%d), fromX(%f), fromY(%f), to(%d), toX(%f), toY(%f), security(%d).(%s)\n", 
-			         linkName, from, fromX, fromY, to, toX, toY, security, filename );
+			         LanTemplate::String ( lan, link->name ), link->from, link->fromX, link->fromY, link->to, link->toX, link->toY, link->security, filename );
 		}
 		else {
-			cluster->AddLanLink( from, fromX, fromY, to, toX, toY, security );
+			cluster->AddLanLink( link->from, link->fromX, link->fromY, link->to, link->toX, link->toY, link->security );
 		}
 
 	}
@@ -228,27 +226,17 @@ Computer  *LanGenerator::LoadLAN ( char *filename )
     //
     // Load Valid Subnets
 
-	while ( thefile )
-	{
-
-		char fullLine [256];
-		thefile.getline( fullLine, 256 );
+	LanTemplateSubnet *subnets = LanTemplate::Subnets ( lan );
 
-		if ( fullLine[0] == '.' )       break;
-        if ( strlen(fullLine) < 2 )     continue;
-		if ( fullLine[0] == ';' )       continue;
-
-		char name[128];
-		int systemIndex;
-		int validIndex;
+	for ( int in = 0; in < lan->numsubnets; ++in )
+	{
 
-		std::istrstream thisLine ( fullLine );
-		thisLine >> name >> systemIndex >> validIndex >> ws;
+		int systemIndex = subnets [in].system;
 
 		if ( cluster->systems.ValidIndex ( systemIndex ) ) {
 			LanComputerSystem *system = cluster->systems.GetData(systemIndex);
 			if ( system )
-				system->validSubnets.PutData( validIndex );
+				system->validSubnets.PutData( subnets [in].valid );
 		}
 
     }
@@ -263,27 +251,10 @@ Computer  *LanGenerator::LoadLAN ( char *filename )
     //
     // Load hidden data values
 
-	while ( thefile )
-	{
-
-		char fullLine [256];
-		thefile.getline( fullLine, 256 );
-
-		if ( fullLine[0] == '.' )       break;
-        if ( strlen(fullLine) < 2 )     continue;
-		if ( fullLine[0] == ';' )       continue;
+	LanTemplateData *hidden = LanTemplate::Data ( lan );
 
-		char dataName[128];
-		int index;
-		char allData[256];
-
-		std::istrstream thisLine ( fullLine );
-		thisLine >> dataName >> index >> ws;
-        thisLine.getline( allData, 256 );
-
-        LanGenerator::HideData( comp, index, allData );
-
-    }
+	for ( int id = 0; id < lan->numdata; ++id )
+        LanGenerator::HideData( comp, hidden [id].system, LanTemplate::String ( lan, hidden [id].text ) );
 
 
     //
@@ -339,9 +310,6 @@ Computer  *LanGenerator::LoadLAN ( char *filename )
 
     printf ( "done\n" );
 
-	thefile.close ();
-	RsArchiveFileClose ( filename );
-
 	return comp;
 
 }
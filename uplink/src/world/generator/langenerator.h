@@ -14,6 +14,8 @@ class LanComputerLink;
 class LanCluster;
 class Computer;
 
+struct LanTemplateHeader;
+
 /*
 	Alignment values:		-1 = Left aligned
 							0  = Centre aligned
@@ -39,7 +41,8 @@ public:
     //
 	// Top level functions for generating entire networks
 
-	static Computer  *LoadLAN					( char *filename );
+	static Computer  *LoadLAN					( char *filename );								// Uses a compiled template if present
+	static Computer  *LoadLAN					( LanTemplateHeader *lan, char *filename );
 	static Computer  *GenerateLAN				( char *companyname, int difficulty );			// 0 = low, 5 = high
 	static void       GenerateLANCluster        ( LanComputer *comp, int difficulty );
 
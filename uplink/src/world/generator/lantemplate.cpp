@@ -0,0 +1,454 @@
+// -*- tab-width:4 c-file-style:"cc-mode" -*-
+
+#include <strstream>
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "tosser.h"
+
+#include "world/vlocation.h"
+#include "world/company/company.h"
+#include "world/computer/lancomputer.h"
+
+#include "world/generator/lantemplate.h"
+
+#include "mmgr.h"
+
+
+static const char LANTEMPLATE_MAGIC [4] = { 'U', 'L', 'A', 'N' };
+
+
+// Growable pool of NUL terminated strings
+
+struct LanStringPool
+{
+
+	char *data;
+	int size;
+	int capacity;
+
+};
+
+static int AddString ( LanStringPool *pool, const char *string )
+{
+
+	int length = (int) strlen ( string ) + 1;
+
+	if ( pool->size + length > pool->capacity ) {
+		int newcapacity = pool->capacity * 2 + length;
+		char *newdata = new char [newcapacity];
+		if ( pool->data ) {
+			memcpy ( newdata, pool->data, pool->size );
+			delete [] pool->data;
+		}
+		pool->data = newdata;
+		pool->capacity = newcapacity;
+	}
+
+	int offset = pool->size;
+	memcpy ( pool->data + offset, string, length );
+	pool->size += length;
+	return offset;
+
+}
+
+// Reads the next line of a section, false at the end of the section
+
+static bool NextSectionLine ( std::istrstream &thefile, char *fullLine, int size )
+{
+
+	while ( thefile ) {
+
+		thefile.getline( fullLine, size );
+
+		if ( fullLine[0] == '.' )       return false;
+        if ( strlen(fullLine) < 2 )     continue;
+		if ( fullLine[0] == ';' )       continue;
+
+		return true;
+
+	}
+
+	return false;
+
+}
+
+static int SystemType ( const char *systemName )
+{
+
+	// Same order as the original loader, as some names contain others
+
+	if		( strstr(systemName, "ROUTER") )			return LANSYSTEM_ROUTER;
+	else if ( strstr(systemName, "HUB") )				return LANSYSTEM_HUB;
+	else if ( strstr(systemName, "TERMINAL") )			return LANSYSTEM_TERMINAL;
+	else if ( strstr(systemName, "MAINSERVER") )		return LANSYSTEM_MAINSERVER;
+	else if ( strstr(systemName, "AUTHENTICATION") )	return LANSYSTEM_AUTHENTICATION;
+	else if ( strstr(systemName, "LOCK") )				return LANSYSTEM_LOCK;
+	else if ( strstr(systemName, "ISOLATIONBRIDGE") )   return LANSYSTEM_ISOLATIONBRIDGE;
+	else if ( strstr(systemName, "SESSIONKEYSERVER") )  return LANSYSTEM_SESSIONKEYSERVER;
+	else if ( strstr(systemName, "RADIOTRANSMITTER") )  return LANSYSTEM_RADIOTRANSMITTER;
+	else if ( strstr(systemName, "RADIORECEIVER") )     return LANSYSTEM_RADIORECEIVER;
+	else if ( strstr(systemName, "FAXPRINTER") )        return LANSYSTEM_FAXPRINTER;
+	else if ( strstr(systemName, "MODEM" ) )			return LANSYSTEM_MODEM;
+	else if ( strstr(systemName, "LOGSERVER" ) )        return LANSYSTEM_LOGSERVER;
+
+	return LANSYSTEM_NONE;
+
+}
+
+// Copies the records into place and deletes them
+
+template <class T>
+static void MoveRecords ( LList <T *> *records, char *target )
+{
+
+	T *record = (T *) target;
+	for ( int i = 0; i < records->Size (); ++i ) {
+		record [i] = *records->GetData (i);
+		delete records->GetData (i);
+	}
+	records->Empty ();
+
+}
+
+char *LanTemplate::Compile ( char *text, int textsize, int *size )
+{
+
+	if ( !text || textsize <= 0 ) return NULL;
+
+	//
+	// Strip carriage returns, as idos2unixstream did
+
+	char *unixtext = new char [textsize + 1];
+	int length = 0;
+	for ( int i = 0; i < textsize; ++i )
+		if ( text [i] != '\r' ) unixtext [length++] = text [i];
+	unixtext [length] = '\0';
+
+	std::istrstream thefile ( unixtext, length );
+
+	LanStringPool pool;
+	pool.data = NULL;
+	pool.size = 0;
+	pool.capacity = 0;
+
+	LanTemplateHeader header;
+	memset ( &header, 0, sizeof(header) );
+	memcpy ( header.magic, LANTEMPLATE_MAGIC, sizeof(header.magic) );
+	header.version = LANTEMPLATE_VERSION;
+
+	//
+	// Header information
+
+	char computerName[SIZE_COMPUTER_NAME] = "";
+	char companyName[SIZE_COMPANY_NAME] = "";
+	char ip [SIZE_VLOCATION_IP] = "";
+	int x = 0, y = 0;
+
+	char buffer [256];
+
+    thefile >> buffer >> std::ws;
+    thefile.getline( computerName, SIZE_COMPUTER_NAME );
+
+	thefile >> buffer >> std::ws;
+    thefile.getline( companyName, SIZE_COMPANY_NAME );
+
+    thefile >> buffer >> std::ws;
+    thefile.getline( ip, SIZE_VLOCATION_IP );
+
+	thefile.getline( buffer, 256 );
+	sscanf ( buffer, "XPOS %d", &x );
+
+	thefile.getline( buffer, 256 );
+	sscanf ( buffer, "YPOS %d", &y );
+
+	header.computername = AddString ( &pool, computerName );
+	header.companyname = AddString ( &pool, companyName );
+	header.ip = AddString ( &pool, ip );
+	header.x = x;
+	header.y = y;
+
+	char fullLine [256];
+
+	//
+	// Systems
+
+	LList <LanTemplateSystem *> systems;
+
+	while ( NextSectionLine ( thefile, fullLine, sizeof(fullLine) ) ) {
+
+		char systemName[128] = "";
+		int index = 0;
+		LanTemplateSystem *system = new LanTemplateSystem;
+		memset ( system, 0, sizeof(LanTemplateSystem) );
+
+		std::istrstream thisLine ( fullLine );
+		thisLine >> index >> systemName >> system->x >> system->y >> system->security
+				 >> system->data1 >> system->data2 >> system->data3 >> std::ws;
+
+		system->TYPE = SystemType ( systemName );
+		system->name = AddString ( &pool, systemName );
+		system->phonenumber = -1;
+
+        if ( strstr(systemName, "MODEM") ) {
+			char dataX[256] = "";
+            thisLine.getline(dataX, 256);
+            if ( strlen(dataX) >= 3 )
+				system->phonenumber = AddString ( &pool, dataX );
+        }
+
+		systems.PutDataAtEnd ( system );
+
+	}
+
+	//
+	// Links
+
+	LList <LanTemplateLink *> links;
+
+	while ( NextSectionLine ( thefile, fullLine, sizeof(fullLine) ) ) {
+
+		char linkName [256] = "";
+		LanTemplateLink *link = new LanTemplateLink;
+		memset ( link, 0, sizeof(LanTemplateLink) );
+
+		std::istrstream thisLine ( fullLine );
+		thisLine >> linkName >> link->from >> link->fromX >> link->fromY
+				 >> link->to >> link->toX >> link->toY >> link->security >> std::ws;
+		linkName[ sizeof(linkName) - 1 ] = '\0';
+
+		link->name = AddString ( &pool, linkName );
+		links.PutDataAtEnd ( link );
+
+	}
+
+	//
+	// Valid subnets
+
+	LList <LanTemplateSubnet *> subnets;
+
+	while ( NextSectionLine ( thefile, fullLine, sizeof(fullLine) ) ) {
+
+		char name[128] = "";
+		LanTemplateSubnet *subnet = new LanTemplateSubnet;
+		subnet->system = -1;
+		subnet->valid = -1;
+
+		std::istrstream thisLine ( fullLine );
+		thisLine >> name >> subnet->system >> subnet->valid >> std::ws;
+
+		subnets.PutDataAtEnd ( subnet );
+
+	}
+
+	//
+	// Hidden data
+
+	LList <LanTemplateData *> data;
+
+	while ( NextSectionLine ( thefile, fullLine, sizeof(fullLine) ) ) {
+
+		char dataName[128] = "";
+		char allData[256] = "";
+		LanTemplateData *item = new LanTemplateData;
+		item->system = -1;
+
+		std::istrstream thisLine ( fullLine );
+		thisLine >> dataName >> item->system >> std::ws;
+        thisLine.getline( allData, 256 );
+
+		item->text = AddString ( &pool, allData );
+		data.PutDataAtEnd ( item );
+
+	}
+
+	delete [] unixtext;
+
+	//
+	// Lay out the template
+
+	int offset = sizeof(LanTemplateHeader);
+
+	header.numsystems = systems.Size ();
+	header.systemsoffset = offset;
+	offset += header.numsystems * sizeof(LanTemplateSystem);
+
+	header.numlinks = links.Size ();
+	header.linksoffset = offset;
+	offset += header.numlinks * sizeof(LanTemplateLink);
+
+	header.numsubnets = subnets.Size ();
+	header.subnetsoffset = offset;
+	offset += header.numsubnets * sizeof(LanTemplateSubnet);
+
+	header.numdata = data.Size ();
+	header.dataoffset = offset;
+	offset += header.numdata * sizeof(LanTemplateData);
+
+	header.stringsoffset = offset;
+	header.stringssize = pool.size;
+	offset += pool.size;
+
+	char *result = new char [offset];
+	memcpy ( result, &header, sizeof(header) );
+	MoveRecords ( &systems, result + header.systemsoffset );
+	MoveRecords ( &links, result + header.linksoffset );
+	MoveRecords ( &subnets, result + header.subnetsoffset );
+	MoveRecords ( &data, result + header.dataoffset );
+	memcpy ( result + header.stringsoffset, pool.data, pool.size );
+
+	delete [] pool.data;
+
+	if ( size ) *size = offset;
+	return result;
+
+}
+
+// True if count records of recordsize at offset lie inside the template
+
+static bool InBounds ( int size, int offset, int count, int recordsize )
+{
+
+	if ( offset < 0 || offset > size || count < 0 ) return false;
+	if ( offset % sizeof(int) != 0 ) return false;
+	return count <= ( size - offset ) / recordsize;
+
+}
+
+static bool ValidString ( LanTemplateHeader *header, int offset, bool optional )
+{
+
+	if ( optional && offset == -1 ) return true;
+	return offset >= 0 && offset < header->stringssize;
+
+}
+
+bool LanTemplate::IsValid ( char *data, int size )
+{
+
+	if ( !data || size < (int) sizeof(LanTemplateHeader) ) return false;
+
+	LanTemplateHeader *header = (LanTemplateHeader *) data;
+
+	if ( memcmp ( header->magic, LANTEMPLATE_MAGIC, sizeof(header->magic) ) != 0 ) return false;
+	if ( header->version != LANTEMPLATE_VERSION ) return false;
+
+	if ( !InBounds ( size, header->systemsoffset, header->numsystems, sizeof(LanTemplateSystem) ) ) return false;
+	if ( !InBounds ( size, header->linksoffset, header->numlinks, sizeof(LanTemplateLink) ) ) return false;
+	if ( !InBounds ( size, header->subnetsoffset, header->numsubnets, sizeof(LanTemplateSubnet) ) ) return false;
+	if ( !InBounds ( size, header->dataoffset, header->numdata, sizeof(LanTemplateData) ) ) return false;
+
+	if ( header->stringssize <= 0 ) return false;
+	if ( !InBounds ( size, header->stringsoffset, header->stringssize, 1 ) ) return false;
+
+	if ( data [header->stringsoffset + header->stringssize - 1] != '\0' ) return false;
+
+	//
+	// Every string used must be in the pool
+
+	if ( !ValidString ( header, header->computername, false ) ||
+		 !ValidString ( header, header->companyname, false ) ||
+		 !ValidString ( header, header->ip, false ) )
+		return false;
+
+	LanTemplateSystem *systems = Systems ( header );
+	for ( int is = 0; is < header->numsystems; ++is )
+		if ( !ValidString ( header, systems [is].name, false ) ||
+			 !ValidString ( header, systems [is].phonenumber, true ) )
+			return false;
+
+	LanTemplateLink *links = Links ( header );
+	for ( int il = 0; il < header->numlinks; ++il )
+		if ( !ValidString ( header, links [il].name, false ) )
+			return false;
+
+	LanTemplateData *hidden = Data ( header );
+	for ( int id = 0; id < header->numdata; ++id )
+		if ( !ValidString ( header, hidden [id].text, false ) )
+			return false;
+
+	return true;
+
+}
+
+bool LanTemplate::Stamp ( char *data, char *textpath )
+{
+
+	struct stat st;
+	if ( !data || stat ( textpath, &st ) != 0 ) return false;
+
+	LanTemplateHeader *header = (LanTemplateHeader *) data;
+	header->sourcemtime = (long long) st.st_mtime;
+	header->sourcesize = (long long) st.st_size;
+	return true;
+
+}
+
+bool LanTemplate::IsStaleFor ( char *data, char *textpath )
+{
+
+	// Text inside an archive has no time to compare, so the template is trusted
+
+	struct stat st;
+	if ( stat ( textpath, &st ) != 0 ) return false;
+
+	LanTemplateHeader *header = (LanTemplateHeader *) data;
+	return header->sourcemtime != (long long) st.st_mtime ||
+		   header->sourcesize != (long long) st.st_size;
+
+}
+
+void LanTemplate::TemplateFilename ( char *textfilename, char *result, size_t resultsize )
+{
+
+	if ( resultsize == 0 ) return;
+
+	strncpy ( result, textfilename, resultsize - 1 );
+	result [resultsize - 1] = '\0';
+
+	char *extension = strrchr ( result, '.' );
+	char *slash = strrchr ( result, '/' );
+	if ( extension && ( !slash || extension > slash ) ) *extension = '\0';
+
+	size_t length = strlen ( result );
+	strncat ( result, LANTEMPLATE_EXTENSION, resultsize - length - 1 );
+
+}
+
+LanTemplateSystem *LanTemplate::Systems ( LanTemplateHeader *header )
+{
+
+	return (LanTemplateSystem *) ( (char *) header + header->systemsoffset );
+
+}
+
+LanTemplateLink *LanTemplate::Links ( LanTemplateHeader *header )
+{
+
+	return (LanTemplateLink *) ( (char *) header + header->linksoffset );
+
+}
+
+LanTemplateSubnet *LanTemplate::Subnets ( LanTemplateHeader *header )
+{
+
+	return (LanTemplateSubnet *) ( (char *) header + header->subnetsoffset );
+
+}
+
+LanTemplateData *LanTemplate::Data ( LanTemplateHeader *header )
+{
+
+	return (LanTemplateData *) ( (char *) header + header->dataoffset );
+
+}
+
+char *LanTemplate::String ( LanTemplateHeader *header, int offset )
+{
+
+	if ( offset < 0 || offset >= header->stringssize ) return NULL;
+	return (char *) header + header->stringsoffset + offset;
+
+}
@@ -0,0 +1,114 @@
+
+/*
+
+  Lan Template
+
+	Binary form of the hand built LAN text files in data/lans/.
+	A template is a header followed by fixed size records and a
+	string pool, so it can be used straight from memory
+
+	lanpack converts the text files ahead of time, and LoadLAN
+	compiles the text itself when there is no valid template, or
+	when the loose text file has changed since it was packed
+
+  */
+
+#ifndef _included_lantemplate_h
+#define _included_lantemplate_h
+
+#include <stddef.h>
+
+
+#define LANTEMPLATE_VERSION     2
+#define LANTEMPLATE_EXTENSION   ".lan"
+
+// Strings are offsets into the pool, -1 for none
+// All offsets are in bytes from the start of the template
+
+struct LanTemplateHeader
+{
+
+	char magic [4];							// "ULAN"
+	int version;
+
+	long long sourcemtime;					// Modification time and size of the text file
+	long long sourcesize;					// it was packed from, 0 if compiled in memory
+
+	int computername;
+	int companyname;
+	int ip;
+	int x, y;
+
+	int numsystems, systemsoffset;
+	int numlinks, linksoffset;
+	int numsubnets, subnetsoffset;
+	int numdata, dataoffset;
+
+	int stringsoffset, stringssize;
+
+};
+
+struct LanTemplateSystem
+{
+
+	int TYPE;								// LANSYSTEM_NONE if not recognised
+	int name;								// As written, for warnings
+	int x, y;
+	int security;
+	int data1, data2, data3;
+	int phonenumber;						// Modems only
+
+};
+
+struct LanTemplateLink
+{
+
+	int name;
+	int from, to;
+	float fromX, fromY;
+	float toX, toY;
+	int security;
+
+};
+
+struct LanTemplateSubnet
+{
+
+	int system;
+	int valid;
+
+};
+
+struct LanTemplateData
+{
+
+	int system;
+	int text;
+
+};
+
+
+class LanTemplate
+{
+
+public:
+
+	static char *Compile ( char *text, int textsize, int *size );			// Returns new [] data, NULL on failure
+	static bool  IsValid ( char *data, int size );
+
+	static bool  Stamp ( char *data, char *textpath );						// Records textpath's time and size
+	static bool  IsStaleFor ( char *data, char *textpath );				// False if textpath can't be found
+
+
+	static void  TemplateFilename ( char *textfilename, char *result, size_t resultsize );
+
+	static LanTemplateSystem *Systems ( LanTemplateHeader *header );
+	static LanTemplateLink   *Links   ( LanTemplateHeader *header );
+	static LanTemplateSubnet *Subnets ( LanTemplateHeader *header );
+	static LanTemplateData   *Data    ( LanTemplateHeader *header );
+	static char              *String  ( LanTemplateHeader *header, int offset );		// NULL for -1
+
+};
+
+
+#endif
@@ -26,7 +26,7 @@ LList <char *> NameGenerator::companynamesA;
 LList <char *> NameGenerator::companynamesB;
 
 
-static char tempname [MAX_COMPUTERNAME];                 // This is used to return string values
+static thread_local char tempname [MAX_COMPUTERNAME];    // This is used to return string values (per thread, see WorldPartition)
 
 
 void NameGenerator::Initialise ()
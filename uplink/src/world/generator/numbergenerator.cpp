@@ -7,16 +7,37 @@
 
 
 
+static thread_local unsigned long long *stream = NULL;
+
+static int Random ()
+{
+
+	if ( !stream ) return rand ();
+
+	// 64 bit LCG, top bits cut down to the range of rand ()
+
+	*stream = *stream * 6364136223846793005ULL + 1442695040888963407ULL;
+	return (int) ( *stream >> 33 ) & RAND_MAX;
+
+}
+
 void NumberGenerator::Initialise ()
 {
 
 }
 
+void NumberGenerator::SetStream ( unsigned long long *newstream )
+{
+
+	stream = newstream;
+
+}
+
 
 int NumberGenerator::RandomNumber ( int range )
 {
 
-	int result = (int) ( ( (float) rand () / (float) RAND_MAX ) * range );
+	int result = (int) ( ( (float) Random () / (float) RAND_MAX ) * range );
 	if ( result < 0 ) result = 0;
 	if ( result >= range ) result = range - 1;
 
@@ -26,7 +47,7 @@ int NumberGenerator::RandomNumber ( int range )
 
 float NumberGenerator::RandomUniformNumber ()	
 {
-    return (float) rand () / (float) RAND_MAX;
+    return (float) Random () / (float) RAND_MAX;
 }
 
 float NumberGenerator::RandomNormalNumber ( float mean, float range )	
@@ -37,7 +58,7 @@ float NumberGenerator::RandomNormalNumber ( float mean, float range )
 	float s = 0;
 
 	for ( int i = 0; i < 12; ++i )
-		s += ( (float) rand () / (float) RAND_MAX );
+		s += ( (float) Random () / (float) RAND_MAX );
 
 	s = ( s-6.0f ) * ( range/3.0f ) + mean;
 
@@ -22,6 +22,9 @@ public:
 
 	static int ApplyVariance ( int num, int variance );					
 				// Applies +-percentage variance to num
+
+	static void SetStream ( unsigned long long *newstream );
+				// Draw from *newstream on this thread instead of rand (), NULL to go back
 		
 
 };
@@ -766,8 +766,8 @@ void WorldGenerator::GenerateUplinkPublicAccessServer ()
 
 	DialogScreen *dlg6 = new DialogScreen ();
 
-	int screenw = app->GetOptions ()->GetOptionValue ("graphics_screenwidth");
-	int screenh = app->GetOptions ()->GetOptionValue ("graphics_screenheight");
+	int screenw = app->GetOptions ()->GetOptionValue ( OPTION_SCREENWIDTH );
+	int screenh = app->GetOptions ()->GetOptionValue ( OPTION_SCREENHEIGHT );
 
 	dlg6->AddWidget ( "connecting", WIDGET_CAPTION, screenw - 370, screenh - 30, 370, 20, "", "" );
 	comp->AddComputerScreen ( dlg6, 6 );
@@ -4128,7 +4128,7 @@ Mission *WorldGenerator::GetRandomMission  ()
 	CompanyUplink *cu = (CompanyUplink *) game->GetWorld ()->GetCompany ( "Uplink" );
 	UplinkAssert ( cu );
 
-	LList <Mission *> *missions = &(cu->missions);
+	Deque <Mission *> *missions = &(cu->missions);
 	UplinkAssert ( missions->Size () > 0 );
 
 	int index = NumberGenerator::RandomNumber ( missions->Size () );
@@ -20,6 +20,8 @@
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
+POOL_DEFINE ( Message, 256 )
+
 Message::Message()
 {
 	
@@ -48,6 +48,10 @@ public:
 	Message();
 	virtual ~Message();
 
+	// Messages come from a pool
+
+	POOL_MEMBERS ( Message )
+
 	void SetTo		( char *newto );
 	void SetFrom	( char *newfrom );
 	void SetSubject ( char *newsubject );
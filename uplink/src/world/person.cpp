@@ -17,6 +17,7 @@
 #include "world/person.h"
 #include "world/player.h"
 #include "world/vlocation.h"
+#include "world/worldpartition.h"
 
 #include "world/company/mission.h"
 #include "world/computer/bankaccount.h"
@@ -400,6 +401,38 @@ void Person::Print ()
 
 }
 
+void Person::UpdatePartition ( WorldPartition *partition )
+{
+
+	UplinkAssert (partition);
+
+	// The player's hack monitors and trace reach all over the world
+
+	if ( GetOBJECTID () == OID_PLAYER ) {
+		partition->AddCommand ( WORLDCOMMAND_UPDATE, this );
+		return;
+	}
+
+	if ( strcmp ( name, "PLAYER" ) == 0 || messages.Size () == 0 )
+		return;
+
+	//
+	// Mail from the player can complete a mission or move the plot on,
+	// so that is read on the main thread. Anything else is thrown away here
+	//
+
+	Message *msg = messages.GetData (0);
+
+	if ( strcmp ( msg->from, "PLAYER" ) == 0 ) {
+		partition->AddCommand ( WORLDCOMMAND_UPDATE, this );
+		return;
+	}
+
+	delete msg;
+	messages.RemoveData (0);
+
+}
+
 void Person::Update ()
 {
 
@@ -33,6 +33,7 @@
 
 class Message;
 class VLocation;
+class WorldPartition;
 
 // ============================================================================
 
@@ -98,6 +99,8 @@ public:
 
 	bool HasMessageLink ( const char *ip );
 
+	void UpdatePartition ( WorldPartition *partition );		// Update from a worker thread, queues what it can't do there
+
 	// Common functions
 
 	virtual bool Load  ( FILE *file );
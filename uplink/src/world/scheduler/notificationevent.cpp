@@ -189,16 +189,47 @@ void NotificationEvent::DemoGenerateNewMission ()
 
 }
 
+// Computers can share a name, and can be taken out of the world after being marked
+
+static bool InWorld ( World *world, Computer *comp )
+{
+
+	for ( BTree <Computer *> *tree = world->computers.LookupTree ( comp->name ); tree;
+		  tree = tree->Left () ? tree->Left ()->LookupTree ( comp->name ) : NULL )
+		if ( tree->data == comp ) return true;
+
+	return false;
+
+}
+
 void NotificationEvent::CheckForSecurityBreaches ()
 {
 
-	DArray <Computer *> *d_computers = game->GetWorld ()->computers.ConvertToDArray ();
+	//
+	// Only look at computers that have been marked since the last sweep
+	// Anything still pending afterwards is marked again for next time
+	//
 
-	for ( int i = 0; i < d_computers->Size (); ++i )
-		if ( d_computers->ValidIndex (i) )
-			d_computers->GetData (i)->CheckForSecurityBreaches ();
+	World *world = game->GetWorld ();
 
-	delete d_computers;
+	DArray <Computer *> *d_marked = world->securitybreaches.ConvertToDArray ();
+	DArray <Computer *> d_computers;
+
+	for ( int i = 0; i < d_marked->Size (); ++i )
+		if ( d_marked->ValidIndex (i) && InWorld ( world, d_marked->GetData (i) ) )
+			d_computers.PutData ( d_marked->GetData (i) );
+
+	delete d_marked;
+	world->securitybreaches.Empty ();
+
+	for ( int i = 0; i < d_computers.Size (); ++i )
+		if ( d_computers.ValidIndex (i) )
+			d_computers.GetData (i)->CheckForSecurityBreaches ();
+
+	for ( int i = 0; i < d_computers.Size (); ++i )
+		if ( d_computers.ValidIndex (i) )
+			if ( d_computers.GetData (i)->HasSecurityBreaches () )
+				world->MarkSecurityBreach ( d_computers.GetData (i) );
 
 
 	// Schedule another
@@ -270,6 +301,7 @@ void NotificationEvent::ExpireOldStuff ()
 
 	//
 	// Expire old missions
+	// They are kept newest first, so stop at the first one still current
 	//
 
 	for ( int im = cu->missions.Size () - 1; im >= 1; --im ) {
@@ -280,10 +312,11 @@ void NotificationEvent::ExpireOldStuff ()
 			testdate.SetDate ( &mission->createdate );
 			testdate.AdvanceMinute ( TIME_TOEXPIREMISSIONS );
 
-			if ( testdate.Before ( &(game->GetWorld ()->date) ) ) {
-				delete mission;
-				cu->missions.RemoveData (im);
-			}
+			if ( !testdate.Before ( &(game->GetWorld ()->date) ) )
+				break;
+
+			delete mission;
+			cu->missions.RemoveData (im);
 
 		}
 	}
@@ -457,7 +490,7 @@ void NotificationEvent::GiveMissionToNPC ()
 
 	CompanyUplink *uplink = (CompanyUplink *) game->GetWorld ()->GetCompany ( "Uplink" );
 	UplinkAssert (uplink);
-	LList <Mission *> *fullist = &(uplink->missions);
+	Deque <Mission *> *fullist = &(uplink->missions);
 	LList <Mission *> missions;
 	LList <int>		  missions_index;											// Indexes of each mission
 
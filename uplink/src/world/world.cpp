@@ -19,10 +19,13 @@
 
 #include "game/game.h"
 
+#include "options/options.h"
+
 #include "world/world.h"
 #include "world/vlocation.h"
 #include "world/person.h"
 #include "world/player.h"
+#include "world/worldpartition.h"
 
 #include "world/company/company.h"
 #include "world/company/mission.h"
@@ -281,6 +284,21 @@ void World::CreateGatewayDef ( GatewayDef *newdef )
 
 }
 
+void World::MarkSecurityBreach ( Computer *computer )
+{
+
+	UplinkAssert (computer);
+
+	// Computers can share a name, so look for this one among them
+
+	for ( BTree <Computer *> *tree = securitybreaches.LookupTree ( computer->name ); tree;
+		  tree = tree->Left () ? tree->Left ()->LookupTree ( computer->name ) : NULL )
+		if ( tree->data == computer ) return;
+
+	securitybreaches.PutData ( computer->name, computer );
+
+}
+
 VLocation *World::GetVLocation  ( char *ip )
 {
 
@@ -397,6 +415,19 @@ bool World::Load ( FILE *file )
 	if ( !LoadBTree ( (BTree <UplinkObject *> *) &computers, file ) ) return false;
 	if ( !LoadBTree ( (BTree <UplinkObject *> *) &people,    file ) ) return false;
 
+	// Rebuild the list of computers waiting on a security breach sweep
+
+	securitybreaches.Empty ();
+
+	DArray <Computer *> *d_computers = computers.ConvertToDArray ();
+
+	for ( int i = 0; i < d_computers->Size (); ++i )
+		if ( d_computers->ValidIndex (i) )
+			if ( d_computers->GetData (i)->HasSecurityBreaches () )
+				MarkSecurityBreach ( d_computers->GetData (i) );
+
+	delete d_computers;
+
 	// Fix for dead or jailed people talking on the phone or administering companies
 	// If the person is in charge of administering a company, replace him with a new person
 	// Else it will be impossible to capture his voice and thus breaking in the servers of the company
@@ -458,6 +489,20 @@ char *World::GetID ()
 
 }
 
+static void UpdateComputerPartition ( UplinkObject *object, WorldPartition *partition )
+{
+
+	((Computer *) object)->UpdatePartition ( partition );
+
+}
+
+static void UpdatePersonPartition ( UplinkObject *object, WorldPartition *partition )
+{
+
+	((Person *) object)->UpdatePartition ( partition );
+
+}
+
 void World::Update ()
 {
 
@@ -467,8 +512,20 @@ void World::Update ()
 
 		UpdateBTree ( (BTree <UplinkObject *> *) &locations );
 		UpdateBTree ( (BTree <UplinkObject *> *) &companies );
-		UpdateBTree ( (BTree <UplinkObject *> *) &computers );
-		UpdateBTree ( (BTree <UplinkObject *> *) &people    );
+
+		// Partitioned updates draw from their own random numbers, so they
+		// only run if asked for - otherwise the world goes as it always has
+
+		int updatethreads = app->GetOptions ()->GetOptionValue ( "game_updatethreads" );
+
+		if ( updatethreads > 0 ) {
+			UpdatePartitioned ( (BTree <UplinkObject *> *) &computers, UpdateComputerPartition, updatethreads );
+			UpdatePartitioned ( (BTree <UplinkObject *> *) &people,    UpdatePersonPartition,   updatethreads );
+		}
+		else {
+			UpdateBTree ( (BTree <UplinkObject *> *) &computers );
+			UpdateBTree ( (BTree <UplinkObject *> *) &people    );
+		}
 		
 		scheduler.Update ();
         plotgenerator.Update ();
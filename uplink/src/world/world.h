@@ -58,6 +58,9 @@ public:
 	DArray <char *>		  passwords;					// No need to serialise
 	DArray <GatewayDef *> gatewaydefs;					// No need to serialise
 
+	BTree <Computer *>	 securitybreaches;				// Computers with something for CheckForSecurityBreaches
+														// to act on - no need to serialise, rebuilt on Load
+
 public:
 
 	World();
@@ -77,6 +80,8 @@ public:
 	void CreateComputer   ( Computer   *computer );
 	void CreatePerson     ( Person     *person );	
 	void CreateGatewayDef ( GatewayDef *newdef );
+
+	void MarkSecurityBreach ( Computer *computer );		// Computer will be looked at by the next breach sweep
 	
 	VLocation  *GetVLocation  ( char *ip );				//  These all return NULL  
 	Company    *GetCompany	  ( char *name );			//  if the specified object
@@ -0,0 +1,166 @@
+
+#include <atomic>
+#include <thread>
+
+#include "gucci.h"
+
+#include "app/globals.h"
+#include "app/uplinkobject.h"
+
+#include "game/game.h"
+
+#include "world/world.h"
+#include "world/worldpartition.h"
+#include "world/computer/computer.h"
+#include "world/generator/numbergenerator.h"
+
+#include "mmgr.h"
+
+
+struct WorldPartitionJob
+{
+
+	DArray <UplinkObject *> *objects;
+	DArray <char *> *ids;
+	WorldPartitionUpdate update;
+	unsigned long long seed;
+
+	WorldPartition partitions [WORLDPARTITION_COUNT];
+	std::atomic <int> next;                             // Next partition to run
+
+};
+
+
+void WorldPartition::AddCommand ( int TYPE, UplinkObject *object )
+{
+
+	WorldCommand *command = new WorldCommand ();
+	command->TYPE = TYPE;
+	command->object = object;
+	command->random = random;
+	commands.PutData ( command );
+
+}
+
+static unsigned long long UpdateSeed ()
+{
+
+	return ( (unsigned long long) NumberGenerator::RandomNumber ( 65536 ) << 16 ) |
+		   NumberGenerator::RandomNumber ( 65536 );
+
+}
+
+static unsigned long long StreamSeed ( unsigned long long seed, char *id )
+{
+
+	// FNV-1a of the id, then splitmix64, so similar ids get unrelated streams
+
+	unsigned long long z = 0xCBF29CE484222325ULL;
+	for ( unsigned char *c = (unsigned char *) id; c && *c; ++c )
+		z = ( z ^ *c ) * 0x100000001B3ULL;
+
+	z += seed * 0x9E3779B97F4A7C15ULL;
+	z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+	z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+	return z ^ ( z >> 31 );
+
+}
+
+static void UpdateWorker ( WorldPartitionJob *job )
+{
+
+	while ( true ) {
+
+		int p = job->next++;
+		if ( p >= WORLDPARTITION_COUNT ) break;
+
+		WorldPartition *partition = &job->partitions [p];
+		NumberGenerator::SetStream ( &partition->random );
+
+		for ( int i = partition->first; i < partition->last; ++i )
+			if ( job->objects->ValidIndex (i) && job->objects->GetData (i) ) {
+				partition->random = StreamSeed ( job->seed, job->ids->GetData (i) );
+				job->update ( job->objects->GetData (i), partition );
+			}
+
+		NumberGenerator::SetStream ( NULL );
+
+	}
+
+}
+
+void UpdatePartitioned ( BTree <UplinkObject *> *btree, WorldPartitionUpdate update, int numthreads )
+{
+
+	UplinkAssert ( btree );
+	UplinkAssert ( update );
+
+	WorldPartitionJob *job = new WorldPartitionJob ();
+	job->objects = btree->ConvertToDArray ();
+	job->ids = btree->ConvertIndexToDArray ();
+	job->update = update;
+	job->seed = UpdateSeed ();
+	job->next = 0;
+
+	int size = job->objects->Size ();
+
+	for ( int p = 0; p < WORLDPARTITION_COUNT; ++p ) {
+		job->partitions [p].first = (int) ( (long long) size * p / WORLDPARTITION_COUNT );
+		job->partitions [p].last = (int) ( (long long) size * ( p + 1 ) / WORLDPARTITION_COUNT );
+	}
+
+	//
+	// Run the partitions - this thread takes a share as well
+
+	if ( numthreads > WORLDPARTITION_COUNT ) numthreads = WORLDPARTITION_COUNT;
+
+	std::thread *workers = numthreads > 1 ? new std::thread [numthreads - 1] : NULL;
+	for ( int t = 0; t < numthreads - 1; ++t )
+		workers [t] = std::thread ( UpdateWorker, job );
+
+	UpdateWorker ( job );
+
+	for ( int t = 0; t < numthreads - 1; ++t )
+		workers [t].join ();
+	delete [] workers;
+
+	//
+	// Run the queued commands in partition order
+
+	for ( int p = 0; p < WORLDPARTITION_COUNT; ++p ) {
+
+		LList <WorldCommand *> *commands = &job->partitions [p].commands;
+
+		for ( int i = 0; i < commands->Size (); ++i ) {
+
+			WorldCommand *command = commands->GetData (i);
+			UplinkAssert ( command );
+
+			switch ( command->TYPE ) {
+
+				case WORLDCOMMAND_SECURITYBREACH:
+					game->GetWorld ()->MarkSecurityBreach ( (Computer *) command->object );
+					break;
+
+				case WORLDCOMMAND_UPDATE:
+					NumberGenerator::SetStream ( &command->random );
+					command->object->Update ();
+					NumberGenerator::SetStream ( NULL );
+					break;
+
+				default:
+					UplinkAbort ( "UpdatePartitioned, unrecognised command" );
+
+			}
+
+			delete command;
+
+		}
+
+	}
+
+	delete job->objects;
+	delete job->ids;
+	delete job;
+
+}
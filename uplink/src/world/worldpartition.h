@@ -0,0 +1,69 @@
+
+/*
+
+  World Partition
+
+	Runs the Update of every computer or every person on worker threads.
+	The objects are split into a fixed number of partitions. Each object
+	draws from its own random number stream, seeded from its id and one
+	number from the main generator, so it gets the same numbers whichever
+	partition or thread runs it. Anything that reaches outside the object
+	is queued on its partition and run on the main thread afterwards, in
+	partition order - so the world ends up the same whatever the number
+	of threads. It is not the same world as after UpdateBTree, which
+	draws every object's numbers from the main generator in turn
+
+  */
+
+#ifndef _included_worldpartition_h
+#define _included_worldpartition_h
+
+#include "tosser.h"
+
+class UplinkObject;
+
+
+#define WORLDPARTITION_COUNT            32              // Handed out to the threads one at a time
+
+#define WORLDCOMMAND_SECURITYBREACH     1               // World::MarkSecurityBreach ( (Computer *) object )
+#define WORLDCOMMAND_UPDATE             2               // object->Update ()
+
+
+struct WorldCommand
+{
+
+	int TYPE;
+	UplinkObject *object;
+	unsigned long long random;                          // The object's stream, carried on by the command
+
+};
+
+
+class WorldPartition
+{
+
+public:
+
+	int first;                                          // Objects [first, last) of the update
+	int last;
+
+	unsigned long long random;                          // Stream of the object being updated
+	LList <WorldCommand *> commands;                    // Run on the main thread after all partitions
+
+public:
+
+	void AddCommand ( int TYPE, UplinkObject *object );
+
+};
+
+
+typedef void (*WorldPartitionUpdate) ( UplinkObject *object, WorldPartition *partition );
+
+// Calls update ( object, partition ) for every object on numthreads threads,
+// then runs the queued commands. Draws one seed for the streams from the
+// main random numbers
+
+void UpdatePartitioned ( BTree <UplinkObject *> *btree, WorldPartitionUpdate update, int numthreads );
+
+
+#endif